@@ -0,0 +1,201 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+// Measures the throughput of cdc_concurrent_map with 1 to 64 threads against a
+// cdc_hash_table behind one global mutex. Every thread does a mix of 90%
+// lookups and 10% insert_or_assign on random keys.
+// Usage: concurrent-map [number of keys] [operations per thread].
+#define CDC_USE_SHORT_NAMES
+#include <cdcontainers/cdc.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_THREADS 64
+#define WRITE_PERCENT 10
+
+struct worker {
+  pthread_t thread;
+  concurrent_map_t *map;
+  hash_table_t *table;
+  pthread_mutex_t *mutex;
+  size_t keys;
+  size_t ops;
+  size_t seed;
+  size_t found;
+};
+
+static int eq(const void *l, const void *r)
+{
+  return CDC_TO_SIZE(l) == CDC_TO_SIZE(r);
+}
+
+static size_t hash(const void *val)
+{
+  return cdc_hash_mix(CDC_TO_SIZE(val));
+}
+
+static size_t next_random(size_t *state)
+{
+  *state = *state * 6364136223846793005ull + 1442695040888963407ull;
+  return *state >> 17;
+}
+
+static double now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void *run_concurrent_map(void *arg)
+{
+  struct worker *w = (struct worker *)arg;
+  for (size_t i = 0; i < w->ops; ++i) {
+    size_t r = next_random(&w->seed);
+    void *key = CDC_FROM_SIZE(r % w->keys);
+    if (r / w->keys % 100 < WRITE_PERCENT) {
+      concurrent_map_insert_or_assign(w->map, key, key, NULL);
+    } else {
+      void *value = NULL;
+      w->found += concurrent_map_get(w->map, key, &value) == CDC_STATUS_OK;
+    }
+  }
+
+  return NULL;
+}
+
+static void *run_locked_table(void *arg)
+{
+  struct worker *w = (struct worker *)arg;
+  for (size_t i = 0; i < w->ops; ++i) {
+    size_t r = next_random(&w->seed);
+    void *key = CDC_FROM_SIZE(r % w->keys);
+    pthread_mutex_lock(w->mutex);
+    if (r / w->keys % 100 < WRITE_PERCENT) {
+      hash_table_insert_or_assign(w->table, key, key, NULL, NULL);
+    } else {
+      void *value = NULL;
+      w->found += hash_table_get(w->table, key, &value) == CDC_STATUS_OK;
+    }
+
+    pthread_mutex_unlock(w->mutex);
+  }
+
+  return NULL;
+}
+
+// Returns millions of operations per second or a negative value on failure.
+static double run(struct worker *workers, size_t threads, void *(*fn)(void *))
+{
+  double start = now();
+  size_t started = 0;
+  for (; started < threads; ++started) {
+    if (pthread_create(&workers[started].thread, NULL, fn, &workers[started]) != 0) {
+      break;
+    }
+  }
+
+  size_t ops = 0;
+  size_t found = 0;
+  for (size_t i = 0; i < started; ++i) {
+    pthread_join(workers[i].thread, NULL);
+    ops += workers[i].ops;
+    found += workers[i].found;
+  }
+
+  double seconds = now() - start;
+  if (started != threads || found == 0) {
+    return -1.0;
+  }
+
+  return seconds > 0 ? (double)ops / seconds / 1e6 : 0.0;
+}
+
+int main(int argc, char **argv)
+{
+  size_t keys = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 1000000;
+  size_t ops = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 1000000;
+  if (keys == 0 || ops == 0) {
+    return EXIT_SUCCESS;
+  }
+
+  concurrent_map_t *map = NULL;
+  hash_table_t *table = NULL;
+  pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  if (concurrent_map_ctor(&map, &info) != CDC_STATUS_OK) {
+    return EXIT_FAILURE;
+  }
+
+  if (hash_table_ctor(&table, &info) != CDC_STATUS_OK) {
+    concurrent_map_dtor(map);
+    return EXIT_FAILURE;
+  }
+
+  int ret = EXIT_SUCCESS;
+  for (size_t i = 0; i < keys && ret == EXIT_SUCCESS; ++i) {
+    void *key = CDC_FROM_SIZE(i);
+    if (concurrent_map_insert(map, key, key, NULL) != CDC_STATUS_OK ||
+        hash_table_insert(table, key, key, NULL, NULL) != CDC_STATUS_OK) {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  static struct worker workers[MAX_THREADS];
+  printf("%zu keys, %zu operations per thread, %d%% writes\n", keys, ops, WRITE_PERCENT);
+  printf("millions of operations per second\n");
+  printf("%8s %16s %16s\n", "threads", "concurrent_map", "mutex+table");
+  for (size_t threads = 1; threads <= MAX_THREADS && ret == EXIT_SUCCESS; threads *= 2) {
+    for (size_t i = 0; i < threads; ++i) {
+      struct worker w = {0};
+      w.map = map;
+      w.table = table;
+      w.mutex = &mutex;
+      w.keys = keys;
+      w.ops = ops;
+      w.seed = i + 1;
+      workers[i] = w;
+    }
+
+    double sharded = run(workers, threads, run_concurrent_map);
+    for (size_t i = 0; i < threads; ++i) {
+      workers[i].seed = i + 1;
+      workers[i].found = 0;
+    }
+
+    double locked = run(workers, threads, run_locked_table);
+    if (sharded < 0 || locked < 0) {
+      ret = EXIT_FAILURE;
+      break;
+    }
+
+    printf("%8zu %16.2f %16.2f\n", threads, sharded, locked);
+  }
+
+  concurrent_map_dtor(map);
+  hash_table_dtor(table);
+  return ret;
+}
@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+// Reports the build time, the bytes per key and the lookup throughput of
+// cdc_frozen_map built from a cdc_hash_table snapshot, next to the same numbers
+// of the hash table. Usage: frozen-map [maximum number of keys].
+#define CDC_USE_SHORT_NAMES
+#include <cdcontainers/cdc.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static int eq(const void *l, const void *r)
+{
+  return CDC_TO_SIZE(l) == CDC_TO_SIZE(r);
+}
+
+static size_t hash(const void *val)
+{
+  return cdc_hash_mix(CDC_TO_SIZE(val));
+}
+
+static double seconds(clock_t start)
+{
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static double mops(size_t n, double elapsed)
+{
+  return elapsed > 0 ? (double)n / elapsed / 1e6 : 0.0;
+}
+
+// The frozen map has no memory_usage, its arrays are sized by the number of
+// keys and buckets.
+static size_t frozen_map_bytes(frozen_map_t *m)
+{
+  return sizeof(frozen_map_t) + 2 * m->size * sizeof(void *) + m->bcount * sizeof(uint32_t);
+}
+
+// The table object, its buckets and one malloc'ed entry per key plus the nil
+// entry; allocator overhead is not counted.
+static size_t hash_table_bytes(hash_table_t *t)
+{
+  return sizeof(hash_table_t) + t->bcount * sizeof(hash_table_entry_t *) +
+         (t->size + 1) * sizeof(hash_table_entry_t);
+}
+
+static int run(size_t n)
+{
+  hash_table_t *t = NULL;
+  frozen_map_t *m = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  if (hash_table_ctor(&t, &info) != CDC_STATUS_OK) {
+    return EXIT_FAILURE;
+  }
+
+  // Keys are spread over the whole range, so they are not dense integers.
+  for (size_t i = 0; i < n; ++i) {
+    void *key = CDC_FROM_SIZE(i * 2654435761u);
+    if (hash_table_insert(t, key, key, NULL, NULL) != CDC_STATUS_OK) {
+      hash_table_dtor(t);
+      return EXIT_FAILURE;
+    }
+  }
+
+  clock_t start = clock();
+  if (frozen_map_ctor_hash_table(&m, &info, t) != CDC_STATUS_OK) {
+    hash_table_dtor(t);
+    return EXIT_FAILURE;
+  }
+
+  double build = seconds(start);
+
+  size_t found = 0;
+  start = clock();
+  for (size_t i = 0; i < n; ++i) {
+    void *value = NULL;
+    found += frozen_map_get(m, CDC_FROM_SIZE(i * 2654435761u), &value) == CDC_STATUS_OK;
+  }
+
+  double frozen_lookup = mops(n, seconds(start));
+
+  start = clock();
+  for (size_t i = 0; i < n; ++i) {
+    void *value = NULL;
+    found += hash_table_get(t, CDC_FROM_SIZE(i * 2654435761u), &value) == CDC_STATUS_OK;
+  }
+
+  double table_lookup = mops(n, seconds(start));
+  double frozen_bytes = (double)frozen_map_bytes(m) / (double)n;
+  double table_bytes = (double)hash_table_bytes(t) / (double)n;
+  printf("%10zu %10.3f %10.2f %10.2f %10.2f %10.2f\n", n, build, frozen_bytes, table_bytes,
+         frozen_lookup, table_lookup);
+  frozen_map_dtor(m);
+  hash_table_dtor(t);
+  return found == 2 * n ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char **argv)
+{
+  size_t max = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 4096000;
+  printf("build in seconds, bytes per key, millions of lookups per second\n");
+  printf("%10s %10s %10s %10s %10s %10s\n", "keys", "build", "frozen B", "table B", "frozen",
+         "table");
+  for (size_t n = 1000; n <= max; n *= 4) {
+    if (run(n) != EXIT_SUCCESS) {
+      printf("%zu keys failed\n", n);
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+// Compares cdc_hash_table_get_many with a loop of cdc_hash_table_get on a table
+// larger than the caches, for batches of 64 to 256 keys.
+// Usage: get-many [number of keys].
+#define CDC_USE_SHORT_NAMES
+#include <cdcontainers/cdc.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_BATCH_SIZE 256
+
+static int eq(const void *l, const void *r)
+{
+  return CDC_TO_SIZE(l) == CDC_TO_SIZE(r);
+}
+
+static size_t hash(const void *val)
+{
+  return cdc_hash_mix(CDC_TO_SIZE(val));
+}
+
+static void shuffle(size_t *keys, size_t n, unsigned seed)
+{
+  srand(seed);
+  for (size_t i = n - 1; i > 0; --i) {
+    size_t j = ((size_t)rand() * ((size_t)RAND_MAX + 1) + (size_t)rand()) % (i + 1);
+    CDC_SWAP(size_t, keys[i], keys[j]);
+  }
+}
+
+static double mops(size_t n, clock_t start)
+{
+  double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  return seconds > 0 ? (double)n / seconds / 1e6 : 0.0;
+}
+
+static int run(hash_table_t *t, size_t *probes, size_t n, size_t batch)
+{
+  void *keys[MAX_BATCH_SIZE];
+  void *values[MAX_BATCH_SIZE];
+  bool found[MAX_BATCH_SIZE];
+  size_t count = n - n % batch;
+
+  size_t single = 0;
+  clock_t start = clock();
+  for (size_t i = 0; i < count; i += batch) {
+    for (size_t j = 0; j < batch; ++j) {
+      void *value = NULL;
+      single += hash_table_get(t, CDC_FROM_SIZE(probes[i + j]), &value) == CDC_STATUS_OK;
+    }
+  }
+
+  double get = mops(count, start);
+
+  size_t many = 0;
+  start = clock();
+  for (size_t i = 0; i < count; i += batch) {
+    for (size_t j = 0; j < batch; ++j) {
+      keys[j] = CDC_FROM_SIZE(probes[i + j]);
+    }
+
+    many += hash_table_get_many(t, keys, batch, values, found);
+  }
+
+  double get_many = mops(count, start);
+  printf("%8zu %12.2f %12.2f %10.2f\n", batch, get, get_many, get > 0 ? get_many / get : 0.0);
+  return single == count && many == count ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 4000000;
+  if (n < MAX_BATCH_SIZE) {
+    return EXIT_SUCCESS;
+  }
+
+  hash_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  size_t *probes = (size_t *)malloc(n * sizeof(size_t));
+  if (!probes || hash_table_ctor(&t, &info) != CDC_STATUS_OK) {
+    free(probes);
+    return EXIT_FAILURE;
+  }
+
+  int ret = EXIT_SUCCESS;
+  for (size_t i = 0; i < n && ret == EXIT_SUCCESS; ++i) {
+    probes[i] = i;
+    if (hash_table_insert(t, CDC_FROM_SIZE(i), CDC_FROM_SIZE(i), NULL, NULL) != CDC_STATUS_OK) {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  shuffle(probes, n, 1);
+  printf("%zu keys, millions of lookups per second\n", n);
+  printf("%8s %12s %12s %10s\n", "batch", "get", "get_many", "speedup");
+  for (size_t batch = 64; batch <= MAX_BATCH_SIZE && ret == EXIT_SUCCESS; batch *= 2) {
+    ret = run(t, probes, n, batch);
+  }
+
+  hash_table_dtor(t);
+  free(probes);
+  return ret;
+}
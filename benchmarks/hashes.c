@@ -0,0 +1,87 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+// Compares the throughput of cdc_hash_bytes with the cdc_hash_binary combiner
+// on keys from 4 bytes to 4 KB. Usage: hashes [megabytes hashed per key size].
+#define CDC_USE_SHORT_NAMES
+#include <cdcontainers/cdc.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Keys are read at different offsets of the buffer, so the hashes cannot be
+// hoisted out of the loop.
+#define BUFFER_SIZE (64 * 1024)
+#define MAX_KEY_SIZE 4096
+
+static double seconds(clock_t start)
+{
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void report(const char *name, size_t size, size_t n, double elapsed)
+{
+  double mhashes = elapsed > 0 ? (double)n / elapsed / 1e6 : 0.0;
+  double gbytes = elapsed > 0 ? (double)n * (double)size / elapsed / 1e9 : 0.0;
+  printf("%-8s %8zu %14.2f %12.2f\n", name, size, mhashes, gbytes);
+}
+
+int main(int argc, char **argv)
+{
+  size_t megabytes = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 256;
+  char *buffer = (char *)malloc(BUFFER_SIZE);
+  if (!buffer) {
+    return EXIT_FAILURE;
+  }
+
+  srand(1);
+  for (size_t i = 0; i < BUFFER_SIZE; ++i) {
+    buffer[i] = (char)rand();
+  }
+
+  printf("%zu MB hashed per key size\n", megabytes);
+  printf("%-8s %8s %14s %12s\n", "hash", "bytes", "Mhashes/s", "GB/s");
+  size_t sink = 0;
+  for (size_t size = 4; size <= MAX_KEY_SIZE; size *= 2) {
+    size_t n = CDC_MAX(megabytes * 1024 * 1024 / size, (size_t)1);
+    size_t offsets = BUFFER_SIZE - size;
+
+    clock_t start = clock();
+    for (size_t i = 0; i < n; ++i) {
+      sink ^= cdc_hash_binary(buffer + (i * 64) % offsets, size);
+    }
+
+    report("binary", size, n, seconds(start));
+
+    start = clock();
+    for (size_t i = 0; i < n; ++i) {
+      sink ^= cdc_hash_bytes(buffer + (i * 64) % offsets, size, 0);
+    }
+
+    report("bytes", size, n, seconds(start));
+  }
+
+  // The result is printed, so the compiler keeps the hashes.
+  printf("checksum %zx\n", sink);
+  free(buffer);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,195 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+// Reports the bytes per entry and the lookup throughput of the trees that take
+// their nodes from a cdc_node_pool. The bytes include the pool chunks, "node"
+// is the size of one node and "reused" are the bytes per entry after half of
+// the keys are erased and inserted again. The bytes are counted by the
+// allocator of the map. Usage: node-pool [number of keys].
+#define CDC_USE_SHORT_NAMES
+#include <cdcontainers/cdc.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Every block starts with its size, the header keeps the block aligned for any
+// type.
+#define HEADER_SIZE 16
+
+struct backend {
+  const char *name;
+  const map_table_t *table;
+  size_t node_size;
+};
+
+static void *counting_alloc(void *ctx, size_t size)
+{
+  char *block = (char *)malloc(HEADER_SIZE + size);
+  if (!block) {
+    return NULL;
+  }
+
+  *(size_t *)block = size;
+  *(size_t *)ctx += size;
+  return block + HEADER_SIZE;
+}
+
+static void counting_free(void *ctx, void *ptr)
+{
+  if (ptr) {
+    char *block = (char *)ptr - HEADER_SIZE;
+    *(size_t *)ctx -= *(size_t *)block;
+    free(block);
+  }
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t size)
+{
+  if (!ptr) {
+    return counting_alloc(ctx, size);
+  }
+
+  char *block = (char *)ptr - HEADER_SIZE;
+  size_t old_size = *(size_t *)block;
+  block = (char *)realloc(block, HEADER_SIZE + size);
+  if (!block) {
+    return NULL;
+  }
+
+  *(size_t *)block = size;
+  *(size_t *)ctx += size - old_size;
+  return block + HEADER_SIZE;
+}
+
+static int lt(const void *l, const void *r)
+{
+  return CDC_TO_SIZE(l) < CDC_TO_SIZE(r);
+}
+
+static void shuffle(size_t *keys, size_t n, unsigned seed)
+{
+  srand(seed);
+  for (size_t i = n - 1; i > 0; --i) {
+    size_t j = ((size_t)rand() * ((size_t)RAND_MAX + 1) + (size_t)rand()) % (i + 1);
+    CDC_SWAP(size_t, keys[i], keys[j]);
+  }
+}
+
+static double mops(size_t n, clock_t start)
+{
+  double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  return seconds > 0 ? (double)n / seconds / 1e6 : 0.0;
+}
+
+static int run(const struct backend *backend, size_t *keys, size_t *probes, size_t n)
+{
+  map_t *m = NULL;
+  size_t allocated = 0;
+  allocator_t allocator = {counting_alloc, counting_realloc, counting_free, &allocated};
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+  info.allocator = &allocator;
+  if (map_ctor(backend->table, &m, &info) != CDC_STATUS_OK) {
+    return EXIT_FAILURE;
+  }
+
+  int ret = EXIT_SUCCESS;
+  clock_t start = clock();
+  for (size_t i = 0; i < n && ret == EXIT_SUCCESS; ++i) {
+    if (map_insert(m, CDC_FROM_SIZE(keys[i]), CDC_FROM_SIZE(keys[i]), NULL, NULL) !=
+        CDC_STATUS_OK) {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  double insert = mops(n, start);
+  double bytes = (double)allocated / (double)n;
+
+  size_t found = 0;
+  start = clock();
+  for (size_t i = 0; i < n; ++i) {
+    void *value = NULL;
+    found += map_get(m, CDC_FROM_SIZE(probes[i]), &value) == CDC_STATUS_OK;
+  }
+
+  double lookup = mops(n, start);
+
+  // Erased nodes go to the free list of the pool and are taken again.
+  for (size_t i = 0; i < n; i += 2) {
+    map_erase(m, CDC_FROM_SIZE(keys[i]));
+  }
+
+  for (size_t i = 0; i < n && ret == EXIT_SUCCESS; i += 2) {
+    if (map_insert(m, CDC_FROM_SIZE(keys[i]), CDC_FROM_SIZE(keys[i]), NULL, NULL) !=
+        CDC_STATUS_OK) {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  double reused = (double)allocated / (double)n;
+  printf("%-8s %12.2f %12.2f %10.2f %10zu %10.2f\n", backend->name, insert, lookup, bytes,
+         backend->node_size, reused);
+  map_dtor(m);
+  return ret == EXIT_SUCCESS && found == n ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 1000000;
+  if (n == 0) {
+    return EXIT_SUCCESS;
+  }
+
+  size_t *keys = (size_t *)malloc(n * sizeof(size_t));
+  size_t *probes = (size_t *)malloc(n * sizeof(size_t));
+  if (!keys || !probes) {
+    free(keys);
+    free(probes);
+    return EXIT_FAILURE;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    keys[i] = i;
+    probes[i] = i;
+  }
+
+  shuffle(keys, n, 1);
+  shuffle(probes, n, 2);
+
+  const struct backend backends[] = {{"avl", cdc_map_avl, sizeof(avl_tree_node_t)},
+                                     {"splay", cdc_map_splay, sizeof(splay_tree_node_t)},
+                                     {"treap", cdc_map_treap, sizeof(treap_node_t)}};
+  printf("%zu random keys, millions of operations per second, bytes per entry\n", n);
+  printf("%-8s %12s %12s %10s %10s %10s\n", "tree", "insert", "lookup", "bytes", "node",
+         "reused");
+  int ret = EXIT_SUCCESS;
+  for (size_t i = 0; i < CDC_ARRAY_SIZE(backends); ++i) {
+    if (run(&backends[i], keys, probes, n) != EXIT_SUCCESS) {
+      printf("%s failed\n", backends[i].name);
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  free(keys);
+  free(probes);
+  return ret;
+}
@@ -0,0 +1,148 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+// Compares the throughput of insertion, lookup and full iteration of the
+// ordered cdc_map backends. Usage: ordered-maps [number of keys].
+#define CDC_USE_SHORT_NAMES
+#include <cdcontainers/cdc.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+struct backend {
+  const char *name;
+  const map_table_t *table;
+};
+
+static int lt(const void *l, const void *r)
+{
+  return CDC_TO_SIZE(l) < CDC_TO_SIZE(r);
+}
+
+static void shuffle(size_t *keys, size_t n, unsigned seed)
+{
+  srand(seed);
+  for (size_t i = n - 1; i > 0; --i) {
+    size_t j = ((size_t)rand() * ((size_t)RAND_MAX + 1) + (size_t)rand()) % (i + 1);
+    CDC_SWAP(size_t, keys[i], keys[j]);
+  }
+}
+
+static double mops(size_t n, clock_t start)
+{
+  double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  return seconds > 0 ? (double)n / seconds / 1e6 : 0.0;
+}
+
+static int run(const struct backend *backend, size_t *keys, size_t *probes, size_t n)
+{
+  map_t *m = NULL;
+  map_iter_t it = CDC_INIT_STRUCT;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+  if (map_ctor(backend->table, &m, &info) != CDC_STATUS_OK) {
+    return EXIT_FAILURE;
+  }
+
+  if (map_iter_ctor(m, &it) != CDC_STATUS_OK) {
+    map_dtor(m);
+    return EXIT_FAILURE;
+  }
+
+  clock_t start = clock();
+  for (size_t i = 0; i < n; ++i) {
+    if (map_insert(m, CDC_FROM_SIZE(keys[i]), CDC_FROM_SIZE(keys[i]), NULL, NULL) !=
+        CDC_STATUS_OK) {
+      map_iter_dtor(&it);
+      map_dtor(m);
+      return EXIT_FAILURE;
+    }
+  }
+
+  double insert = mops(n, start);
+
+  size_t found = 0;
+  start = clock();
+  for (size_t i = 0; i < n; ++i) {
+    void *value = NULL;
+    found += map_get(m, CDC_FROM_SIZE(probes[i]), &value) == CDC_STATUS_OK;
+  }
+
+  double lookup = mops(n, start);
+
+  size_t sum = 0;
+  start = clock();
+  for (map_begin(m, &it); map_iter_has_next(&it); map_iter_next(&it)) {
+    sum += CDC_TO_SIZE(map_iter_value(&it));
+  }
+
+  double iteration = mops(n, start);
+  memory_usage_t usage = map_memory_usage(m);
+  printf("%-8s %12.2f %12.2f %12.2f %14zu\n", backend->name, insert, lookup, iteration,
+         usage.bytes);
+  map_iter_dtor(&it);
+  map_dtor(m);
+  return found == n && sum == n * (n - 1) / 2 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 1000000;
+  if (n == 0) {
+    return EXIT_SUCCESS;
+  }
+
+  size_t *keys = (size_t *)malloc(n * sizeof(size_t));
+  size_t *probes = (size_t *)malloc(n * sizeof(size_t));
+  if (!keys || !probes) {
+    free(keys);
+    free(probes);
+    return EXIT_FAILURE;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    keys[i] = i;
+    probes[i] = i;
+  }
+
+  shuffle(keys, n, 1);
+  shuffle(probes, n, 2);
+
+  const struct backend backends[] = {{"avl", cdc_map_avl},
+                                     {"splay", cdc_map_splay},
+                                     {"treap", cdc_map_treap},
+                                     {"btree", cdc_map_btree},
+                                     {"rbtree", cdc_map_rbtree}};
+  printf("%zu random keys, millions of operations per second\n", n);
+  printf("%-8s %12s %12s %12s %14s\n", "map", "insert", "lookup", "iteration", "bytes");
+  int ret = EXIT_SUCCESS;
+  for (size_t i = 0; i < CDC_ARRAY_SIZE(backends); ++i) {
+    if (run(&backends[i], keys, probes, n) != EXIT_SUCCESS) {
+      printf("%s failed\n", backends[i].name);
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  free(keys);
+  free(probes);
+  return ret;
+}
@@ -49,6 +49,7 @@
 struct cdc_deque {
   void *container;
   const struct cdc_sequence_table *table;
+  const struct cdc_allocator *allocator;
 };
 
 // Base
@@ -162,6 +163,21 @@ static inline bool cdc_deque_empty(struct cdc_deque *d)
   return d->table->empty(d->container);
 }
 
+/**
+ * @brief Returns the memory used by the deque and its container. The memory of
+ * the elements is not included.
+ * @param d - cdc_deque
+ * @return memory usage
+ */
+static inline struct cdc_memory_usage cdc_deque_memory_usage(struct cdc_deque *d)
+{
+  assert(d != NULL);
+
+  struct cdc_memory_usage usage = d->table->memory_usage(d->container);
+  usage.bytes += sizeof(struct cdc_deque);
+  return usage;
+}
+
 /**
  * @brief Returns the number of items in the deque.
  * @param d - cdc_deque
@@ -311,6 +327,7 @@ typedef struct cdc_deque deque_t;
 
 // Capacity
 #define deque_empty(...) cdc_deque_empty(__VA_ARGS__)
+#define deque_memory_usage(...) cdc_deque_memory_usage(__VA_ARGS__)
 #define deque_size(...) cdc_deque_size(__VA_ARGS__)
 
 // Modifiers
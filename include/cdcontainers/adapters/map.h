@@ -30,6 +30,7 @@
 #ifndef CDCONTAINERS_INCLUDE_CDCONTAINERS_MAP_H
 #define CDCONTAINERS_INCLUDE_CDCONTAINERS_MAP_H
 
+#include <cdcontainers/bloom-filter.h>
 #include <cdcontainers/common.h>
 #include <cdcontainers/status.h>
 #include <cdcontainers/tables/imap.h>
@@ -51,6 +52,8 @@
 struct cdc_map {
   void *container;
   const struct cdc_map_table *table;
+  struct cdc_bloom_filter *filter;
+  const struct cdc_allocator *allocator;
 };
 
 /**
@@ -61,6 +64,7 @@ struct cdc_map {
 struct cdc_map_iter {
   void *iter;
   const struct cdc_map_iter_table *table;
+  const struct cdc_allocator *allocator;
 };
 
 // Base
@@ -71,7 +75,8 @@ struct cdc_map_iter {
 /**
  * @brief Constructs an empty map.
  * @param[in] table - table of a map implementation. It can be cdc_map_avl,
- * cdc_map_splay, cdc_map_map, cdc_map_htable.
+ * cdc_map_splay, cdc_map_map, cdc_map_btree, cdc_map_rbtree, cdc_map_htable,
+ * cdc_map_flat_htable, cdc_map_robin_hood_htable.
  * @param[out] m - cdc_map
  * @param[in] info - cdc_data_info
  * @return CDC_STATUS_OK in a successful case or other value indicating
@@ -94,7 +99,8 @@ enum cdc_stat cdc_map_ctor(const struct cdc_map_table *table, struct cdc_map **m
  * pointers on cdc_pair's(first - key, and the second - value).  The last item
  * must be CDC_END.
  * @param[in] table - table of a map implementation. It can be cdc_map_avl,
- * cdc_map_splay, cdc_map_map, cdc_map_htable.
+ * cdc_map_splay, cdc_map_map, cdc_map_btree, cdc_map_rbtree, cdc_map_htable,
+ * cdc_map_flat_htable, cdc_map_robin_hood_htable.
  * @param[out] m - cdc_map
  * @param[in] info - cdc_data_info
  * @return CDC_STATUS_OK in a successful case or other value indicating
@@ -118,7 +124,8 @@ enum cdc_stat cdc_map_ctorl(const struct cdc_map_table *table, struct cdc_map **
  * @brief Constructs a map, initialized by args. The last item must be
  * CDC_END.
  * @param[in] table - table of a map implementation. It can be cdc_map_avl,
- * cdc_map_splay, cdc_map_map, cdc_map_htable.
+ * cdc_map_splay, cdc_map_map, cdc_map_btree, cdc_map_rbtree, cdc_map_htable,
+ * cdc_map_flat_htable, cdc_map_robin_hood_htable.
  * @param[out] m - cdc_map
  * @param[in] info - cdc_data_info
  * @return CDC_STATUS_OK in a successful case or other value indicating
@@ -126,11 +133,72 @@ enum cdc_stat cdc_map_ctorl(const struct cdc_map_table *table, struct cdc_map **
  */
 enum cdc_stat cdc_map_ctorv(const struct cdc_map_table *table, struct cdc_map **m,
                             struct cdc_data_info *info, va_list args);
+
+/**
+ * @brief Constructs a map from an array of pairs(first - key, and the second -
+ * value) sorted by keys in ascending order without duplicates. The tree tables
+ * build a balanced tree in O(n) without comparing the keys, the other tables
+ * insert the pairs one by one.
+ * @param[in] table - table of a map implementation.
+ * @param[out] m - cdc_map
+ * @param[in] info - cdc_data_info
+ * @param[in] pairs - sorted array of pairs
+ * @param[in] n - number of pairs
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_map_ctor_sorted(const struct cdc_map_table *table, struct cdc_map **m,
+                                  struct cdc_data_info *info, const struct cdc_pair *pairs,
+                                  size_t n);
 /**
  * @brief Destroys the map.
  * @param[in] t - cdc_map
  */
 void cdc_map_dtor(struct cdc_map *m);
+
+/**
+ * @brief Puts a bloom filter in front of the map. Then cdc_map_get,
+ * cdc_map_get_many, cdc_map_count and cdc_map_find answer for most of the
+ * missing keys from one cache line of the filter without a lookup in the
+ * underlying container. When the filter is full, it is rebuilt from the keys
+ * of the map with a capacity of twice the map size. Erased keys stay in the
+ * filter until it is rebuilt, so many erasures increase the false positive rate.
+ * @param[in] m - cdc_map
+ * @param[in] hash - hash function of the keys, it can differ from the one of
+ * the map
+ * @param[in] fp_rate - false positive rate of the filter, it must be in the
+ * range (0, 1)
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_map_enable_filter(struct cdc_map *m, cdc_hash_fn_t hash, double fp_rate);
+
+/**
+ * @brief Removes the bloom filter added by cdc_map_enable_filter.
+ * @param[in] m - cdc_map
+ */
+void cdc_map_disable_filter(struct cdc_map *m);
+
+/**
+ * @brief Adds a key to the bloom filter of the map and grows the filter if it
+ * is full. It is used by the insertion functions.
+ * @param[in] m - cdc_map
+ * @param[in] key - inserted key
+ */
+void cdc_map_filter_insert(struct cdc_map *m, void *key);
+
+/**
+ * @brief Looks up n keys like cdc_map_get_many, but only the keys that pass the
+ * bloom filter reach the underlying container. It is used by cdc_map_get_many.
+ * @param[in] m - cdc_map
+ * @param[in] keys - keys of the elements to find
+ * @param[in] n - number of keys
+ * @param[out] values - values that are mapped to the keys
+ * @param[out] found - flags that are set for the found keys
+ * @return number of the found keys.
+ */
+size_t cdc_map_filter_get_many(struct cdc_map *m, void **keys, size_t n, void **values,
+                               bool *found);
 /** @} */
 
 // Lookup
@@ -150,9 +218,37 @@ static inline enum cdc_stat cdc_map_get(struct cdc_map *m, void *key, void **val
 {
   assert(m != NULL);
 
+  if (m->filter && !cdc_bloom_filter_contains(m->filter, key)) {
+    return CDC_STATUS_NOT_FOUND;
+  }
+
   return m->table->get(m->container, key, value);
 }
 
+/**
+ * @brief Looks up n keys at once. If keys[i] is found, found[i] is set to true
+ * and values[i] to the mapped value, otherwise found[i] is set to false and
+ * values[i] is not changed. Hash table based maps overlap the memory accesses
+ * of different keys, so this is faster than n calls of cdc_map_get.
+ * @param[in] m - cdc_map
+ * @param[in] keys - keys of the elements to find
+ * @param[in] n - number of keys
+ * @param[out] values - values that are mapped to the keys
+ * @param[out] found - flags that are set for the found keys
+ * @return number of the found keys.
+ */
+static inline size_t cdc_map_get_many(struct cdc_map *m, void **keys, size_t n, void **values,
+                                      bool *found)
+{
+  assert(m != NULL);
+
+  if (m->filter) {
+    return cdc_map_filter_get_many(m, keys, n, values, found);
+  }
+
+  return m->table->get_many(m->container, keys, n, values, found);
+}
+
 /**
  * @brief Returns the number of elements with key that compares equal to the
  * specified argument key, which is either 1 or 0 since this container does not
@@ -165,6 +261,10 @@ static inline size_t cdc_map_count(struct cdc_map *m, void *key)
 {
   assert(m != NULL);
 
+  if (m->filter && !cdc_bloom_filter_contains(m->filter, key)) {
+    return 0;
+  }
+
   return m->table->count(m->container, key);
 }
 
@@ -180,8 +280,211 @@ static inline void cdc_map_find(struct cdc_map *m, void *key, struct cdc_map_ite
 {
   assert(m != NULL);
 
+  if (m->filter && !cdc_bloom_filter_contains(m->filter, key)) {
+    m->table->end(m->container, it->iter);
+    return;
+  }
+
   m->table->find(m->container, key, it->iter);
 }
+
+/**
+ * @brief Finds the first element with key that is not less than key. Only
+ * ordered maps support it.
+ * @param[in] m - cdc_map
+ * @param[in] key - key value to compare the elements to
+ * @param[out] it - pointer will be recorded iterator to the first element with
+ * key not less than key. If no such element is found, past-the-end iterator is
+ * returned.
+ * @return CDC_STATUS_OK in a successful case or CDC_STATUS_NOT_SUPPORTED if the
+ * map is not ordered.
+ */
+static inline enum cdc_stat cdc_map_lower_bound(struct cdc_map *m, void *key,
+                                                struct cdc_map_iter *it)
+{
+  assert(m != NULL);
+
+  if (!m->table->lower_bound) {
+    return CDC_STATUS_NOT_SUPPORTED;
+  }
+
+  m->table->lower_bound(m->container, key, it->iter);
+  return CDC_STATUS_OK;
+}
+
+/**
+ * @brief Finds the first element with key that is greater than key. Only
+ * ordered maps support it.
+ * @param[in] m - cdc_map
+ * @param[in] key - key value to compare the elements to
+ * @param[out] it - pointer will be recorded iterator to the first element with
+ * key greater than key. If no such element is found, past-the-end iterator is
+ * returned.
+ * @return CDC_STATUS_OK in a successful case or CDC_STATUS_NOT_SUPPORTED if the
+ * map is not ordered.
+ */
+static inline enum cdc_stat cdc_map_upper_bound(struct cdc_map *m, void *key,
+                                                struct cdc_map_iter *it)
+{
+  assert(m != NULL);
+
+  if (!m->table->upper_bound) {
+    return CDC_STATUS_NOT_SUPPORTED;
+  }
+
+  m->table->upper_bound(m->container, key, it->iter);
+  return CDC_STATUS_OK;
+}
+
+/**
+ * @brief Returns a range containing all elements with key equivalent to key,
+ * which has at most one element since this container does not allow duplicates.
+ * Only ordered maps support it.
+ * @param[in] m - cdc_map
+ * @param[in] key - key value to compare the elements to
+ * @param[out] first - pointer will be recorded the lower bound of key
+ * @param[out] last - pointer will be recorded the upper bound of key
+ * @return CDC_STATUS_OK in a successful case or CDC_STATUS_NOT_SUPPORTED if the
+ * map is not ordered.
+ */
+static inline enum cdc_stat cdc_map_equal_range(struct cdc_map *m, void *key,
+                                                struct cdc_map_iter *first,
+                                                struct cdc_map_iter *last)
+{
+  assert(m != NULL);
+
+  enum cdc_stat stat = cdc_map_lower_bound(m, key, first);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  return cdc_map_upper_bound(m, key, last);
+}
+
+/**
+ * @brief Returns the range of elements with keys in [from, to) in O(log n). The
+ * elements are visited from first until the iterator is equal to last. Only
+ * ordered maps support it.
+ * @param[in] m - cdc_map
+ * @param[in] from - key value of the beginning of the range
+ * @param[in] to - key value of the end of the range, it must not be less than
+ * from
+ * @param[out] first - pointer will be recorded the lower bound of from
+ * @param[out] last - pointer will be recorded the lower bound of to
+ * @return CDC_STATUS_OK in a successful case or CDC_STATUS_NOT_SUPPORTED if the
+ * map is not ordered.
+ */
+static inline enum cdc_stat cdc_map_range(struct cdc_map *m, void *from, void *to,
+                                          struct cdc_map_iter *first, struct cdc_map_iter *last)
+{
+  assert(m != NULL);
+
+  enum cdc_stat stat = cdc_map_lower_bound(m, from, first);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  return cdc_map_lower_bound(m, to, last);
+}
+
+/**
+ * @brief Finds the element with index k in the order of the keys, the index of
+ * the first element is 0. Only the cdc_map_avl and cdc_map_treap maps support
+ * it if the library is built with the CDC_ORDER_STATISTICS option.
+ * @param[in] m - cdc_map
+ * @param[in] k - index of the element
+ * @param[out] it - pointer will be recorded iterator to the element with index
+ * k. If k is not less than the size of the map, past-the-end iterator is
+ * returned.
+ * @return CDC_STATUS_OK in a successful case or CDC_STATUS_NOT_SUPPORTED if the
+ * map does not keep subtree sizes.
+ */
+static inline enum cdc_stat cdc_map_select(struct cdc_map *m, size_t k, struct cdc_map_iter *it)
+{
+  assert(m != NULL);
+
+  if (!m->table->select) {
+    return CDC_STATUS_NOT_SUPPORTED;
+  }
+
+  m->table->select(m->container, k, it->iter);
+  return CDC_STATUS_OK;
+}
+
+/**
+ * @brief Returns the number of elements with keys less than key, that is the
+ * index of key if it is in the map. Only the cdc_map_avl and cdc_map_treap maps
+ * support it if the library is built with the CDC_ORDER_STATISTICS option.
+ * @param[in] m - cdc_map
+ * @param[in] key - key value to compare the elements to
+ * @param[out] rank - pointer will be recorded the number of elements with keys
+ * less than key
+ * @return CDC_STATUS_OK in a successful case or CDC_STATUS_NOT_SUPPORTED if the
+ * map does not keep subtree sizes.
+ */
+static inline enum cdc_stat cdc_map_rank(struct cdc_map *m, void *key, size_t *rank)
+{
+  assert(m != NULL);
+  assert(rank != NULL);
+
+  if (!m->table->rank) {
+    return CDC_STATUS_NOT_SUPPORTED;
+  }
+
+  *rank = m->table->rank(m->container, key);
+  return CDC_STATUS_OK;
+}
+
+/**
+ * @brief The same as cdc_map_get, but looks up a probe, an object that is
+ * compared with the keys by the callbacks of the info. No key is built, so a
+ * string can be looked up by a cdc_str_view without copying it. The hash and eq
+ * callbacks are used by hash tables, the compare callback is used by trees. The
+ * filter of the map is not used.
+ * @param[in] m - cdc_map
+ * @param[in] probe - probe of the element to find
+ * @param[in] info - callbacks of the probe
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+static inline enum cdc_stat cdc_map_get_probe(struct cdc_map *m, const void *probe,
+                                              const struct cdc_probe_info *info, void **value)
+{
+  assert(m != NULL);
+
+  return m->table->get_probe(m->container, probe, info, value);
+}
+
+/**
+ * @brief The same as cdc_map_count, but looks up a probe.
+ * @param[in] m - cdc_map
+ * @param[in] probe - probe of the elements to count
+ * @param[in] info - callbacks of the probe
+ * @return number of elements equal to the probe, that is either 1 or 0.
+ */
+static inline size_t cdc_map_count_probe(struct cdc_map *m, const void *probe,
+                                         const struct cdc_probe_info *info)
+{
+  assert(m != NULL);
+
+  return m->table->count_probe(m->container, probe, info);
+}
+
+/**
+ * @brief The same as cdc_map_find, but looks up a probe.
+ * @param[in] m - cdc_map
+ * @param[in] probe - probe of the element to search for
+ * @param[in] info - callbacks of the probe
+ * @param[out] it - pointer will be recorded iterator to an element equal to the
+ * probe. If no such element is found, past-the-end iterator is returned.
+ */
+static inline void cdc_map_find_probe(struct cdc_map *m, const void *probe,
+                                      const struct cdc_probe_info *info, struct cdc_map_iter *it)
+{
+  assert(m != NULL);
+
+  m->table->find_probe(m->container, probe, info, it->iter);
+}
 /** @} */
 
 // Capacity
@@ -212,6 +515,14 @@ static inline bool cdc_map_empty(struct cdc_map *m)
 
   return m->table->empty(m->container);
 }
+
+/**
+ * @brief Returns the memory used by the map, its container and the Bloom
+ * filter. The memory of the elements is not included.
+ * @param[in] m - cdc_map
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_map_memory_usage(struct cdc_map *m);
 /** @} */
 
 // Modifiers
@@ -228,6 +539,9 @@ static inline void cdc_map_clear(struct cdc_map *m)
   assert(m != NULL);
 
   m->table->clear(m->container);
+  if (m->filter) {
+    cdc_bloom_filter_clear(m->filter);
+  }
 }
 
 /**
@@ -249,7 +563,21 @@ static inline enum cdc_stat cdc_map_insert(struct cdc_map *m, void *key, void *v
   assert(m != NULL);
 
   void *iter = it ? it->iter : NULL;
-  return m->table->insert(m->container, key, value, iter, inserted);
+  if (!m->filter) {
+    return m->table->insert(m->container, key, value, iter, inserted);
+  }
+
+  bool is_inserted = false;
+  enum cdc_stat stat = m->table->insert(m->container, key, value, iter, &is_inserted);
+  if (is_inserted) {
+    cdc_map_filter_insert(m, key);
+  }
+
+  if (inserted) {
+    *inserted = is_inserted;
+  }
+
+  return stat;
 }
 
 /**
@@ -271,7 +599,21 @@ static inline enum cdc_stat cdc_map_insert_or_assign(struct cdc_map *m, void *ke
   assert(m != NULL);
 
   void *iter = it ? it->iter : NULL;
-  return m->table->insert_or_assign(m->container, key, value, iter, inserted);
+  if (!m->filter) {
+    return m->table->insert_or_assign(m->container, key, value, iter, inserted);
+  }
+
+  bool is_inserted = false;
+  enum cdc_stat stat = m->table->insert_or_assign(m->container, key, value, iter, &is_inserted);
+  if (is_inserted) {
+    cdc_map_filter_insert(m, key);
+  }
+
+  if (inserted) {
+    *inserted = is_inserted;
+  }
+
+  return stat;
 }
 
 /**
@@ -299,6 +641,7 @@ static inline void cdc_map_swap(struct cdc_map *a, struct cdc_map *b)
   assert(a->table == b->table);
 
   CDC_SWAP(void *, a->container, b->container);
+  CDC_SWAP(struct cdc_bloom_filter *, a->filter, b->filter);
 }
 /** @} */
 
@@ -374,7 +717,7 @@ static inline void cdc_map_iter_dtor(struct cdc_map_iter *it)
 {
   assert(it != NULL);
 
-  it->table->dtor(it->iter);
+  it->table->dtor(it->iter, it->allocator);
 }
 
 /**
@@ -502,16 +845,32 @@ typedef struct cdc_map_iter map_iter_t;
 #define map_ctor(...) cdc_map_ctor(__VA_ARGS__)
 #define map_ctorv(...) cdc_map_ctorv(__VA_ARGS__)
 #define map_ctorl(...) cdc_map_ctorl(__VA_ARGS__)
+#define map_ctor_sorted(...) cdc_map_ctor_sorted(__VA_ARGS__)
 #define map_dtor(...) cdc_map_dtor(__VA_ARGS__)
+#define map_enable_filter(...) cdc_map_enable_filter(__VA_ARGS__)
+#define map_disable_filter(...) cdc_map_disable_filter(__VA_ARGS__)
+#define map_filter_insert(...) cdc_map_filter_insert(__VA_ARGS__)
+#define map_filter_get_many(...) cdc_map_filter_get_many(__VA_ARGS__)
 
 // Lookup
 #define map_get(...) cdc_map_get(__VA_ARGS__)
+#define map_get_many(...) cdc_map_get_many(__VA_ARGS__)
 #define map_count(...) cdc_map_count(__VA_ARGS__)
 #define map_find(...) cdc_map_find(__VA_ARGS__)
+#define map_lower_bound(...) cdc_map_lower_bound(__VA_ARGS__)
+#define map_upper_bound(...) cdc_map_upper_bound(__VA_ARGS__)
+#define map_equal_range(...) cdc_map_equal_range(__VA_ARGS__)
+#define map_range(...) cdc_map_range(__VA_ARGS__)
+#define map_select(...) cdc_map_select(__VA_ARGS__)
+#define map_rank(...) cdc_map_rank(__VA_ARGS__)
+#define map_get_probe(...) cdc_map_get_probe(__VA_ARGS__)
+#define map_count_probe(...) cdc_map_count_probe(__VA_ARGS__)
+#define map_find_probe(...) cdc_map_find_probe(__VA_ARGS__)
 
 // Capacity
 #define map_size(...) cdc_map_size(__VA_ARGS__)
 #define map_empty(...) cdc_map_empty(__VA_ARGS__)
+#define map_memory_usage(...) cdc_map_memory_usage(__VA_ARGS__)
 
 // Modifiers
 #define map_clear(...) cdc_map_clear(__VA_ARGS__)
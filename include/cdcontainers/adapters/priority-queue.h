@@ -44,6 +44,7 @@
 struct cdc_priority_queue {
   void *container;
   const struct cdc_priority_queue_table *table;
+  const struct cdc_allocator *allocator;
 };
 
 /**
@@ -117,6 +118,21 @@ static inline bool cdc_priority_queue_empty(struct cdc_priority_queue *q)
   return q->table->empty(q->container);
 }
 
+/**
+ * @brief Returns the memory used by the priority queue and its container. The
+ * memory of the elements is not included.
+ * @param q - cdc_priority_queue
+ * @return memory usage
+ */
+static inline struct cdc_memory_usage cdc_priority_queue_memory_usage(struct cdc_priority_queue *q)
+{
+  assert(q != NULL);
+
+  struct cdc_memory_usage usage = q->table->memory_usage(q->container);
+  usage.bytes += sizeof(struct cdc_priority_queue);
+  return usage;
+}
+
 /**
  * @brief Returns the number of items in the priority queue.
  * @param q - cdc_priority_queue
@@ -177,6 +193,7 @@ typedef struct cdc_priority_queue priority_queue_t;
 
 // Capacity
 #define priority_queue_empty(...) cdc_priority_queue_empty(__VA_ARGS__)
+#define priority_queue_memory_usage(...) cdc_priority_queue_memory_usage(__VA_ARGS__)
 #define priority_queue_size(...) cdc_priority_queue_size(__VA_ARGS__)
 
 // Modifiers
@@ -43,6 +43,7 @@
 struct cdc_queue {
   void *container;
   const struct cdc_sequence_table *table;
+  const struct cdc_allocator *allocator;
 };
 
 /**
@@ -126,6 +127,21 @@ static inline bool cdc_queue_empty(struct cdc_queue *q)
   return q->table->empty(q->container);
 }
 
+/**
+ * @brief Returns the memory used by the queue and its container. The memory of
+ * the elements is not included.
+ * @param q - cdc_queue
+ * @return memory usage
+ */
+static inline struct cdc_memory_usage cdc_queue_memory_usage(struct cdc_queue *q)
+{
+  assert(q != NULL);
+
+  struct cdc_memory_usage usage = q->table->memory_usage(q->container);
+  usage.bytes += sizeof(struct cdc_queue);
+  return usage;
+}
+
 /**
  * @brief Returns the number of items in the queue.
  * @param q - cdc_queue
@@ -187,6 +203,7 @@ typedef struct cdc_queue queue_t;
 
 // Capacity
 #define queue_empty(...) cdc_queue_empty(__VA_ARGS__)
+#define queue_memory_usage(...) cdc_queue_memory_usage(__VA_ARGS__)
 #define queue_size(...) cdc_queue_size(__VA_ARGS__)
 
 // Modifiers
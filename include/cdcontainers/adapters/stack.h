@@ -43,6 +43,7 @@
 struct cdc_stack {
   void *container;
   const struct cdc_sequence_table *table;
+  const struct cdc_allocator *allocator;
 };
 
 /**
@@ -112,6 +113,21 @@ static inline bool cdc_stack_empty(struct cdc_stack *s)
   return s->table->empty(s->container);
 }
 
+/**
+ * @brief Returns the memory used by the stack and its container. The memory of
+ * the elements is not included.
+ * @param s - cdc_stack
+ * @return memory usage
+ */
+static inline struct cdc_memory_usage cdc_stack_memory_usage(struct cdc_stack *s)
+{
+  assert(s != NULL);
+
+  struct cdc_memory_usage usage = s->table->memory_usage(s->container);
+  usage.bytes += sizeof(struct cdc_stack);
+  return usage;
+}
+
 /**
  * @brief Returns the number of items in the stack.
  * @param s - cdc_stack
@@ -172,6 +188,7 @@ typedef struct cdc_stack cstack_t;
 
 // Capacity
 #define stack_empty(...) cdc_stack_empty(__VA_ARGS__)
+#define stack_memory_usage(...) cdc_stack_memory_usage(__VA_ARGS__)
 #define stack_size(...) cdc_stack_size(__VA_ARGS__)
 
 // Modifiers
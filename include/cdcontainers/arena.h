@@ -0,0 +1,139 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+/**
+ * @file
+ * @author Maksim Andrianov <maksimandrianov1@yandex.ru>
+ * @brief The cdc_arena is a struct and functions that provide a region
+ * allocator.
+ */
+#ifndef CDCONTAINERS_INCLUDE_CDCONTAINERS_ARENA_H
+#define CDCONTAINERS_INCLUDE_CDCONTAINERS_ARENA_H
+
+#include <cdcontainers/common.h>
+#include <cdcontainers/status.h>
+
+#include <assert.h>
+#include <stddef.h>
+
+/**
+ * @defgroup cdc_arena
+ * @brief The cdc_arena is a struct and functions that provide a region
+ * allocator.
+ *
+ * Memory is cut from large blocks one piece after another and is never
+ * returned separately: cdc_arena_reset and cdc_arena_dtor release all of it at
+ * once. Containers whose cdc_data_info uses the allocator of an arena do not
+ * visit their nodes on destruction and clearing unless a dfree callback is
+ * set, so destroying them takes O(1) time. Such containers must be destroyed
+ * or abandoned before the arena is reset. The arena is not thread-safe.
+ * @{
+ */
+/**
+ * @brief Default size of a block of the arena in bytes.
+ */
+#define CDC_ARENA_BLOCK_SIZE 65536
+
+/**
+ * @brief The cdc_arena is service struct.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_arena {
+  void *blocks;
+  char *cursor;
+  char *end;
+  char *last;
+  size_t block_size;
+  struct cdc_allocator allocator;
+};
+
+// Base
+/**
+ * @defgroup cdc_arena_base Base
+ * @{
+ */
+/**
+ * @brief Constructs an empty arena. Blocks are allocated on demand.
+ * @param[out] a - cdc_arena
+ * @param[in] block_size - size of a block in bytes or 0 for
+ * CDC_ARENA_BLOCK_SIZE. Larger allocations get blocks of their own.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_arena_ctor(struct cdc_arena **a, size_t block_size);
+
+/**
+ * @brief Destroys the arena and releases all the memory allocated from it.
+ * @param[in] a - cdc_arena
+ */
+void cdc_arena_dtor(struct cdc_arena *a);
+/** @} */
+
+// Allocation
+/**
+ * @defgroup cdc_arena_allocation Allocation
+ * @{
+ */
+/**
+ * @brief Allocates size bytes from the arena. The memory is aligned for any
+ * built-in type.
+ * @param[in] a - cdc_arena
+ * @param[in] size - number of bytes
+ * @return pointer to the memory or NULL if there is not enough memory.
+ */
+void *cdc_arena_alloc(struct cdc_arena *a, size_t size);
+
+/**
+ * @brief Returns the allocator that allocates from the arena. Its free
+ * callback is NULL. The allocator can be set to cdc_data_info.allocator.
+ * @param[in] a - cdc_arena
+ * @return pointer to the allocator of the arena.
+ */
+static inline const struct cdc_allocator *cdc_arena_allocator(struct cdc_arena *a)
+{
+  assert(a != NULL);
+
+  return &a->allocator;
+}
+
+/**
+ * @brief Releases all the memory allocated from the arena. The first block is
+ * kept for reuse.
+ * @param[in] a - cdc_arena
+ */
+void cdc_arena_reset(struct cdc_arena *a);
+/** @} */
+
+// Short names
+#ifdef CDC_USE_SHORT_NAMES
+typedef struct cdc_arena arena_t;
+
+// Base
+#define arena_ctor(...) cdc_arena_ctor(__VA_ARGS__)
+#define arena_dtor(...) cdc_arena_dtor(__VA_ARGS__)
+
+// Allocation
+#define arena_alloc(...) cdc_arena_alloc(__VA_ARGS__)
+#define arena_allocator(...) cdc_arena_allocator(__VA_ARGS__)
+#define arena_reset(...) cdc_arena_reset(__VA_ARGS__)
+#endif
+/** @} */
+#endif  // CDCONTAINERS_INCLUDE_CDCONTAINERS_ARENA_H
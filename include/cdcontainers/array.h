@@ -42,6 +42,22 @@
  * @brief The cdc_array is a struct and functions that provide a dynamic array.
  * @{
  */
+/**
+ * @brief The cdc_array_growth_policy struct describes how the array grows when
+ * it is full.
+ *
+ * The new capacity is the old one multiplied by factor, but it is at least
+ * min_capacity and exceeds the old one by at most max_step elements if
+ * max_step is not 0. The buffer is grown with realloc of the allocator, so it
+ * can be grown in place. glibc grows large buffers, which it maps with mmap, by
+ * mremap without copying them.
+ */
+struct cdc_array_growth_policy {
+  double factor;
+  size_t min_capacity;
+  size_t max_step;
+};
+
 /**
  * @brief The cdc_array is service struct.
  * @warning To avoid problems, do not change the structure fields in the code.
@@ -52,6 +68,7 @@ struct cdc_array {
   size_t capacity;
   void **buffer;
   struct cdc_data_info *dinfo;
+  struct cdc_array_growth_policy growth;
 };
 // Base
 /**
@@ -199,6 +216,14 @@ static inline bool cdc_array_empty(struct cdc_array *v)
   return v->size == 0;
 }
 
+/**
+ * @brief Returns the memory used by the array and its buffer. The memory of the
+ * elements is not included.
+ * @param[in] v - cdc_array
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_array_memory_usage(struct cdc_array *v);
+
 /**
  * @brief Returns the number of elements in the array.
  * @param[in] v - cdc_array
@@ -230,6 +255,17 @@ static inline size_t cdc_array_capacity(struct cdc_array *v)
  * an error
  */
 enum cdc_stat cdc_array_shrink_to_fit(struct cdc_array *v);
+
+/**
+ * @brief Sets the growth policy of the array. The default policy doubles the
+ * capacity, which is at least 4, without a limit of the step. The capacity does
+ * not change until the next growth.
+ * @param[in] v - cdc_array
+ * @param[in] policy - growth policy, factor must be greater than 1 and
+ * min_capacity must be greater than 0
+ */
+void cdc_array_set_growth_policy(struct cdc_array *v,
+                                 const struct cdc_array_growth_policy *policy);
 /** @} */
 
 // Modifiers
@@ -328,6 +364,7 @@ void cdc_array_swap(struct cdc_array *a, struct cdc_array *b);
 // Short names
 #ifdef CDC_USE_SHORT_NAMES
 typedef struct cdc_array array_t;
+typedef struct cdc_array_growth_policy array_growth_policy_t;
 
 // Base
 #define array_ctor(...) cdc_array_ctor(__VA_ARGS__)
@@ -345,10 +382,12 @@ typedef struct cdc_array array_t;
 // Capacity
 #define array_reserve(...) cdc_array_reserve(__VA_ARGS__)
 #define array_empty(...) cdc_array_empty(__VA_ARGS__)
+#define array_memory_usage(...) cdc_array_memory_usage(__VA_ARGS__)
 #define array_size(...) cdc_array_size(__VA_ARGS__)
 #define array_capacity(...) cdc_array_capacity(__VA_ARGS__)
 #define array_cap_exp(...) cdc_array_cap_exp(__VA_ARGS__)
 #define array_shrink_to_fit(...) cdc_array_shrink_to_fit(__VA_ARGS__)
+#define array_set_growth_policy(...) cdc_array_set_growth_policy(__VA_ARGS__)
 
 // Modifiers
 #define array_set(...) cdc_array_set(__VA_ARGS__)
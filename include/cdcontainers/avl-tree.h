@@ -38,6 +38,8 @@
  * @brief The cdc_avl_tree is a struct and functions that provide an avl tree.
  * @{
  */
+struct cdc_node_pool;
+
 /**
  * @brief The cdc_avl_tree_node is service struct.
  * @warning To avoid problems, do not change the structure fields in the code.
@@ -50,6 +52,9 @@ struct cdc_avl_tree_node {
   void *key;
   void *value;
   unsigned char height;
+#ifdef CDC_ORDER_STATISTICS
+  size_t size;
+#endif
 };
 
 /**
@@ -61,6 +66,7 @@ struct cdc_avl_tree {
   struct cdc_avl_tree_node *root;
   size_t size;
   struct cdc_data_info *dinfo;
+  struct cdc_node_pool *pool;
 };
 
 /**
@@ -130,6 +136,21 @@ enum cdc_stat cdc_avl_tree_ctorl(struct cdc_avl_tree **t, struct cdc_data_info *
  */
 enum cdc_stat cdc_avl_tree_ctorv(struct cdc_avl_tree **t, struct cdc_data_info *info, va_list args);
 
+/**
+ * @brief Constructs an avl tree from an array of pairs(first - key, and the second -
+ * value) sorted by keys in ascending order without duplicates. The balanced
+ * tree is built in O(n) without comparing the keys, the order is only checked
+ * by an assertion.
+ * @param[out] t - cdc_avl_tree
+ * @param[in] info - cdc_data_info
+ * @param[in] pairs - sorted array of pairs
+ * @param[in] n - number of pairs
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_avl_tree_ctor_sorted(struct cdc_avl_tree **t, struct cdc_data_info *info,
+                                       const struct cdc_pair *pairs, size_t n);
+
 /**
  * @brief Destroys the avl tree.
  * @param[in] t - cdc_avl_tree
@@ -171,6 +192,109 @@ size_t cdc_avl_tree_count(struct cdc_avl_tree *t, void *key);
  * returned.
  */
 void cdc_avl_tree_find(struct cdc_avl_tree *t, void *key, struct cdc_avl_tree_iter *it);
+
+/**
+ * @brief Finds the first element with key that is not less than key.
+ * @param[in] t - cdc_avl_tree
+ * @param[in] key - key value to compare the elements to
+ * @param[out] it - pointer will be recorded iterator to the first element with
+ * key not less than key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_avl_tree_lower_bound(struct cdc_avl_tree *t, void *key, struct cdc_avl_tree_iter *it);
+
+/**
+ * @brief Finds the first element with key that is greater than key.
+ * @param[in] t - cdc_avl_tree
+ * @param[in] key - key value to compare the elements to
+ * @param[out] it - pointer will be recorded iterator to the first element with
+ * key greater than key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_avl_tree_upper_bound(struct cdc_avl_tree *t, void *key, struct cdc_avl_tree_iter *it);
+
+/**
+ * @brief Returns a range containing all elements with key equivalent to key,
+ * which has at most one element since this container does not allow duplicates.
+ * @param[in] t - cdc_avl_tree
+ * @param[in] key - key value to compare the elements to
+ * @param[out] range - pointer will be recorded pair of iterators, the lower
+ * bound and the upper bound of key.
+ */
+void cdc_avl_tree_equal_range(struct cdc_avl_tree *t, void *key,
+                              struct cdc_pair_avl_tree_iter *range);
+
+/**
+ * @brief Returns the range of elements with keys in [from, to) in O(log n). The
+ * elements are visited from range->first until the iterator is equal to
+ * range->second.
+ * @param[in] t - cdc_avl_tree
+ * @param[in] from - key value of the beginning of the range
+ * @param[in] to - key value of the end of the range, it must not be less than
+ * from
+ * @param[out] range - pointer will be recorded pair of iterators, the lower
+ * bounds of from and to.
+ */
+void cdc_avl_tree_range(struct cdc_avl_tree *t, void *from, void *to,
+                        struct cdc_pair_avl_tree_iter *range);
+
+#ifdef CDC_ORDER_STATISTICS
+/**
+ * @brief Finds the element with index k in the order of the keys, the index of
+ * the first element is 0. Takes O(log n) using the subtree sizes that are kept
+ * if the library is built with the CDC_ORDER_STATISTICS option.
+ * @param[in] t - cdc_avl_tree
+ * @param[in] k - index of the element
+ * @param[out] it - pointer will be recorded iterator to the element with index
+ * k. If k is not less than the size of the avl tree, past-the-end iterator is
+ * returned.
+ */
+void cdc_avl_tree_select(struct cdc_avl_tree *t, size_t k, struct cdc_avl_tree_iter *it);
+
+/**
+ * @brief Returns the number of elements with keys less than key, that is the
+ * index of key if it is in the avl tree. Takes O(log n) using the subtree sizes
+ * that are kept if the library is built with the CDC_ORDER_STATISTICS option.
+ * @param[in] t - cdc_avl_tree
+ * @param[in] key - key value to compare the elements to
+ * @return number of elements with keys less than key.
+ */
+size_t cdc_avl_tree_rank(struct cdc_avl_tree *t, void *key);
+#endif
+
+/**
+ * @brief The same as cdc_avl_tree_get, but looks up a probe, an object that
+ * is compared with the keys by the callbacks of the info. No key is built, so a
+ * string can be looked up by a cdc_str_view without copying it.
+ * @param[in] t - cdc_avl_tree
+ * @param[in] probe - probe of the element to find
+ * @param[in] info - compare callback of the probe
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_avl_tree_get_probe(struct cdc_avl_tree *t, const void *probe,
+                                     const struct cdc_probe_info *info, void **value);
+
+/**
+ * @brief The same as cdc_avl_tree_count, but looks up a probe.
+ * @param[in] t - cdc_avl_tree
+ * @param[in] probe - probe of the elements to count
+ * @param[in] info - compare callback of the probe
+ * @return number of elements equal to the probe, that is either 1 or 0.
+ */
+size_t cdc_avl_tree_count_probe(struct cdc_avl_tree *t, const void *probe,
+                                const struct cdc_probe_info *info);
+
+/**
+ * @brief The same as cdc_avl_tree_find, but looks up a probe.
+ * @param[in] t - cdc_avl_tree
+ * @param[in] probe - probe of the element to search for
+ * @param[in] info - compare callback of the probe
+ * @param[out] it - pointer will be recorded iterator to an element equal to the
+ * probe. If no such element is found, past-the-end iterator is returned.
+ */
+void cdc_avl_tree_find_probe(struct cdc_avl_tree *t, const void *probe,
+                             const struct cdc_probe_info *info, struct cdc_avl_tree_iter *it);
 /** @} */
 
 // Capacity
@@ -201,6 +325,14 @@ static inline bool cdc_avl_tree_empty(struct cdc_avl_tree *t)
 
   return t->size == 0;
 }
+
+/**
+ * @brief Returns the memory used by the tree and the node pool. The memory of
+ * the elements is not included.
+ * @param[in] t - cdc_avl_tree
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_avl_tree_memory_usage(struct cdc_avl_tree *t);
 /** @} */
 
 // Modifiers
@@ -425,16 +557,27 @@ typedef struct cdc_pair_avl_tree_iter_bool pair_avl_tree_iter_bool_t;
 #define avl_tree_ctor(...) cdc_avl_tree_ctor(__VA_ARGS__)
 #define avl_tree_ctorv(...) cdc_avl_tree_ctorv(__VA_ARGS__)
 #define avl_tree_ctorl(...) cdc_avl_tree_ctorl(__VA_ARGS__)
+#define avl_tree_ctor_sorted(...) cdc_avl_tree_ctor_sorted(__VA_ARGS__)
 #define avl_tree_dtor(...) cdc_avl_tree_dtor(__VA_ARGS__)
 
 // Lookup
 #define avl_tree_get(...) cdc_avl_tree_get(__VA_ARGS__)
 #define avl_tree_count(...) cdc_avl_tree_count(__VA_ARGS__)
 #define avl_tree_find(...) cdc_avl_tree_find(__VA_ARGS__)
+#define avl_tree_lower_bound(...) cdc_avl_tree_lower_bound(__VA_ARGS__)
+#define avl_tree_upper_bound(...) cdc_avl_tree_upper_bound(__VA_ARGS__)
+#define avl_tree_equal_range(...) cdc_avl_tree_equal_range(__VA_ARGS__)
+#define avl_tree_range(...) cdc_avl_tree_range(__VA_ARGS__)
+#define avl_tree_select(...) cdc_avl_tree_select(__VA_ARGS__)
+#define avl_tree_rank(...) cdc_avl_tree_rank(__VA_ARGS__)
+#define avl_tree_get_probe(...) cdc_avl_tree_get_probe(__VA_ARGS__)
+#define avl_tree_count_probe(...) cdc_avl_tree_count_probe(__VA_ARGS__)
+#define avl_tree_find_probe(...) cdc_avl_tree_find_probe(__VA_ARGS__)
 
 // Capacity
 #define avl_tree_size(...) cdc_avl_tree_size(__VA_ARGS__)
 #define avl_tree_empty(...) cdc_avl_tree_empty(__VA_ARGS__)
+#define avl_tree_memory_usage(...) cdc_avl_tree_memory_usage(__VA_ARGS__)
 
 // Modifiers
 #define avl_tree_clear(...) cdc_avl_tree_clear(__VA_ARGS__)
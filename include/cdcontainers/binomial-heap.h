@@ -146,6 +146,14 @@ static inline bool cdc_binomial_heap_empty(struct cdc_binomial_heap *h)
   return h->size == 0;
 }
 
+/**
+ * @brief Returns the memory used by the heap and its nodes. The memory of the
+ * elements is not included.
+ * @param h - cdc_binomial_heap
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_binomial_heap_memory_usage(struct cdc_binomial_heap *h);
+
 // Modifiers
 /**
  * @brief Extracts the top item from the binomial heap. This function assumes
@@ -263,6 +271,7 @@ typedef struct cdc_binomial_heap_iter binomial_heap_iter_t;
 
 // Capacity
 #define binomial_heap_empty(...) cdc_binomial_heap_empty(__VA_ARGS__)
+#define binomial_heap_memory_usage(...) cdc_binomial_heap_memory_usage(__VA_ARGS__)
 #define binomial_heap_size(...) cdc_binomial_heap_size(__VA_ARGS__)
 
 // Modifiers
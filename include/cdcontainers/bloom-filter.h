@@ -0,0 +1,203 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+/**
+ * @file
+ * @author Maksim Andrianov <maksimandrianov1@yandex.ru>
+ * @brief The cdc_bloom_filter is a struct and functions that provide a blocked
+ * Bloom filter.
+ */
+#ifndef CDCONTAINERS_INCLUDE_CDCONTAINERS_BLOOM_FILTER_H
+#define CDCONTAINERS_INCLUDE_CDCONTAINERS_BLOOM_FILTER_H
+
+#include <cdcontainers/common.h>
+#include <cdcontainers/hash.h>
+#include <cdcontainers/status.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @defgroup cdc_bloom_filter
+ * @brief The cdc_bloom_filter is a struct and functions that provide a blocked
+ * Bloom filter.
+ *
+ * The filter answers whether a key may have been added: a negative answer is
+ * always right, a positive one is wrong with the configured probability while
+ * the number of added keys does not exceed the capacity. All bits of a key are
+ * in one block of the size of a cache line, so a check reads one cache line.
+ * @{
+ */
+/**
+ * @brief Number of 64-bit words in a block of the filter.
+ */
+#define CDC_BLOOM_FILTER_BLOCK_WORDS 8
+
+/**
+ * @brief The cdc_bloom_filter is service struct.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_bloom_filter {
+  uint64_t *blocks;
+  size_t bcount;
+  size_t count;
+  size_t capacity;
+  unsigned hash_count;
+  double fp_rate;
+  cdc_hash_fn_t hash;
+  const struct cdc_allocator *allocator;
+};
+
+// Base
+/**
+ * @defgroup cdc_bloom_filter_base Base
+ * @{
+ */
+/**
+ * @brief Constructs an empty bloom filter.
+ * @param[out] f - cdc_bloom_filter
+ * @param[in] hash - hash function of the keys
+ * @param[in] capacity - expected number of keys
+ * @param[in] fp_rate - false positive rate for capacity keys, it must be in
+ * the range (0, 1)
+ * @param[in] allocator - allocator of the filter memory or NULL for the
+ * standard functions
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_bloom_filter_ctor(struct cdc_bloom_filter **f, cdc_hash_fn_t hash,
+                                    size_t capacity, double fp_rate,
+                                    const struct cdc_allocator *allocator);
+
+/**
+ * @brief Destroys the bloom filter.
+ * @param[in] f - cdc_bloom_filter
+ */
+void cdc_bloom_filter_dtor(struct cdc_bloom_filter *f);
+/** @} */
+
+// Lookup
+/**
+ * @defgroup cdc_bloom_filter_lookup Lookup
+ * @{
+ */
+/**
+ * @brief Checks if the key may have been added to the filter.
+ * @param[in] f - cdc_bloom_filter
+ * @param[in] key - key to check
+ * @return false if the key has not been added, true if it may have been.
+ */
+bool cdc_bloom_filter_contains(struct cdc_bloom_filter *f, void *key);
+
+/**
+ * @brief The same as cdc_bloom_filter_contains, but takes a precomputed hash
+ * of the key instead of calling the hash function.
+ * @param[in] f - cdc_bloom_filter
+ * @param[in] hash - hash of the key
+ * @return false if the key has not been added, true if it may have been.
+ */
+bool cdc_bloom_filter_contains_hashed(struct cdc_bloom_filter *f, size_t hash);
+/** @} */
+
+// Capacity
+/**
+ * @defgroup cdc_bloom_filter_capacity Capacity
+ * @{
+ */
+/**
+ * @brief Returns the number of keys added since the construction or the last
+ * cdc_bloom_filter_clear, including repeated ones.
+ * @param[in] f - cdc_bloom_filter
+ * @return the number of added keys.
+ */
+static inline size_t cdc_bloom_filter_count(struct cdc_bloom_filter *f)
+{
+  assert(f != NULL);
+
+  return f->count;
+}
+
+/**
+ * @brief Returns the number of keys for which the filter keeps the false
+ * positive rate.
+ * @param[in] f - cdc_bloom_filter
+ * @return the capacity of the filter.
+ */
+static inline size_t cdc_bloom_filter_capacity(struct cdc_bloom_filter *f)
+{
+  assert(f != NULL);
+
+  return f->capacity;
+}
+/** @} */
+
+// Modifiers
+/**
+ * @defgroup cdc_bloom_filter_modifiers Modifiers
+ * @{
+ */
+/**
+ * @brief Removes all the keys from the bloom filter.
+ * @param[in] f - cdc_bloom_filter
+ */
+void cdc_bloom_filter_clear(struct cdc_bloom_filter *f);
+
+/**
+ * @brief Adds a key to the bloom filter.
+ * @param[in] f - cdc_bloom_filter
+ * @param[in] key - key to add
+ */
+void cdc_bloom_filter_add(struct cdc_bloom_filter *f, void *key);
+
+/**
+ * @brief The same as cdc_bloom_filter_add, but takes a precomputed hash of the
+ * key instead of calling the hash function.
+ * @param[in] f - cdc_bloom_filter
+ * @param[in] hash - hash of the key
+ */
+void cdc_bloom_filter_add_hashed(struct cdc_bloom_filter *f, size_t hash);
+/** @} */
+
+// Short names
+#ifdef CDC_USE_SHORT_NAMES
+typedef struct cdc_bloom_filter bloom_filter_t;
+
+// Base
+#define bloom_filter_ctor(...) cdc_bloom_filter_ctor(__VA_ARGS__)
+#define bloom_filter_dtor(...) cdc_bloom_filter_dtor(__VA_ARGS__)
+
+// Lookup
+#define bloom_filter_contains(...) cdc_bloom_filter_contains(__VA_ARGS__)
+#define bloom_filter_contains_hashed(...) cdc_bloom_filter_contains_hashed(__VA_ARGS__)
+
+// Capacity
+#define bloom_filter_count(...) cdc_bloom_filter_count(__VA_ARGS__)
+#define bloom_filter_capacity(...) cdc_bloom_filter_capacity(__VA_ARGS__)
+
+// Modifiers
+#define bloom_filter_clear(...) cdc_bloom_filter_clear(__VA_ARGS__)
+#define bloom_filter_add(...) cdc_bloom_filter_add(__VA_ARGS__)
+#define bloom_filter_add_hashed(...) cdc_bloom_filter_add_hashed(__VA_ARGS__)
+#endif
+/** @} */
+#endif  // CDCONTAINERS_INCLUDE_CDCONTAINERS_BLOOM_FILTER_H
@@ -0,0 +1,612 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+/**
+ * @file
+ * @author Maksim Andrianov <maksimandrianov1@yandex.ru>
+ * @brief The cdc_btree is a struct and functions that provide a B+ tree.
+ */
+#ifndef CDCONTAINERS_INCLUDE_CDCONTAINERS_BTREE_H
+#define CDCONTAINERS_INCLUDE_CDCONTAINERS_BTREE_H
+
+#include <cdcontainers/common.h>
+#include <cdcontainers/status.h>
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+
+/**
+ * @defgroup cdc_btree
+ * @brief The cdc_btree is a struct and functions that provide a B+ tree.
+ *
+ * Nodes keep up to CDC_BTREE_ORDER keys in arrays, so a lookup visits a few
+ * nodes of several cache lines instead of a node per comparison. Keys and
+ * values are stored only in leaves, which are linked in a list, so iteration
+ * scans the leaves one after another.
+ * @{
+ */
+/**
+ * @brief The maximum number of keys in a node. Nodes except the root have at
+ * least half as many keys.
+ */
+#define CDC_BTREE_ORDER 32
+
+/**
+ * @brief The cdc_btree_node is service struct, the common part of leaves and
+ * inner nodes.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_btree_node {
+  struct cdc_btree_node *parent;
+  unsigned size;
+  bool is_leaf;
+  void *keys[CDC_BTREE_ORDER];
+};
+
+/**
+ * @brief The cdc_btree_leaf is service struct.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_btree_leaf {
+  struct cdc_btree_node base;
+  struct cdc_btree_leaf *prev;
+  struct cdc_btree_leaf *next;
+  void *values[CDC_BTREE_ORDER];
+};
+
+/**
+ * @brief The cdc_btree_inner is service struct. The keys of children[i + 1] are
+ * not less than keys[i].
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_btree_inner {
+  struct cdc_btree_node base;
+  struct cdc_btree_node *children[CDC_BTREE_ORDER + 1];
+};
+
+/**
+ * @brief The cdc_btree is service struct.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_btree {
+  struct cdc_btree_node *root;
+  struct cdc_btree_leaf *first;
+  struct cdc_btree_leaf *last;
+  size_t size;
+  size_t leaf_count;
+  size_t inner_count;
+  struct cdc_data_info *dinfo;
+};
+
+/**
+ * @brief The cdc_btree_iter is service struct.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_btree_iter {
+  struct cdc_btree *container;
+  struct cdc_btree_leaf *leaf;
+  size_t index;
+};
+
+struct cdc_pair_btree_iter {
+  struct cdc_btree_iter first;
+  struct cdc_btree_iter second;
+};
+
+struct cdc_pair_btree_iter_bool {
+  struct cdc_btree_iter first;
+  bool second;
+};
+
+// Base
+/**
+ * @defgroup cdc_btree_base Base
+ * @{
+ */
+/**
+ * @brief Constructs an empty B+ tree.
+ * @param[out] t - cdc_btree
+ * @param[in] info - cdc_data_info
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_btree_ctor(struct cdc_btree **t, struct cdc_data_info *info);
+
+/**
+ * @brief Constructs a B+ tree, initialized by an variable number of
+ * pointers on cdc_pair's(first - key, and the second - value).  The last item
+ * must be CDC_END.
+ * @param[out] t - cdc_btree
+ * @param[in] info - cdc_data_info
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ *
+ * Example:
+ * @code{.c}
+ * struct cdc_btree *tree = NULL;
+ * cdc_pair value1 = {CDC_FROM_INT(1), CDC_FROM_INT(2)};
+ * cdc_pair value2 = {CDC_FROM_INT(3), CDC_FROM_INT(4)};
+ * ...
+ * if (cdc_btree_ctorl(&tree, info, &value1, &value2, CDC_END) != CDC_STATUS_OK) {
+ *   // handle error
+ * }
+ * @endcode
+ */
+enum cdc_stat cdc_btree_ctorl(struct cdc_btree **t, struct cdc_data_info *info, ...);
+
+/**
+ * @brief Constructs a B+ tree, initialized by args. The last item must be
+ * CDC_END.
+ * @param[out] t - cdc_btree
+ * @param[in] info - cdc_data_info
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_btree_ctorv(struct cdc_btree **t, struct cdc_data_info *info, va_list args);
+
+/**
+ * @brief Destroys the B+ tree.
+ * @param[in] t - cdc_btree
+ */
+void cdc_btree_dtor(struct cdc_btree *t);
+/** @} */
+
+// Lookup
+/**
+ * @defgroup cdc_btree_lookup Lookup
+ * @{
+ */
+/**
+ * @brief Returns a value that is mapped to a key. If the key does
+ * not exist, then NULL will return.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key of the element to find
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_btree_get(struct cdc_btree *t, void *key, void **value);
+
+/**
+ * @brief Returns the number of elements with key that compares equal to the
+ * specified argument key, which is either 1 or 0 since this container does not
+ * allow duplicates.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key value of the elements to count
+ * @return number of elements with key key, that is either 1 or 0.
+ */
+size_t cdc_btree_count(struct cdc_btree *t, void *key);
+
+/**
+ * @brief Finds an element with key equivalent to key.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key value of the element to search for
+ * @param[out] it - pointer will be recorded iterator to an element with key
+ * equivalent to key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_btree_find(struct cdc_btree *t, void *key, struct cdc_btree_iter *it);
+
+/**
+ * @brief Finds the first element with key that is not less than key.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key value to compare the elements to
+ * @param[out] it - pointer will be recorded iterator to the first element with
+ * key not less than key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_btree_lower_bound(struct cdc_btree *t, void *key, struct cdc_btree_iter *it);
+
+/**
+ * @brief Finds the first element with key that is greater than key.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key value to compare the elements to
+ * @param[out] it - pointer will be recorded iterator to the first element with
+ * key greater than key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_btree_upper_bound(struct cdc_btree *t, void *key, struct cdc_btree_iter *it);
+
+/**
+ * @brief Returns a range containing all elements with key equivalent to key,
+ * which has at most one element since this container does not allow duplicates.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key value to compare the elements to
+ * @param[out] range - pointer will be recorded pair of iterators, the lower
+ * bound and the upper bound of key.
+ */
+void cdc_btree_equal_range(struct cdc_btree *t, void *key, struct cdc_pair_btree_iter *range);
+
+/**
+ * @brief Returns the range of elements with keys in [from, to) in O(log n). The
+ * elements are visited from range->first until the iterator is equal to
+ * range->second.
+ * @param[in] t - cdc_btree
+ * @param[in] from - key value of the beginning of the range
+ * @param[in] to - key value of the end of the range, it must not be less than
+ * from
+ * @param[out] range - pointer will be recorded pair of iterators, the lower
+ * bounds of from and to.
+ */
+void cdc_btree_range(struct cdc_btree *t, void *from, void *to, struct cdc_pair_btree_iter *range);
+
+/**
+ * @brief The same as cdc_btree_get, but looks up a probe, an object that
+ * is compared with the keys by the callbacks of the info.
+ * @param[in] t - cdc_btree
+ * @param[in] probe - probe of the element to find
+ * @param[in] info - compare callback of the probe
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_btree_get_probe(struct cdc_btree *t, const void *probe,
+                                  const struct cdc_probe_info *info, void **value);
+
+/**
+ * @brief The same as cdc_btree_count, but looks up a probe.
+ * @param[in] t - cdc_btree
+ * @param[in] probe - probe of the elements to count
+ * @param[in] info - compare callback of the probe
+ * @return number of elements equal to the probe, that is either 1 or 0.
+ */
+size_t cdc_btree_count_probe(struct cdc_btree *t, const void *probe,
+                             const struct cdc_probe_info *info);
+
+/**
+ * @brief The same as cdc_btree_find, but looks up a probe.
+ * @param[in] t - cdc_btree
+ * @param[in] probe - probe of the element to search for
+ * @param[in] info - compare callback of the probe
+ * @param[out] it - pointer will be recorded iterator to an element equal to the
+ * probe. If no such element is found, past-the-end iterator is returned.
+ */
+void cdc_btree_find_probe(struct cdc_btree *t, const void *probe,
+                          const struct cdc_probe_info *info, struct cdc_btree_iter *it);
+/** @} */
+
+// Capacity
+/**
+ * @defgroup cdc_btree_capacity Capacity
+ * @{
+ */
+/**
+ * @brief Returns the number of items in the B+ tree.
+ * @param[in] t - cdc_btree
+ * @return the number of items in the B+ tree.
+ */
+static inline size_t cdc_btree_size(struct cdc_btree *t)
+{
+  assert(t != NULL);
+
+  return t->size;
+}
+
+/**
+ * @brief Checks if the B+ tree has no elements.
+ * @param[in] t - cdc_btree
+ * @return true if the B+ tree is empty, false otherwise.
+ */
+static inline bool cdc_btree_empty(struct cdc_btree *t)
+{
+  assert(t != NULL);
+
+  return t->size == 0;
+}
+
+/**
+ * @brief Returns the memory used by the tree, its leaves and inner nodes. The
+ * memory of the elements is not included.
+ * @param[in] t - cdc_btree
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_btree_memory_usage(struct cdc_btree *t);
+/** @} */
+
+// Modifiers
+/**
+ * @defgroup cdc_btree_modifiers Modifiers
+ * @{
+ */
+/**
+ * @brief Removes all the elements from the B+ tree.
+ * @param[in] t - cdc_btree
+ */
+void cdc_btree_clear(struct cdc_btree *t);
+
+/**
+ * @brief Inserts an element into the container, if the container doesn't already
+ * contain an element with an equivalent key.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] ret - pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion) and a bool denoting whether the
+ * insertion took place. The pointer can be equal to NULL.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_btree_insert(struct cdc_btree *t, void *key, void *value,
+                               struct cdc_pair_btree_iter_bool *ret);
+
+/**
+ * @brief Inserts an element into the container, if the container doesn't already
+ * contain an element with an equivalent key.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] it - iterator to the inserted element (or to the element that
+ * prevented the insertion). The pointer can be equal to NULL.
+ * @param[out] inserted - bool denoting whether the insertion
+ * took place. The pointer can be equal to NULL.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_btree_insert1(struct cdc_btree *t, void *key, void *value,
+                                struct cdc_btree_iter *it, bool *inserted);
+
+/**
+ * @brief Inserts an element or assigns to the current element if the key
+ * already exists.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] ret - pair. The bool component is true if the insertion took place and
+ * false if the assignment took place. The iterator component is pointing at the
+ * element that was inserted or updated.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_btree_insert_or_assign(struct cdc_btree *t, void *key, void *value,
+                                         struct cdc_pair_btree_iter_bool *ret);
+
+/**
+ * @brief Inserts an element or assigns to the current element if the key
+ * already exists.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] it - iterator is pointing at the element that was inserted or updated.
+ * The pointer can be equal to NULL
+ * @param[out] inserted - bool is true if the insertion took place and false if the
+ * assignment took place. The pointer can be equal to NULL
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_btree_insert_or_assign1(struct cdc_btree *t, void *key, void *value,
+                                          struct cdc_btree_iter *it, bool *inserted);
+
+/**
+ * @brief Removes the element (if one exists) with the key equivalent to key.
+ * @param[in] t - cdc_btree
+ * @param[in] key - key value of the elements to remove
+ * @return number of elements removed.
+ */
+size_t cdc_btree_erase(struct cdc_btree *t, void *key);
+
+/**
+ * @brief Swaps B+ trees a and b. This operation is very fast and never fails.
+ * @param[in, out] a - cdc_btree
+ * @param[in, out] b - cdc_btree
+ */
+void cdc_btree_swap(struct cdc_btree *a, struct cdc_btree *b);
+/** @} */
+
+// Iterators
+/**
+ * @defgroup cdc_btree_iterators Iterators
+ * @{
+ */
+/**
+ * @brief Initializes the iterator to the beginning.
+ * @param[in] t - cdc_btree
+ * @param[out] it - cdc_btree_iter
+ */
+void cdc_btree_begin(struct cdc_btree *t, struct cdc_btree_iter *it);
+
+/**
+ * @brief Initializes the iterator to the end.
+ * @param[in] t - cdc_btree
+ * @param[out] it - cdc_btree_iter
+ */
+void cdc_btree_end(struct cdc_btree *t, struct cdc_btree_iter *it);
+/** @} */
+
+// Iterators
+/**
+ * @defgroup cdc_btree_iter
+ * @brief The cdc_btree_iter is a struct and functions that provide a B+ tree iterator.
+ * @{
+ */
+/**
+ * @brief Advances the iterator to the next element in the B+ tree.
+ * @param[in] it - iterator
+ */
+static inline void cdc_btree_iter_next(struct cdc_btree_iter *it)
+{
+  assert(it != NULL);
+
+  if (++it->index == it->leaf->base.size) {
+    it->leaf = it->leaf->next;
+    it->index = 0;
+  }
+}
+
+/**
+ * @brief Advances the iterator to the previous element in the B+ tree.
+ * @param[in] it - iterator
+ */
+static inline void cdc_btree_iter_prev(struct cdc_btree_iter *it)
+{
+  assert(it != NULL);
+
+  if (it->leaf && it->index > 0) {
+    --it->index;
+    return;
+  }
+
+  it->leaf = it->leaf ? it->leaf->prev : it->container->last;
+  it->index = it->leaf ? it->leaf->base.size - 1 : 0;
+}
+
+/**
+ * @brief Returns true if there is at least one element ahead of the iterator, i.e.
+ * the iterator is not at the back of the container; otherwise returns false.
+ * @param[in] it - iterator
+ * @return true if there is at least one element ahead of the iterator, i.e.
+ * the iterator is not at the back of the container; otherwise returns false.
+ */
+static inline bool cdc_btree_iter_has_next(struct cdc_btree_iter *it)
+{
+  assert(it != NULL);
+
+  return it->leaf != NULL;
+}
+
+/**
+ * @brief Returns true if there is at least one element behind the iterator, i.e.
+ * the iterator is not at the front of the container; otherwise returns false.
+ * @param[in] it - iterator
+ * @return true if there is at least one element behind the iterator, i.e.
+ * the iterator is not at the front of the container; otherwise returns false.
+ */
+static inline bool cdc_btree_iter_has_prev(struct cdc_btree_iter *it)
+{
+  assert(it != NULL);
+
+  return it->leaf ? it->index > 0 || it->leaf->prev != NULL : it->container->size != 0;
+}
+
+/**
+ * @brief Returns an item's key.
+ * @param[in] it - iterator
+ * @return the item's key.
+ */
+static inline void *cdc_btree_iter_key(struct cdc_btree_iter *it)
+{
+  assert(it != NULL);
+
+  return it->leaf->base.keys[it->index];
+}
+
+/**
+ * @brief Returns an item's value.
+ * @param[in] it - iterator
+ * @return the item's value.
+ */
+static inline void *cdc_btree_iter_value(struct cdc_btree_iter *it)
+{
+  assert(it != NULL);
+
+  return it->leaf->values[it->index];
+}
+
+/**
+ * @brief Returns a pair, where first - key, second - value.
+ * @param[in] it - iterator
+ * @return pair, where first - key, second - value.
+ */
+static inline struct cdc_pair cdc_btree_iter_key_value(struct cdc_btree_iter *it)
+{
+  assert(it != NULL);
+
+  struct cdc_pair pair = {it->leaf->base.keys[it->index], it->leaf->values[it->index]};
+  return pair;
+}
+
+/**
+ * @brief Returns true if the iterator |it1| equal to the iterator |it2|,
+ * otherwise returns false.
+ * @param[in] it1 - iterator
+ * @param[in] it2 - iterator
+ * @return true if the iterator |it1| equal to the iterator |it2|,
+ * otherwise returns false.
+ */
+static inline bool cdc_btree_iter_is_eq(struct cdc_btree_iter *it1, struct cdc_btree_iter *it2)
+{
+  assert(it1 != NULL);
+  assert(it2 != NULL);
+
+  return it1->container == it2->container && it1->leaf == it2->leaf && it1->index == it2->index;
+}
+/** @} */
+
+// Short names
+#ifdef CDC_USE_SHORT_NAMES
+typedef struct cdc_btree_node btree_node_t;
+typedef struct cdc_btree_leaf btree_leaf_t;
+typedef struct cdc_btree_inner btree_inner_t;
+typedef struct cdc_btree btree_t;
+typedef struct cdc_btree_iter btree_iter_t;
+typedef struct cdc_pair_btree_iter pair_btree_iter_t;
+typedef struct cdc_pair_btree_iter_bool pair_btree_iter_bool_t;
+
+// Base
+#define btree_ctor(...) cdc_btree_ctor(__VA_ARGS__)
+#define btree_ctorv(...) cdc_btree_ctorv(__VA_ARGS__)
+#define btree_ctorl(...) cdc_btree_ctorl(__VA_ARGS__)
+#define btree_dtor(...) cdc_btree_dtor(__VA_ARGS__)
+
+// Lookup
+#define btree_get(...) cdc_btree_get(__VA_ARGS__)
+#define btree_count(...) cdc_btree_count(__VA_ARGS__)
+#define btree_find(...) cdc_btree_find(__VA_ARGS__)
+#define btree_lower_bound(...) cdc_btree_lower_bound(__VA_ARGS__)
+#define btree_upper_bound(...) cdc_btree_upper_bound(__VA_ARGS__)
+#define btree_equal_range(...) cdc_btree_equal_range(__VA_ARGS__)
+#define btree_range(...) cdc_btree_range(__VA_ARGS__)
+#define btree_get_probe(...) cdc_btree_get_probe(__VA_ARGS__)
+#define btree_count_probe(...) cdc_btree_count_probe(__VA_ARGS__)
+#define btree_find_probe(...) cdc_btree_find_probe(__VA_ARGS__)
+
+// Capacity
+#define btree_size(...) cdc_btree_size(__VA_ARGS__)
+#define btree_empty(...) cdc_btree_empty(__VA_ARGS__)
+#define btree_memory_usage(...) cdc_btree_memory_usage(__VA_ARGS__)
+
+// Modifiers
+#define btree_clear(...) cdc_btree_clear(__VA_ARGS__)
+#define btree_insert(...) cdc_btree_insert(__VA_ARGS__)
+#define btree_insert1(...) cdc_btree_insert1(__VA_ARGS__)
+#define btree_insert_or_assign(...) cdc_btree_insert_or_assign(__VA_ARGS__)
+#define btree_insert_or_assign1(...) cdc_btree_insert_or_assign1(__VA_ARGS__)
+#define btree_erase(...) cdc_btree_erase(__VA_ARGS__)
+#define btree_swap(...) cdc_btree_swap(__VA_ARGS__)
+
+// Iterators
+#define btree_begin(...) cdc_btree_begin(__VA_ARGS__)
+#define btree_end(...) cdc_btree_end(__VA_ARGS__)
+
+// Iterators
+#define btree_iter_next(...) cdc_btree_iter_next(__VA_ARGS__)
+#define btree_iter_has_next(...) cdc_btree_iter_has_next(__VA_ARGS__)
+#define btree_iter_has_prev(...) cdc_btree_iter_has_prev(__VA_ARGS__)
+#define btree_iter_prev(...) cdc_btree_iter_prev(__VA_ARGS__)
+#define btree_iter_key(...) cdc_btree_iter_key(__VA_ARGS__)
+#define btree_iter_value(...) cdc_btree_iter_value(__VA_ARGS__)
+#define btree_iter_key_value(...) cdc_btree_iter_key_value(__VA_ARGS__)
+#define btree_iter_is_eq(...) cdc_btree_iter_is_eq(__VA_ARGS__)
+#endif
+/** @} */
+#endif  // CDCONTAINERS_INCLUDE_CDCONTAINERS_BTREE_H
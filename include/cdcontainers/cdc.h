@@ -32,9 +32,23 @@
  *   - cdc_pairing_heap - pairing heap. See pairing-heap.h.
  *   - cdc_hash_table - hash table with collisions resolved by chaining. See
  * hash-table.h.
+ *   - cdc_flat_hash_table - open-addressing hash table. See flat-hash-table.h.
+ *   - cdc_robin_hood_table - open-addressing hash table with Robin Hood hashing.
+ *   See robin-hood-table.h.
+ *   - cdc_concurrent_map - thread-safe hash map sharded over cdc_hash_table's.
+ *   See concurrent-map.h.
+ *   - cdc_rcu_hash_table - hash table with lock-free lookups for read-mostly
+ *   workloads. See rcu-hash-table.h.
+ *   - cdc_frozen_map - immutable map based on a minimal perfect hash function.
+ *   See frozen-map.h.
+ *   - cdc_bloom_filter - blocked Bloom filter. See bloom-filter.h.
  *   - cdc_avl_tree - avl tree. See avl-tree.h.
  *   - cdc_splay_tree - splay tree. See splay-tree.h.
  *   - cdc_treap - сartesian tree. See treap.h.
+ *   - cdc_btree - B+ tree with linked leaves. See btree.h.
+ *   - cdc_rb_tree - red-black tree. See rb-tree.h.
+ *
+ * and the cdc_arena region allocator for short-lived containers. See arena.h.
  *
  * and following adapters:
  *   - cdc_deque (Can work with: cdc_array, cdc_list, cdc_circular_array). See
@@ -45,8 +59,8 @@
  * queue.h.
  *   - cdc_priority_queue (Can work with: cdc_heap, cdc_binomial_heap,
  * cdc_pairing_heap). See priority-queue.h.
- *   - cdc_map (Can work with: cdc_avl_tree, cdc_splay_tree, cdc_treap). See
- * map.h.
+ *   - cdc_map (Can work with: cdc_avl_tree, cdc_splay_tree, cdc_treap,
+ * cdc_btree, cdc_rb_tree). See map.h.
  *
  *  Example usage array:
  *  @include array.c
@@ -61,18 +75,27 @@
 #include <cdcontainers/adapters/priority-queue.h>
 #include <cdcontainers/adapters/queue.h>
 #include <cdcontainers/adapters/stack.h>
+#include <cdcontainers/arena.h>
 #include <cdcontainers/array.h>
 #include <cdcontainers/avl-tree.h>
 #include <cdcontainers/binomial-heap.h>
+#include <cdcontainers/bloom-filter.h>
+#include <cdcontainers/btree.h>
 #include <cdcontainers/casts.h>
 #include <cdcontainers/circular-array.h>
 #include <cdcontainers/common.h>
+#include <cdcontainers/concurrent-map.h>
+#include <cdcontainers/flat-hash-table.h>
+#include <cdcontainers/frozen-map.h>
 #include <cdcontainers/global.h>
 #include <cdcontainers/hash-table.h>
 #include <cdcontainers/hash.h>
 #include <cdcontainers/heap.h>
 #include <cdcontainers/list.h>
 #include <cdcontainers/pairing-heap.h>
+#include <cdcontainers/rb-tree.h>
+#include <cdcontainers/rcu-hash-table.h>
+#include <cdcontainers/robin-hood-table.h>
 #include <cdcontainers/splay-tree.h>
 #include <cdcontainers/status.h>
 #include <cdcontainers/treap.h>
@@ -181,6 +181,14 @@ static inline bool cdc_circular_array_empty(struct cdc_circular_array *d)
   return d->size == 0;
 }
 
+/**
+ * @brief Returns the memory used by the circular array and its buffer. The
+ * memory of the elements is not included.
+ * @param[in] d - cdc_circular_array
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_circular_array_memory_usage(struct cdc_circular_array *d);
+
 /**
  * @brief Returns the number of elements in the circular array.
  * @param[in] d - cdc_circular_array
@@ -297,6 +305,7 @@ typedef struct cdc_circular_array circular_array_t;
 
 // Capacity
 #define circular_array_empty(...) cdc_circular_array_empty(__VA_ARGS__)
+#define circular_array_memory_usage(...) cdc_circular_array_memory_usage(__VA_ARGS__)
 #define circular_array_size(...) cdc_circular_array_size(__VA_ARGS__)
 
 // Modifiers
@@ -55,6 +55,45 @@ typedef void (*cdc_free_fn_t)(void *);
 typedef int (*cdc_unary_pred_fn_t)(const void *);
 typedef int (*cdc_binary_pred_fn_t)(const void *, const void *);
 typedef void (*cdc_copy_fn_t)(void *, const void *);
+typedef int (*cdc_compare_fn_t)(const void *, const void *);
+
+/**
+ * @brief The cdc_allocator struct is a memory allocator of containers.
+ *
+ * The callbacks have the meaning of malloc, realloc and free and get ctx as
+ * the first argument. The allocator must outlive the containers that use it.
+ * Containers that are modified by several threads, such as cdc_concurrent_map,
+ * call it from these threads. free can be NULL if memory is released in bulk by
+ * the owner of the allocator, as cdc_arena does; then containers do not visit
+ * their nodes to release them.
+ */
+struct cdc_allocator {
+  void *(*alloc)(void *ctx, size_t size);
+  void *(*realloc)(void *ctx, void *ptr, size_t size);
+  void (*free)(void *ctx, void *ptr);
+  void *ctx;
+};
+
+/**
+ * @brief Returns the number of live bytes that containers and arenas have
+ * allocated from the standard allocator: service structs, buffers, nodes and
+ * buckets. Memory of custom allocators is not counted, they own it. The counter
+ * is only maintained if the library is built with the CDC_MEMORY_COUNTER
+ * option, otherwise 0 is returned.
+ */
+size_t cdc_live_bytes(void);
+
+/**
+ * @brief The cdc_memory_usage struct describes the memory used by a container.
+ *
+ * bytes is the structural memory of the container: the service struct,
+ * buffers, nodes, buckets and sentinels. The elements are not owned by the
+ * container and their memory is not included, count is their number.
+ */
+struct cdc_memory_usage {
+  size_t bytes;
+  size_t count;
+};
 
 struct cdc_pair {
   void *first;
@@ -93,13 +132,80 @@ struct cdc_data_info {
   cdc_copy_fn_t cp;
   size_t size;
   /**
-   * @brief __cnt
+   * @brief allocator - memory allocator of the container.
+   *
+   * The container and all its internal memory are allocated by it. If this
+   * field is NULL, malloc, realloc and free are used.
+   */
+  const struct cdc_allocator *allocator;
+  /**
+   * @brief __cnt - reference count of the copies of the data info that are
+   * kept by containers.
    *
-   * To avoid problems, do not change this field in the code.
+   * Must be 0 in the data info passed to constructors, containers do not
+   * modify it, so it can be used by several threads at once. To avoid
+   * problems, do not change this field in the code.
    */
   size_t __cnt;
 };
 
+/**
+ * @brief The cdc_probe_info struct describes a probe, an object of another type
+ * than the keys of a container, that is used to find a key without building it.
+ *
+ * For example, a (pointer, length) view of a substring of a parsed buffer can
+ * be looked up in a map with null-terminated string keys.
+ */
+struct cdc_probe_info {
+  /**
+   * @brief hash - callback hash of the probe.
+   *
+   * Must be equal to the hash of the equal key. Used by hash tables.
+   */
+  cdc_hash_fn_t hash;
+  /**
+   * @brief eq - callback equal, eq(probe, key).
+   *
+   * Used by hash tables.
+   */
+  cdc_binary_pred_fn_t eq;
+  /**
+   * @brief compare - callback three-way comparison, compare(probe, key).
+   *
+   * Returns a negative value if the probe is less than the key, zero if they
+   * are equal and a positive value otherwise. Must be consistent with the
+   * cmp of the container. Used by trees.
+   */
+  cdc_compare_fn_t compare;
+};
+
+/**
+ * @brief The cdc_str_view struct is a string that is not null-terminated.
+ */
+struct cdc_str_view {
+  const char *data;
+  size_t size;
+};
+
+/**
+ * @brief Probe for containers with null-terminated string keys, hashed by
+ * cdc_pdhash_str and ordered as by strcmp. The probe is a pointer to
+ * cdc_str_view.
+ */
+extern const struct cdc_probe_info *cdc_str_view_probe;
+
+static inline struct cdc_str_view cdc_str_view_make(const char *data, size_t size)
+{
+  struct cdc_str_view view = {data, size};
+  return view;
+}
+
+static inline struct cdc_memory_usage cdc_memory_usage_make(size_t bytes, size_t count)
+{
+  struct cdc_memory_usage usage = {bytes, count};
+  return usage;
+}
+
 static inline size_t cdc_up_to_pow2(size_t x)
 {
   x = x - 1;
@@ -125,7 +231,15 @@ enum cdc_iterator_type {
 typedef enum cdc_iterator_type iterator_type_t;
 
 typedef struct cdc_pair pair_t;
+typedef struct cdc_allocator allocator_t;
 typedef struct cdc_data_info data_info_t;
+typedef struct cdc_probe_info probe_info_t;
+typedef struct cdc_str_view str_view_t;
+typedef struct cdc_memory_usage memory_usage_t;
+
+#define str_view_make(...) cdc_str_view_make(__VA_ARGS__)
+#define memory_usage_make(...) cdc_memory_usage_make(__VA_ARGS__)
+#define live_bytes(...) cdc_live_bytes(__VA_ARGS__)
 #endif
 
 #endif  // CDCONTAINERS_INCLUDE_CDCONTAINERS_COMMON_H
@@ -0,0 +1,316 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+/**
+ * @file
+ * @author Maksim Andrianov <maksimandrianov1@yandex.ru>
+ * @brief The cdc_concurrent_map is a struct and functions that provide a
+ * thread-safe hash map.
+ */
+#ifndef CDCONTAINERS_INCLUDE_CDCONTAINERS_CONCURRENT_MAP_H
+#define CDCONTAINERS_INCLUDE_CDCONTAINERS_CONCURRENT_MAP_H
+
+#include <cdcontainers/common.h>
+#include <cdcontainers/global.h>
+#include <cdcontainers/hash-table.h>
+#include <cdcontainers/status.h>
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * @defgroup cdc_concurrent_map
+ * @brief The cdc_concurrent_map is a struct and functions that provide a
+ * thread-safe hash map.
+ *
+ * Keys are partitioned over a power of two number of shards. Every shard is a
+ * cdc_hash_table protected by its own reader-writer lock, so operations on keys
+ * of different shards do not block each other and lookups of the same shard
+ * run in parallel. The map does not copy keys and values: a pointer returned
+ * by a lookup stays valid only while no other thread erases or replaces it.
+ * @{
+ */
+/**
+ * @brief The cdc_concurrent_map_shard struct
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_concurrent_map_shard {
+  pthread_rwlock_t lock;
+  struct cdc_hash_table *table;
+};
+
+/**
+ * @brief The cdc_concurrent_map_padded_shard is a shard that occupies whole
+ * cache lines, so that threads working with neighbouring shards do not share
+ * a cache line. The table of a shard is allocated with
+ * CDC_HASH_TABLE_CACHE_ALIGNED for the same reason.
+ */
+union cdc_concurrent_map_padded_shard {
+  struct cdc_concurrent_map_shard shard;
+  char pad[(sizeof(struct cdc_concurrent_map_shard) + CDC_CACHE_LINE_SIZE - 1) /
+           CDC_CACHE_LINE_SIZE * CDC_CACHE_LINE_SIZE];
+};
+
+/**
+ * @brief The cdc_concurrent_map is service struct.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_concurrent_map {
+  union cdc_concurrent_map_padded_shard *shards;
+  size_t shard_count;
+  unsigned shard_shift;
+  struct cdc_data_info *dinfo;
+};
+
+// Base
+/**
+ * @defgroup cdc_concurrent_map_base Base
+ * @{
+ */
+/**
+ * @brief Constructs an empty concurrent map with the default number of
+ * shards.
+ * @param[out] m - cdc_concurrent_map
+ * @param[in] info - cdc_data_info
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_concurrent_map_ctor(struct cdc_concurrent_map **m, struct cdc_data_info *info);
+
+/**
+ * @brief Constructs an empty concurrent map.
+ * @param[out] m - cdc_concurrent_map
+ * @param[in] info - cdc_data_info
+ * @param[in] shard_count - number of shards, it is rounded up to a power of two.
+ * A good value is a few times the number of threads that use the map.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_concurrent_map_ctor1(struct cdc_concurrent_map **m, struct cdc_data_info *info,
+                                       size_t shard_count);
+
+/**
+ * @brief Destroys the concurrent map. It must not be used by other threads.
+ * @param[in] m - cdc_concurrent_map
+ */
+void cdc_concurrent_map_dtor(struct cdc_concurrent_map *m);
+/** @} */
+
+// Lookup
+/**
+ * @defgroup cdc_concurrent_map_lookup Lookup
+ * @{
+ */
+/**
+ * @brief Returns a value that is mapped to a key.
+ * @param[in] m - cdc_concurrent_map
+ * @param[in] key - key of the element to find
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_concurrent_map_get(struct cdc_concurrent_map *m, void *key, void **value);
+
+/**
+ * @brief Returns the number of elements with key that compares equal to the
+ * specified argument key, which is either 1 or 0 since this container does not
+ * allow duplicates.
+ * @param[in] m - cdc_concurrent_map
+ * @param[in] key - key value of the elements to count
+ * @return number of elements with key key, that is either 1 or 0.
+ */
+size_t cdc_concurrent_map_count(struct cdc_concurrent_map *m, void *key);
+/** @} */
+
+// Capacity
+/**
+ * @defgroup cdc_concurrent_map_capacity Capacity
+ * @{
+ */
+/**
+ * @brief Returns the number of items in the concurrent map. The shards are
+ * counted one by one, so the result is not a snapshot if other threads modify
+ * the map.
+ * @param[in] m - cdc_concurrent_map
+ * @return the number of items in the concurrent map.
+ */
+size_t cdc_concurrent_map_size(struct cdc_concurrent_map *m);
+
+/**
+ * @brief Checks if the concurrent map has no elements. The same remark as for
+ * cdc_concurrent_map_size applies.
+ * @param[in] m - cdc_concurrent_map
+ * @return true if the concurrent map is empty, false otherwise.
+ */
+static inline bool cdc_concurrent_map_empty(struct cdc_concurrent_map *m)
+{
+  assert(m != NULL);
+
+  return cdc_concurrent_map_size(m) == 0;
+}
+
+/**
+ * @brief Returns the number of shards.
+ * @param[in] m - cdc_concurrent_map
+ * @return the number of shards.
+ */
+static inline size_t cdc_concurrent_map_shard_count(struct cdc_concurrent_map *m)
+{
+  assert(m != NULL);
+
+  return m->shard_count;
+}
+/** @} */
+
+// Modifiers
+/**
+ * @defgroup cdc_concurrent_map_modifiers Modifiers
+ * @{
+ */
+/**
+ * @brief Removes all the elements from the concurrent map. Shards are cleared
+ * one by one.
+ * @param[in] m - cdc_concurrent_map
+ */
+void cdc_concurrent_map_clear(struct cdc_concurrent_map *m);
+
+/**
+ * @brief Inserts an element into the container, if the container doesn't
+ * already contain an element with an equivalent key.
+ * @param[in] m - cdc_concurrent_map
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] inserted - true if the insertion took place. The pointer can be
+ * equal to NULL.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_concurrent_map_insert(struct cdc_concurrent_map *m, void *key, void *value,
+                                        bool *inserted);
+
+/**
+ * @brief Inserts an element or assigns to the current element if the key
+ * already exists.
+ * @param[in] m - cdc_concurrent_map
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] inserted - true if the insertion took place and false if the
+ * assignment took place. The pointer can be equal to NULL.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_concurrent_map_insert_or_assign(struct cdc_concurrent_map *m, void *key,
+                                                  void *value, bool *inserted);
+
+/**
+ * @brief Returns the value that is mapped to a key. If the key does not
+ * exist, the value returned by compute is inserted. The check and the
+ * insertion are atomic: compute is called at most once per key even if several
+ * threads call this function for the same key. compute is called with the
+ * shard locked, so it must not use the concurrent map.
+ * @param[in] m - cdc_concurrent_map
+ * @param[in] key - key of the element
+ * @param[in] compute - function that creates a value for the key
+ * @param[in] arg - user argument that is passed to compute
+ * @param[out] value - value that is mapped to the key after the call. The
+ * pointer can be equal to NULL.
+ * @param[out] inserted - true if the insertion took place. The pointer can be
+ * equal to NULL.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_concurrent_map_compute_if_absent(struct cdc_concurrent_map *m, void *key,
+                                                   void *(*compute)(void *key, void *arg),
+                                                   void *arg, void **value, bool *inserted);
+
+/**
+ * @brief Removes the element (if one exists) with the key equivalent to key.
+ * @param[in] m - cdc_concurrent_map
+ * @param[in] key - key value of the elements to remove
+ * @return number of elements removed.
+ */
+size_t cdc_concurrent_map_erase(struct cdc_concurrent_map *m, void *key);
+/** @} */
+
+// Iteration
+/**
+ * @defgroup cdc_concurrent_map_iteration Iteration
+ * @{
+ */
+/**
+ * @brief Calls cb for every element of one shard. The shard is locked for
+ * reading during the whole call, so cb sees a consistent state of the shard.
+ * cb must not modify the concurrent map.
+ * @param[in] m - cdc_concurrent_map
+ * @param[in] shard - index of the shard, it must be less than
+ * cdc_concurrent_map_shard_count
+ * @param[in] cb - callback that takes a key, a value and arg
+ * @param[in] arg - user argument that is passed to cb
+ */
+void cdc_concurrent_map_shard_foreach(struct cdc_concurrent_map *m, size_t shard,
+                                      void (*cb)(void *key, void *value, void *arg), void *arg);
+
+/**
+ * @brief Calls cb for every element of the concurrent map. The shards are
+ * visited one by one, each of them as by cdc_concurrent_map_shard_foreach.
+ * @param[in] m - cdc_concurrent_map
+ * @param[in] cb - callback that takes a key, a value and arg
+ * @param[in] arg - user argument that is passed to cb
+ */
+void cdc_concurrent_map_foreach(struct cdc_concurrent_map *m,
+                                void (*cb)(void *key, void *value, void *arg), void *arg);
+/** @} */
+
+// Short names
+#ifdef CDC_USE_SHORT_NAMES
+typedef struct cdc_concurrent_map_shard concurrent_map_shard_t;
+typedef union cdc_concurrent_map_padded_shard concurrent_map_padded_shard_t;
+typedef struct cdc_concurrent_map concurrent_map_t;
+
+// Base
+#define concurrent_map_ctor(...) cdc_concurrent_map_ctor(__VA_ARGS__)
+#define concurrent_map_ctor1(...) cdc_concurrent_map_ctor1(__VA_ARGS__)
+#define concurrent_map_dtor(...) cdc_concurrent_map_dtor(__VA_ARGS__)
+
+// Lookup
+#define concurrent_map_get(...) cdc_concurrent_map_get(__VA_ARGS__)
+#define concurrent_map_count(...) cdc_concurrent_map_count(__VA_ARGS__)
+
+// Capacity
+#define concurrent_map_size(...) cdc_concurrent_map_size(__VA_ARGS__)
+#define concurrent_map_empty(...) cdc_concurrent_map_empty(__VA_ARGS__)
+#define concurrent_map_shard_count(...) cdc_concurrent_map_shard_count(__VA_ARGS__)
+
+// Modifiers
+#define concurrent_map_clear(...) cdc_concurrent_map_clear(__VA_ARGS__)
+#define concurrent_map_insert(...) cdc_concurrent_map_insert(__VA_ARGS__)
+#define concurrent_map_insert_or_assign(...) cdc_concurrent_map_insert_or_assign(__VA_ARGS__)
+#define concurrent_map_compute_if_absent(...) cdc_concurrent_map_compute_if_absent(__VA_ARGS__)
+#define concurrent_map_erase(...) cdc_concurrent_map_erase(__VA_ARGS__)
+
+// Iteration
+#define concurrent_map_shard_foreach(...) cdc_concurrent_map_shard_foreach(__VA_ARGS__)
+#define concurrent_map_foreach(...) cdc_concurrent_map_foreach(__VA_ARGS__)
+#endif
+/** @} */
+#endif  // CDCONTAINERS_INCLUDE_CDCONTAINERS_CONCURRENT_MAP_H
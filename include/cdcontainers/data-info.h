@@ -23,6 +23,11 @@
 
 #include <cdcontainers/common.h>
 
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
 struct cdc_data_info *cdc_di_shared_ctorc(struct cdc_data_info *other);
 void cdc_di_shared_dtor(struct cdc_data_info *info);
 
@@ -32,6 +37,115 @@ void cdc_di_shared_dtor(struct cdc_data_info *info);
 #define CDC_HAS_HASH(dinfo) (dinfo && dinfo->hash)
 #define CDC_HAS_CP(dinfo) (dinfo && dinfo->cp)
 #define CDC_HAS_SIZE(dinfo) (dinfo && dinfo->size)
+#define CDC_HAS_ALLOCATOR(dinfo) (dinfo && dinfo->allocator)
+
+// Nodes of a container need not be visited on destruction if the allocator
+// releases memory in bulk and there is nothing to free in them.
+#define CDC_HAS_BULK_FREE(dinfo) (CDC_HAS_ALLOCATOR(dinfo) && !dinfo->allocator->free)
+#define CDC_CAN_DROP_NODES(dinfo) (CDC_HAS_BULK_FREE(dinfo) && !CDC_HAS_DFREE(dinfo))
+
+#define CDC_ALLOCATOR(dinfo) ((dinfo) ? (dinfo)->allocator : NULL)
+
+// With CDC_MEMORY_COUNTER memory of the standard functions is allocated with a
+// header that keeps its size for cdc_live_bytes.
+#ifdef CDC_MEMORY_COUNTER
+void *cdc_counted_malloc(size_t size);
+void *cdc_counted_calloc(size_t size);
+void *cdc_counted_realloc(void *ptr, size_t size);
+void cdc_counted_free(void *ptr);
+
+#define CDC_STD_MALLOC(size) cdc_counted_malloc(size)
+#define CDC_STD_CALLOC(size) cdc_counted_calloc(size)
+#define CDC_STD_REALLOC(ptr, size) cdc_counted_realloc(ptr, size)
+#define CDC_STD_FREE(ptr) cdc_counted_free(ptr)
+#else
+#define CDC_STD_MALLOC(size) malloc(size)
+#define CDC_STD_CALLOC(size) calloc(size, 1)
+#define CDC_STD_REALLOC(ptr, size) realloc(ptr, size)
+#define CDC_STD_FREE(ptr) free(ptr)
+#endif
+
+// Allocation functions that use the allocator |a| or the standard functions if
+// |a| is NULL.
+static inline void *cdc_malloc(const struct cdc_allocator *a, size_t size)
+{
+  return a ? a->alloc(a->ctx, size) : CDC_STD_MALLOC(size);
+}
+
+static inline void *cdc_calloc(const struct cdc_allocator *a, size_t size)
+{
+  if (!a) {
+    return CDC_STD_CALLOC(size);
+  }
+
+  void *ptr = a->alloc(a->ctx, size);
+  if (ptr) {
+    memset(ptr, 0, size);
+  }
+
+  return ptr;
+}
+
+static inline void *cdc_realloc(const struct cdc_allocator *a, void *ptr, size_t size)
+{
+  return a ? a->realloc(a->ctx, ptr, size) : CDC_STD_REALLOC(ptr, size);
+}
+
+static inline void cdc_free(const struct cdc_allocator *a, void *ptr)
+{
+  if (!a) {
+    CDC_STD_FREE(ptr);
+  } else if (ptr && a->free) {
+    a->free(a->ctx, ptr);
+  }
+}
+
+// Memory aligned to |alignment|, a power of two, from the allocator |a|. The
+// block is over-allocated and the pointer returned by cdc_malloc is kept right
+// before the aligned memory, so it must be released with cdc_aligned_free.
+static inline void *cdc_aligned_malloc(const struct cdc_allocator *a, size_t alignment,
+                                       size_t size)
+{
+  assert(alignment >= sizeof(void *) && (alignment & (alignment - 1)) == 0);
+
+  void *ptr = cdc_malloc(a, size + alignment - 1 + sizeof(void *));
+  if (!ptr) {
+    return NULL;
+  }
+
+  uintptr_t aligned =
+      ((uintptr_t)ptr + sizeof(void *) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+  ((void **)aligned)[-1] = ptr;
+  return (void *)aligned;
+}
+
+static inline void cdc_aligned_free(const struct cdc_allocator *a, void *ptr)
+{
+  if (ptr) {
+    cdc_free(a, ((void **)ptr)[-1]);
+  }
+}
+
+// The same functions for the allocator of |info|, which can be NULL.
+static inline void *cdc_di_malloc(struct cdc_data_info *info, size_t size)
+{
+  return cdc_malloc(CDC_ALLOCATOR(info), size);
+}
+
+static inline void *cdc_di_calloc(struct cdc_data_info *info, size_t size)
+{
+  return cdc_calloc(CDC_ALLOCATOR(info), size);
+}
+
+static inline void *cdc_di_realloc(struct cdc_data_info *info, void *ptr, size_t size)
+{
+  return cdc_realloc(CDC_ALLOCATOR(info), ptr, size);
+}
+
+static inline void cdc_di_free(struct cdc_data_info *info, void *ptr)
+{
+  cdc_free(CDC_ALLOCATOR(info), ptr);
+}
 
 static inline int cdc_eq(int (*pred)(const void *, const void *), const void *l, const void *r)
 {
@@ -62,6 +176,10 @@ static inline int cdc_lte(int (*pred)(const void *, const void *), const void *l
 #ifdef CDC_USE_SHORT_NAMES
 #define di_shared_ctorc(...) cdc_di_shared_ctorc(__VA_ARGS__)
 #define di_shared_dtor(...) cdc_di_shared_dtor(__VA_ARGS__)
+#define di_malloc(...) cdc_di_malloc(__VA_ARGS__)
+#define di_calloc(...) cdc_di_calloc(__VA_ARGS__)
+#define di_realloc(...) cdc_di_realloc(__VA_ARGS__)
+#define di_free(...) cdc_di_free(__VA_ARGS__)
 #endif
 
 #endif  // CDCONTAINERS_SRC_DATA_INFO_Hs
@@ -0,0 +1,212 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+/**
+ * @file
+ * @author Maksim Andrianov <maksimandrianov1@yandex.ru>
+ * @brief The cdc_frozen_map is a struct and functions that provide an
+ * immutable map based on a minimal perfect hash function.
+ */
+#ifndef CDCONTAINERS_INCLUDE_CDCONTAINERS_FROZEN_MAP_H
+#define CDCONTAINERS_INCLUDE_CDCONTAINERS_FROZEN_MAP_H
+
+#include <cdcontainers/common.h>
+#include <cdcontainers/hash-table.h>
+#include <cdcontainers/hash.h>
+#include <cdcontainers/status.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @defgroup cdc_frozen_map
+ * @brief The cdc_frozen_map is a struct and functions that provide an
+ * immutable map based on a minimal perfect hash function.
+ *
+ * The map is built once from an array of pairs or from a cdc_hash_table and
+ * can not be changed afterwards. n keys and values are stored in two arrays of
+ * exactly n elements. A lookup hashes the key once, reads the displacement of
+ * its bucket, and compares the key in the only slot where it can be (hash and
+ * displace, CHD). The hash function of cdc_data_info must give different
+ * hashes for different keys.
+ * @{
+ */
+/**
+ * @brief The cdc_frozen_map is service struct.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_frozen_map {
+  void **keys;
+  void **values;
+  uint32_t *displacements;
+  size_t size;
+  size_t bcount;
+  size_t salt;
+  struct cdc_data_info *dinfo;
+};
+
+// Base
+/**
+ * @defgroup cdc_frozen_map_base Base
+ * @{
+ */
+/**
+ * @brief Constructs a frozen map from an array of pairs (first - key, and
+ * the second - value).
+ * @param[out] m - cdc_frozen_map
+ * @param[in] info - cdc_data_info
+ * @param[in] pairs - keys and values of the map
+ * @param[in] n - number of pairs
+ * @return CDC_STATUS_OK in a successful case, CDC_STATUS_ALREADY_EXISTS if
+ * pairs contain equal keys or other value indicating an error.
+ */
+enum cdc_stat cdc_frozen_map_ctor(struct cdc_frozen_map **m, struct cdc_data_info *info,
+                                  struct cdc_pair *pairs, size_t n);
+
+/**
+ * @brief Constructs a frozen map from the elements of a hash table. The table
+ * is not changed. dfree of info is applied to the elements by
+ * cdc_frozen_map_dtor, so pass info without dfree if the table keeps owning
+ * them.
+ * @param[out] m - cdc_frozen_map
+ * @param[in] info - cdc_data_info
+ * @param[in] t - cdc_hash_table
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_frozen_map_ctor_hash_table(struct cdc_frozen_map **m,
+                                             struct cdc_data_info *info,
+                                             struct cdc_hash_table *t);
+
+/**
+ * @brief Destroys the frozen map.
+ * @param[in] m - cdc_frozen_map
+ */
+void cdc_frozen_map_dtor(struct cdc_frozen_map *m);
+/** @} */
+
+// Lookup
+/**
+ * @defgroup cdc_frozen_map_lookup Lookup
+ * @{
+ */
+/**
+ * @brief Returns a value that is mapped to a key.
+ * @param[in] m - cdc_frozen_map
+ * @param[in] key - key of the element to find
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_frozen_map_get(struct cdc_frozen_map *m, void *key, void **value);
+
+/**
+ * @brief Returns the number of elements with key that compares equal to the
+ * specified argument key, which is either 1 or 0 since this container does not
+ * allow duplicates.
+ * @param[in] m - cdc_frozen_map
+ * @param[in] key - key value of the elements to count
+ * @return number of elements with key key, that is either 1 or 0.
+ */
+size_t cdc_frozen_map_count(struct cdc_frozen_map *m, void *key);
+
+/**
+ * @brief Returns the key of the element at position index. Positions are in
+ * the range [0, size) and can be used to iterate over the map.
+ * @param[in] m - cdc_frozen_map
+ * @param[in] index - position of the element
+ * @return the key of the element.
+ */
+static inline void *cdc_frozen_map_key_at(struct cdc_frozen_map *m, size_t index)
+{
+  assert(m != NULL);
+  assert(index < m->size);
+
+  return m->keys[index];
+}
+
+/**
+ * @brief Returns the value of the element at position index.
+ * @param[in] m - cdc_frozen_map
+ * @param[in] index - position of the element
+ * @return the value of the element.
+ */
+static inline void *cdc_frozen_map_value_at(struct cdc_frozen_map *m, size_t index)
+{
+  assert(m != NULL);
+  assert(index < m->size);
+
+  return m->values[index];
+}
+/** @} */
+
+// Capacity
+/**
+ * @defgroup cdc_frozen_map_capacity Capacity
+ * @{
+ */
+/**
+ * @brief Returns the number of items in the frozen map.
+ * @param[in] m - cdc_frozen_map
+ * @return the number of items in the frozen map.
+ */
+static inline size_t cdc_frozen_map_size(struct cdc_frozen_map *m)
+{
+  assert(m != NULL);
+
+  return m->size;
+}
+
+/**
+ * @brief Checks if the frozen map has no elements.
+ * @param[in] m - cdc_frozen_map
+ * @return true if the frozen map is empty, false otherwise.
+ */
+static inline bool cdc_frozen_map_empty(struct cdc_frozen_map *m)
+{
+  assert(m != NULL);
+
+  return m->size == 0;
+}
+/** @} */
+
+// Short names
+#ifdef CDC_USE_SHORT_NAMES
+typedef struct cdc_frozen_map frozen_map_t;
+
+// Base
+#define frozen_map_ctor(...) cdc_frozen_map_ctor(__VA_ARGS__)
+#define frozen_map_ctor_hash_table(...) cdc_frozen_map_ctor_hash_table(__VA_ARGS__)
+#define frozen_map_dtor(...) cdc_frozen_map_dtor(__VA_ARGS__)
+
+// Lookup
+#define frozen_map_get(...) cdc_frozen_map_get(__VA_ARGS__)
+#define frozen_map_count(...) cdc_frozen_map_count(__VA_ARGS__)
+#define frozen_map_key_at(...) cdc_frozen_map_key_at(__VA_ARGS__)
+#define frozen_map_value_at(...) cdc_frozen_map_value_at(__VA_ARGS__)
+
+// Capacity
+#define frozen_map_size(...) cdc_frozen_map_size(__VA_ARGS__)
+#define frozen_map_empty(...) cdc_frozen_map_empty(__VA_ARGS__)
+#endif
+/** @} */
+#endif  // CDCONTAINERS_INCLUDE_CDCONTAINERS_FROZEN_MAP_H
@@ -26,6 +26,14 @@
 
 #define CDC_UNUSED(x) (void)(x)
 
+#define CDC_CACHE_LINE_SIZE 64
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CDC_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define CDC_PREFETCH(addr) CDC_UNUSED(addr)
+#endif
+
 #define CDC_CHECK(X, msg)                                                           \
   do {                                                                              \
     if (X) {                                                                        \
@@ -40,6 +40,48 @@
  * @brief The cdc_hash_table is a struct and functions that provide a hash table.
  * @{
  */
+/**
+ * @brief Options of the hash table. They can be combined with | and passed to
+ * cdc_hash_table_ctor2.
+ */
+enum cdc_hash_table_flag {
+  // Grows the table gradually: when the load factor is exceeded, a new bucket
+  // array is allocated and every following insertion or erasure moves a few
+  // buckets of the old array into it, instead of moving all entries at once.
+  CDC_HASH_TABLE_INCREMENTAL_REHASH = 1 << 0,
+  // Allocates entries from chunks that hold many entries instead of one malloc
+  // per entry. Erased entries are reused by the following insertions, chunks
+  // are released by cdc_hash_table_clear and cdc_hash_table_dtor.
+  CDC_HASH_TABLE_NODE_POOL = 1 << 1,
+  // Mixes the bits of the hashes (see cdc_hash_mix) before selecting a bucket.
+  // Use it with hash functions that are close to identity, e.g. cdc_hash_int or
+  // hashes of pointers; the cdc_pdhash_* functions are already mixed.
+  CDC_HASH_TABLE_MIX_HASH = 1 << 2,
+  // Allocates the table object aligned to a cache line and padded to whole
+  // lines, so tables that are changed by different threads (e.g. the shards of
+  // cdc_concurrent_map) do not share cache lines. The flag stays with the
+  // object in cdc_hash_table_swap.
+  CDC_HASH_TABLE_CACHE_ALIGNED = 1 << 3,
+  // Allocates a storage for CDC_HASH_TABLE_SMALL_SIZE elements at the tail of
+  // the block of the table object and keeps the elements there while they fit,
+  // looking them up by a linear scan of their hashes. Until then the table has
+  // one bucket and allocates nothing besides its block. The buckets are
+  // allocated when the table grows larger, or on cdc_hash_table_rehash and
+  // cdc_hash_table_reserve, which invalidates all iterators; the storage is
+  // released only with the table. The flag stays with the object in
+  // cdc_hash_table_swap, and a table in small mode can only be swapped with a
+  // table that has the flag.
+  CDC_HASH_TABLE_SMALL = 1 << 4
+};
+
+/**
+ * @brief The maximum number of elements that a table with CDC_HASH_TABLE_SMALL
+ * keeps in the storage at the tail of its block.
+ */
+#define CDC_HASH_TABLE_SMALL_SIZE 8
+
+struct cdc_node_pool;
+
 /**
  * @brief The cdc_hash_table_entry struct
  * @warning To avoid problems, do not change the structure fields in the code.
@@ -58,11 +100,17 @@ struct cdc_hash_table_entry {
  * Use only special functions to access and change structure fields.
  */
 struct cdc_hash_table {
+  struct cdc_hash_table_entry *head;
   struct cdc_hash_table_entry *tail;
   struct cdc_hash_table_entry **buckets;
   size_t bcount;
+  struct cdc_hash_table_entry **old_buckets;
+  size_t old_bcount;
+  size_t migrated;
   double load_factor;
   size_t size;
+  int flags;
+  struct cdc_node_pool *pool;
   struct cdc_data_info *dinfo;
 };
 
@@ -158,6 +206,45 @@ enum cdc_stat cdc_hash_table_ctorl1(struct cdc_hash_table **t, struct cdc_data_i
 enum cdc_stat cdc_hash_table_ctorv1(struct cdc_hash_table **t, struct cdc_data_info *info,
                                     double load_factor, va_list args);
 
+/**
+ * @brief Constructs an empty hash table.
+ * @param[out] t - cdc_hash_table
+ * @param[in] info - cdc_data_info
+ * @param[in] load_factor - maximum load factor
+ * @param[in] flags - combination of cdc_hash_table_flag values
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_hash_table_ctor2(struct cdc_hash_table **t, struct cdc_data_info *info,
+                                   double load_factor, int flags);
+
+/**
+ * @brief Constructs a hash table, initialized by an variable number of
+ * pointers on cdc_pair's(first - key, and the second - value).  The last item
+ * must be CDC_END.
+ * @param[out] t - cdc_hash_table
+ * @param[in] info - cdc_data_info
+ * @param[in] load_factor - maximum load factor
+ * @param[in] flags - combination of cdc_hash_table_flag values
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_hash_table_ctorl2(struct cdc_hash_table **t, struct cdc_data_info *info,
+                                    double load_factor, int flags, ...);
+
+/**
+ * @brief Constructs a hash table, initialized by args. The last item must be
+ * CDC_END.
+ * @param[out] t - cdc_hash_table
+ * @param[in] info - cdc_data_info
+ * @param[in] load_factor - maximum load factor
+ * @param[in] flags - combination of cdc_hash_table_flag values
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_hash_table_ctorv2(struct cdc_hash_table **t, struct cdc_data_info *info,
+                                    double load_factor, int flags, va_list args);
+
 /**
  * @brief Destroys the hash table.
  * @param[in] t - cdc_hash_table
@@ -180,6 +267,35 @@ void cdc_hash_table_dtor(struct cdc_hash_table *t);
  */
 enum cdc_stat cdc_hash_table_get(struct cdc_hash_table *t, void *key, void **value);
 
+/**
+ * @brief The same as cdc_hash_table_get, but takes a precomputed hash of the key
+ * instead of calling the hash function.
+ * @param[in] t - cdc_hash_table
+ * @param[in] key - key of the element to find
+ * @param[in] hash - hash of the key, it must be equal to the value returned by
+ * the hash function of cdc_data_info for this key
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_hash_table_get_hashed(struct cdc_hash_table *t, void *key, size_t hash,
+                                        void **value);
+
+/**
+ * @brief Looks up n keys at once. All keys are hashed first and their buckets
+ * are prefetched before any of them is resolved, so cache misses of different
+ * lookups overlap. If keys[i] is found, found[i] is set to true and values[i]
+ * to the mapped value, otherwise found[i] is set to false and values[i] is
+ * not changed.
+ * @param[in] t - cdc_hash_table
+ * @param[in] keys - keys of the elements to find
+ * @param[in] n - number of keys
+ * @param[out] values - values that are mapped to the keys
+ * @param[out] found - flags that are set for the found keys
+ * @return number of the found keys.
+ */
+size_t cdc_hash_table_get_many(struct cdc_hash_table *t, void **keys, size_t n, void **values,
+                               bool *found);
+
 /**
  * @brief Returns the number of elements with key that compares equal to the
  * specified argument key, which is either 1 or 0 since this container does not
@@ -190,6 +306,17 @@ enum cdc_stat cdc_hash_table_get(struct cdc_hash_table *t, void *key, void **val
  */
 size_t cdc_hash_table_count(struct cdc_hash_table *t, void *key);
 
+/**
+ * @brief The same as cdc_hash_table_count, but takes a precomputed hash of the
+ * key instead of calling the hash function.
+ * @param[in] t - cdc_hash_table
+ * @param[in] key - key value of the elements to count
+ * @param[in] hash - hash of the key, it must be equal to the value returned by
+ * the hash function of cdc_data_info for this key
+ * @return number of elements with key key, that is either 1 or 0.
+ */
+size_t cdc_hash_table_count_hashed(struct cdc_hash_table *t, void *key, size_t hash);
+
 /**
  * @brief Finds an element with key equivalent to key.
  * @param[in] t - cdc_hash_table
@@ -199,6 +326,54 @@ size_t cdc_hash_table_count(struct cdc_hash_table *t, void *key);
  * returned.
  */
 void cdc_hash_table_find(struct cdc_hash_table *t, void *key, struct cdc_hash_table_iter *it);
+
+/**
+ * @brief The same as cdc_hash_table_find, but takes a precomputed hash of the key
+ * instead of calling the hash function.
+ * @param[in] t - cdc_hash_table
+ * @param[in] key - key value of the element to search for
+ * @param[in] hash - hash of the key, it must be equal to the value returned by
+ * the hash function of cdc_data_info for this key
+ * @param[out] it - pointer will be recorded iterator to an element with key
+ * equivalent to key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_hash_table_find_hashed(struct cdc_hash_table *t, void *key, size_t hash,
+                                struct cdc_hash_table_iter *it);
+
+/**
+ * @brief The same as cdc_hash_table_get, but looks up a probe, an object that
+ * is compared with the keys by the callbacks of the info. No key is built, so a
+ * string can be looked up by a cdc_str_view without copying it.
+ * @param[in] t - cdc_hash_table
+ * @param[in] probe - probe of the element to find
+ * @param[in] info - hash and eq callbacks of the probe
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_hash_table_get_probe(struct cdc_hash_table *t, const void *probe,
+                                       const struct cdc_probe_info *info, void **value);
+
+/**
+ * @brief The same as cdc_hash_table_count, but looks up a probe.
+ * @param[in] t - cdc_hash_table
+ * @param[in] probe - probe of the elements to count
+ * @param[in] info - hash and eq callbacks of the probe
+ * @return number of elements equal to the probe, that is either 1 or 0.
+ */
+size_t cdc_hash_table_count_probe(struct cdc_hash_table *t, const void *probe,
+                                  const struct cdc_probe_info *info);
+
+/**
+ * @brief The same as cdc_hash_table_find, but looks up a probe.
+ * @param[in] t - cdc_hash_table
+ * @param[in] probe - probe of the element to search for
+ * @param[in] info - hash and eq callbacks of the probe
+ * @param[out] it - pointer will be recorded iterator to an element equal to the
+ * probe. If no such element is found, past-the-end iterator is returned.
+ */
+void cdc_hash_table_find_probe(struct cdc_hash_table *t, const void *probe,
+                               const struct cdc_probe_info *info, struct cdc_hash_table_iter *it);
 /** @} */
 
 // Capacity
@@ -229,6 +404,14 @@ static inline bool cdc_hash_table_empty(struct cdc_hash_table *t)
 
   return t->size == 0;
 }
+
+/**
+ * @brief Returns the memory used by the table, its buckets, the sentinel and
+ * the entries. The memory of the elements is not included.
+ * @param[in] t - cdc_hash_table
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_hash_table_memory_usage(struct cdc_hash_table *t);
 /** @} */
 
 // Modifiers
@@ -257,6 +440,25 @@ void cdc_hash_table_clear(struct cdc_hash_table *t);
 enum cdc_stat cdc_hash_table_insert(struct cdc_hash_table *t, void *key, void *value,
                                     struct cdc_hash_table_iter *it, bool *inserted);
 
+/**
+ * @brief The same as cdc_hash_table_insert, but takes a precomputed hash of the
+ * key instead of calling the hash function.
+ * @param[in] t - cdc_hash_table
+ * @param[in] key - key of the element
+ * @param[in] hash - hash of the key, it must be equal to the value returned by
+ * the hash function of cdc_data_info for this key
+ * @param[in] value - value of the element
+ * @param[out] it - iterator to the inserted element (or to the element that
+ * prevented the insertion). The pointer can be equal to NULL.
+ * @param[out] inserted - bool denoting whether the insertion
+ * took place. The pointer can be equal to NULL.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_hash_table_insert_hashed(struct cdc_hash_table *t, void *key, size_t hash,
+                                           void *value, struct cdc_hash_table_iter *it,
+                                           bool *inserted);
+
 /**
  * @brief Inserts an element or assigns to the current element if the key
  * already exists.
@@ -272,6 +474,26 @@ enum cdc_stat cdc_hash_table_insert(struct cdc_hash_table *t, void *key, void *v
 enum cdc_stat cdc_hash_table_insert_or_assign(struct cdc_hash_table *t, void *key, void *value,
                                               struct cdc_hash_table_iter *it, bool *inserted);
 
+/**
+ * @brief The same as cdc_hash_table_insert_or_assign, but takes a precomputed
+ * hash of the key instead of calling the hash function.
+ * @param[in] t - cdc_hash_table
+ * @param[in] key - key of the element
+ * @param[in] hash - hash of the key, it must be equal to the value returned by
+ * the hash function of cdc_data_info for this key
+ * @param[in] value - value of the element
+ * @param[out] it - iterator is pointing at the element that was inserted or updated.
+ * The pointer can be equal to NULL
+ * @param[out] inserted - bool is true if the insertion took place and false if the
+ * assignment took place. The pointer can be equal to NULL
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_hash_table_insert_or_assign_hashed(struct cdc_hash_table *t, void *key,
+                                                     size_t hash, void *value,
+                                                     struct cdc_hash_table_iter *it,
+                                                     bool *inserted);
+
 /**
  * @brief Removes the element (if one exists) with the key equivalent to key.
  * @param[in] t - cdc_hash_table
@@ -280,6 +502,17 @@ enum cdc_stat cdc_hash_table_insert_or_assign(struct cdc_hash_table *t, void *ke
  */
 size_t cdc_hash_table_erase(struct cdc_hash_table *t, void *key);
 
+/**
+ * @brief The same as cdc_hash_table_erase, but takes a precomputed hash of the
+ * key instead of calling the hash function.
+ * @param[in] t - cdc_hash_table
+ * @param[in] key - key value of the elements to remove
+ * @param[in] hash - hash of the key, it must be equal to the value returned by
+ * the hash function of cdc_data_info for this key
+ * @return number of elements removed.
+ */
+size_t cdc_hash_table_erase_hashed(struct cdc_hash_table *t, void *key, size_t hash);
+
 /**
  * @brief Swaps hash_tables a and b. This operation is very fast and never fails.
  * @param[in, out] a - cdc_hash_table
@@ -304,7 +537,7 @@ static inline void cdc_hash_table_begin(struct cdc_hash_table *t, struct cdc_has
   assert(it != NULL);
 
   it->container = t;
-  it->current = t->buckets[0]->next;
+  it->current = t->head->next;
 }
 
 /**
@@ -365,7 +598,7 @@ static inline void cdc_hash_table_set_max_load_factor(struct cdc_hash_table *t,
 
 /**
  * @brief Reserves at least the specified number of buckets. This regenerates
- * the hash table.
+ * the hash table at once, even with CDC_HASH_TABLE_INCREMENTAL_REHASH.
  * @param[in] t - cdc_hash_table
  * @param[in] count - new number of buckets
  * @return CDC_STATUS_OK in a successful case or other value indicating
@@ -400,12 +633,22 @@ static inline size_t cdc_hash_table_bucket_count(struct cdc_hash_table *t)
 
   return t->bcount;
 }
+
+/**
+ * @brief Returns the number of elements in the bucket n.
+ * @param[in] t - cdc_hash_table
+ * @param[in] n - index of the bucket, must be less than the number of buckets
+ * @return the number of elements in the bucket n.
+ */
+size_t cdc_hash_table_bucket_size(struct cdc_hash_table *t, size_t n);
 /** @} */
 
 // Iterators
 /**
  * @defgroup cdc_hash_table_iter
  * @brief The cdc_hash_table_iter is a struct and functions that provide a hash table iterator.
+ * With CDC_HASH_TABLE_INCREMENTAL_REHASH any insertion or erasure can move
+ * elements, so it invalidates the order of iteration.
  * @{
  */
 /**
@@ -503,22 +746,37 @@ typedef struct cdc_pair_hash_table_iter_bool pair_hash_table_iter_bool_t;
 #define hash_table_ctor1(...) cdc_hash_table_ctor1(__VA_ARGS__)
 #define hash_table_ctorl1(...) cdc_hash_table_ctorl1(__VA_ARGS__)
 #define hash_table_ctorv1(...) cdc_hash_table_ctorv1(__VA_ARGS__)
+#define hash_table_ctor2(...) cdc_hash_table_ctor2(__VA_ARGS__)
+#define hash_table_ctorl2(...) cdc_hash_table_ctorl2(__VA_ARGS__)
+#define hash_table_ctorv2(...) cdc_hash_table_ctorv2(__VA_ARGS__)
 #define hash_table_dtor(...) cdc_hash_table_dtor(__VA_ARGS__)
 
 // Lookup
 #define hash_table_get(...) cdc_hash_table_get(__VA_ARGS__)
 #define hash_table_count(...) cdc_hash_table_count(__VA_ARGS__)
 #define hash_table_find(...) cdc_hash_table_find(__VA_ARGS__)
+#define hash_table_get_hashed(...) cdc_hash_table_get_hashed(__VA_ARGS__)
+#define hash_table_get_many(...) cdc_hash_table_get_many(__VA_ARGS__)
+#define hash_table_count_hashed(...) cdc_hash_table_count_hashed(__VA_ARGS__)
+#define hash_table_find_hashed(...) cdc_hash_table_find_hashed(__VA_ARGS__)
+#define hash_table_get_probe(...) cdc_hash_table_get_probe(__VA_ARGS__)
+#define hash_table_count_probe(...) cdc_hash_table_count_probe(__VA_ARGS__)
+#define hash_table_find_probe(...) cdc_hash_table_find_probe(__VA_ARGS__)
 
 // Capacity
 #define hash_table_size(...) cdc_hash_table_size(__VA_ARGS__)
 #define hash_table_empty(...) cdc_hash_table_empty(__VA_ARGS__)
+#define hash_table_memory_usage(...) cdc_hash_table_memory_usage(__VA_ARGS__)
 
 // Modifiers
 #define hash_table_clear(...) cdc_hash_table_clear(__VA_ARGS__)
 #define hash_table_insert(...) cdc_hash_table_insert(__VA_ARGS__)
 #define hash_table_insert_or_assign(...) cdc_hash_table_insert_or_assign(__VA_ARGS__)
 #define hash_table_erase(...) cdc_hash_table_erase(__VA_ARGS__)
+#define hash_table_insert_hashed(...) cdc_hash_table_insert_hashed(__VA_ARGS__)
+#define hash_table_insert_or_assign_hashed(...) \
+  cdc_hash_table_insert_or_assign_hashed(__VA_ARGS__)
+#define hash_table_erase_hashed(...) cdc_hash_table_erase_hashed(__VA_ARGS__)
 #define hash_table_swap(...) cdc_hash_table_swap(__VA_ARGS__)
 
 // Iterators
@@ -534,6 +792,7 @@ typedef struct cdc_pair_hash_table_iter_bool pair_hash_table_iter_bool_t;
 
 // Bucket interface
 #define hash_table_bucket_count(...) cdc_hash_table_bucket_count(__VA_ARGS__)
+#define hash_table_bucket_size(...) cdc_hash_table_bucket_size(__VA_ARGS__)
 
 // Iterators
 #define hash_table_iter_next(...) cdc_hash_table_iter_next(__VA_ARGS__)
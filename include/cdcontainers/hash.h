@@ -25,6 +25,8 @@
  * The ideas of algorithms were borrowed from the boost library.
  * http://www.boost.org/doc/libs/1_64_0/boost/functional/hash/hash.hpp
  * http://www.boost.org/doc/libs/1_64_0/boost/functional/hash/detail/hash_float.hpp
+ * The hash of byte ranges and strings is based on wyhash.
+ * https://github.com/wangyi-fudan/wyhash
  */
 #ifndef CDCONTAINERS_INCLUDE_CDCONTAINERS_HASH_H
 #define CDCONTAINERS_INCLUDE_CDCONTAINERS_HASH_H
@@ -33,10 +35,59 @@
 #include <float.h>
 #include <limits.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 typedef size_t (*cdc_hash_fn_t)(void const *);
 
+/**
+ * @brief Mixes the bits of the hash (the finalizer of MurmurHash3). Every bit of
+ * the result depends on every bit of the argument, so the low bits of the result
+ * are good even when the argument differs only in the high bits (e.g. aligned
+ * pointers or small integers). The function is a bijection.
+ * @param[in] hash - hash to mix
+ * @return mixed hash.
+ */
+static inline size_t cdc_hash_mix(size_t hash)
+{
+#if SIZE_MAX > UINT32_MAX
+  uint64_t h = (uint64_t)hash;
+  h ^= h >> 33;
+  h *= UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+  h *= UINT64_C(0xc4ceb9fe1a85ec53);
+  h ^= h >> 33;
+#else
+  uint32_t h = (uint32_t)hash;
+  h ^= h >> 16;
+  h *= UINT32_C(0x85ebca6b);
+  h ^= h >> 13;
+  h *= UINT32_C(0xc2b2ae35);
+  h ^= h >> 16;
+#endif
+  return (size_t)h;
+}
+
+/**
+ * @brief Returns a hash of the byte range. It processes 16 bytes at a time on
+ * short keys and 48 bytes at a time on long keys, and every bit of the input
+ * affects every bit of the result.
+ * @param[in] data - pointer to the first byte
+ * @param[in] length - number of bytes
+ * @param[in] seed - seed of the hash, different seeds give independent hashes
+ * @return hash of the byte range.
+ */
+size_t cdc_hash_bytes(const void *data, size_t length, size_t seed);
+
+/**
+ * @brief Returns a hash of the null-terminated string. It is equal to
+ * cdc_hash_bytes(str, strlen(str), seed).
+ * @param[in] str - null-terminated string
+ * @param[in] seed - seed of the hash
+ * @return hash of the string.
+ */
+size_t cdc_hash_str(const char *str, size_t seed);
+
 #define CDC_DIGITS_CHAR (CHAR_BIT - (CHAR_MIN < 0))
 #define CDC_DIGITS_SCHAR (CHAR_BIT - 1)
 #define CDC_DIGITS_UCHAR (CHAR_BIT)
@@ -134,11 +185,19 @@ MAKE_SIGNED_HASH(char, CDC_DIGITS_CHAR, char)
 MAKE_UNSIGNED_HASH(char, CDC_DIGITS_CHAR, char)
 #endif
 
+// The cdc_hash_NAME functions are close to identity for integers, so the
+// pointer data hashes mix them. Define CDC_PDHASH_NO_MIX to get raw values.
+#ifdef CDC_PDHASH_NO_MIX
+#define CDC_PDHASH_MIX(x) (x)
+#else
+#define CDC_PDHASH_MIX(x) cdc_hash_mix(x)
+#endif
+
 #define MAKE_POINTER_DATA_HASH(T, NAME, CAST_FUNC)  \
   static inline size_t cdc_pdhash_##NAME(void *val) \
   {                                                 \
     T t = CAST_FUNC(val);                           \
-    return cdc_hash_##NAME(t);                      \
+    return CDC_PDHASH_MIX(cdc_hash_##NAME(t));      \
   }
 
 MAKE_POINTER_DATA_HASH(char, char, CDC_TO_CHAR)
@@ -160,4 +219,22 @@ MAKE_POINTER_DATA_HASH(float, float, CDC_TO_FLOAT)
 MAKE_POINTER_DATA_HASH(double, double, CDC_TO_DOUBLE)
 #endif
 
+/**
+ * @brief cdc_hash_fn_t for keys that are pointers to null-terminated strings.
+ */
+static inline size_t cdc_pdhash_str(const void *val)
+{
+  return cdc_hash_str((const char *)val, 0);
+}
+
+/**
+ * @brief Defines cdc_pdhash_NAME, a cdc_hash_fn_t for keys that are pointers to
+ * objects of SIZE bytes (e.g. structures without padding).
+ */
+#define CDC_MAKE_POINTER_BYTES_HASH(SIZE, NAME)           \
+  static inline size_t cdc_pdhash_##NAME(const void *val) \
+  {                                                       \
+    return cdc_hash_bytes(val, SIZE, 0);                  \
+  }
+
 #endif  // CDCONTAINERS_INCLUDE_CDCONTAINERS_HASH_H
@@ -126,6 +126,14 @@ static inline bool cdc_heap_empty(struct cdc_heap *h)
   return cdc_array_empty(h->array);
 }
 
+/**
+ * @brief Returns the memory used by the heap and its array. The memory of the
+ * elements is not included.
+ * @param h - cdc_heap
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_heap_memory_usage(struct cdc_heap *h);
+
 // Modifiers
 /**
  * @brief Extracts the top item from the heap. This function assumes that the
@@ -236,6 +244,7 @@ typedef struct cdc_heap_iter heap_iter_t;
 
 // Capacity
 #define heap_empty(...) cdc_heap_empty(__VA_ARGS__)
+#define heap_memory_usage(...) cdc_heap_memory_usage(__VA_ARGS__)
 #define heap_size(...) cdc_heap_size(__VA_ARGS__)
 
 // Modifiers
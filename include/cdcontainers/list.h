@@ -227,6 +227,14 @@ static inline bool cdc_list_empty(struct cdc_list *l)
 
   return l->size == 0;
 }
+
+/**
+ * @brief Returns the memory used by the list and its nodes. The memory of the
+ * elements is not included.
+ * @param[in] l - cdc_list
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_list_memory_usage(struct cdc_list *l);
 /** @} */
 
 // Modifiers
@@ -691,6 +699,7 @@ typedef struct cdc_list_riter list_riter_t;
 
 // Capacity
 #define list_empty(...) cdc_list_empty(__VA_ARGS__)
+#define list_memory_usage(...) cdc_list_memory_usage(__VA_ARGS__)
 #define list_size(...) cdc_list_size(__VA_ARGS__)
 
 // Modifiers
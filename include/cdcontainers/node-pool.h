@@ -0,0 +1,75 @@
+// The MIT License (MIT)
+// Copyright (c) 2017 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#ifndef CDCONTAINERS_SRC_NODE_POOL_H
+#define CDCONTAINERS_SRC_NODE_POOL_H
+
+#include <cdcontainers/common.h>
+#include <cdcontainers/status.h>
+
+#include <stddef.h>
+
+// Size of the first chunk of a pool with page-sized chunks.
+#define CDC_NODE_POOL_PAGE_SIZE 4096
+// Size of the largest chunk of a pool with page-sized chunks. With
+// CDC_NODE_POOL_HUGEPAGES chunks of this size are aligned to it and backed by
+// transparent huge pages if the pool uses the standard allocator.
+#define CDC_NODE_POOL_HUGEPAGE_SIZE (2 * 1024 * 1024)
+
+// The cdc_node_pool hands out fixed-size nodes from chunks of chunk_size nodes.
+// If chunk_size is 0, the first chunk takes a page and each next one is twice
+// as large up to CDC_NODE_POOL_HUGEPAGE_SIZE bytes. Freed nodes are kept in a
+// free list and reused, chunks are returned to the system only by
+// cdc_node_pool_clear and cdc_node_pool_dtor. The pool and the chunks are
+// allocated by the allocator of dinfo, which must outlive the pool.
+struct cdc_node_pool {
+  void *free_nodes;
+  void *chunks;
+  char *cursor;
+  char *end;
+  size_t node_size;
+  size_t chunk_size;
+  size_t chunk_bytes;
+  size_t bytes;
+  struct cdc_data_info *dinfo;
+};
+
+enum cdc_stat cdc_node_pool_ctor(struct cdc_node_pool **pool, struct cdc_data_info *info,
+                                 size_t node_size, size_t chunk_size);
+void cdc_node_pool_dtor(struct cdc_node_pool *pool);
+void *cdc_node_pool_alloc(struct cdc_node_pool *pool);
+void cdc_node_pool_free(struct cdc_node_pool *pool, void *node);
+void cdc_node_pool_clear(struct cdc_node_pool *pool);
+// Returns the number of bytes of the pool and its chunks.
+size_t cdc_node_pool_memory_usage(struct cdc_node_pool *pool);
+
+// Short names
+#ifdef CDC_USE_SHORT_NAMES
+typedef struct cdc_node_pool node_pool_t;
+
+#define node_pool_ctor(...) cdc_node_pool_ctor(__VA_ARGS__)
+#define node_pool_dtor(...) cdc_node_pool_dtor(__VA_ARGS__)
+#define node_pool_alloc(...) cdc_node_pool_alloc(__VA_ARGS__)
+#define node_pool_free(...) cdc_node_pool_free(__VA_ARGS__)
+#define node_pool_clear(...) cdc_node_pool_clear(__VA_ARGS__)
+#define node_pool_memory_usage(...) cdc_node_pool_memory_usage(__VA_ARGS__)
+#endif
+
+#endif  // CDCONTAINERS_SRC_NODE_POOL_H
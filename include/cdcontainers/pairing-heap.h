@@ -143,6 +143,14 @@ static inline bool cdc_pairing_heap_empty(struct cdc_pairing_heap *h)
   return h->size == 0;
 }
 
+/**
+ * @brief Returns the memory used by the heap and its nodes. The memory of the
+ * elements is not included.
+ * @param h - cdc_pairing_heap
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_pairing_heap_memory_usage(struct cdc_pairing_heap *h);
+
 // Modifiers
 /**
  * @brief Extracts the top item from the pairing heap. This function assumes
@@ -260,6 +268,7 @@ typedef struct cdc_pairing_heap_iter pairing_heap_iter_t;
 
 // Capacity
 #define pairing_heap_empty(...) cdc_pairing_heap_empty(__VA_ARGS__)
+#define pairing_heap_memory_usage(...) cdc_pairing_heap_memory_usage(__VA_ARGS__)
 #define pairing_heap_size(...) cdc_pairing_heap_size(__VA_ARGS__)
 
 // Modifiers
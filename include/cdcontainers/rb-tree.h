@@ -0,0 +1,582 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+/**
+ * @file
+ * @author Maksim Andrianov <maksimandrianov1@yandex.ru>
+ * @brief The cdc_rb_tree is a struct and functions that provide a red-black tree.
+ */
+#ifndef CDCONTAINERS_INCLUDE_CDCONTAINERS_RB_TREE_H
+#define CDCONTAINERS_INCLUDE_CDCONTAINERS_RB_TREE_H
+
+#include <cdcontainers/common.h>
+#include <cdcontainers/status.h>
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup cdc_rb_tree
+ * @brief The cdc_rb_tree is a struct and functions that provide a red-black tree.
+ *
+ * An insertion makes at most two rotations and an erasure at most three, the
+ * other rebalancing steps only recolor nodes.
+ * @{
+ */
+struct cdc_node_pool;
+
+/**
+ * @brief The cdc_rb_tree_node is service struct. parent_color is the pointer to
+ * the parent with the color of the node in the lowest bit, 0 is red and 1 is
+ * black. Nodes are aligned as pointers, so the bit is free.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_rb_tree_node {
+  uintptr_t parent_color;
+  struct cdc_rb_tree_node *left;
+  struct cdc_rb_tree_node *right;
+  void *key;
+  void *value;
+};
+
+/**
+ * @brief The cdc_rb_tree is service struct.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_rb_tree {
+  struct cdc_rb_tree_node *root;
+  size_t size;
+  struct cdc_data_info *dinfo;
+  struct cdc_node_pool *pool;
+};
+
+/**
+ * @brief The cdc_rb_tree_iter is service struct.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_rb_tree_iter {
+  struct cdc_rb_tree *container;
+  struct cdc_rb_tree_node *prev;
+  struct cdc_rb_tree_node *current;
+};
+
+struct cdc_pair_rb_tree_iter {
+  struct cdc_rb_tree_iter first;
+  struct cdc_rb_tree_iter second;
+};
+
+struct cdc_pair_rb_tree_iter_bool {
+  struct cdc_rb_tree_iter first;
+  bool second;
+};
+
+// Base
+/**
+ * @defgroup cdc_rb_tree_base Base
+ * @{
+ */
+/**
+ * @brief Constructs an empty red-black tree.
+ * @param[out] t - cdc_rb_tree
+ * @param[in] info - cdc_data_info
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rb_tree_ctor(struct cdc_rb_tree **t, struct cdc_data_info *info);
+
+/**
+ * @brief Constructs a red-black tree, initialized by an variable number of
+ * pointers on cdc_pair's(first - key, and the second - value).  The last item
+ * must be CDC_END.
+ * @param[out] t - cdc_rb_tree
+ * @param[in] info - cdc_data_info
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ *
+ * Example:
+ * @code{.c}
+ * struct cdc_rb_tree *tree = NULL;
+ * cdc_pair value1 = {CDC_FROM_INT(1), CDC_FROM_INT(2)};
+ * cdc_pair value2 = {CDC_FROM_INT(3), CDC_FROM_INT(4)};
+ * ...
+ * if (cdc_rb_tree_ctorl(&tree, info, &value1, &value2, CDC_END) != CDC_STATUS_OK) {
+ *   // handle error
+ * }
+ * @endcode
+ */
+enum cdc_stat cdc_rb_tree_ctorl(struct cdc_rb_tree **t, struct cdc_data_info *info, ...);
+
+/**
+ * @brief Constructs a red-black tree, initialized by args. The last item must be
+ * CDC_END.
+ * @param[out] t - cdc_rb_tree
+ * @param[in] info - cdc_data_info
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rb_tree_ctorv(struct cdc_rb_tree **t, struct cdc_data_info *info, va_list args);
+
+/**
+ * @brief Constructs a red-black tree from an array of pairs(first - key, and the second -
+ * value) sorted by keys in ascending order without duplicates. The balanced
+ * tree is built in O(n) without comparing the keys, the order is only checked
+ * by an assertion.
+ * @param[out] t - cdc_rb_tree
+ * @param[in] info - cdc_data_info
+ * @param[in] pairs - sorted array of pairs
+ * @param[in] n - number of pairs
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rb_tree_ctor_sorted(struct cdc_rb_tree **t, struct cdc_data_info *info,
+                                      const struct cdc_pair *pairs, size_t n);
+
+/**
+ * @brief Destroys the red-black tree.
+ * @param[in] t - cdc_rb_tree
+ */
+void cdc_rb_tree_dtor(struct cdc_rb_tree *t);
+/** @} */
+
+// Lookup
+/**
+ * @defgroup cdc_rb_tree_lookup Lookup
+ * @{
+ */
+/**
+ * @brief Returns a value that is mapped to a key. If the key does
+ * not exist, then NULL will return.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key of the element to find
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_rb_tree_get(struct cdc_rb_tree *t, void *key, void **value);
+
+/**
+ * @brief Returns the number of elements with key that compares equal to the
+ * specified argument key, which is either 1 or 0 since this container does not
+ * allow duplicates.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key value of the elements to count
+ * @return number of elements with key key, that is either 1 or 0.
+ */
+size_t cdc_rb_tree_count(struct cdc_rb_tree *t, void *key);
+
+/**
+ * @brief Finds an element with key equivalent to key.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key value of the element to search for
+ * @param[out] it - pointer will be recorded iterator to an element with key
+ * equivalent to key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_rb_tree_find(struct cdc_rb_tree *t, void *key, struct cdc_rb_tree_iter *it);
+
+/**
+ * @brief Finds the first element with key that is not less than key.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key value to compare the elements to
+ * @param[out] it - pointer will be recorded iterator to the first element with
+ * key not less than key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_rb_tree_lower_bound(struct cdc_rb_tree *t, void *key, struct cdc_rb_tree_iter *it);
+
+/**
+ * @brief Finds the first element with key that is greater than key.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key value to compare the elements to
+ * @param[out] it - pointer will be recorded iterator to the first element with
+ * key greater than key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_rb_tree_upper_bound(struct cdc_rb_tree *t, void *key, struct cdc_rb_tree_iter *it);
+
+/**
+ * @brief Returns a range containing all elements with key equivalent to key,
+ * which has at most one element since this container does not allow duplicates.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key value to compare the elements to
+ * @param[out] range - pointer will be recorded pair of iterators, the lower
+ * bound and the upper bound of key.
+ */
+void cdc_rb_tree_equal_range(struct cdc_rb_tree *t, void *key, struct cdc_pair_rb_tree_iter *range);
+
+/**
+ * @brief Returns the range of elements with keys in [from, to) in O(log n). The
+ * elements are visited from range->first until the iterator is equal to
+ * range->second.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] from - key value of the beginning of the range
+ * @param[in] to - key value of the end of the range, it must not be less than
+ * from
+ * @param[out] range - pointer will be recorded pair of iterators, the lower
+ * bounds of from and to.
+ */
+void cdc_rb_tree_range(struct cdc_rb_tree *t, void *from, void *to,
+                       struct cdc_pair_rb_tree_iter *range);
+
+/**
+ * @brief The same as cdc_rb_tree_get, but looks up a probe, an object that
+ * is compared with the keys by the callbacks of the info. No key is built, so a
+ * string can be looked up by a cdc_str_view without copying it.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] probe - probe of the element to find
+ * @param[in] info - compare callback of the probe
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_rb_tree_get_probe(struct cdc_rb_tree *t, const void *probe,
+                                     const struct cdc_probe_info *info, void **value);
+
+/**
+ * @brief The same as cdc_rb_tree_count, but looks up a probe.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] probe - probe of the elements to count
+ * @param[in] info - compare callback of the probe
+ * @return number of elements equal to the probe, that is either 1 or 0.
+ */
+size_t cdc_rb_tree_count_probe(struct cdc_rb_tree *t, const void *probe,
+                                const struct cdc_probe_info *info);
+
+/**
+ * @brief The same as cdc_rb_tree_find, but looks up a probe.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] probe - probe of the element to search for
+ * @param[in] info - compare callback of the probe
+ * @param[out] it - pointer will be recorded iterator to an element equal to the
+ * probe. If no such element is found, past-the-end iterator is returned.
+ */
+void cdc_rb_tree_find_probe(struct cdc_rb_tree *t, const void *probe,
+                             const struct cdc_probe_info *info, struct cdc_rb_tree_iter *it);
+/** @} */
+
+// Capacity
+/**
+ * @defgroup cdc_rb_tree_capacity Capacity
+ * @{
+ */
+/**
+ * @brief Returns the number of items in the rb_tree.
+ * @param[in] t - cdc_rb_tree
+ * @return the number of items in the rb_tree.
+ */
+static inline size_t cdc_rb_tree_size(struct cdc_rb_tree *t)
+{
+  assert(t != NULL);
+
+  return t->size;
+}
+
+/**
+ * @brief Checks if the red-black tree has no elements.
+ * @param[in] t - cdc_rb_tree
+ * @return true if the red-black tree is empty, false otherwise.
+ */
+static inline bool cdc_rb_tree_empty(struct cdc_rb_tree *t)
+{
+  assert(t != NULL);
+
+  return t->size == 0;
+}
+
+/**
+ * @brief Returns the memory used by the tree and the node pool. The memory of
+ * the elements is not included.
+ * @param[in] t - cdc_rb_tree
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_rb_tree_memory_usage(struct cdc_rb_tree *t);
+/** @} */
+
+// Modifiers
+/**
+ * @defgroup cdc_rb_tree_modifiers Modifiers
+ * @{
+ */
+/**
+ * @brief Removes all the elements from the rb_tree.
+ * @param[in] t - cdc_rb_tree
+ */
+void cdc_rb_tree_clear(struct cdc_rb_tree *t);
+
+/**
+ * @brief Inserts an element into the container, if the container doesn't already
+ * contain an element with an equivalent key.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] ret - pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion) and a bool denoting whether the
+ * insertion took place. The pointer can be equal to NULL.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rb_tree_insert(struct cdc_rb_tree *t, void *key, void *value,
+                                  struct cdc_pair_rb_tree_iter_bool *ret);
+
+/**
+ * @brief Inserts an element into the container, if the container doesn't already
+ * contain an element with an equivalent key.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] it - iterator to the inserted element (or to the element that
+ * prevented the insertion). The pointer can be equal to NULL.
+ * @param[out] inserted - bool denoting whether the insertion
+ * took place. The pointer can be equal to NULL.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rb_tree_insert1(struct cdc_rb_tree *t, void *key, void *value,
+                                   struct cdc_rb_tree_iter *it, bool *inserted);
+
+/**
+ * @brief Inserts an element or assigns to the current element if the key
+ * already exists.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] ret - pair. The bool component is true if the insertion took place and
+ * false if the assignment took place. The iterator component is pointing at the
+ * element that was inserted or updated.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rb_tree_insert_or_assign(struct cdc_rb_tree *t, void *key, void *value,
+                                            struct cdc_pair_rb_tree_iter_bool *ret);
+
+/**
+ * @brief Inserts an element or assigns to the current element if the key
+ * already exists.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] it - iterator is pointing at the element that was inserted or updated.
+ * The pointer can be equal to NULL
+ * @param[out] inserted - bool is true if the insertion took place and false if the
+ * assignment took place. The pointer can be equal to NULL
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rb_tree_insert_or_assign1(struct cdc_rb_tree *t, void *key, void *value,
+                                             struct cdc_rb_tree_iter *it, bool *inserted);
+
+/**
+ * @brief Removes the element (if one exists) with the key equivalent to key.
+ * @param[in] t - cdc_rb_tree
+ * @param[in] key - key value of the elements to remove
+ * @return number of elements removed.
+ */
+size_t cdc_rb_tree_erase(struct cdc_rb_tree *t, void *key);
+
+/**
+ * @brief Swaps rb_trees a and b. This operation is very fast and never fails.
+ * @param[in, out] a - cdc_rb_tree
+ * @param[in, out] b - cdc_rb_tree
+ */
+void cdc_rb_tree_swap(struct cdc_rb_tree *a, struct cdc_rb_tree *b);
+/** @} */
+
+// Iterators
+/**
+ * @defgroup cdc_rb_tree_iterators Iterators
+ * @{
+ */
+/**
+ * @brief Initializes the iterator to the beginning.
+ * @param[in] t - cdc_rb_tree
+ * @param[out] it - cdc_rb_tree_iter
+ */
+void cdc_rb_tree_begin(struct cdc_rb_tree *t, struct cdc_rb_tree_iter *it);
+
+/**
+ * @brief Initializes the iterator to the end.
+ * @param[in] t - cdc_rb_tree
+ * @param[out] it - cdc_rb_tree_iter
+ */
+void cdc_rb_tree_end(struct cdc_rb_tree *t, struct cdc_rb_tree_iter *it);
+/** @} */
+
+// Iterators
+/**
+ * @defgroup cdc_rb_tree_iter
+ * @brief The cdc_rb_tree_iter is a struct and functions that provide a red-black tree
+ * iterator.
+ * @{
+ */
+/**
+ * @brief Advances the iterator to the next element in the red-black tree.
+ * @param[in] it - iterator
+ */
+void cdc_rb_tree_iter_next(struct cdc_rb_tree_iter *it);
+
+/**
+ * @brief Advances the iterator to the previous element in the red-black tree.
+ * @param[in] it - iterator
+ */
+void cdc_rb_tree_iter_prev(struct cdc_rb_tree_iter *it);
+
+/**
+ * @brief Returns true if there is at least one element ahead of the iterator, i.e.
+ * the iterator is not at the back of the container; otherwise returns false.
+ * @param[in] it - iterator
+ * @return true if there is at least one element ahead of the iterator, i.e.
+ * the iterator is not at the back of the container; otherwise returns false.
+ */
+static inline bool cdc_rb_tree_iter_has_next(struct cdc_rb_tree_iter *it)
+{
+  assert(it != NULL);
+
+  return it->current != NULL;
+}
+
+/**
+ * @brief Returns true if there is at least one element behind the iterator, i.e.
+ * the iterator is not at the front of the container; otherwise returns false.
+ * @param[in] it - iterator
+ * @return true if there is at least one element behind the iterator, i.e.
+ * the iterator is not at the front of the container; otherwise returns false.
+ */
+static inline bool cdc_rb_tree_iter_has_prev(struct cdc_rb_tree_iter *it)
+{
+  assert(it != NULL);
+
+  return it->prev != NULL;
+}
+
+/**
+ * @brief Returns an item's key.
+ * @param[in] it - iterator
+ * @return the item's key.
+ */
+static inline void *cdc_rb_tree_iter_key(struct cdc_rb_tree_iter *it)
+{
+  assert(it != NULL);
+
+  return it->current->key;
+}
+
+/**
+ * @brief Returns an item's value.
+ * @param[in] it - iterator
+ * @return the item's value.
+ */
+static inline void *cdc_rb_tree_iter_value(struct cdc_rb_tree_iter *it)
+{
+  assert(it != NULL);
+
+  return it->current->value;
+}
+
+/**
+ * @brief Returns a pair, where first - key, second - value.
+ * @param[in] it - iterator
+ * @return pair, where first - key, second - value.
+ */
+static inline struct cdc_pair cdc_rb_tree_iter_key_value(struct cdc_rb_tree_iter *it)
+{
+  assert(it != NULL);
+
+  struct cdc_pair pair = {it->prev->key, it->prev->value};
+  return pair;
+}
+
+/**
+ * @brief Returns false if the iterator |it1| equal to the iterator |it2|,
+ * otherwise returns false.
+ * @param[in] it1 - iterator
+ * @param[in] it2 - iterator
+ * @return false if the iterator |it1| equal to the iterator |it2|,
+ * otherwise returns false.
+ */
+static inline bool cdc_rb_tree_iter_is_eq(struct cdc_rb_tree_iter *it1,
+                                           struct cdc_rb_tree_iter *it2)
+{
+  assert(it1 != NULL);
+  assert(it2 != NULL);
+
+  return it1->container == it2->container && it1->prev == it2->prev && it1->current == it2->current;
+}
+/** @} */
+
+// Short names
+#ifdef CDC_USE_SHORT_NAMES
+typedef struct cdc_rb_tree_node rb_tree_node_t;
+typedef struct cdc_rb_tree rb_tree_t;
+typedef struct cdc_rb_tree_iter rb_tree_iter_t;
+typedef struct cdc_pair_rb_tree_iter pair_rb_tree_iter_t;
+typedef struct cdc_pair_rb_tree_iter_bool pair_rb_tree_iter_bool_t;
+
+// Base
+#define rb_tree_ctor(...) cdc_rb_tree_ctor(__VA_ARGS__)
+#define rb_tree_ctorv(...) cdc_rb_tree_ctorv(__VA_ARGS__)
+#define rb_tree_ctorl(...) cdc_rb_tree_ctorl(__VA_ARGS__)
+#define rb_tree_ctor_sorted(...) cdc_rb_tree_ctor_sorted(__VA_ARGS__)
+#define rb_tree_dtor(...) cdc_rb_tree_dtor(__VA_ARGS__)
+
+// Lookup
+#define rb_tree_get(...) cdc_rb_tree_get(__VA_ARGS__)
+#define rb_tree_count(...) cdc_rb_tree_count(__VA_ARGS__)
+#define rb_tree_find(...) cdc_rb_tree_find(__VA_ARGS__)
+#define rb_tree_lower_bound(...) cdc_rb_tree_lower_bound(__VA_ARGS__)
+#define rb_tree_upper_bound(...) cdc_rb_tree_upper_bound(__VA_ARGS__)
+#define rb_tree_equal_range(...) cdc_rb_tree_equal_range(__VA_ARGS__)
+#define rb_tree_range(...) cdc_rb_tree_range(__VA_ARGS__)
+#define rb_tree_get_probe(...) cdc_rb_tree_get_probe(__VA_ARGS__)
+#define rb_tree_count_probe(...) cdc_rb_tree_count_probe(__VA_ARGS__)
+#define rb_tree_find_probe(...) cdc_rb_tree_find_probe(__VA_ARGS__)
+
+// Capacity
+#define rb_tree_size(...) cdc_rb_tree_size(__VA_ARGS__)
+#define rb_tree_empty(...) cdc_rb_tree_empty(__VA_ARGS__)
+#define rb_tree_memory_usage(...) cdc_rb_tree_memory_usage(__VA_ARGS__)
+
+// Modifiers
+#define rb_tree_clear(...) cdc_rb_tree_clear(__VA_ARGS__)
+#define rb_tree_insert(...) cdc_rb_tree_insert(__VA_ARGS__)
+#define rb_tree_insert1(...) cdc_rb_tree_insert1(__VA_ARGS__)
+#define rb_tree_insert_or_assign(...) cdc_rb_tree_insert_or_assign(__VA_ARGS__)
+#define rb_tree_insert_or_assign1(...) cdc_rb_tree_insert_or_assign1(__VA_ARGS__)
+#define rb_tree_erase(...) cdc_rb_tree_erase(__VA_ARGS__)
+#define rb_tree_swap(...) cdc_rb_tree_swap(__VA_ARGS__)
+
+// Iterators
+#define rb_tree_begin(...) cdc_rb_tree_begin(__VA_ARGS__)
+#define rb_tree_end(...) cdc_rb_tree_end(__VA_ARGS__)
+
+// Iterators
+#define rb_tree_iter_next(...) cdc_rb_tree_iter_next(__VA_ARGS__)
+#define rb_tree_iter_has_next(...) cdc_rb_tree_iter_has_next(__VA_ARGS__)
+#define rb_tree_iter_has_prev(...) cdc_rb_tree_iter_has_prev(__VA_ARGS__)
+#define rb_tree_iter_prev(...) cdc_rb_tree_iter_prev(__VA_ARGS__)
+#define rb_tree_iter_key(...) cdc_rb_tree_iter_key(__VA_ARGS__)
+#define rb_tree_iter_value(...) cdc_rb_tree_iter_value(__VA_ARGS__)
+#define rb_tree_iter_key_value(...) cdc_rb_tree_iter_key_value(__VA_ARGS__)
+#define rb_tree_iter_is_eq(...) cdc_rb_tree_iter_is_eq(__VA_ARGS__)
+#endif
+/** @} */
+#endif  // CDCONTAINERS_INCLUDE_CDCONTAINERS_RB_TREE_H
@@ -0,0 +1,359 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+/**
+ * @file
+ * @author Maksim Andrianov <maksimandrianov1@yandex.ru>
+ * @brief The cdc_rcu_hash_table is a struct and functions that provide a hash
+ * table with lock-free lookups.
+ */
+#ifndef CDCONTAINERS_INCLUDE_CDCONTAINERS_RCU_HASH_TABLE_H
+#define CDCONTAINERS_INCLUDE_CDCONTAINERS_RCU_HASH_TABLE_H
+
+#include <cdcontainers/common.h>
+#include <cdcontainers/global.h>
+#include <cdcontainers/hash.h>
+#include <cdcontainers/status.h>
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * @defgroup cdc_rcu_hash_table
+ * @brief The cdc_rcu_hash_table is a struct and functions that provide a hash
+ * table for read-mostly workloads.
+ *
+ * Lookups take no locks and write only to the cdc_rcu_reader of the calling
+ * thread. Writers are serialized by a mutex and never change an entry that
+ * readers can see: an entry is replaced by a new copy or unlinked, and the old
+ * one is retired. A retired entry is freed only after every reader that could
+ * see it has left its read-side critical section (epoch based reclamation).
+ *
+ * Every thread that looks up keys creates a cdc_rcu_reader and makes lookups
+ * between cdc_rcu_reader_lock and cdc_rcu_reader_unlock. Keys and values
+ * returned by lookups can be used until cdc_rcu_reader_unlock.
+ * @{
+ */
+/**
+ * @brief The cdc_rcu_hash_table_entry struct
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_rcu_hash_table_entry {
+  struct cdc_rcu_hash_table_entry *next;
+  void *key;
+  void *value;
+  size_t hash;
+  // Fields used after the entry is retired.
+  struct cdc_rcu_hash_table_entry *retired_next;
+  size_t retired_epoch;
+  bool free_data;
+};
+
+/**
+ * @brief The cdc_rcu_hash_table_buckets struct
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_rcu_hash_table_buckets {
+  size_t count;
+  struct cdc_rcu_hash_table_buckets *retired_next;
+  size_t retired_epoch;
+  struct cdc_rcu_hash_table_entry *buckets[];
+};
+
+struct cdc_rcu_hash_table;
+
+/**
+ * @brief The cdc_rcu_reader is a read-side handle of one thread. It occupies
+ * whole cache lines, so readers of different threads do not share them.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_rcu_reader {
+  // Epoch at the start of the current critical section or 0 outside of it.
+  size_t epoch;
+  struct cdc_rcu_hash_table *table;
+  struct cdc_rcu_reader *next;
+  char pad[CDC_CACHE_LINE_SIZE - 3 * sizeof(void *)];
+};
+
+/**
+ * @brief The cdc_rcu_hash_table is service struct.
+ * @warning To avoid problems, do not change the structure fields in the code.
+ * Use only special functions to access and change structure fields.
+ */
+struct cdc_rcu_hash_table {
+  struct cdc_rcu_hash_table_buckets *buckets;
+  size_t epoch;
+  size_t size;
+  double load_factor;
+  pthread_mutex_t mutex;
+  struct cdc_rcu_reader *readers;
+  struct cdc_rcu_hash_table_entry *retired_entries;
+  struct cdc_rcu_hash_table_buckets *retired_buckets;
+  size_t retired_count;
+  struct cdc_data_info *dinfo;
+};
+
+// Base
+/**
+ * @defgroup cdc_rcu_hash_table_base Base
+ * @{
+ */
+/**
+ * @brief Constructs an empty rcu hash table.
+ * @param[out] t - cdc_rcu_hash_table
+ * @param[in] info - cdc_data_info
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rcu_hash_table_ctor(struct cdc_rcu_hash_table **t, struct cdc_data_info *info);
+
+/**
+ * @brief Constructs an empty rcu hash table.
+ * @param[out] t - cdc_rcu_hash_table
+ * @param[in] info - cdc_data_info
+ * @param[in] load_factor - maximum load factor
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rcu_hash_table_ctor1(struct cdc_rcu_hash_table **t, struct cdc_data_info *info,
+                                       double load_factor);
+
+/**
+ * @brief Destroys the rcu hash table. All readers must be destroyed before.
+ * @param[in] t - cdc_rcu_hash_table
+ */
+void cdc_rcu_hash_table_dtor(struct cdc_rcu_hash_table *t);
+/** @} */
+
+// Readers
+/**
+ * @defgroup cdc_rcu_hash_table_readers Readers
+ * @{
+ */
+/**
+ * @brief Creates a reader of the rcu hash table. A reader must be used by one
+ * thread at a time.
+ * @param[in] t - cdc_rcu_hash_table
+ * @param[out] r - cdc_rcu_reader
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rcu_reader_ctor(struct cdc_rcu_hash_table *t, struct cdc_rcu_reader **r);
+
+/**
+ * @brief Destroys the reader. It must not be in a critical section.
+ * @param[in] r - cdc_rcu_reader
+ */
+void cdc_rcu_reader_dtor(struct cdc_rcu_reader *r);
+
+/**
+ * @brief Enters a read-side critical section. Critical sections can not be
+ * nested. Entries that are seen in the section are not freed until
+ * cdc_rcu_reader_unlock, so sections should be short.
+ * @param[in] r - cdc_rcu_reader
+ */
+static inline void cdc_rcu_reader_lock(struct cdc_rcu_reader *r)
+{
+  assert(r != NULL);
+  assert(r->epoch == 0);
+
+  __atomic_store_n(&r->epoch, __atomic_load_n(&r->table->epoch, __ATOMIC_ACQUIRE),
+                   __ATOMIC_SEQ_CST);
+  // The epoch must be visible to writers before any entry is loaded.
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Leaves a read-side critical section.
+ * @param[in] r - cdc_rcu_reader
+ */
+static inline void cdc_rcu_reader_unlock(struct cdc_rcu_reader *r)
+{
+  assert(r != NULL);
+  assert(r->epoch != 0);
+
+  __atomic_store_n(&r->epoch, 0, __ATOMIC_RELEASE);
+}
+/** @} */
+
+// Lookup
+/**
+ * @defgroup cdc_rcu_hash_table_lookup Lookup
+ * @{
+ */
+/**
+ * @brief Returns a value that is mapped to a key. It must be called in a
+ * read-side critical section.
+ * @param[in] t - cdc_rcu_hash_table
+ * @param[in] key - key of the element to find
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_rcu_hash_table_get(struct cdc_rcu_hash_table *t, void *key, void **value);
+
+/**
+ * @brief Returns the number of elements with key that compares equal to the
+ * specified argument key, which is either 1 or 0 since this container does not
+ * allow duplicates. It must be called in a read-side critical section.
+ * @param[in] t - cdc_rcu_hash_table
+ * @param[in] key - key value of the elements to count
+ * @return number of elements with key key, that is either 1 or 0.
+ */
+size_t cdc_rcu_hash_table_count(struct cdc_rcu_hash_table *t, void *key);
+/** @} */
+
+// Capacity
+/**
+ * @defgroup cdc_rcu_hash_table_capacity Capacity
+ * @{
+ */
+/**
+ * @brief Returns the number of items in the rcu hash table.
+ * @param[in] t - cdc_rcu_hash_table
+ * @return the number of items in the rcu hash table.
+ */
+static inline size_t cdc_rcu_hash_table_size(struct cdc_rcu_hash_table *t)
+{
+  assert(t != NULL);
+
+  return __atomic_load_n(&t->size, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Checks if the rcu hash table has no elements.
+ * @param[in] t - cdc_rcu_hash_table
+ * @return true if the rcu hash table is empty, false otherwise.
+ */
+static inline bool cdc_rcu_hash_table_empty(struct cdc_rcu_hash_table *t)
+{
+  assert(t != NULL);
+
+  return cdc_rcu_hash_table_size(t) == 0;
+}
+
+/**
+ * @brief Returns the number of retired entries that are not freed yet,
+ * because readers could still see them.
+ * @param[in] t - cdc_rcu_hash_table
+ * @return the number of retired entries.
+ */
+size_t cdc_rcu_hash_table_retired_count(struct cdc_rcu_hash_table *t);
+/** @} */
+
+// Modifiers
+/**
+ * @defgroup cdc_rcu_hash_table_modifiers Modifiers
+ * @{
+ */
+/**
+ * @brief Removes all the elements from the rcu hash table.
+ * @param[in] t - cdc_rcu_hash_table
+ */
+void cdc_rcu_hash_table_clear(struct cdc_rcu_hash_table *t);
+
+/**
+ * @brief Inserts an element into the container, if the container doesn't
+ * already contain an element with an equivalent key.
+ * @param[in] t - cdc_rcu_hash_table
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] inserted - true if the insertion took place. The pointer can be
+ * equal to NULL.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rcu_hash_table_insert(struct cdc_rcu_hash_table *t, void *key, void *value,
+                                        bool *inserted);
+
+/**
+ * @brief Inserts an element or assigns to the current element if the key
+ * already exists. An assignment replaces the entry by a copy, readers that
+ * have found the old entry keep seeing the old value.
+ * @param[in] t - cdc_rcu_hash_table
+ * @param[in] key - key of the element
+ * @param[in] value - value of the element
+ * @param[out] inserted - true if the insertion took place and false if the
+ * assignment took place. The pointer can be equal to NULL.
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_rcu_hash_table_insert_or_assign(struct cdc_rcu_hash_table *t, void *key,
+                                                  void *value, bool *inserted);
+
+/**
+ * @brief Removes the element (if one exists) with the key equivalent to key.
+ * The data of the element is freed by dfree of cdc_data_info when no reader
+ * can see it.
+ * @param[in] t - cdc_rcu_hash_table
+ * @param[in] key - key value of the elements to remove
+ * @return number of elements removed.
+ */
+size_t cdc_rcu_hash_table_erase(struct cdc_rcu_hash_table *t, void *key);
+
+/**
+ * @brief Frees the retired entries that no reader can see. It is called by
+ * every modification, so it is needed only to release memory after the last
+ * one.
+ * @param[in] t - cdc_rcu_hash_table
+ */
+void cdc_rcu_hash_table_reclaim(struct cdc_rcu_hash_table *t);
+/** @} */
+
+// Short names
+#ifdef CDC_USE_SHORT_NAMES
+typedef struct cdc_rcu_hash_table_entry rcu_hash_table_entry_t;
+typedef struct cdc_rcu_hash_table_buckets rcu_hash_table_buckets_t;
+typedef struct cdc_rcu_hash_table rcu_hash_table_t;
+typedef struct cdc_rcu_reader rcu_reader_t;
+
+// Base
+#define rcu_hash_table_ctor(...) cdc_rcu_hash_table_ctor(__VA_ARGS__)
+#define rcu_hash_table_ctor1(...) cdc_rcu_hash_table_ctor1(__VA_ARGS__)
+#define rcu_hash_table_dtor(...) cdc_rcu_hash_table_dtor(__VA_ARGS__)
+
+// Readers
+#define rcu_reader_ctor(...) cdc_rcu_reader_ctor(__VA_ARGS__)
+#define rcu_reader_dtor(...) cdc_rcu_reader_dtor(__VA_ARGS__)
+#define rcu_reader_lock(...) cdc_rcu_reader_lock(__VA_ARGS__)
+#define rcu_reader_unlock(...) cdc_rcu_reader_unlock(__VA_ARGS__)
+
+// Lookup
+#define rcu_hash_table_get(...) cdc_rcu_hash_table_get(__VA_ARGS__)
+#define rcu_hash_table_count(...) cdc_rcu_hash_table_count(__VA_ARGS__)
+
+// Capacity
+#define rcu_hash_table_size(...) cdc_rcu_hash_table_size(__VA_ARGS__)
+#define rcu_hash_table_empty(...) cdc_rcu_hash_table_empty(__VA_ARGS__)
+#define rcu_hash_table_retired_count(...) cdc_rcu_hash_table_retired_count(__VA_ARGS__)
+
+// Modifiers
+#define rcu_hash_table_clear(...) cdc_rcu_hash_table_clear(__VA_ARGS__)
+#define rcu_hash_table_insert(...) cdc_rcu_hash_table_insert(__VA_ARGS__)
+#define rcu_hash_table_insert_or_assign(...) cdc_rcu_hash_table_insert_or_assign(__VA_ARGS__)
+#define rcu_hash_table_erase(...) cdc_rcu_hash_table_erase(__VA_ARGS__)
+#define rcu_hash_table_reclaim(...) cdc_rcu_hash_table_reclaim(__VA_ARGS__)
+#endif
+/** @} */
+#endif  // CDCONTAINERS_INCLUDE_CDCONTAINERS_RCU_HASH_TABLE_H
@@ -39,8 +39,10 @@
  * Use only special functions to access and change structure fields.
  */
 struct cdc_map_iter_table {
-  void *(*ctor)();
-  void (*dtor)(void *it);
+  // The iterator is allocated with the allocator of the map, which is NULL for
+  // the standard functions.
+  void *(*ctor)(const struct cdc_allocator *allocator);
+  void (*dtor)(void *it, const struct cdc_allocator *allocator);
   enum cdc_iterator_type (*type)();
   void (*next)(void *it);
   void (*prev)(void *it);
@@ -60,12 +62,30 @@ struct cdc_map_iter_table {
 struct cdc_map_table {
   enum cdc_stat (*ctor)(void **cntr, struct cdc_data_info *info);
   enum cdc_stat (*ctorv)(void **cntr, struct cdc_data_info *info, va_list args);
+  // Can be NULL, then cdc_map_ctor_sorted inserts the pairs one by one.
+  enum cdc_stat (*ctor_sorted)(void **cntr, struct cdc_data_info *info,
+                               const struct cdc_pair *pairs, size_t n);
   void (*dtor)(void *cntr);
   enum cdc_stat (*get)(void *cntr, void *key, void **value);
+  size_t (*get_many)(void *cntr, void **keys, size_t n, void **values, bool *found);
   size_t (*count)(void *cntr, void *key);
   void (*find)(void *cntr, void *key, void *it);
+  // Can be NULL for unordered containers, then cdc_map_lower_bound and
+  // cdc_map_upper_bound return CDC_STATUS_NOT_SUPPORTED.
+  void (*lower_bound)(void *cntr, void *key, void *it);
+  void (*upper_bound)(void *cntr, void *key, void *it);
+  // Can be NULL, then cdc_map_select and cdc_map_rank return
+  // CDC_STATUS_NOT_SUPPORTED. The avl tree and the treap tables set them if the
+  // library is built with the CDC_ORDER_STATISTICS option.
+  void (*select)(void *cntr, size_t k, void *it);
+  size_t (*rank)(void *cntr, void *key);
+  enum cdc_stat (*get_probe)(void *cntr, const void *probe, const struct cdc_probe_info *info,
+                             void **value);
+  size_t (*count_probe)(void *cntr, const void *probe, const struct cdc_probe_info *info);
+  void (*find_probe)(void *cntr, const void *probe, const struct cdc_probe_info *info, void *it);
   size_t (*size)(void *cntr);
   bool (*empty)(void *cntr);
+  struct cdc_memory_usage (*memory_usage)(void *cntr);
   void (*clear)(void *cntr);
   enum cdc_stat (*insert)(void *cntr, void *key, void *value, void *it, bool *inserted);
   enum cdc_stat (*insert_or_assign)(void *cntr, void *key, void *value, void *it, bool *inserted);
@@ -79,7 +99,11 @@ struct cdc_map_table {
 extern const struct cdc_map_table *cdc_map_avl;
 extern const struct cdc_map_table *cdc_map_splay;
 extern const struct cdc_map_table *cdc_map_treap;
+extern const struct cdc_map_table *cdc_map_btree;
+extern const struct cdc_map_table *cdc_map_rbtree;
 extern const struct cdc_map_table *cdc_map_htable;
+extern const struct cdc_map_table *cdc_map_flat_htable;
+extern const struct cdc_map_table *cdc_map_robin_hood_htable;
 
 // Short names
 #ifdef CDC_USE_SHORT_NAMES
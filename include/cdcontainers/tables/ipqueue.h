@@ -44,6 +44,7 @@ struct cdc_priority_queue_table {
   void (*dtor)(void *cntr);
   void *(*top)(void *cntr);
   bool (*empty)(void *cntr);
+  struct cdc_memory_usage (*memory_usage)(void *cntr);
   size_t (*size)(void *cntr);
   enum cdc_stat (*push)(void *cntr, void *elem);
   void (*pop)(void *cntr);
@@ -45,6 +45,7 @@ struct cdc_sequence_table {
   void *(*front)(void *cntr);
   void *(*back)(void *cntr);
   bool (*empty)(void *cntr);
+  struct cdc_memory_usage (*memory_usage)(void *cntr);
   size_t (*size)(void *cntr);
   enum cdc_stat (*push_back)(void *cntr, void *elem);
   void (*pop_back)(void *cntr);
@@ -41,6 +41,8 @@
 
 typedef int (*cdc_priority_fn_t)(void *);
 
+struct cdc_node_pool;
+
 /**
  * @brief The cdc_treap_node is service struct.
  * @warning To avoid problems, do not change the structure fields in the code.
@@ -53,6 +55,9 @@ struct cdc_treap_node {
   void *key;
   void *value;
   int priority;
+#ifdef CDC_ORDER_STATISTICS
+  size_t size;
+#endif
 };
 
 /**
@@ -65,6 +70,7 @@ struct cdc_treap {
   size_t size;
   cdc_priority_fn_t prior;
   struct cdc_data_info *dinfo;
+  struct cdc_node_pool *pool;
 };
 
 /**
@@ -78,6 +84,11 @@ struct cdc_treap_iter {
   struct cdc_treap_node *current;
 };
 
+struct cdc_pair_treap_iter {
+  struct cdc_treap_iter first;
+  struct cdc_treap_iter second;
+};
+
 struct cdc_pair_treap_iter_bool {
   struct cdc_treap_iter first;
   bool second;
@@ -129,6 +140,21 @@ enum cdc_stat cdc_treap_ctorl(struct cdc_treap **t, struct cdc_data_info *info,
  */
 enum cdc_stat cdc_treap_ctorv(struct cdc_treap **t, struct cdc_data_info *info, va_list args);
 
+/**
+ * @brief Constructs a treap from an array of pairs(first - key, and the second -
+ * value) sorted by keys in ascending order without duplicates. The treap of the
+ * keys and their priorities is built in O(n) without comparing the keys, the
+ * order is only checked by an assertion.
+ * @param[out] t - cdc_treap
+ * @param[in] info - cdc_data_info
+ * @param[in] pairs - sorted array of pairs
+ * @param[in] n - number of pairs
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_treap_ctor_sorted(struct cdc_treap **t, struct cdc_data_info *info,
+                                    const struct cdc_pair *pairs, size_t n);
+
 /**
  * @brief Constructs an empty treap.
  * @param[out] t - cdc_treap
@@ -165,6 +191,21 @@ enum cdc_stat cdc_treap_ctorl1(struct cdc_treap **t, struct cdc_data_info *info,
 enum cdc_stat cdc_treap_ctorv1(struct cdc_treap **t, struct cdc_data_info *info,
                                cdc_priority_fn_t prior, va_list args);
 
+/**
+ * @brief Constructs a treap from an array of pairs sorted by keys in ascending
+ * order without duplicates. See cdc_treap_ctor_sorted.
+ * @param[out] t - cdc_treap
+ * @param[in] info - cdc_data_info
+ * @param[in] prior - function that generates a priority
+ * @param[in] pairs - sorted array of pairs
+ * @param[in] n - number of pairs
+ * @return CDC_STATUS_OK in a successful case or other value indicating
+ * an error.
+ */
+enum cdc_stat cdc_treap_ctor_sorted1(struct cdc_treap **t, struct cdc_data_info *info,
+                                     cdc_priority_fn_t prior, const struct cdc_pair *pairs,
+                                     size_t n);
+
 /**
  * @brief Destroys the treap.
  * @param[in] t - cdc_treap
@@ -206,6 +247,107 @@ size_t cdc_treap_count(struct cdc_treap *t, void *key);
  * returned.
  */
 void cdc_treap_find(struct cdc_treap *t, void *key, struct cdc_treap_iter *it);
+
+/**
+ * @brief Finds the first element with key that is not less than key.
+ * @param[in] t - cdc_treap
+ * @param[in] key - key value to compare the elements to
+ * @param[out] it - pointer will be recorded iterator to the first element with
+ * key not less than key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_treap_lower_bound(struct cdc_treap *t, void *key, struct cdc_treap_iter *it);
+
+/**
+ * @brief Finds the first element with key that is greater than key.
+ * @param[in] t - cdc_treap
+ * @param[in] key - key value to compare the elements to
+ * @param[out] it - pointer will be recorded iterator to the first element with
+ * key greater than key. If no such element is found, past-the-end iterator is
+ * returned.
+ */
+void cdc_treap_upper_bound(struct cdc_treap *t, void *key, struct cdc_treap_iter *it);
+
+/**
+ * @brief Returns a range containing all elements with key equivalent to key,
+ * which has at most one element since this container does not allow duplicates.
+ * @param[in] t - cdc_treap
+ * @param[in] key - key value to compare the elements to
+ * @param[out] range - pointer will be recorded pair of iterators, the lower
+ * bound and the upper bound of key.
+ */
+void cdc_treap_equal_range(struct cdc_treap *t, void *key, struct cdc_pair_treap_iter *range);
+
+/**
+ * @brief Returns the range of elements with keys in [from, to) in O(log n). The
+ * elements are visited from range->first until the iterator is equal to
+ * range->second.
+ * @param[in] t - cdc_treap
+ * @param[in] from - key value of the beginning of the range
+ * @param[in] to - key value of the end of the range, it must not be less than
+ * from
+ * @param[out] range - pointer will be recorded pair of iterators, the lower
+ * bounds of from and to.
+ */
+void cdc_treap_range(struct cdc_treap *t, void *from, void *to, struct cdc_pair_treap_iter *range);
+
+#ifdef CDC_ORDER_STATISTICS
+/**
+ * @brief Finds the element with index k in the order of the keys, the index of
+ * the first element is 0. Takes O(log n) using the subtree sizes that are kept
+ * if the library is built with the CDC_ORDER_STATISTICS option.
+ * @param[in] t - cdc_treap
+ * @param[in] k - index of the element
+ * @param[out] it - pointer will be recorded iterator to the element with index
+ * k. If k is not less than the size of the treap, past-the-end iterator is
+ * returned.
+ */
+void cdc_treap_select(struct cdc_treap *t, size_t k, struct cdc_treap_iter *it);
+
+/**
+ * @brief Returns the number of elements with keys less than key, that is the
+ * index of key if it is in the treap. Takes O(log n) using the subtree sizes
+ * that are kept if the library is built with the CDC_ORDER_STATISTICS option.
+ * @param[in] t - cdc_treap
+ * @param[in] key - key value to compare the elements to
+ * @return number of elements with keys less than key.
+ */
+size_t cdc_treap_rank(struct cdc_treap *t, void *key);
+#endif
+
+/**
+ * @brief The same as cdc_treap_get, but looks up a probe, an object that
+ * is compared with the keys by the callbacks of the info. No key is built, so a
+ * string can be looked up by a cdc_str_view without copying it.
+ * @param[in] t - cdc_treap
+ * @param[in] probe - probe of the element to find
+ * @param[in] info - compare callback of the probe
+ * @param[out] value - pinter to the value that is mapped to a key.
+ * @return CDC_STATUS_OK if the key is found, CDC_STATUS_NOT_FOUND otherwise.
+ */
+enum cdc_stat cdc_treap_get_probe(struct cdc_treap *t, const void *probe,
+                                  const struct cdc_probe_info *info, void **value);
+
+/**
+ * @brief The same as cdc_treap_count, but looks up a probe.
+ * @param[in] t - cdc_treap
+ * @param[in] probe - probe of the elements to count
+ * @param[in] info - compare callback of the probe
+ * @return number of elements equal to the probe, that is either 1 or 0.
+ */
+size_t cdc_treap_count_probe(struct cdc_treap *t, const void *probe,
+                             const struct cdc_probe_info *info);
+
+/**
+ * @brief The same as cdc_treap_find, but looks up a probe.
+ * @param[in] t - cdc_treap
+ * @param[in] probe - probe of the element to search for
+ * @param[in] info - compare callback of the probe
+ * @param[out] it - pointer will be recorded iterator to an element equal to the
+ * probe. If no such element is found, past-the-end iterator is returned.
+ */
+void cdc_treap_find_probe(struct cdc_treap *t, const void *probe,
+                          const struct cdc_probe_info *info, struct cdc_treap_iter *it);
 /** @} */
 
 // Capacity
@@ -236,6 +378,14 @@ static inline bool cdc_treap_empty(struct cdc_treap *t)
 
   return t->size == 0;
 }
+
+/**
+ * @brief Returns the memory used by the treap and the node pool. The memory of
+ * the elements is not included.
+ * @param[in] t - cdc_treap
+ * @return memory usage
+ */
+struct cdc_memory_usage cdc_treap_memory_usage(struct cdc_treap *t);
 /** @} */
 
 // Modifiers
@@ -462,16 +612,28 @@ typedef struct cdc_pair_treap_iter_bool pair_treap_iter_bool_t;
 #define treap_ctor1(...) cdc_treap_ctor1(__VA_ARGS__)
 #define treap_ctorv1(...) cdc_treap_ctorv1(__VA_ARGS__)
 #define treap_ctorl1(...) cdc_treap_ctorl1(__VA_ARGS__)
+#define treap_ctor_sorted(...) cdc_treap_ctor_sorted(__VA_ARGS__)
+#define treap_ctor_sorted1(...) cdc_treap_ctor_sorted1(__VA_ARGS__)
 #define treap_dtor(...) cdc_treap_dtor(__VA_ARGS__)
 
 // Lookup
 #define treap_get(...) cdc_treap_get(__VA_ARGS__)
 #define treap_count(...) cdc_treap_count(__VA_ARGS__)
 #define treap_find(...) cdc_treap_find(__VA_ARGS__)
+#define treap_lower_bound(...) cdc_treap_lower_bound(__VA_ARGS__)
+#define treap_upper_bound(...) cdc_treap_upper_bound(__VA_ARGS__)
+#define treap_equal_range(...) cdc_treap_equal_range(__VA_ARGS__)
+#define treap_range(...) cdc_treap_range(__VA_ARGS__)
+#define treap_select(...) cdc_treap_select(__VA_ARGS__)
+#define treap_rank(...) cdc_treap_rank(__VA_ARGS__)
+#define treap_get_probe(...) cdc_treap_get_probe(__VA_ARGS__)
+#define treap_count_probe(...) cdc_treap_count_probe(__VA_ARGS__)
+#define treap_find_probe(...) cdc_treap_find_probe(__VA_ARGS__)
 
 // Capacity
 #define treap_size(...) cdc_treap_size(__VA_ARGS__)
 #define treap_empty(...) cdc_treap_empty(__VA_ARGS__)
+#define treap_memory_usage(...) cdc_treap_memory_usage(__VA_ARGS__)
 
 // Modifiers
 #define treap_clear(...) cdc_treap_clear(__VA_ARGS__)
@@ -23,8 +23,23 @@
 
 #include <cdcontainers/data-info.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 
+// Returns true if the keys of the pairs are strictly increasing. Used to check
+// the input of the constructors from sorted arrays.
+static inline bool cdc_is_sorted_unique(const struct cdc_pair *pairs, size_t n,
+                                        cdc_binary_pred_fn_t cmp)
+{
+  for (size_t i = 1; i < n; ++i) {
+    if (!cmp(pairs[i - 1].first, pairs[i].first)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 #define CDC_MAKE_FIND_NODE_FN(T)                                           \
   static T cdc_find_tree_node(T node, void *key, cdc_binary_pred_fn_t cmp) \
   {                                                                        \
@@ -38,6 +53,83 @@
     return node;                                                           \
   }
 
+#define CDC_MAKE_FIND_NODE_BY_PROBE_FN(T)                                 \
+  static T cdc_find_tree_node_by_probe(T node, const void *probe,         \
+                                       const struct cdc_probe_info *info) \
+  {                                                                       \
+    while (node != NULL) {                                                \
+      int ret = info->compare(probe, node->key);                          \
+      if (ret == 0) {                                                     \
+        break;                                                            \
+      }                                                                   \
+      node = ret < 0 ? node->left : node->right;                          \
+    }                                                                     \
+    return node;                                                          \
+  }
+
+#define CDC_MAKE_LOWER_BOUND_FN(T)                                                \
+  static T cdc_lower_bound_tree_node(T node, void *key, cdc_binary_pred_fn_t cmp) \
+  {                                                                               \
+    T bound = NULL;                                                               \
+    while (node != NULL) {                                                        \
+      if (cmp(node->key, key)) {                                                  \
+        node = node->right;                                                       \
+      } else {                                                                    \
+        bound = node;                                                             \
+        node = node->left;                                                        \
+      }                                                                           \
+    }                                                                             \
+    return bound;                                                                 \
+  }
+
+#define CDC_MAKE_UPPER_BOUND_FN(T)                                                \
+  static T cdc_upper_bound_tree_node(T node, void *key, cdc_binary_pred_fn_t cmp) \
+  {                                                                               \
+    T bound = NULL;                                                               \
+    while (node != NULL) {                                                        \
+      if (cmp(key, node->key)) {                                                  \
+        bound = node;                                                             \
+        node = node->left;                                                        \
+      } else {                                                                    \
+        node = node->right;                                                       \
+      }                                                                           \
+    }                                                                             \
+    return bound;                                                                 \
+  }
+
+// Nodes of the trees that keep subtree sizes, see CDC_ORDER_STATISTICS.
+#define CDC_MAKE_SELECT_NODE_FN(T)                         \
+  static T cdc_select_tree_node(T node, size_t k)          \
+  {                                                        \
+    while (node != NULL) {                                 \
+      size_t lsize = node->left ? node->left->size : 0;    \
+      if (k < lsize) {                                     \
+        node = node->left;                                 \
+      } else if (k > lsize) {                              \
+        k -= lsize + 1;                                    \
+        node = node->right;                                \
+      } else {                                             \
+        break;                                             \
+      }                                                    \
+    }                                                      \
+    return node;                                           \
+  }
+
+#define CDC_MAKE_RANK_FN(T)                                                  \
+  static size_t cdc_tree_rank(T node, void *key, cdc_binary_pred_fn_t cmp)   \
+  {                                                                          \
+    size_t rank = 0;                                                         \
+    while (node != NULL) {                                                   \
+      if (cmp(node->key, key)) {                                             \
+        rank += (node->left ? node->left->size : 0) + 1;                     \
+        node = node->right;                                                  \
+      } else {                                                               \
+        node = node->left;                                                   \
+      }                                                                      \
+    }                                                                        \
+    return rank;                                                             \
+  }
+
 #define CDC_MAKE_MIN_NODE_FN(T)      \
   static T cdc_min_tree_node(T node) \
   {                                  \
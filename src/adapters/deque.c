@@ -21,20 +21,23 @@
 #define CDC_USE_SHORT_NAMES
 #include "cdcontainers/adapters/deque.h"
 
+#include "cdcontainers/data-info.h"
+
 stat_t deque_ctor(const sequence_table_t *table, deque_t **d, data_info_t *info)
 {
   assert(table != NULL);
   assert(d != NULL);
 
-  deque_t *tmp = (deque_t *)malloc(sizeof(deque_t));
+  deque_t *tmp = (deque_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(deque_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
   stat_t ret = tmp->table->ctor(&tmp->container, info);
   if (ret != CDC_STATUS_OK) {
-    free(tmp);
+    cdc_free(tmp->allocator, tmp);
     return ret;
   }
 
@@ -59,15 +62,16 @@ stat_t deque_ctorv(const sequence_table_t *table, deque_t **d, data_info_t *info
   assert(table != NULL);
   assert(d != NULL);
 
-  deque_t *tmp = (deque_t *)malloc(sizeof(deque_t));
+  deque_t *tmp = (deque_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(deque_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
   stat_t ret = tmp->table->ctorv(&tmp->container, info, args);
   if (ret != CDC_STATUS_OK) {
-    free(tmp);
+    cdc_free(tmp->allocator, tmp);
     return ret;
   }
 
@@ -80,7 +84,7 @@ void deque_dtor(deque_t *d)
   assert(d != NULL);
 
   d->table->dtor(d->container);
-  free(d);
+  cdc_free(d->allocator, d);
 }
 
 void deque_swap(deque_t *a, deque_t *b)
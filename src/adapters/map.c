@@ -23,21 +23,28 @@
 
 #include "cdcontainers/data-info.h"
 
+#define MAP_FILTER_MIN_CAPACITY 64
+#define MAP_FILTER_GROWTH 2
+// Number of keys that pass the filter and are looked up together in get_many.
+#define MAP_FILTER_BATCH_SIZE 16
+
 stat_t map_ctor(const map_table_t *table, map_t **m, data_info_t *info)
 {
   assert(table != NULL);
   assert(m != NULL);
   assert(CDC_HAS_CMP(info));
 
-  map_t *tmp = (map_t *)malloc(sizeof(map_t));
+  map_t *tmp = (map_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(map_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
+  tmp->filter = NULL;
   stat_t stat = tmp->table->ctor(&tmp->container, info);
   if (stat != CDC_STATUS_OK) {
-    free(tmp);
+    cdc_free(tmp->allocator, tmp);
     return stat;
   }
 
@@ -64,15 +71,17 @@ stat_t map_ctorv(const map_table_t *table, map_t **m, data_info_t *info, va_list
   assert(m != NULL);
   assert(CDC_HAS_CMP(info));
 
-  map_t *tmp = (map_t *)malloc(sizeof(map_t));
+  map_t *tmp = (map_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(map_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
+  tmp->filter = NULL;
   stat_t stat = tmp->table->ctorv(&tmp->container, info, args);
   if (stat != CDC_STATUS_OK) {
-    free(tmp);
+    cdc_free(tmp->allocator, tmp);
     return stat;
   }
 
@@ -80,12 +89,203 @@ stat_t map_ctorv(const map_table_t *table, map_t **m, data_info_t *info, va_list
   return stat;
 }
 
+static stat_t insert_sorted(const map_table_t *table, void **cntr, data_info_t *info,
+                            const pair_t *pairs, size_t n)
+{
+  stat_t stat = table->ctor(cntr, info);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    stat = table->insert(*cntr, pairs[i].first, pairs[i].second, NULL, NULL);
+    if (stat != CDC_STATUS_OK) {
+      table->dtor(*cntr);
+      return stat;
+    }
+  }
+
+  return CDC_STATUS_OK;
+}
+
+stat_t map_ctor_sorted(const map_table_t *table, map_t **m, data_info_t *info, const pair_t *pairs,
+                       size_t n)
+{
+  assert(table != NULL);
+  assert(m != NULL);
+  assert(CDC_HAS_CMP(info));
+
+  map_t *tmp = (map_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(map_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
+  tmp->filter = NULL;
+  stat_t stat = table->ctor_sorted ? table->ctor_sorted(&tmp->container, info, pairs, n)
+                                   : insert_sorted(table, &tmp->container, info, pairs, n);
+  if (stat != CDC_STATUS_OK) {
+    cdc_free(tmp->allocator, tmp);
+    return stat;
+  }
+
+  *m = tmp;
+  return CDC_STATUS_OK;
+}
+
 void map_dtor(map_t *m)
 {
   assert(m != NULL);
 
   m->table->dtor(m->container);
-  free(m);
+  if (m->filter) {
+    bloom_filter_dtor(m->filter);
+  }
+
+  cdc_free(m->allocator, m);
+}
+
+memory_usage_t map_memory_usage(map_t *m)
+{
+  assert(m != NULL);
+
+  memory_usage_t usage = m->table->memory_usage(m->container);
+  usage.bytes += sizeof(map_t);
+  if (m->filter) {
+    usage.bytes +=
+        sizeof(bloom_filter_t) + m->filter->bcount * CDC_BLOOM_FILTER_BLOCK_WORDS * sizeof(uint64_t);
+  }
+
+  return usage;
+}
+
+static stat_t make_filter(map_t *m, cdc_hash_fn_t hash, size_t capacity, double fp_rate,
+                          bloom_filter_t **f)
+{
+  map_iter_t it = CDC_INIT_STRUCT;
+  map_iter_t end = CDC_INIT_STRUCT;
+  bloom_filter_t *tmp = NULL;
+  stat_t stat = bloom_filter_ctor(&tmp, hash, capacity, fp_rate, m->allocator);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  if ((stat = map_iter_ctor(m, &it)) != CDC_STATUS_OK) {
+    goto free_filter;
+  }
+
+  if ((stat = map_iter_ctor(m, &end)) != CDC_STATUS_OK) {
+    goto free_it;
+  }
+
+  map_begin(m, &it);
+  map_end(m, &end);
+  for (; !map_iter_is_eq(&it, &end); map_iter_next(&it)) {
+    bloom_filter_add(tmp, map_iter_key(&it));
+  }
+
+  map_iter_dtor(&end);
+  map_iter_dtor(&it);
+  *f = tmp;
+  return CDC_STATUS_OK;
+free_it:
+  map_iter_dtor(&it);
+free_filter:
+  bloom_filter_dtor(tmp);
+  return stat;
+}
+
+stat_t map_enable_filter(map_t *m, cdc_hash_fn_t hash, double fp_rate)
+{
+  assert(m != NULL);
+  assert(hash != NULL);
+  assert(fp_rate > 0 && fp_rate < 1);
+
+  bloom_filter_t *filter = NULL;
+  size_t capacity = CDC_MAX(map_size(m) * MAP_FILTER_GROWTH, (size_t)MAP_FILTER_MIN_CAPACITY);
+  stat_t stat = make_filter(m, hash, capacity, fp_rate, &filter);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  map_disable_filter(m);
+  m->filter = filter;
+  return CDC_STATUS_OK;
+}
+
+void map_disable_filter(map_t *m)
+{
+  assert(m != NULL);
+
+  if (m->filter) {
+    bloom_filter_dtor(m->filter);
+    m->filter = NULL;
+  }
+}
+
+void map_filter_insert(map_t *m, void *key)
+{
+  assert(m != NULL);
+  assert(m->filter != NULL);
+
+  bloom_filter_t *filter = m->filter;
+  if (bloom_filter_count(filter) < bloom_filter_capacity(filter)) {
+    bloom_filter_add(filter, key);
+    return;
+  }
+
+  // The key is already in the map, so the new filter gets it from there. If
+  // the new filter can not be made, the old one is kept: it stays correct,
+  // only its false positive rate grows. The count of the old filter includes
+  // erased keys, so the new capacity is based on the size of the map.
+  bloom_filter_t *tmp = NULL;
+  size_t capacity = CDC_MAX(map_size(m) * MAP_FILTER_GROWTH, (size_t)MAP_FILTER_MIN_CAPACITY);
+  if (make_filter(m, filter->hash, capacity, filter->fp_rate, &tmp) != CDC_STATUS_OK) {
+    bloom_filter_add(filter, key);
+    return;
+  }
+
+  bloom_filter_dtor(filter);
+  m->filter = tmp;
+}
+
+size_t map_filter_get_many(map_t *m, void **keys, size_t n, void **values, bool *found)
+{
+  assert(m != NULL);
+  assert(m->filter != NULL);
+
+  void *batch_keys[MAP_FILTER_BATCH_SIZE];
+  void *batch_values[MAP_FILTER_BATCH_SIZE];
+  bool batch_found[MAP_FILTER_BATCH_SIZE];
+  size_t index[MAP_FILTER_BATCH_SIZE];
+  size_t result = 0;
+  size_t i = 0;
+  while (i < n) {
+    size_t batch = 0;
+    for (; i < n && batch < MAP_FILTER_BATCH_SIZE; ++i) {
+      if (bloom_filter_contains(m->filter, keys[i])) {
+        batch_keys[batch] = keys[i];
+        index[batch++] = i;
+      } else {
+        found[i] = false;
+      }
+    }
+
+    if (batch == 0) {
+      continue;
+    }
+
+    result += m->table->get_many(m->container, batch_keys, batch, batch_values, batch_found);
+    for (size_t j = 0; j < batch; ++j) {
+      found[index[j]] = batch_found[j];
+      if (batch_found[j]) {
+        values[index[j]] = batch_values[j];
+      }
+    }
+  }
+
+  return result;
 }
 
 stat_t map_iter_ctor(map_t *m, map_iter_t *it)
@@ -94,7 +294,8 @@ stat_t map_iter_ctor(map_t *m, map_iter_t *it)
   assert(it != NULL);
 
   it->table = m->table->iter_table;
-  it->iter = it->table->ctor();
+  it->allocator = m->allocator;
+  it->iter = it->table->ctor(it->allocator);
   if (!it->iter) {
     return CDC_STATUS_BAD_ALLOC;
   }
@@ -30,15 +30,17 @@ stat_t priority_queue_ctor(const priority_queue_table_t *table, priority_queue_t
   assert(q != NULL);
   assert(CDC_HAS_CMP(info));
 
-  priority_queue_t *tmp = (priority_queue_t *)malloc(sizeof(priority_queue_t));
+  priority_queue_t *tmp =
+      (priority_queue_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(priority_queue_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
   stat_t ret = tmp->table->ctor(&tmp->container, info);
   if (ret != CDC_STATUS_OK) {
-    free(tmp);
+    cdc_free(tmp->allocator, tmp);
     return ret;
   }
 
@@ -67,15 +69,17 @@ stat_t priority_queue_ctorv(const priority_queue_table_t *table, priority_queue_
   assert(q != NULL);
   assert(CDC_HAS_CMP(info));
 
-  priority_queue_t *tmp = (priority_queue_t *)malloc(sizeof(priority_queue_t));
+  priority_queue_t *tmp =
+      (priority_queue_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(priority_queue_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
   stat_t ret = tmp->table->ctorv(&tmp->container, info, args);
   if (ret != CDC_STATUS_OK) {
-    free(tmp);
+    cdc_free(tmp->allocator, tmp);
     return ret;
   }
 
@@ -88,7 +92,7 @@ void priority_queue_dtor(priority_queue_t *q)
   assert(q != NULL);
 
   q->table->dtor(q->container);
-  free(q);
+  cdc_free(q->allocator, q);
 }
 
 void priority_queue_swap(priority_queue_t *a, priority_queue_t *b)
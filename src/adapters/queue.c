@@ -21,20 +21,23 @@
 #define CDC_USE_SHORT_NAMES
 #include "cdcontainers/adapters/queue.h"
 
+#include "cdcontainers/data-info.h"
+
 stat_t queue_ctor(const sequence_table_t *table, queue_t **q, data_info_t *info)
 {
   assert(table != NULL);
   assert(q != NULL);
 
-  queue_t *tmp = (queue_t *)malloc(sizeof(queue_t));
+  queue_t *tmp = (queue_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(queue_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
   stat_t ret = tmp->table->ctor(&tmp->container, info);
   if (ret != CDC_STATUS_OK) {
-    free(tmp);
+    cdc_free(tmp->allocator, tmp);
     return ret;
   }
 
@@ -59,15 +62,16 @@ stat_t queue_ctorv(const sequence_table_t *table, queue_t **q, data_info_t *info
   assert(table != NULL);
   assert(q != NULL);
 
-  queue_t *tmp = (queue_t *)malloc(sizeof(queue_t));
+  queue_t *tmp = (queue_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(queue_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
   stat_t ret = tmp->table->ctorv(&tmp->container, info, args);
   if (ret != CDC_STATUS_OK) {
-    free(tmp);
+    cdc_free(tmp->allocator, tmp);
     return ret;
   }
 
@@ -80,7 +84,7 @@ void queue_dtor(queue_t *q)
   assert(q != NULL);
 
   q->table->dtor(q->container);
-  free(q);
+  cdc_free(q->allocator, q);
 }
 
 void queue_swap(queue_t *a, queue_t *b)
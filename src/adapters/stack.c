@@ -21,20 +21,23 @@
 #define CDC_USE_SHORT_NAMES
 #include "cdcontainers/adapters/stack.h"
 
+#include "cdcontainers/data-info.h"
+
 stat_t stack_ctor(const sequence_table_t *table, cstack_t **s, data_info_t *info)
 {
   assert(table != NULL);
   assert(s != NULL);
 
-  cstack_t *tmp = (cstack_t *)malloc(sizeof(cstack_t));
+  cstack_t *tmp = (cstack_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(cstack_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
   stat_t ret = tmp->table->ctor(&tmp->container, info);
   if (ret != CDC_STATUS_OK) {
-    free(tmp);
+    cdc_free(tmp->allocator, tmp);
     return ret;
   }
 
@@ -59,15 +62,16 @@ stat_t stack_ctorv(const sequence_table_t *table, cstack_t **s, data_info_t *inf
   assert(table != NULL);
   assert(s != NULL);
 
-  cstack_t *tmp = (cstack_t *)malloc(sizeof(cstack_t));
+  cstack_t *tmp = (cstack_t *)cdc_malloc(CDC_ALLOCATOR(info), sizeof(cstack_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->table = table;
+  tmp->allocator = CDC_ALLOCATOR(info);
   stat_t ret = tmp->table->ctorv(&tmp->container, info, args);
   if (ret != CDC_STATUS_OK) {
-    free(tmp);
+    cdc_free(tmp->allocator, tmp);
     return ret;
   }
 
@@ -80,7 +84,7 @@ void stack_dtor(cstack_t *s)
   assert(s != NULL);
 
   s->table->dtor(s->container);
-  free(s);
+  cdc_free(s->allocator, s);
 }
 
 void stack_swap(cstack_t *a, cstack_t *b)
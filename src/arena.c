@@ -0,0 +1,212 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "cdcontainers/arena.h"
+
+#include "cdcontainers/data-info.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_ALIGNMENT 16
+
+// A block starts with the pointer to the next block followed by the memory.
+// The first block in the list is the one memory is cut from.
+struct block {
+  struct block *next;
+  char *end;
+};
+
+static size_t align_up(size_t size)
+{
+  return (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+static size_t header_size()
+{
+  return align_up(sizeof(struct block));
+}
+
+static char *block_data(struct block *b)
+{
+  return (char *)b + header_size();
+}
+
+static struct block *new_block(size_t size)
+{
+  struct block *b = (struct block *)cdc_malloc(NULL, header_size() + size);
+  if (!b) {
+    return NULL;
+  }
+
+  b->next = NULL;
+  b->end = block_data(b) + size;
+  return b;
+}
+
+static void free_blocks(struct block *b)
+{
+  while (b) {
+    struct block *next = b->next;
+    cdc_free(NULL, b);
+    b = next;
+  }
+}
+
+// Allocates a block only for the memory of size bytes. The block is put after
+// the current one, so the rest of the current block is still used.
+static void *alloc_large(arena_t *a, size_t size)
+{
+  struct block *b = new_block(size);
+  if (!b) {
+    return NULL;
+  }
+
+  struct block *head = (struct block *)a->blocks;
+  if (head) {
+    b->next = head->next;
+    head->next = b;
+  } else {
+    a->blocks = b;
+    a->cursor = b->end;
+    a->end = b->end;
+  }
+
+  return block_data(b);
+}
+
+static bool add_block(arena_t *a)
+{
+  struct block *b = new_block(a->block_size);
+  if (!b) {
+    return false;
+  }
+
+  b->next = (struct block *)a->blocks;
+  a->blocks = b;
+  a->cursor = block_data(b);
+  a->end = b->end;
+  return true;
+}
+
+static void *arena_realloc(arena_t *a, void *ptr, size_t size)
+{
+  if (!ptr) {
+    return arena_alloc(a, size);
+  }
+
+  // The last allocation is grown or shrunk in place if it fits.
+  if (ptr == a->last && (size_t)(a->end - a->last) >= align_up(size)) {
+    a->cursor = a->last + align_up(size);
+    return ptr;
+  }
+
+  // The old size is not stored, so as many bytes as fit into the new memory
+  // are copied from the used part of the block of ptr. The bytes after the old
+  // memory are not used by the caller.
+  struct block *b = (struct block *)a->blocks;
+  while (b && ((char *)ptr < block_data(b) || (char *)ptr >= b->end)) {
+    b = b->next;
+  }
+
+  assert(b != NULL);
+  char *used_end = b == a->blocks ? a->cursor : b->end;
+  size_t available = (size_t)(used_end - (char *)ptr);
+  void *new_ptr = arena_alloc(a, size);
+  if (new_ptr) {
+    memcpy(new_ptr, ptr, size < available ? size : available);
+  }
+
+  return new_ptr;
+}
+
+static void *allocator_alloc(void *ctx, size_t size)
+{
+  return arena_alloc((arena_t *)ctx, size);
+}
+
+static void *allocator_realloc(void *ctx, void *ptr, size_t size)
+{
+  return arena_realloc((arena_t *)ctx, ptr, size);
+}
+
+stat_t arena_ctor(arena_t **a, size_t block_size)
+{
+  assert(a != NULL);
+
+  arena_t *tmp = (arena_t *)cdc_calloc(NULL, sizeof(arena_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  tmp->block_size = align_up(block_size ? block_size : CDC_ARENA_BLOCK_SIZE);
+  tmp->allocator.alloc = allocator_alloc;
+  tmp->allocator.realloc = allocator_realloc;
+  tmp->allocator.free = NULL;
+  tmp->allocator.ctx = tmp;
+  *a = tmp;
+  return CDC_STATUS_OK;
+}
+
+void arena_dtor(arena_t *a)
+{
+  assert(a != NULL);
+
+  free_blocks((struct block *)a->blocks);
+  cdc_free(NULL, a);
+}
+
+void *arena_alloc(arena_t *a, size_t size)
+{
+  assert(a != NULL);
+
+  size = align_up(size ? size : 1);
+  if ((size_t)(a->end - a->cursor) < size) {
+    if (size > a->block_size / 2) {
+      return alloc_large(a, size);
+    }
+
+    if (!add_block(a)) {
+      return NULL;
+    }
+  }
+
+  a->last = a->cursor;
+  a->cursor += size;
+  return a->last;
+}
+
+void arena_reset(arena_t *a)
+{
+  assert(a != NULL);
+
+  struct block *head = (struct block *)a->blocks;
+  if (head) {
+    free_blocks(head->next);
+    head->next = NULL;
+    a->cursor = block_data(head);
+    a->end = head->end;
+  }
+
+  a->last = NULL;
+}
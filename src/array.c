@@ -39,29 +39,42 @@ static bool should_grow(array_t *v)
 
 static stat_t reallocate(array_t *v, size_t capacity)
 {
-  if (capacity < ARRAY_MIN_CAPACITY) {
-    capacity = ARRAY_MIN_CAPACITY;
+  if (capacity < v->growth.min_capacity) {
+    capacity = v->growth.min_capacity;
   }
 
   if (capacity < v->size) {
     return CDC_STATUS_OK;
   }
 
-  void **tmp = (void **)malloc(capacity * sizeof(void *));
+  void **tmp = (void **)di_realloc(v->dinfo, v->buffer, capacity * sizeof(void *));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
-  memcpy(tmp, v->buffer, v->size * sizeof(void *));
-  free(v->buffer);
   v->capacity = capacity;
   v->buffer = tmp;
   return CDC_STATUS_OK;
 }
 
+// Returns the capacity after the growth to at least required elements.
+static size_t next_capacity(array_t *v, size_t required)
+{
+  size_t capacity = (size_t)((double)v->capacity * v->growth.factor);
+  if (v->growth.max_step && capacity - v->capacity > v->growth.max_step) {
+    capacity = v->capacity + v->growth.max_step;
+  }
+
+  if (capacity <= v->capacity) {
+    capacity = v->capacity + 1;
+  }
+
+  return capacity < required ? required : capacity;
+}
+
 static stat_t grow(array_t *v)
 {
-  return reallocate(v, (size_t)(v->capacity * ARRAY_COPACITY_EXP));
+  return reallocate(v, next_capacity(v, v->size + 1));
 }
 
 static void free_data(array_t *v)
@@ -76,7 +89,7 @@ static void free_data(array_t *v)
 static void free_buffer(array_t *v)
 {
   free_data(v);
-  free(v->buffer);
+  di_free(v->dinfo, v->buffer);
   v->buffer = NULL;
 }
 
@@ -108,7 +121,7 @@ stat_t array_ctor(array_t **v, data_info_t *info)
 {
   assert(v != NULL);
 
-  array_t *tmp = (array_t *)calloc(sizeof(array_t), 1);
+  array_t *tmp = (array_t *)di_calloc(info, sizeof(array_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
@@ -119,6 +132,8 @@ stat_t array_ctor(array_t **v, data_info_t *info)
     goto free_di;
   }
 
+  tmp->growth.factor = ARRAY_COPACITY_EXP;
+  tmp->growth.min_capacity = ARRAY_MIN_CAPACITY;
   ret = reallocate(tmp, ARRAY_MIN_CAPACITY);
   if (ret != CDC_STATUS_OK) {
     goto free_array;
@@ -130,7 +145,7 @@ stat_t array_ctor(array_t **v, data_info_t *info)
 free_di:
   di_shared_dtor(tmp->dinfo);
 free_array:
-  free(tmp);
+  di_free(info, tmp);
   return ret;
 }
 
@@ -162,8 +177,16 @@ void array_dtor(array_t *v)
   assert(v != NULL);
 
   free_buffer(v);
-  di_shared_dtor(v->dinfo);
-  free(v);
+  data_info_t *dinfo = v->dinfo;
+  di_free(dinfo, v);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t array_memory_usage(array_t *v)
+{
+  assert(v != NULL);
+
+  return memory_usage_make(sizeof(array_t) + v->capacity * sizeof(void *), v->size);
 }
 
 stat_t array_insert(array_t *v, size_t index, void *value)
@@ -223,6 +246,16 @@ stat_t array_shrink_to_fit(array_t *v)
   return reallocate(v, v->size);
 }
 
+void array_set_growth_policy(array_t *v, const array_growth_policy_t *policy)
+{
+  assert(v != NULL);
+  assert(policy != NULL);
+  assert(policy->factor > 1.0);
+  assert(policy->min_capacity > 0);
+
+  v->growth = *policy;
+}
+
 stat_t array_push_back(array_t *v, void *value)
 {
   assert(v != NULL);
@@ -239,6 +272,7 @@ void array_swap(array_t *a, array_t *b)
   CDC_SWAP(size_t, a->capacity, b->capacity);
   CDC_SWAP(void **, a->buffer, b->buffer);
   CDC_SWAP(data_info_t *, a->dinfo, b->dinfo);
+  CDC_SWAP(array_growth_policy_t, a->growth, b->growth);
 }
 
 stat_t array_at(array_t *v, size_t index, void **elem)
@@ -260,7 +294,7 @@ stat_t array_append(array_t *v, void **data, size_t len)
 
   size_t new_capacity = v->size + len;
   if (new_capacity > v->capacity) {
-    stat_t ret = reallocate(v, (size_t)(new_capacity * ARRAY_COPACITY_EXP));
+    stat_t ret = reallocate(v, next_capacity(v, new_capacity));
     if (ret != CDC_STATUS_OK) {
       return ret;
     }
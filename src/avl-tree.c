@@ -22,6 +22,7 @@
 #include "cdcontainers/avl-tree.h"
 
 #include "cdcontainers/data-info.h"
+#include "cdcontainers/node-pool.h"
 #include "cdcontainers/tree-utils.h"
 
 #include <stdint.h>
@@ -29,14 +30,21 @@
 #include <string.h>
 
 CDC_MAKE_FIND_NODE_FN(avl_tree_node_t *)
+CDC_MAKE_FIND_NODE_BY_PROBE_FN(avl_tree_node_t *)
+CDC_MAKE_LOWER_BOUND_FN(avl_tree_node_t *)
+CDC_MAKE_UPPER_BOUND_FN(avl_tree_node_t *)
 CDC_MAKE_MIN_NODE_FN(avl_tree_node_t *)
 CDC_MAKE_MAX_NODE_FN(avl_tree_node_t *)
 CDC_MAKE_SUCCESSOR_FN(avl_tree_node_t *)
 CDC_MAKE_PREDECESSOR_FN(avl_tree_node_t *)
+#ifdef CDC_ORDER_STATISTICS
+CDC_MAKE_SELECT_NODE_FN(avl_tree_node_t *)
+CDC_MAKE_RANK_FN(avl_tree_node_t *)
+#endif
 
-static avl_tree_node_t *make_new_node(void *key, void *val)
+static avl_tree_node_t *make_new_node(avl_tree_t *t, void *key, void *val)
 {
-  avl_tree_node_t *node = (avl_tree_node_t *)malloc(sizeof(avl_tree_node_t));
+  avl_tree_node_t *node = (avl_tree_node_t *)node_pool_alloc(t->pool);
   if (!node) {
     return NULL;
   }
@@ -44,6 +52,9 @@ static avl_tree_node_t *make_new_node(void *key, void *val)
   node->key = key;
   node->value = val;
   node->height = 1;
+#ifdef CDC_ORDER_STATISTICS
+  node->size = 1;
+#endif
   node->parent = NULL;
   node->left = NULL;
   node->right = NULL;
@@ -59,14 +70,16 @@ static void free_node(avl_tree_t *t, avl_tree_node_t *node)
     t->dinfo->dfree(&pair);
   }
 
-  free(node);
+  node_pool_free(t->pool, node);
 }
 
 static void free_avl_tree(avl_tree_t *t, avl_tree_node_t *root)
 {
   assert(t != NULL);
 
-  if (root == NULL) {
+  // The nodes are released with the chunks of the pool, so they are visited
+  // only to free the data.
+  if (root == NULL || !CDC_HAS_DFREE(t->dinfo)) {
     return;
   }
 
@@ -80,6 +93,13 @@ static unsigned char height(avl_tree_node_t *node)
   return node ? node->height : 0;
 }
 
+#ifdef CDC_ORDER_STATISTICS
+static size_t subtree_size(avl_tree_node_t *node)
+{
+  return node ? node->size : 0;
+}
+#endif
+
 static int height_diff(avl_tree_node_t *node)
 {
   return height(node->right) - height(node->left);
@@ -90,6 +110,11 @@ static void update_height(avl_tree_node_t *node)
   unsigned char lhs = height(node->left);
   unsigned char rhs = height(node->right);
   node->height = CDC_MAX(lhs, rhs) + 1;
+#ifdef CDC_ORDER_STATISTICS
+  // The size is updated with the height, balance visits all the ancestors of
+  // an inserted or erased node.
+  node->size = subtree_size(node->left) + subtree_size(node->right) + 1;
+#endif
 }
 
 static void update_link(avl_tree_node_t *parent, avl_tree_node_t *old_child,
@@ -268,12 +293,13 @@ static avl_tree_node_t *erase_node(avl_tree_t *t, avl_tree_node_t *node)
     CDC_SWAP(void *, node->key, mnode->key);
     parent = mnode->parent;
     if (parent == node) {
-      parent->right = NULL;
-    } else if (parent) {
+      parent->right = mnode->right;
+    } else {
       parent->left = mnode->right;
-      if (mnode->right) {
-        mnode->right->parent = parent;
-      }
+    }
+
+    if (mnode->right) {
+      mnode->right->parent = parent;
     }
 
     node = mnode;
@@ -283,6 +309,48 @@ static avl_tree_node_t *erase_node(avl_tree_t *t, avl_tree_node_t *node)
   return balance(parent);
 }
 
+// Builds a balanced subtree of the sorted pairs. Nodes are allocated in the
+// order of the keys, so neighbouring keys are close in memory.
+static stat_t build_sorted(avl_tree_t *t, const pair_t *pairs, size_t n, avl_tree_node_t **root)
+{
+  *root = NULL;
+  if (n == 0) {
+    return CDC_STATUS_OK;
+  }
+
+  size_t mid = n / 2;
+  avl_tree_node_t *left = NULL;
+  avl_tree_node_t *right = NULL;
+  stat_t stat = build_sorted(t, pairs, mid, &left);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  avl_tree_node_t *node = make_new_node(t, pairs[mid].first, pairs[mid].second);
+  if (!node) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  stat = build_sorted(t, pairs + mid + 1, n - mid - 1, &right);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  node->left = left;
+  node->right = right;
+  if (left) {
+    left->parent = node;
+  }
+
+  if (right) {
+    right->parent = node;
+  }
+
+  update_height(node);
+  *root = node;
+  return CDC_STATUS_OK;
+}
+
 static stat_t init_varg(avl_tree_t *t, va_list args)
 {
   pair_t *pair = NULL;
@@ -301,16 +369,23 @@ stat_t avl_tree_ctor(avl_tree_t **t, data_info_t *info)
   assert(t != NULL);
   assert(CDC_HAS_CMP(info));
 
-  avl_tree_t *tmp = (avl_tree_t *)calloc(sizeof(avl_tree_t), 1);
+  avl_tree_t *tmp = (avl_tree_t *)di_calloc(info, sizeof(avl_tree_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
-    free(tmp);
+    di_free(info, tmp);
     return CDC_STATUS_BAD_ALLOC;
   }
 
+  stat_t stat = node_pool_ctor(&tmp->pool, tmp->dinfo, sizeof(avl_tree_node_t), 0);
+  if (stat != CDC_STATUS_OK) {
+    di_shared_dtor(tmp->dinfo);
+    di_free(info, tmp);
+    return stat;
+  }
+
   *t = tmp;
   return CDC_STATUS_OK;
 }
@@ -340,13 +415,48 @@ stat_t avl_tree_ctorv(avl_tree_t **t, data_info_t *info, va_list args)
   return init_varg(*t, args);
 }
 
+stat_t avl_tree_ctor_sorted(avl_tree_t **t, data_info_t *info, const pair_t *pairs, size_t n)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+  assert(pairs != NULL || n == 0);
+  assert(cdc_is_sorted_unique(pairs, n, info->cmp));
+
+  avl_tree_t *tmp = NULL;
+  stat_t stat = avl_tree_ctor(&tmp, info);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  // Nodes of a failed build are not linked to the root, so they are released
+  // with the pool and the data is not freed.
+  if ((stat = build_sorted(tmp, pairs, n, &tmp->root)) != CDC_STATUS_OK) {
+    tmp->root = NULL;
+    avl_tree_dtor(tmp);
+    return stat;
+  }
+
+  tmp->size = n;
+  *t = tmp;
+  return CDC_STATUS_OK;
+}
+
 void avl_tree_dtor(avl_tree_t *t)
 {
   assert(t != NULL);
 
   free_avl_tree(t, t->root);
-  di_shared_dtor(t->dinfo);
-  free(t);
+  node_pool_dtor(t->pool);
+  data_info_t *dinfo = t->dinfo;
+  di_free(dinfo, t);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t avl_tree_memory_usage(avl_tree_t *t)
+{
+  assert(t != NULL);
+
+  return memory_usage_make(sizeof(avl_tree_t) + node_pool_memory_usage(t->pool), t->size);
 }
 
 stat_t avl_tree_get(avl_tree_t *t, void *key, void **value)
@@ -385,6 +495,125 @@ void avl_tree_find(avl_tree_t *t, void *key, avl_tree_iter_t *it)
   it->prev = cdc_tree_predecessor(node);
 }
 
+void avl_tree_lower_bound(avl_tree_t *t, void *key, avl_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  avl_tree_node_t *node = cdc_lower_bound_tree_node(t->root, key, t->dinfo->cmp);
+  if (!node) {
+    avl_tree_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
+void avl_tree_upper_bound(avl_tree_t *t, void *key, avl_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  avl_tree_node_t *node = cdc_upper_bound_tree_node(t->root, key, t->dinfo->cmp);
+  if (!node) {
+    avl_tree_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
+void avl_tree_equal_range(avl_tree_t *t, void *key, pair_avl_tree_iter_t *range)
+{
+  assert(t != NULL);
+  assert(range != NULL);
+
+  avl_tree_lower_bound(t, key, &range->first);
+  range->second = range->first;
+  if (range->first.current && !t->dinfo->cmp(key, range->first.current->key)) {
+    avl_tree_iter_next(&range->second);
+  }
+}
+
+void avl_tree_range(avl_tree_t *t, void *from, void *to, pair_avl_tree_iter_t *range)
+{
+  assert(t != NULL);
+  assert(range != NULL);
+  assert(!t->dinfo->cmp(to, from));
+
+  avl_tree_lower_bound(t, from, &range->first);
+  avl_tree_lower_bound(t, to, &range->second);
+}
+
+#ifdef CDC_ORDER_STATISTICS
+void avl_tree_select(avl_tree_t *t, size_t k, avl_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  avl_tree_node_t *node = cdc_select_tree_node(t->root, k);
+  if (!node) {
+    avl_tree_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
+size_t avl_tree_rank(avl_tree_t *t, void *key)
+{
+  assert(t != NULL);
+
+  return cdc_tree_rank(t->root, key, t->dinfo->cmp);
+}
+#endif
+
+stat_t avl_tree_get_probe(avl_tree_t *t, const void *probe, const probe_info_t *info, void **value)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  avl_tree_node_t *node = cdc_find_tree_node_by_probe(t->root, probe, info);
+  if (node) {
+    *value = node->value;
+    return CDC_STATUS_OK;
+  }
+
+  return CDC_STATUS_NOT_FOUND;
+}
+
+size_t avl_tree_count_probe(avl_tree_t *t, const void *probe, const probe_info_t *info)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  return (size_t)(cdc_find_tree_node_by_probe(t->root, probe, info) != NULL);
+}
+
+void avl_tree_find_probe(avl_tree_t *t, const void *probe, const probe_info_t *info,
+                         avl_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+  assert(it != NULL);
+
+  avl_tree_node_t *node = cdc_find_tree_node_by_probe(t->root, probe, info);
+  if (!node) {
+    avl_tree_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
 stat_t avl_tree_insert(avl_tree_t *t, void *key, void *value, pair_avl_tree_iter_bool_t *ret)
 {
   assert(t != NULL);
@@ -406,7 +635,7 @@ stat_t avl_tree_insert1(avl_tree_t *t, void *key, void *value, avl_tree_iter_t *
   avl_tree_node_t *node = find_hint(t->root, key, t->dinfo->cmp);
   bool finded = node && cdc_eq(t->dinfo->cmp, node->key, key);
   if (!finded) {
-    avl_tree_node_t *new_node = make_new_node(key, value);
+    avl_tree_node_t *new_node = make_new_node(t, key, value);
     if (!new_node) {
       return CDC_STATUS_BAD_ALLOC;
     }
@@ -450,7 +679,7 @@ stat_t avl_tree_insert_or_assign1(avl_tree_t *t, void *key, void *value, avl_tre
   avl_tree_node_t *node = find_hint(t->root, key, t->dinfo->cmp);
   bool finded = node && cdc_eq(t->dinfo->cmp, node->key, key);
   if (!finded) {
-    avl_tree_node_t *new_node = make_new_node(key, value);
+    avl_tree_node_t *new_node = make_new_node(t, key, value);
     if (!new_node) {
       return CDC_STATUS_BAD_ALLOC;
     }
@@ -492,6 +721,7 @@ void avl_tree_clear(avl_tree_t *t)
   assert(t != NULL);
 
   free_avl_tree(t, t->root);
+  node_pool_clear(t->pool);
   t->size = 0;
   t->root = NULL;
 }
@@ -504,6 +734,7 @@ void avl_tree_swap(avl_tree_t *a, avl_tree_t *b)
   CDC_SWAP(avl_tree_node_t *, a->root, b->root);
   CDC_SWAP(size_t, a->size, b->size);
   CDC_SWAP(data_info_t *, a->dinfo, b->dinfo);
+  CDC_SWAP(node_pool_t *, a->pool, b->pool);
 }
 
 void avl_tree_begin(avl_tree_t *t, avl_tree_iter_t *it)
@@ -28,9 +28,10 @@
 #include <stdio.h>
 #include <string.h>
 
-static binomial_heap_node_t *new_node(void *key)
+static binomial_heap_node_t *new_node(binomial_heap_t *h, void *key)
 {
-  binomial_heap_node_t *node = (binomial_heap_node_t *)calloc(sizeof(binomial_heap_node_t), 1);
+  binomial_heap_node_t *node =
+      (binomial_heap_node_t *)di_calloc(h->dinfo, sizeof(binomial_heap_node_t));
   if (!node) return NULL;
 
   node->key = key;
@@ -43,7 +44,7 @@ static void free_node(binomial_heap_t *h, binomial_heap_node_t *node)
     h->dinfo->dfree(node->key);
   }
 
-  free(node);
+  di_free(h->dinfo, node);
 }
 
 static void free_heap(binomial_heap_t *h, binomial_heap_node_t *root)
@@ -255,13 +256,13 @@ stat_t binomial_heap_ctor(binomial_heap_t **h, data_info_t *info)
   assert(h != NULL);
   assert(CDC_HAS_CMP(info));
 
-  binomial_heap_t *tmp = (binomial_heap_t *)calloc(sizeof(binomial_heap_t), 1);
+  binomial_heap_t *tmp = (binomial_heap_t *)di_calloc(info, sizeof(binomial_heap_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
-    free(tmp);
+    di_free(info, tmp);
     return CDC_STATUS_BAD_ALLOC;
   }
 
@@ -299,8 +300,17 @@ void binomial_heap_dtor(binomial_heap_t *h)
   assert(h != NULL);
 
   free_heap(h, h->root);
-  di_shared_dtor(h->dinfo);
-  free(h);
+  data_info_t *dinfo = h->dinfo;
+  di_free(dinfo, h);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t binomial_heap_memory_usage(binomial_heap_t *h)
+{
+  assert(h != NULL);
+
+  return memory_usage_make(sizeof(binomial_heap_t) + h->size * sizeof(binomial_heap_node_t),
+                           h->size);
 }
 
 stat_t binomial_heap_extract_top(binomial_heap_t *h)
@@ -335,7 +345,7 @@ stat_t binomial_heap_riinsert(binomial_heap_t *h, void *key, binomial_heap_iter_
 {
   assert(h != NULL);
 
-  binomial_heap_node_t *node = new_node(key);
+  binomial_heap_node_t *node = new_node(h, key);
   if (!node) return CDC_STATUS_BAD_ALLOC;
 
   update_top(h, node);
@@ -0,0 +1,156 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "cdcontainers/bloom-filter.h"
+
+#include "cdcontainers/data-info.h"
+#include "cdcontainers/global.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOOM_FILTER_BLOCK_BITS (CDC_BLOOM_FILTER_BLOCK_WORDS * 64)
+#define BLOOM_FILTER_MAX_HASH_COUNT 16
+// Keys are not spread evenly over the blocks, so a blocked filter needs more
+// bits than a classic one for the same false positive rate, and the more the
+// lower the rate is. The overhead is 15% per decimal order of the rate.
+#define BLOOM_FILTER_BLOCK_OVERHEAD 0.15
+#define BLOOM_FILTER_SALT ((size_t)0x9e3779b97f4a7c15ULL)
+
+CDC_STATIC_ASSERT(CDC_BLOOM_FILTER_BLOCK_WORDS * 8 == CDC_CACHE_LINE_SIZE,
+                  bloom_filter_block_must_be_cache_line);
+
+static uint64_t *get_block(bloom_filter_t *f, size_t hash)
+{
+  return f->blocks + (hash % f->bcount) * CDC_BLOOM_FILTER_BLOCK_WORDS;
+}
+
+// The bits of a key in its block are chosen by double hashing of a second
+// hash, which is independent of the one that chooses the block.
+static void make_mask(bloom_filter_t *f, size_t hash, uint64_t *mask)
+{
+  size_t h = cdc_hash_mix(hash ^ BLOOM_FILTER_SALT);
+  size_t step = (h >> (sizeof(size_t) * 4)) | 1;
+  memset(mask, 0, CDC_BLOOM_FILTER_BLOCK_WORDS * sizeof(uint64_t));
+  for (unsigned i = 0; i < f->hash_count; ++i) {
+    size_t bit = (h + i * step) % BLOOM_FILTER_BLOCK_BITS;
+    mask[bit / 64] |= (uint64_t)1 << (bit % 64);
+  }
+}
+
+stat_t bloom_filter_ctor(bloom_filter_t **f, cdc_hash_fn_t hash, size_t capacity, double fp_rate,
+                         const struct cdc_allocator *allocator)
+{
+  assert(f != NULL);
+  assert(hash != NULL);
+  assert(fp_rate > 0 && fp_rate < 1);
+
+  bloom_filter_t *tmp = (bloom_filter_t *)cdc_calloc(allocator, sizeof(bloom_filter_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  double ln2 = log(2.0);
+  double overhead = 1 - log10(fp_rate) * BLOOM_FILTER_BLOCK_OVERHEAD;
+  double bits_per_key = -log(fp_rate) / (ln2 * ln2);
+  double bits = bits_per_key * overhead * (double)CDC_MAX(capacity, (size_t)1);
+  long hash_count = lround(bits_per_key * ln2);
+  tmp->hash_count = (unsigned)CDC_MIN(CDC_MAX(hash_count, 1L), (long)BLOOM_FILTER_MAX_HASH_COUNT);
+  tmp->bcount = (size_t)ceil(bits / BLOOM_FILTER_BLOCK_BITS);
+  tmp->capacity = capacity;
+  tmp->fp_rate = fp_rate;
+  tmp->hash = hash;
+  tmp->allocator = allocator;
+  size_t size = tmp->bcount * CDC_BLOOM_FILTER_BLOCK_WORDS * sizeof(uint64_t);
+  tmp->blocks = (uint64_t *)cdc_aligned_malloc(allocator, CDC_CACHE_LINE_SIZE, size);
+  if (!tmp->blocks) {
+    cdc_free(allocator, tmp);
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  memset(tmp->blocks, 0, size);
+  *f = tmp;
+  return CDC_STATUS_OK;
+}
+
+void bloom_filter_dtor(bloom_filter_t *f)
+{
+  assert(f != NULL);
+
+  cdc_aligned_free(f->allocator, f->blocks);
+  cdc_free(f->allocator, f);
+}
+
+bool bloom_filter_contains(bloom_filter_t *f, void *key)
+{
+  assert(f != NULL);
+
+  return bloom_filter_contains_hashed(f, f->hash(key));
+}
+
+bool bloom_filter_contains_hashed(bloom_filter_t *f, size_t hash)
+{
+  assert(f != NULL);
+
+  hash = cdc_hash_mix(hash);
+  uint64_t mask[CDC_BLOOM_FILTER_BLOCK_WORDS];
+  make_mask(f, hash, mask);
+  // No early exit, so that the loop over the whole block can be vectorized.
+  uint64_t *block = get_block(f, hash);
+  uint64_t missing = 0;
+  for (size_t i = 0; i < CDC_BLOOM_FILTER_BLOCK_WORDS; ++i) {
+    missing |= mask[i] & ~block[i];
+  }
+
+  return missing == 0;
+}
+
+void bloom_filter_clear(bloom_filter_t *f)
+{
+  assert(f != NULL);
+
+  memset(f->blocks, 0, f->bcount * CDC_BLOOM_FILTER_BLOCK_WORDS * sizeof(uint64_t));
+  f->count = 0;
+}
+
+void bloom_filter_add(bloom_filter_t *f, void *key)
+{
+  assert(f != NULL);
+
+  bloom_filter_add_hashed(f, f->hash(key));
+}
+
+void bloom_filter_add_hashed(bloom_filter_t *f, size_t hash)
+{
+  assert(f != NULL);
+
+  hash = cdc_hash_mix(hash);
+  uint64_t mask[CDC_BLOOM_FILTER_BLOCK_WORDS];
+  make_mask(f, hash, mask);
+  uint64_t *block = get_block(f, hash);
+  for (size_t i = 0; i < CDC_BLOOM_FILTER_BLOCK_WORDS; ++i) {
+    block[i] |= mask[i];
+  }
+
+  ++f->count;
+}
@@ -0,0 +1,919 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "cdcontainers/btree.h"
+
+#include "cdcontainers/data-info.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BTREE_MIN_SIZE (CDC_BTREE_ORDER / 2)
+// Nodes that can be split by one insertion, one per level and a new root.
+#define BTREE_MAX_SPLITS (sizeof(size_t) * 8 + 1)
+
+static btree_leaf_t *as_leaf(btree_node_t *node)
+{
+  return (btree_leaf_t *)node;
+}
+
+static btree_inner_t *as_inner(btree_node_t *node)
+{
+  return (btree_inner_t *)node;
+}
+
+static btree_leaf_t *make_leaf(btree_t *t)
+{
+  btree_leaf_t *leaf = (btree_leaf_t *)di_malloc(t->dinfo, sizeof(btree_leaf_t));
+  if (!leaf) {
+    return NULL;
+  }
+
+  leaf->base.parent = NULL;
+  leaf->base.size = 0;
+  leaf->base.is_leaf = true;
+  leaf->prev = NULL;
+  leaf->next = NULL;
+  ++t->leaf_count;
+  return leaf;
+}
+
+static btree_inner_t *make_inner(btree_t *t)
+{
+  btree_inner_t *inner = (btree_inner_t *)di_malloc(t->dinfo, sizeof(btree_inner_t));
+  if (!inner) {
+    return NULL;
+  }
+
+  inner->base.parent = NULL;
+  inner->base.size = 0;
+  inner->base.is_leaf = false;
+  ++t->inner_count;
+  return inner;
+}
+
+static void free_node(btree_t *t, btree_node_t *node)
+{
+  if (node->is_leaf) {
+    --t->leaf_count;
+  } else {
+    --t->inner_count;
+  }
+
+  di_free(t->dinfo, node);
+}
+
+static void free_subtree(btree_t *t, btree_node_t *node)
+{
+  if (!node->is_leaf) {
+    btree_inner_t *inner = as_inner(node);
+    for (unsigned i = 0; i <= node->size; ++i) {
+      free_subtree(t, inner->children[i]);
+    }
+  }
+
+  free_node(t, node);
+}
+
+static void free_btree(btree_t *t)
+{
+  if (CDC_HAS_DFREE(t->dinfo)) {
+    for (btree_leaf_t *leaf = t->first; leaf; leaf = leaf->next) {
+      for (unsigned i = 0; i < leaf->base.size; ++i) {
+        pair_t pair = {leaf->base.keys[i], leaf->values[i]};
+        t->dinfo->dfree(&pair);
+      }
+    }
+  }
+
+  // Memory of an allocator that releases it in bulk is not freed by nodes.
+  if (t->root && !CDC_HAS_BULK_FREE(t->dinfo)) {
+    free_subtree(t, t->root);
+  }
+
+  t->root = NULL;
+  t->first = NULL;
+  t->last = NULL;
+  t->leaf_count = 0;
+  t->inner_count = 0;
+}
+
+// Returns the number of keys of the node that are not greater than the key,
+// that is the index of the child of an inner node that can contain the key.
+static size_t upper_bound(btree_node_t *node, void *key, cdc_binary_pred_fn_t cmp)
+{
+  size_t lo = 0;
+  size_t hi = node->size;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (cmp(key, node->keys[mid])) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+
+  return lo;
+}
+
+// Returns the index of the first key of the node that is not less than the key.
+static size_t lower_bound(btree_node_t *node, void *key, cdc_binary_pred_fn_t cmp)
+{
+  size_t lo = 0;
+  size_t hi = node->size;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (cmp(node->keys[mid], key)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+static size_t upper_bound_probe(btree_node_t *node, const void *probe, const probe_info_t *info)
+{
+  size_t lo = 0;
+  size_t hi = node->size;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (info->compare(probe, node->keys[mid]) < 0) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+
+  return lo;
+}
+
+static size_t lower_bound_probe(btree_node_t *node, const void *probe, const probe_info_t *info)
+{
+  size_t lo = 0;
+  size_t hi = node->size;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (info->compare(probe, node->keys[mid]) > 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+static btree_leaf_t *find_leaf(btree_t *t, void *key)
+{
+  btree_node_t *node = t->root;
+  if (!node) {
+    return NULL;
+  }
+
+  while (!node->is_leaf) {
+    node = as_inner(node)->children[upper_bound(node, key, t->dinfo->cmp)];
+  }
+
+  return as_leaf(node);
+}
+
+// Finds the leaf and the index where the key is or must be inserted. Returns
+// true if the key is found.
+static bool find_pos(btree_t *t, void *key, btree_leaf_t **leaf, size_t *index)
+{
+  *leaf = find_leaf(t, key);
+  *index = 0;
+  if (!*leaf) {
+    return false;
+  }
+
+  btree_node_t *node = &(*leaf)->base;
+  *index = lower_bound(node, key, t->dinfo->cmp);
+  return *index < node->size && !t->dinfo->cmp(key, node->keys[*index]);
+}
+
+static bool find_pos_by_probe(btree_t *t, const void *probe, const probe_info_t *info,
+                              btree_leaf_t **leaf, size_t *index)
+{
+  btree_node_t *node = t->root;
+  if (!node) {
+    return false;
+  }
+
+  while (!node->is_leaf) {
+    node = as_inner(node)->children[upper_bound_probe(node, probe, info)];
+  }
+
+  *leaf = as_leaf(node);
+  *index = lower_bound_probe(node, probe, info);
+  return *index < node->size && info->compare(probe, node->keys[*index]) == 0;
+}
+
+static void set_iter(btree_t *t, btree_leaf_t *leaf, size_t index, btree_iter_t *it)
+{
+  it->container = t;
+  it->leaf = leaf;
+  it->index = index;
+}
+
+// Sets the iterator to the key at the index of the leaf, or to the first key
+// of the next leaf if the index is past the keys of the leaf.
+static void set_bound_iter(btree_t *t, btree_leaf_t *leaf, size_t index, btree_iter_t *it)
+{
+  if (leaf && index == leaf->base.size) {
+    leaf = leaf->next;
+    index = 0;
+  }
+
+  set_iter(t, leaf, index, it);
+}
+
+static size_t child_index(btree_inner_t *parent, btree_node_t *child)
+{
+  size_t i = 0;
+  while (parent->children[i] != child) {
+    ++i;
+  }
+
+  return i;
+}
+
+static void leaf_insert_at(btree_leaf_t *leaf, size_t index, void *key, void *value)
+{
+  size_t count = leaf->base.size - index;
+  memmove(leaf->base.keys + index + 1, leaf->base.keys + index, count * sizeof(void *));
+  memmove(leaf->values + index + 1, leaf->values + index, count * sizeof(void *));
+  leaf->base.keys[index] = key;
+  leaf->values[index] = value;
+  ++leaf->base.size;
+}
+
+static void leaf_erase_at(btree_leaf_t *leaf, size_t index)
+{
+  size_t count = leaf->base.size - index - 1;
+  memmove(leaf->base.keys + index, leaf->base.keys + index + 1, count * sizeof(void *));
+  memmove(leaf->values + index, leaf->values + index + 1, count * sizeof(void *));
+  --leaf->base.size;
+}
+
+// Inserts the key and the child after it at the index of the key.
+static void inner_insert_at(btree_inner_t *inner, size_t index, void *key, btree_node_t *child)
+{
+  size_t count = inner->base.size - index;
+  memmove(inner->base.keys + index + 1, inner->base.keys + index, count * sizeof(void *));
+  memmove(inner->children + index + 2, inner->children + index + 1, count * sizeof(void *));
+  inner->base.keys[index] = key;
+  inner->children[index + 1] = child;
+  child->parent = &inner->base;
+  ++inner->base.size;
+}
+
+// Removes the key and the child after it at the index of the key.
+static void inner_erase_at(btree_inner_t *inner, size_t index)
+{
+  size_t count = inner->base.size - index - 1;
+  memmove(inner->base.keys + index, inner->base.keys + index + 1, count * sizeof(void *));
+  memmove(inner->children + index + 1, inner->children + index + 2, count * sizeof(void *));
+  --inner->base.size;
+}
+
+// Moves the upper half of the full leaf to the empty one after it.
+static void split_leaf(btree_t *t, btree_leaf_t *leaf, btree_leaf_t *right)
+{
+  size_t count = CDC_BTREE_ORDER - BTREE_MIN_SIZE;
+  memcpy(right->base.keys, leaf->base.keys + BTREE_MIN_SIZE, count * sizeof(void *));
+  memcpy(right->values, leaf->values + BTREE_MIN_SIZE, count * sizeof(void *));
+  right->base.size = (unsigned)count;
+  leaf->base.size = BTREE_MIN_SIZE;
+  right->prev = leaf;
+  right->next = leaf->next;
+  if (leaf->next) {
+    leaf->next->prev = right;
+  } else {
+    t->last = right;
+  }
+
+  leaf->next = right;
+}
+
+// Splits the full inner node, to which the key and the child after it are
+// inserted at the index of the key, into halves of BTREE_MIN_SIZE keys with the
+// empty right node and returns the middle key, which goes to the parent.
+static void *split_inner(btree_inner_t *inner, btree_inner_t *right, size_t index, void *key,
+                         btree_node_t *child)
+{
+  size_t mid = index < BTREE_MIN_SIZE ? BTREE_MIN_SIZE - 1 : BTREE_MIN_SIZE;
+  void *middle = NULL;
+  if (index == BTREE_MIN_SIZE) {
+    middle = key;
+    right->children[0] = child;
+    memcpy(right->base.keys, inner->base.keys + mid, BTREE_MIN_SIZE * sizeof(void *));
+    memcpy(right->children + 1, inner->children + mid + 1, BTREE_MIN_SIZE * sizeof(void *));
+  } else {
+    size_t count = CDC_BTREE_ORDER - mid - 1;
+    middle = inner->base.keys[mid];
+    memcpy(right->base.keys, inner->base.keys + mid + 1, count * sizeof(void *));
+    memcpy(right->children, inner->children + mid + 1, (count + 1) * sizeof(void *));
+  }
+
+  right->base.size = (unsigned)(CDC_BTREE_ORDER - mid - (index != BTREE_MIN_SIZE));
+  inner->base.size = (unsigned)mid;
+  for (size_t i = 0; i <= right->base.size; ++i) {
+    right->children[i]->parent = &right->base;
+  }
+
+  if (index < BTREE_MIN_SIZE) {
+    inner_insert_at(inner, index, key, child);
+  } else if (index > BTREE_MIN_SIZE) {
+    inner_insert_at(right, index - mid - 1, key, child);
+  }
+
+  return middle;
+}
+
+// Inserts the key and the right node after the left one into their parent and
+// splits the full parents with the preallocated spare nodes.
+static void insert_into_parent(btree_t *t, btree_node_t *left, void *key, btree_node_t *right,
+                               btree_inner_t **spares, size_t *spare_count)
+{
+  while (left->parent) {
+    btree_inner_t *parent = as_inner(left->parent);
+    size_t index = child_index(parent, left);
+    if (parent->base.size < CDC_BTREE_ORDER) {
+      inner_insert_at(parent, index, key, right);
+      return;
+    }
+
+    btree_inner_t *sibling = spares[--*spare_count];
+    void *middle = split_inner(parent, sibling, index, key, right);
+    left = &parent->base;
+    key = middle;
+    right = &sibling->base;
+  }
+
+  btree_inner_t *root = spares[--*spare_count];
+  root->base.size = 1;
+  root->base.keys[0] = key;
+  root->children[0] = left;
+  root->children[1] = right;
+  left->parent = &root->base;
+  right->parent = &root->base;
+  t->root = &root->base;
+}
+
+// Inserts the key that is not in the tree at the found position. All the nodes
+// are allocated before the tree is changed, so it stays valid on failure.
+static stat_t insert_new(btree_t *t, btree_leaf_t *leaf, size_t index, void *key, void *value,
+                         btree_iter_t *it)
+{
+  if (!leaf) {
+    if (!(leaf = make_leaf(t))) {
+      return CDC_STATUS_BAD_ALLOC;
+    }
+
+    t->root = &leaf->base;
+    t->first = leaf;
+    t->last = leaf;
+  }
+
+  if (leaf->base.size < CDC_BTREE_ORDER) {
+    leaf_insert_at(leaf, index, key, value);
+    ++t->size;
+    if (it) {
+      set_iter(t, leaf, index, it);
+    }
+
+    return CDC_STATUS_OK;
+  }
+
+  btree_inner_t *spares[BTREE_MAX_SPLITS];
+  size_t spare_count = 0;
+  btree_node_t *node = leaf->base.parent;
+  while (node && node->size == CDC_BTREE_ORDER) {
+    node = node->parent;
+    ++spare_count;
+  }
+
+  // A new root is needed if the root is split.
+  spare_count += node == NULL;
+  btree_leaf_t *right = make_leaf(t);
+  size_t made = 0;
+  while (made < spare_count && right && (spares[made] = make_inner(t))) {
+    ++made;
+  }
+
+  if (made < spare_count || !right) {
+    while (made) {
+      free_node(t, &spares[--made]->base);
+    }
+
+    if (right) {
+      free_node(t, &right->base);
+    }
+
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  split_leaf(t, leaf, right);
+  if (index > leaf->base.size) {
+    index -= leaf->base.size;
+    leaf = right;
+  }
+
+  leaf_insert_at(leaf, index, key, value);
+  ++t->size;
+  insert_into_parent(t, &right->prev->base, right->base.keys[0], &right->base, spares,
+                     &spare_count);
+  if (it) {
+    set_iter(t, leaf, index, it);
+  }
+
+  return CDC_STATUS_OK;
+}
+
+static void borrow_from_left(btree_inner_t *parent, size_t index, btree_node_t *node,
+                             btree_node_t *left)
+{
+  memmove(node->keys + 1, node->keys, node->size * sizeof(void *));
+  if (node->is_leaf) {
+    btree_leaf_t *leaf = as_leaf(node);
+    btree_leaf_t *left_leaf = as_leaf(left);
+    memmove(leaf->values + 1, leaf->values, node->size * sizeof(void *));
+    node->keys[0] = left->keys[left->size - 1];
+    leaf->values[0] = left_leaf->values[left->size - 1];
+    parent->base.keys[index - 1] = node->keys[0];
+  } else {
+    btree_inner_t *inner = as_inner(node);
+    btree_inner_t *left_inner = as_inner(left);
+    memmove(inner->children + 1, inner->children, (node->size + 1) * sizeof(void *));
+    node->keys[0] = parent->base.keys[index - 1];
+    inner->children[0] = left_inner->children[left->size];
+    inner->children[0]->parent = node;
+    parent->base.keys[index - 1] = left->keys[left->size - 1];
+  }
+
+  --left->size;
+  ++node->size;
+}
+
+static void borrow_from_right(btree_inner_t *parent, size_t index, btree_node_t *node,
+                              btree_node_t *right)
+{
+  if (node->is_leaf) {
+    btree_leaf_t *leaf = as_leaf(node);
+    btree_leaf_t *right_leaf = as_leaf(right);
+    node->keys[node->size] = right->keys[0];
+    leaf->values[node->size] = right_leaf->values[0];
+    ++node->size;
+    leaf_erase_at(right_leaf, 0);
+    parent->base.keys[index] = right->keys[0];
+  } else {
+    btree_inner_t *inner = as_inner(node);
+    btree_inner_t *right_inner = as_inner(right);
+    node->keys[node->size] = parent->base.keys[index];
+    inner->children[node->size + 1] = right_inner->children[0];
+    inner->children[node->size + 1]->parent = node;
+    ++node->size;
+    parent->base.keys[index] = right->keys[0];
+    memmove(right->keys, right->keys + 1, (right->size - 1) * sizeof(void *));
+    memmove(right_inner->children, right_inner->children + 1, right->size * sizeof(void *));
+    --right->size;
+  }
+}
+
+// Moves the right node to the left one, which is the child at the index of the
+// parent, and removes the right node from the parent.
+static void merge(btree_t *t, btree_inner_t *parent, size_t index, btree_node_t *left,
+                  btree_node_t *right)
+{
+  if (left->is_leaf) {
+    btree_leaf_t *left_leaf = as_leaf(left);
+    btree_leaf_t *right_leaf = as_leaf(right);
+    memcpy(left->keys + left->size, right->keys, right->size * sizeof(void *));
+    memcpy(left_leaf->values + left->size, right_leaf->values, right->size * sizeof(void *));
+    left->size += right->size;
+    left_leaf->next = right_leaf->next;
+    if (right_leaf->next) {
+      right_leaf->next->prev = left_leaf;
+    } else {
+      t->last = left_leaf;
+    }
+  } else {
+    btree_inner_t *left_inner = as_inner(left);
+    btree_inner_t *right_inner = as_inner(right);
+    left->keys[left->size] = parent->base.keys[index];
+    memcpy(left->keys + left->size + 1, right->keys, right->size * sizeof(void *));
+    memcpy(left_inner->children + left->size + 1, right_inner->children,
+           (right->size + 1) * sizeof(void *));
+    for (size_t i = 0; i <= right->size; ++i) {
+      right_inner->children[i]->parent = left;
+    }
+
+    left->size += right->size + 1;
+  }
+
+  inner_erase_at(parent, index);
+  free_node(t, right);
+}
+
+// Restores the minimal size of the node after an erasure by borrowing a key
+// from a sibling or merging with it, which can make the parent too small.
+static void rebalance(btree_t *t, btree_node_t *node)
+{
+  while (node != t->root) {
+    if (node->size >= BTREE_MIN_SIZE) {
+      return;
+    }
+
+    btree_inner_t *parent = as_inner(node->parent);
+    size_t index = child_index(parent, node);
+    btree_node_t *left = index > 0 ? parent->children[index - 1] : NULL;
+    btree_node_t *right = index < parent->base.size ? parent->children[index + 1] : NULL;
+    if (left && left->size > BTREE_MIN_SIZE) {
+      borrow_from_left(parent, index, node, left);
+      return;
+    }
+
+    if (right && right->size > BTREE_MIN_SIZE) {
+      borrow_from_right(parent, index, node, right);
+      return;
+    }
+
+    if (left) {
+      merge(t, parent, index - 1, left, node);
+    } else {
+      merge(t, parent, index, node, right);
+    }
+
+    node = &parent->base;
+  }
+
+  if (node->size > 0) {
+    return;
+  }
+
+  if (node->is_leaf) {
+    t->root = NULL;
+    t->first = NULL;
+    t->last = NULL;
+  } else {
+    t->root = as_inner(node)->children[0];
+    t->root->parent = NULL;
+  }
+
+  free_node(t, node);
+}
+
+static stat_t init_varg(btree_t *t, va_list args)
+{
+  pair_t *pair = NULL;
+  while ((pair = va_arg(args, pair_t *)) != CDC_END) {
+    stat_t stat = btree_insert(t, pair->first, pair->second, NULL);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  }
+
+  return CDC_STATUS_OK;
+}
+
+stat_t btree_ctor(btree_t **t, data_info_t *info)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+
+  btree_t *tmp = (btree_t *)di_calloc(info, sizeof(btree_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
+    di_free(info, tmp);
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  *t = tmp;
+  return CDC_STATUS_OK;
+}
+
+stat_t btree_ctorl(btree_t **t, data_info_t *info, ...)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+
+  va_list args;
+  va_start(args, info);
+  stat_t stat = btree_ctorv(t, info, args);
+  va_end(args);
+  return stat;
+}
+
+stat_t btree_ctorv(btree_t **t, data_info_t *info, va_list args)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+
+  stat_t stat = btree_ctor(t, info);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  return init_varg(*t, args);
+}
+
+void btree_dtor(btree_t *t)
+{
+  assert(t != NULL);
+
+  free_btree(t);
+  data_info_t *dinfo = t->dinfo;
+  di_free(dinfo, t);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t btree_memory_usage(btree_t *t)
+{
+  assert(t != NULL);
+
+  size_t bytes = sizeof(btree_t) + t->leaf_count * sizeof(btree_leaf_t) +
+                 t->inner_count * sizeof(btree_inner_t);
+  return memory_usage_make(bytes, t->size);
+}
+
+stat_t btree_get(btree_t *t, void *key, void **value)
+{
+  assert(t != NULL);
+
+  btree_leaf_t *leaf = NULL;
+  size_t index = 0;
+  if (find_pos(t, key, &leaf, &index)) {
+    *value = leaf->values[index];
+    return CDC_STATUS_OK;
+  }
+
+  return CDC_STATUS_NOT_FOUND;
+}
+
+size_t btree_count(btree_t *t, void *key)
+{
+  assert(t != NULL);
+
+  btree_leaf_t *leaf = NULL;
+  size_t index = 0;
+  return (size_t)find_pos(t, key, &leaf, &index);
+}
+
+void btree_find(btree_t *t, void *key, btree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  btree_leaf_t *leaf = NULL;
+  size_t index = 0;
+  if (find_pos(t, key, &leaf, &index)) {
+    set_iter(t, leaf, index, it);
+  } else {
+    btree_end(t, it);
+  }
+}
+
+void btree_lower_bound(btree_t *t, void *key, btree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  btree_leaf_t *leaf = find_leaf(t, key);
+  size_t index = leaf ? lower_bound(&leaf->base, key, t->dinfo->cmp) : 0;
+  set_bound_iter(t, leaf, index, it);
+}
+
+void btree_upper_bound(btree_t *t, void *key, btree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  btree_leaf_t *leaf = find_leaf(t, key);
+  size_t index = leaf ? upper_bound(&leaf->base, key, t->dinfo->cmp) : 0;
+  set_bound_iter(t, leaf, index, it);
+}
+
+void btree_equal_range(btree_t *t, void *key, pair_btree_iter_t *range)
+{
+  assert(t != NULL);
+  assert(range != NULL);
+
+  btree_lower_bound(t, key, &range->first);
+  range->second = range->first;
+  if (range->first.leaf &&
+      !t->dinfo->cmp(key, range->first.leaf->base.keys[range->first.index])) {
+    btree_iter_next(&range->second);
+  }
+}
+
+void btree_range(btree_t *t, void *from, void *to, pair_btree_iter_t *range)
+{
+  assert(t != NULL);
+  assert(range != NULL);
+  assert(!t->dinfo->cmp(to, from));
+
+  btree_lower_bound(t, from, &range->first);
+  btree_lower_bound(t, to, &range->second);
+}
+
+stat_t btree_get_probe(btree_t *t, const void *probe, const probe_info_t *info, void **value)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  btree_leaf_t *leaf = NULL;
+  size_t index = 0;
+  if (find_pos_by_probe(t, probe, info, &leaf, &index)) {
+    *value = leaf->values[index];
+    return CDC_STATUS_OK;
+  }
+
+  return CDC_STATUS_NOT_FOUND;
+}
+
+size_t btree_count_probe(btree_t *t, const void *probe, const probe_info_t *info)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  btree_leaf_t *leaf = NULL;
+  size_t index = 0;
+  return (size_t)find_pos_by_probe(t, probe, info, &leaf, &index);
+}
+
+void btree_find_probe(btree_t *t, const void *probe, const probe_info_t *info, btree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+  assert(it != NULL);
+
+  btree_leaf_t *leaf = NULL;
+  size_t index = 0;
+  if (find_pos_by_probe(t, probe, info, &leaf, &index)) {
+    set_iter(t, leaf, index, it);
+  } else {
+    btree_end(t, it);
+  }
+}
+
+stat_t btree_insert(btree_t *t, void *key, void *value, pair_btree_iter_bool_t *ret)
+{
+  assert(t != NULL);
+
+  btree_iter_t *it = NULL;
+  bool *inserted = NULL;
+  if (ret) {
+    it = &ret->first;
+    inserted = &ret->second;
+  }
+
+  return btree_insert1(t, key, value, it, inserted);
+}
+
+stat_t btree_insert1(btree_t *t, void *key, void *value, btree_iter_t *it, bool *inserted)
+{
+  assert(t != NULL);
+
+  btree_leaf_t *leaf = NULL;
+  size_t index = 0;
+  bool finded = find_pos(t, key, &leaf, &index);
+  if (!finded) {
+    stat_t stat = insert_new(t, leaf, index, key, value, it);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  } else if (it) {
+    set_iter(t, leaf, index, it);
+  }
+
+  if (inserted) {
+    *inserted = !finded;
+  }
+
+  return CDC_STATUS_OK;
+}
+
+stat_t btree_insert_or_assign(btree_t *t, void *key, void *value, pair_btree_iter_bool_t *ret)
+{
+  assert(t != NULL);
+
+  btree_iter_t *it = NULL;
+  bool *inserted = NULL;
+  if (ret) {
+    it = &ret->first;
+    inserted = &ret->second;
+  }
+
+  return btree_insert_or_assign1(t, key, value, it, inserted);
+}
+
+stat_t btree_insert_or_assign1(btree_t *t, void *key, void *value, btree_iter_t *it,
+                               bool *inserted)
+{
+  assert(t != NULL);
+
+  btree_leaf_t *leaf = NULL;
+  size_t index = 0;
+  bool finded = find_pos(t, key, &leaf, &index);
+  if (!finded) {
+    stat_t stat = insert_new(t, leaf, index, key, value, it);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  } else {
+    leaf->values[index] = value;
+    if (it) {
+      set_iter(t, leaf, index, it);
+    }
+  }
+
+  if (inserted) {
+    *inserted = !finded;
+  }
+
+  return CDC_STATUS_OK;
+}
+
+size_t btree_erase(btree_t *t, void *key)
+{
+  assert(t != NULL);
+
+  btree_leaf_t *leaf = NULL;
+  size_t index = 0;
+  if (!find_pos(t, key, &leaf, &index)) {
+    return 0;
+  }
+
+  if (CDC_HAS_DFREE(t->dinfo)) {
+    pair_t pair = {leaf->base.keys[index], leaf->values[index]};
+    t->dinfo->dfree(&pair);
+  }
+
+  leaf_erase_at(leaf, index);
+  --t->size;
+  rebalance(t, &leaf->base);
+  return 1;
+}
+
+void btree_clear(btree_t *t)
+{
+  assert(t != NULL);
+
+  free_btree(t);
+  t->size = 0;
+}
+
+void btree_swap(btree_t *a, btree_t *b)
+{
+  assert(a != NULL);
+  assert(b != NULL);
+
+  CDC_SWAP(btree_node_t *, a->root, b->root);
+  CDC_SWAP(btree_leaf_t *, a->first, b->first);
+  CDC_SWAP(btree_leaf_t *, a->last, b->last);
+  CDC_SWAP(size_t, a->size, b->size);
+  CDC_SWAP(size_t, a->leaf_count, b->leaf_count);
+  CDC_SWAP(size_t, a->inner_count, b->inner_count);
+  CDC_SWAP(data_info_t *, a->dinfo, b->dinfo);
+}
+
+void btree_begin(btree_t *t, btree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  set_iter(t, t->first, 0, it);
+}
+
+void btree_end(btree_t *t, btree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  set_iter(t, NULL, 0, it);
+}
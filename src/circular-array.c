@@ -51,7 +51,28 @@ static stat_t reallocate(circular_array_t *d, size_t capacity)
     return CDC_STATUS_OK;
   }
 
-  void **tmp = (void **)malloc(capacity * sizeof(void *));
+  if (capacity > d->capacity) {
+    // The buffer only grows, so realloc can extend it in place.
+    void **tmp = (void **)di_realloc(d->dinfo, d->buffer, capacity * sizeof(void *));
+    if (!tmp) {
+      return CDC_STATUS_BAD_ALLOC;
+    }
+
+    if (d->head > d->tail) {
+      //  _________________________________________________________________
+      //  | 4 | 5 | 6 | . | . | 1 | 2 | 3 | . | . | . | . | . | . | . | . |
+      //  -----------------------------------------------------------------
+      //  The elements before the head are moved after the old end.
+      memcpy(tmp + d->capacity, tmp, d->tail * sizeof(void *));
+      d->tail += d->capacity;
+    }
+
+    d->capacity = capacity;
+    d->buffer = tmp;
+    return CDC_STATUS_OK;
+  }
+
+  void **tmp = (void **)di_malloc(d->dinfo, capacity * sizeof(void *));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
@@ -70,7 +91,7 @@ static stat_t reallocate(circular_array_t *d, size_t capacity)
     memcpy(tmp, d->buffer + d->head, d->size * sizeof(void *));
   }
 
-  free(d->buffer);
+  di_free(d->dinfo, d->buffer);
   d->tail = d->size;
   d->head = 0;
   d->capacity = capacity;
@@ -112,7 +133,7 @@ stat_t circular_array_ctor(circular_array_t **d, data_info_t *info)
 {
   assert(d != NULL);
 
-  circular_array_t *tmp = (circular_array_t *)calloc(sizeof(circular_array_t), 1);
+  circular_array_t *tmp = (circular_array_t *)di_calloc(info, sizeof(circular_array_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
@@ -134,7 +155,7 @@ stat_t circular_array_ctor(circular_array_t **d, data_info_t *info)
 free_di:
   di_shared_dtor(tmp->dinfo);
 free_circular_array:
-  free(tmp);
+  di_free(info, tmp);
   return ret;
 }
 
@@ -166,9 +187,17 @@ void circular_array_dtor(circular_array_t *d)
   assert(d != NULL);
 
   free_data(d);
-  free(d->buffer);
-  di_shared_dtor(d->dinfo);
-  free(d);
+  di_free(d->dinfo, d->buffer);
+  data_info_t *dinfo = d->dinfo;
+  di_free(dinfo, d);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t circular_array_memory_usage(circular_array_t *d)
+{
+  assert(d != NULL);
+
+  return memory_usage_make(sizeof(circular_array_t) + d->capacity * sizeof(void *), d->size);
 }
 
 stat_t circular_array_at(circular_array_t *d, size_t index, void **elem)
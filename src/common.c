@@ -19,3 +19,39 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 #include "cdcontainers/common.h"
+
+static size_t str_view_hash(const void *probe)
+{
+  const struct cdc_str_view *view = (const struct cdc_str_view *)probe;
+  return cdc_hash_bytes(view->data, view->size, 0);
+}
+
+static int str_view_compare(const void *probe, const void *key)
+{
+  const struct cdc_str_view *view = (const struct cdc_str_view *)probe;
+  const char *str = (const char *)key;
+  for (size_t i = 0; i < view->size; ++i) {
+    unsigned char a = (unsigned char)view->data[i];
+    unsigned char b = (unsigned char)str[i];
+    // The key is a proper prefix of the view.
+    if (b == '\0') {
+      return 1;
+    }
+
+    if (a != b) {
+      return a < b ? -1 : 1;
+    }
+  }
+
+  // The view is a prefix of the key.
+  return str[view->size] == '\0' ? 0 : -1;
+}
+
+static int str_view_eq(const void *probe, const void *key)
+{
+  return str_view_compare(probe, key) == 0;
+}
+
+static const struct cdc_probe_info _str_view_probe = {str_view_hash, str_view_eq, str_view_compare};
+
+const struct cdc_probe_info *cdc_str_view_probe = &_str_view_probe;
@@ -0,0 +1,353 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "cdcontainers/concurrent-map.h"
+
+#include "cdcontainers/data-info.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONCURRENT_MAP_SHARD_COUNT 64  // must be pow 2
+#define CONCURRENT_MAP_LOAD_FACTOR 0.7f
+
+static size_t round_up_pow2(size_t n)
+{
+  size_t result = 1;
+  while (result < n) {
+    result <<= 1;
+  }
+
+  return result;
+}
+
+static unsigned log2_pow2(size_t n)
+{
+  unsigned result = 0;
+  while (n >>= 1) {
+    ++result;
+  }
+
+  return result;
+}
+
+// Shards are selected by the high bits of the mixed hash, and buckets of a
+// shard by the low bits, so keys of one shard are still spread over all its
+// buckets.
+static concurrent_map_shard_t *get_shard(concurrent_map_t *m, size_t hash)
+{
+  if (m->shard_count == 1) {
+    return &m->shards[0].shard;
+  }
+
+  return &m->shards[cdc_hash_mix(hash) >> m->shard_shift].shard;
+}
+
+static void read_lock(concurrent_map_shard_t *shard)
+{
+  int ret = pthread_rwlock_rdlock(&shard->lock);
+  assert(ret == 0);
+  CDC_UNUSED(ret);
+}
+
+static void write_lock(concurrent_map_shard_t *shard)
+{
+  int ret = pthread_rwlock_wrlock(&shard->lock);
+  assert(ret == 0);
+  CDC_UNUSED(ret);
+}
+
+static void unlock(concurrent_map_shard_t *shard)
+{
+  int ret = pthread_rwlock_unlock(&shard->lock);
+  assert(ret == 0);
+  CDC_UNUSED(ret);
+}
+
+static void free_shards(concurrent_map_t *m, size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    hash_table_dtor(m->shards[i].shard.table);
+    pthread_rwlock_destroy(&m->shards[i].shard.lock);
+  }
+}
+
+static stat_t init_shards(concurrent_map_t *m)
+{
+  stat_t stat = CDC_STATUS_OK;
+  size_t i = 0;
+  for (; i < m->shard_count; ++i) {
+    concurrent_map_shard_t *shard = &m->shards[i].shard;
+    // Writers of a shard change the fields of its table, so the tables must not
+    // share cache lines either.
+    stat = hash_table_ctor2(&shard->table, m->dinfo, CONCURRENT_MAP_LOAD_FACTOR,
+                            CDC_HASH_TABLE_CACHE_ALIGNED);
+    if (stat != CDC_STATUS_OK) {
+      goto free_shards;
+    }
+
+    if (pthread_rwlock_init(&shard->lock, NULL) != 0) {
+      hash_table_dtor(shard->table);
+      stat = CDC_STATUS_UNKN;
+      goto free_shards;
+    }
+  }
+
+  return CDC_STATUS_OK;
+free_shards:
+  free_shards(m, i);
+  return stat;
+}
+
+static void foreach_entry(concurrent_map_shard_t *shard,
+                          void (*cb)(void *key, void *value, void *arg), void *arg)
+{
+  hash_table_iter_t it = CDC_INIT_STRUCT;
+  hash_table_iter_t end = CDC_INIT_STRUCT;
+  hash_table_begin(shard->table, &it);
+  hash_table_end(shard->table, &end);
+  for (; !hash_table_iter_is_eq(&it, &end); hash_table_iter_next(&it)) {
+    cb(hash_table_iter_key(&it), hash_table_iter_value(&it), arg);
+  }
+}
+
+stat_t concurrent_map_ctor(concurrent_map_t **m, data_info_t *info)
+{
+  assert(m != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+
+  return concurrent_map_ctor1(m, info, CONCURRENT_MAP_SHARD_COUNT);
+}
+
+stat_t concurrent_map_ctor1(concurrent_map_t **m, data_info_t *info, size_t shard_count)
+{
+  assert(m != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(shard_count > 0);
+
+  concurrent_map_t *tmp = (concurrent_map_t *)di_calloc(info, sizeof(concurrent_map_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  stat_t stat = CDC_STATUS_OK;
+  if (!(tmp->dinfo = di_shared_ctorc(info))) {
+    stat = CDC_STATUS_BAD_ALLOC;
+    goto free_map;
+  }
+
+  tmp->shard_count = round_up_pow2(shard_count);
+  tmp->shard_shift = sizeof(size_t) * CHAR_BIT - log2_pow2(tmp->shard_count);
+  // Shards are aligned to cache lines, otherwise a padded shard could still
+  // share its first and last lines with the neighbours.
+  size_t size = tmp->shard_count * sizeof(concurrent_map_padded_shard_t);
+  tmp->shards = (concurrent_map_padded_shard_t *)cdc_aligned_malloc(CDC_ALLOCATOR(tmp->dinfo),
+                                                                    CDC_CACHE_LINE_SIZE, size);
+  if (!tmp->shards) {
+    stat = CDC_STATUS_BAD_ALLOC;
+    goto free_di;
+  }
+
+  memset(tmp->shards, 0, size);
+  stat = init_shards(tmp);
+  if (stat != CDC_STATUS_OK) {
+    goto free_shards;
+  }
+
+  *m = tmp;
+  return CDC_STATUS_OK;
+free_shards:
+  cdc_aligned_free(CDC_ALLOCATOR(tmp->dinfo), tmp->shards);
+free_di:
+  di_shared_dtor(tmp->dinfo);
+free_map:
+  di_free(info, tmp);
+  return stat;
+}
+
+void concurrent_map_dtor(concurrent_map_t *m)
+{
+  assert(m != NULL);
+
+  free_shards(m, m->shard_count);
+  cdc_aligned_free(CDC_ALLOCATOR(m->dinfo), m->shards);
+  data_info_t *dinfo = m->dinfo;
+  di_free(dinfo, m);
+  di_shared_dtor(dinfo);
+}
+
+stat_t concurrent_map_get(concurrent_map_t *m, void *key, void **value)
+{
+  assert(m != NULL);
+
+  size_t hash = m->dinfo->hash(key);
+  concurrent_map_shard_t *shard = get_shard(m, hash);
+  read_lock(shard);
+  stat_t stat = hash_table_get_hashed(shard->table, key, hash, value);
+  unlock(shard);
+  return stat;
+}
+
+size_t concurrent_map_count(concurrent_map_t *m, void *key)
+{
+  assert(m != NULL);
+
+  size_t hash = m->dinfo->hash(key);
+  concurrent_map_shard_t *shard = get_shard(m, hash);
+  read_lock(shard);
+  size_t count = hash_table_count_hashed(shard->table, key, hash);
+  unlock(shard);
+  return count;
+}
+
+size_t concurrent_map_size(concurrent_map_t *m)
+{
+  assert(m != NULL);
+
+  size_t size = 0;
+  for (size_t i = 0; i < m->shard_count; ++i) {
+    concurrent_map_shard_t *shard = &m->shards[i].shard;
+    read_lock(shard);
+    size += hash_table_size(shard->table);
+    unlock(shard);
+  }
+
+  return size;
+}
+
+void concurrent_map_clear(concurrent_map_t *m)
+{
+  assert(m != NULL);
+
+  for (size_t i = 0; i < m->shard_count; ++i) {
+    concurrent_map_shard_t *shard = &m->shards[i].shard;
+    write_lock(shard);
+    hash_table_clear(shard->table);
+    unlock(shard);
+  }
+}
+
+stat_t concurrent_map_insert(concurrent_map_t *m, void *key, void *value, bool *inserted)
+{
+  assert(m != NULL);
+
+  size_t hash = m->dinfo->hash(key);
+  concurrent_map_shard_t *shard = get_shard(m, hash);
+  write_lock(shard);
+  stat_t stat = hash_table_insert_hashed(shard->table, key, hash, value, NULL, inserted);
+  unlock(shard);
+  return stat;
+}
+
+stat_t concurrent_map_insert_or_assign(concurrent_map_t *m, void *key, void *value,
+                                       bool *inserted)
+{
+  assert(m != NULL);
+
+  size_t hash = m->dinfo->hash(key);
+  concurrent_map_shard_t *shard = get_shard(m, hash);
+  write_lock(shard);
+  stat_t stat = hash_table_insert_or_assign_hashed(shard->table, key, hash, value, NULL, inserted);
+  unlock(shard);
+  return stat;
+}
+
+stat_t concurrent_map_compute_if_absent(concurrent_map_t *m, void *key,
+                                        void *(*compute)(void *key, void *arg), void *arg,
+                                        void **value, bool *inserted)
+{
+  assert(m != NULL);
+  assert(compute != NULL);
+
+  size_t hash = m->dinfo->hash(key);
+  concurrent_map_shard_t *shard = get_shard(m, hash);
+  // Most calls find the key, so the read lock is tried first.
+  void *finded = NULL;
+  read_lock(shard);
+  stat_t stat = hash_table_get_hashed(shard->table, key, hash, &finded);
+  unlock(shard);
+  bool is_inserted = false;
+  if (stat == CDC_STATUS_NOT_FOUND) {
+    write_lock(shard);
+    stat = hash_table_get_hashed(shard->table, key, hash, &finded);
+    if (stat == CDC_STATUS_NOT_FOUND) {
+      finded = compute(key, arg);
+      stat = hash_table_insert_hashed(shard->table, key, hash, finded, NULL, NULL);
+      is_inserted = stat == CDC_STATUS_OK;
+    }
+
+    unlock(shard);
+  }
+
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  if (value) {
+    *value = finded;
+  }
+
+  if (inserted) {
+    *inserted = is_inserted;
+  }
+
+  return CDC_STATUS_OK;
+}
+
+size_t concurrent_map_erase(concurrent_map_t *m, void *key)
+{
+  assert(m != NULL);
+
+  size_t hash = m->dinfo->hash(key);
+  concurrent_map_shard_t *shard = get_shard(m, hash);
+  write_lock(shard);
+  size_t count = hash_table_erase_hashed(shard->table, key, hash);
+  unlock(shard);
+  return count;
+}
+
+void concurrent_map_shard_foreach(concurrent_map_t *m, size_t shard,
+                                  void (*cb)(void *key, void *value, void *arg), void *arg)
+{
+  assert(m != NULL);
+  assert(shard < m->shard_count);
+  assert(cb != NULL);
+
+  concurrent_map_shard_t *s = &m->shards[shard].shard;
+  read_lock(s);
+  foreach_entry(s, cb, arg);
+  unlock(s);
+}
+
+void concurrent_map_foreach(concurrent_map_t *m, void (*cb)(void *key, void *value, void *arg),
+                            void *arg)
+{
+  assert(m != NULL);
+  assert(cb != NULL);
+
+  for (size_t i = 0; i < m->shard_count; ++i) {
+    concurrent_map_shard_foreach(m, i, cb, arg);
+  }
+}
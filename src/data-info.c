@@ -25,17 +25,94 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef CDC_MEMORY_COUNTER
+// The header before the memory keeps its size and keeps the memory aligned for
+// any type.
+union header {
+  size_t size;
+  long double ld;
+  void *ptr;
+  long long ll;
+};
+
+static size_t live_bytes = 0;
+
+static void *counted(union header *h, size_t size)
+{
+  if (!h) {
+    return NULL;
+  }
+
+  h->size = size;
+  __atomic_add_fetch(&live_bytes, size, __ATOMIC_RELAXED);
+  return h + 1;
+}
+
+void *cdc_counted_malloc(size_t size)
+{
+  return counted((union header *)malloc(sizeof(union header) + size), size);
+}
+
+void *cdc_counted_calloc(size_t size)
+{
+  return counted((union header *)calloc(sizeof(union header) + size, 1), size);
+}
+
+void *cdc_counted_realloc(void *ptr, size_t size)
+{
+  if (!ptr) {
+    return cdc_counted_malloc(size);
+  }
+
+  union header *h = (union header *)ptr - 1;
+  size_t old_size = h->size;
+  h = (union header *)realloc(h, sizeof(union header) + size);
+  if (!h) {
+    return NULL;
+  }
+
+  __atomic_sub_fetch(&live_bytes, old_size, __ATOMIC_RELAXED);
+  return counted(h, size);
+}
+
+void cdc_counted_free(void *ptr)
+{
+  if (ptr) {
+    union header *h = (union header *)ptr - 1;
+    __atomic_sub_fetch(&live_bytes, h->size, __ATOMIC_RELAXED);
+    free(h);
+  }
+}
+
+size_t cdc_live_bytes(void)
+{
+  return __atomic_load_n(&live_bytes, __ATOMIC_RELAXED);
+}
+#else
+size_t cdc_live_bytes(void)
+{
+  return 0;
+}
+#endif
+
+// Containers keep a copy of the data info of the caller, which is never
+// modified, so several threads can construct containers from the same struct.
+// The copy has a reference count of at least 1 and is shared by containers that
+// are constructed from it, such as the shards of a cdc_concurrent_map. The data
+// info of a caller has a zero count.
 data_info_t *di_shared_ctorc(data_info_t *other)
 {
   assert(other != NULL);
 
-  if (other->__cnt++ != 0) {
+  if (__atomic_load_n(&other->__cnt, __ATOMIC_RELAXED) != 0) {
+    __atomic_add_fetch(&other->__cnt, 1, __ATOMIC_RELAXED);
     return other;
   }
 
-  data_info_t *result = (data_info_t *)malloc(sizeof(data_info_t));
+  data_info_t *result = (data_info_t *)di_malloc(other, sizeof(data_info_t));
   if (result) {
     memcpy(result, other, sizeof(data_info_t));
+    result->__cnt = 1;
   }
 
   return result;
@@ -43,7 +120,8 @@ data_info_t *di_shared_ctorc(data_info_t *other)
 
 void di_shared_dtor(data_info_t *info)
 {
-  if (info && --info->__cnt == 0) {
-    free(info);
+  // The last owner must see all the writes of the others before freeing.
+  if (info && __atomic_sub_fetch(&info->__cnt, 1, __ATOMIC_ACQ_REL) == 0) {
+    di_free(info, info);
   }
 }
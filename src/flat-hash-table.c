@@ -0,0 +1,613 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "cdcontainers/flat-hash-table.h"
+
+#include "cdcontainers/data-info.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define FLAT_HASH_TABLE_GROUP_WIDTH 16
+#define FLAT_HASH_TABLE_MIN_CAPACITY 16  // must be pow 2 and not less than a group width
+#define FLAT_HASH_TABLE_COPACITY_SHIFT 1
+#define FLAT_HASH_TABLE_LOAD_FACTOR 0.875f
+
+// A control byte of an occupied slot holds the 7 low bits of the hash (h2), so
+// it is never negative. Free slots are marked by negative values.
+#define CTRL_EMPTY ((int8_t)-128)
+#define CTRL_DELETED ((int8_t)-2)
+
+// Bit i of a group mask corresponds to the slot i of a group.
+#if defined(__SSE2__)
+static unsigned group_match(const int8_t *group, int8_t h2)
+{
+  __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+  return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl));
+}
+
+static unsigned group_match_free(const int8_t *group)
+{
+  __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+  return (unsigned)_mm_movemask_epi8(ctrl);
+}
+#else
+static unsigned group_match(const int8_t *group, int8_t h2)
+{
+  unsigned mask = 0;
+  for (unsigned i = 0; i < FLAT_HASH_TABLE_GROUP_WIDTH; ++i) {
+    mask |= (unsigned)(group[i] == h2) << i;
+  }
+
+  return mask;
+}
+
+static unsigned group_match_free(const int8_t *group)
+{
+  unsigned mask = 0;
+  for (unsigned i = 0; i < FLAT_HASH_TABLE_GROUP_WIDTH; ++i) {
+    mask |= (unsigned)(group[i] < 0) << i;
+  }
+
+  return mask;
+}
+#endif
+
+static unsigned group_match_empty(const int8_t *group)
+{
+  return group_match(group, CTRL_EMPTY);
+}
+
+static unsigned lowest_bit(unsigned mask)
+{
+  assert(mask != 0);
+
+#if defined(__GNUC__)
+  return (unsigned)__builtin_ctz(mask);
+#else
+  unsigned i = 0;
+  while (!(mask & 1)) {
+    mask >>= 1;
+    ++i;
+  }
+
+  return i;
+#endif
+}
+
+// Slot selection uses both ends of the hash, so user hashes with weak bits
+// (e.g. identity hashes of integers) are mixed first.
+static size_t get_hash(flat_hash_table_t *t, void *key)
+{
+  return cdc_hash_mix(t->dinfo->hash(key));
+}
+
+static size_t get_h1(size_t hash)
+{
+  return hash >> 7;
+}
+
+static int8_t get_h2(size_t hash)
+{
+  return (int8_t)(hash & 0x7f);
+}
+
+static size_t capacity_to_growth(size_t capacity, double load_factor)
+{
+  size_t growth = (size_t)((double)capacity * load_factor);
+  // At least one slot must stay empty, otherwise a probe of an absent key
+  // never stops.
+  return growth < capacity ? growth : capacity - 1;
+}
+
+static void free_entry(flat_hash_table_t *t, flat_hash_table_entry_t *entry)
+{
+  if (CDC_HAS_DFREE(t->dinfo)) {
+    pair_t pair = {entry->key, entry->value};
+    t->dinfo->dfree(&pair);
+  }
+}
+
+static void free_entries(flat_hash_table_t *t)
+{
+  if (!CDC_HAS_DFREE(t->dinfo)) {
+    return;
+  }
+
+  for (size_t i = 0; i < t->capacity; ++i) {
+    if (t->ctrl[i] >= 0) {
+      free_entry(t, &t->slots[i]);
+    }
+  }
+}
+
+// Groups are probed with the triangular sequence, which visits every group when
+// the number of groups is a power of 2.
+// |eq| is called as eq(key, stored key), so |key| may be a probe.
+static size_t find_slot(flat_hash_table_t *t, const void *key, cdc_binary_pred_fn_t eq,
+                        size_t hash)
+{
+  size_t gmask = t->capacity / FLAT_HASH_TABLE_GROUP_WIDTH - 1;
+  size_t group = get_h1(hash) & gmask;
+  int8_t h2 = get_h2(hash);
+  for (size_t step = 1;; ++step) {
+    const int8_t *ctrl = t->ctrl + group * FLAT_HASH_TABLE_GROUP_WIDTH;
+    for (unsigned mask = group_match(ctrl, h2); mask; mask &= mask - 1) {
+      size_t i = group * FLAT_HASH_TABLE_GROUP_WIDTH + lowest_bit(mask);
+      if (t->slots[i].hash == hash && eq(key, t->slots[i].key)) {
+        return i;
+      }
+    }
+
+    if (group_match_empty(ctrl)) {
+      return t->capacity;
+    }
+
+    group = (group + step) & gmask;
+  }
+}
+
+static size_t find_probe(flat_hash_table_t *t, const void *probe, const probe_info_t *info)
+{
+  return find_slot(t, probe, info->eq, cdc_hash_mix(info->hash(probe)));
+}
+
+static size_t find_free_slot(int8_t *ctrl, size_t capacity, size_t hash)
+{
+  size_t gmask = capacity / FLAT_HASH_TABLE_GROUP_WIDTH - 1;
+  size_t group = get_h1(hash) & gmask;
+  for (size_t step = 1;; ++step) {
+    unsigned mask = group_match_free(ctrl + group * FLAT_HASH_TABLE_GROUP_WIDTH);
+    if (mask) {
+      return group * FLAT_HASH_TABLE_GROUP_WIDTH + lowest_bit(mask);
+    }
+
+    group = (group + step) & gmask;
+  }
+}
+
+static size_t next_full_slot(flat_hash_table_t *t, size_t i)
+{
+  while (i < t->capacity && t->ctrl[i] < 0) {
+    ++i;
+  }
+
+  return i;
+}
+
+static stat_t reallocate(flat_hash_table_t *t, size_t capacity)
+{
+  assert(capacity >= FLAT_HASH_TABLE_MIN_CAPACITY);
+  assert(capacity_to_growth(capacity, t->load_factor) >= t->size);
+
+  flat_hash_table_entry_t *slots = (flat_hash_table_entry_t *)di_malloc(
+      t->dinfo, capacity * sizeof(flat_hash_table_entry_t) + capacity * sizeof(int8_t));
+  if (!slots) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  int8_t *ctrl = (int8_t *)(slots + capacity);
+  memset(ctrl, CTRL_EMPTY, capacity * sizeof(int8_t));
+  for (size_t i = 0; i < t->capacity; ++i) {
+    if (t->ctrl[i] >= 0) {
+      size_t hash = t->slots[i].hash;
+      size_t j = find_free_slot(ctrl, capacity, hash);
+      ctrl[j] = get_h2(hash);
+      slots[j] = t->slots[i];
+    }
+  }
+
+  di_free(t->dinfo, t->slots);
+  t->slots = slots;
+  t->ctrl = ctrl;
+  t->capacity = capacity;
+  t->growth_left = capacity_to_growth(capacity, t->load_factor) - t->size;
+  return CDC_STATUS_OK;
+}
+
+static stat_t grow(flat_hash_table_t *t)
+{
+  // If more than a half of the used slots are tombstones, it is enough to drop
+  // them instead of growing.
+  size_t capacity = t->capacity;
+  if (t->size >= capacity_to_growth(capacity, t->load_factor) / 2) {
+    do {
+      capacity <<= FLAT_HASH_TABLE_COPACITY_SHIFT;
+    } while (capacity_to_growth(capacity, t->load_factor) <= t->size);
+  }
+
+  return reallocate(t, capacity);
+}
+
+static stat_t insert_unique(flat_hash_table_t *t, void *key, void *value, size_t hash,
+                            size_t *ret)
+{
+  size_t i = find_free_slot(t->ctrl, t->capacity, hash);
+  if (t->growth_left == 0 && t->ctrl[i] == CTRL_EMPTY) {
+    stat_t stat = grow(t);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+
+    i = find_free_slot(t->ctrl, t->capacity, hash);
+  }
+
+  t->growth_left -= t->ctrl[i] == CTRL_EMPTY;
+  t->ctrl[i] = get_h2(hash);
+  t->slots[i].key = key;
+  t->slots[i].value = value;
+  t->slots[i].hash = hash;
+  ++t->size;
+  *ret = i;
+  return CDC_STATUS_OK;
+}
+
+static void erase_slot(flat_hash_table_t *t, size_t i)
+{
+  free_entry(t, &t->slots[i]);
+  // A probe sequence never passes a group with an empty slot, so no lookup
+  // depends on this slot being occupied and it can become empty again.
+  const int8_t *group = t->ctrl + (i & ~(size_t)(FLAT_HASH_TABLE_GROUP_WIDTH - 1));
+  if (group_match_empty(group)) {
+    t->ctrl[i] = CTRL_EMPTY;
+    ++t->growth_left;
+  } else {
+    t->ctrl[i] = CTRL_DELETED;
+  }
+
+  --t->size;
+}
+
+static stat_t init_varg(flat_hash_table_t *t, va_list args)
+{
+  pair_t *pair = NULL;
+  while ((pair = va_arg(args, pair_t *)) != CDC_END) {
+    stat_t stat = flat_hash_table_insert(t, pair->first, pair->second, NULL, NULL);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  }
+
+  return CDC_STATUS_OK;
+}
+
+stat_t flat_hash_table_ctor1(flat_hash_table_t **t, data_info_t *info, double load_factor)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(load_factor > 0 && load_factor < 1);
+
+  flat_hash_table_t *tmp = (flat_hash_table_t *)di_calloc(info, sizeof(flat_hash_table_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  tmp->load_factor = load_factor;
+  stat_t stat = CDC_STATUS_OK;
+  if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
+    stat = CDC_STATUS_BAD_ALLOC;
+    goto free_hash_table;
+  }
+
+  stat = reallocate(tmp, FLAT_HASH_TABLE_MIN_CAPACITY);
+  if (stat != CDC_STATUS_OK) {
+    goto free_di;
+  }
+
+  *t = tmp;
+  return stat;
+free_di:
+  di_shared_dtor(tmp->dinfo);
+free_hash_table:
+  di_free(info, tmp);
+  return stat;
+}
+
+stat_t flat_hash_table_ctorl1(flat_hash_table_t **t, data_info_t *info, double load_factor, ...)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(load_factor > 0 && load_factor < 1);
+
+  va_list args;
+  va_start(args, load_factor);
+  stat_t stat = flat_hash_table_ctorv1(t, info, load_factor, args);
+  va_end(args);
+  return stat;
+}
+
+stat_t flat_hash_table_ctorv1(flat_hash_table_t **t, data_info_t *info, double load_factor,
+                              va_list args)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(load_factor > 0 && load_factor < 1);
+
+  stat_t stat = flat_hash_table_ctor1(t, info, load_factor);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  return init_varg(*t, args);
+}
+
+stat_t flat_hash_table_ctor(flat_hash_table_t **t, data_info_t *info)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+
+  return flat_hash_table_ctor1(t, info, FLAT_HASH_TABLE_LOAD_FACTOR);
+}
+
+stat_t flat_hash_table_ctorl(flat_hash_table_t **t, data_info_t *info, ...)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+
+  va_list args;
+  va_start(args, info);
+  stat_t stat = flat_hash_table_ctorv(t, info, args);
+  va_end(args);
+  return stat;
+}
+
+stat_t flat_hash_table_ctorv(flat_hash_table_t **t, data_info_t *info, va_list args)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+
+  return flat_hash_table_ctorv1(t, info, FLAT_HASH_TABLE_LOAD_FACTOR, args);
+}
+
+void flat_hash_table_dtor(flat_hash_table_t *t)
+{
+  assert(t != NULL);
+
+  free_entries(t);
+  di_free(t->dinfo, t->slots);
+  data_info_t *dinfo = t->dinfo;
+  di_free(dinfo, t);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t flat_hash_table_memory_usage(flat_hash_table_t *t)
+{
+  assert(t != NULL);
+
+  size_t slot_size = sizeof(flat_hash_table_entry_t) + sizeof(int8_t);
+  return memory_usage_make(sizeof(flat_hash_table_t) + t->capacity * slot_size, t->size);
+}
+
+stat_t flat_hash_table_get(flat_hash_table_t *t, void *key, void **value)
+{
+  assert(t != NULL);
+
+  size_t i = find_slot(t, key, t->dinfo->eq, get_hash(t, key));
+  if (i == t->capacity) {
+    return CDC_STATUS_NOT_FOUND;
+  }
+
+  *value = t->slots[i].value;
+  return CDC_STATUS_OK;
+}
+
+size_t flat_hash_table_count(flat_hash_table_t *t, void *key)
+{
+  assert(t != NULL);
+
+  return (size_t)(find_slot(t, key, t->dinfo->eq, get_hash(t, key)) != t->capacity);
+}
+
+void flat_hash_table_find(flat_hash_table_t *t, void *key, flat_hash_table_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  it->container = t;
+  it->current = find_slot(t, key, t->dinfo->eq, get_hash(t, key));
+}
+
+stat_t flat_hash_table_get_probe(flat_hash_table_t *t, const void *probe, const probe_info_t *info,
+                                 void **value)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  size_t i = find_probe(t, probe, info);
+  if (i == t->capacity) {
+    return CDC_STATUS_NOT_FOUND;
+  }
+
+  *value = t->slots[i].value;
+  return CDC_STATUS_OK;
+}
+
+size_t flat_hash_table_count_probe(flat_hash_table_t *t, const void *probe,
+                                   const probe_info_t *info)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  return (size_t)(find_probe(t, probe, info) != t->capacity);
+}
+
+void flat_hash_table_find_probe(flat_hash_table_t *t, const void *probe, const probe_info_t *info,
+                                flat_hash_table_iter_t *it)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+  assert(it != NULL);
+
+  it->container = t;
+  it->current = find_probe(t, probe, info);
+}
+
+void flat_hash_table_clear(flat_hash_table_t *t)
+{
+  assert(t != NULL);
+
+  free_entries(t);
+  memset(t->ctrl, CTRL_EMPTY, t->capacity * sizeof(int8_t));
+  t->size = 0;
+  t->growth_left = capacity_to_growth(t->capacity, t->load_factor);
+}
+
+stat_t flat_hash_table_insert(flat_hash_table_t *t, void *key, void *value,
+                              flat_hash_table_iter_t *it, bool *inserted)
+{
+  assert(t != NULL);
+
+  size_t hash = get_hash(t, key);
+  size_t i = find_slot(t, key, t->dinfo->eq, hash);
+  bool finded = i != t->capacity;
+  if (!finded) {
+    stat_t stat = insert_unique(t, key, value, hash, &i);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  }
+
+  if (it) {
+    it->container = t;
+    it->current = i;
+  }
+
+  if (inserted) {
+    *inserted = !finded;
+  }
+
+  return CDC_STATUS_OK;
+}
+
+stat_t flat_hash_table_insert_or_assign(flat_hash_table_t *t, void *key, void *value,
+                                        flat_hash_table_iter_t *it, bool *inserted)
+{
+  assert(t != NULL);
+
+  size_t hash = get_hash(t, key);
+  size_t i = find_slot(t, key, t->dinfo->eq, hash);
+  bool finded = i != t->capacity;
+  if (!finded) {
+    stat_t stat = insert_unique(t, key, value, hash, &i);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  } else {
+    t->slots[i].value = value;
+  }
+
+  if (it) {
+    it->container = t;
+    it->current = i;
+  }
+
+  if (inserted) {
+    *inserted = !finded;
+  }
+
+  return CDC_STATUS_OK;
+}
+
+size_t flat_hash_table_erase(flat_hash_table_t *t, void *key)
+{
+  assert(t != NULL);
+
+  size_t i = find_slot(t, key, t->dinfo->eq, get_hash(t, key));
+  if (i == t->capacity) {
+    return 0;
+  }
+
+  erase_slot(t, i);
+  return 1;
+}
+
+void flat_hash_table_swap(flat_hash_table_t *a, flat_hash_table_t *b)
+{
+  assert(a != NULL);
+  assert(b != NULL);
+
+  CDC_SWAP(flat_hash_table_entry_t *, a->slots, b->slots);
+  CDC_SWAP(int8_t *, a->ctrl, b->ctrl);
+  CDC_SWAP(size_t, a->capacity, b->capacity);
+  CDC_SWAP(size_t, a->size, b->size);
+  CDC_SWAP(size_t, a->growth_left, b->growth_left);
+  CDC_SWAP(double, a->load_factor, b->load_factor);
+  CDC_SWAP(data_info_t *, a->dinfo, b->dinfo);
+}
+
+void flat_hash_table_begin(flat_hash_table_t *t, flat_hash_table_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  it->container = t;
+  it->current = next_full_slot(t, 0);
+}
+
+void flat_hash_table_set_max_load_factor(flat_hash_table_t *t, double load_factor)
+{
+  assert(t != NULL);
+  assert(load_factor > 0 && load_factor < 1);
+
+  size_t used = capacity_to_growth(t->capacity, t->load_factor) - t->growth_left;
+  size_t growth = capacity_to_growth(t->capacity, load_factor);
+  t->load_factor = load_factor;
+  t->growth_left = growth > used ? growth - used : 0;
+}
+
+stat_t flat_hash_table_rehash(flat_hash_table_t *t, size_t count)
+{
+  assert(t != NULL);
+
+  if (count <= t->capacity) {
+    return CDC_STATUS_OK;
+  }
+
+  count = cdc_up_to_pow2(count);
+  assert(count != 0);
+  return reallocate(t, count);
+}
+
+stat_t flat_hash_table_reserve(flat_hash_table_t *t, size_t count)
+{
+  assert(t != NULL);
+
+  return flat_hash_table_rehash(t, (size_t)((double)count / t->load_factor) + 1);
+}
+
+void flat_hash_table_iter_next(flat_hash_table_iter_t *it)
+{
+  assert(it != NULL);
+
+  it->current = next_full_slot(it->container, it->current + 1);
+}
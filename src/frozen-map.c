@@ -0,0 +1,365 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "cdcontainers/frozen-map.h"
+
+#include "cdcontainers/data-info.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Average number of keys in a bucket of the first level.
+#define FROZEN_MAP_BUCKET_SIZE 4
+#define FROZEN_MAP_MAX_SEED (1u << 16)
+#define FROZEN_MAP_MAX_ATTEMPTS 16
+// Displacements with this bit set hold the slot of the only key of a bucket.
+#define FROZEN_MAP_DIRECT_SLOT (1u << 31)
+#define FROZEN_MAP_SEED_STEP ((size_t)0x9e3779b97f4a7c15ULL)
+
+// Buffers used while the map is built.
+struct builder {
+  size_t *hashes;
+  size_t *order;
+  size_t *offsets;
+  size_t *buckets;
+  size_t *slots;
+  bool *taken;
+  data_info_t *dinfo;
+};
+
+static size_t get_bucket(size_t hash, size_t salt, size_t bcount)
+{
+  return cdc_hash_mix(hash ^ salt) % bcount;
+}
+
+static size_t get_slot(size_t hash, uint32_t seed, size_t size)
+{
+  return cdc_hash_mix(hash + seed * FROZEN_MAP_SEED_STEP) % size;
+}
+
+static size_t find_slot(frozen_map_t *m, size_t hash)
+{
+  uint32_t displacement = m->displacements[get_bucket(hash, m->salt, m->bcount)];
+  if (displacement & FROZEN_MAP_DIRECT_SLOT) {
+    return displacement & ~FROZEN_MAP_DIRECT_SLOT;
+  }
+
+  return get_slot(hash, displacement, m->size);
+}
+
+static void free_builder(struct builder *b)
+{
+  di_free(b->dinfo, b->hashes);
+  di_free(b->dinfo, b->order);
+  di_free(b->dinfo, b->offsets);
+  di_free(b->dinfo, b->buckets);
+  di_free(b->dinfo, b->slots);
+  di_free(b->dinfo, b->taken);
+}
+
+static stat_t init_builder(struct builder *b, data_info_t *info, size_t size, size_t bcount)
+{
+  b->dinfo = info;
+  b->hashes = (size_t *)di_malloc(info, size * sizeof(size_t));
+  b->order = (size_t *)di_malloc(info, size * sizeof(size_t));
+  b->offsets = (size_t *)di_malloc(info, (bcount + 1) * sizeof(size_t));
+  b->buckets = (size_t *)di_malloc(info, bcount * sizeof(size_t));
+  b->slots = (size_t *)di_malloc(info, size * sizeof(size_t));
+  b->taken = (bool *)di_malloc(info, size * sizeof(bool));
+  if (!b->hashes || !b->order || !b->offsets || !b->buckets || !b->slots || !b->taken) {
+    free_builder(b);
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  return CDC_STATUS_OK;
+}
+
+// Groups the keys by buckets and orders the non-empty buckets from the largest
+// to the smallest, since large buckets are easier to place into an empty
+// table. Returns the number of non-empty buckets.
+static size_t sort_buckets(frozen_map_t *m, struct builder *b)
+{
+  memset(b->offsets, 0, (m->bcount + 1) * sizeof(size_t));
+  for (size_t i = 0; i < m->size; ++i) {
+    ++b->offsets[get_bucket(b->hashes[i], m->salt, m->bcount) + 1];
+  }
+
+  size_t max_size = 0;
+  for (size_t i = 0; i < m->bcount; ++i) {
+    max_size = CDC_MAX(max_size, b->offsets[i + 1]);
+    b->offsets[i + 1] += b->offsets[i];
+  }
+
+  // slots is used as the positions of the next key of every bucket.
+  memcpy(b->slots, b->offsets, m->bcount * sizeof(size_t));
+  for (size_t i = 0; i < m->size; ++i) {
+    b->order[b->slots[get_bucket(b->hashes[i], m->salt, m->bcount)]++] = i;
+  }
+
+  size_t count = 0;
+  for (size_t size = max_size; size > 0; --size) {
+    for (size_t i = 0; i < m->bcount; ++i) {
+      if (b->offsets[i + 1] - b->offsets[i] == size) {
+        b->buckets[count++] = i;
+      }
+    }
+  }
+
+  return count;
+}
+
+static stat_t check_duplicates(frozen_map_t *m, struct builder *b, pair_t *pairs)
+{
+  for (size_t i = 0; i < m->bcount; ++i) {
+    for (size_t j = b->offsets[i]; j < b->offsets[i + 1]; ++j) {
+      for (size_t k = j + 1; k < b->offsets[i + 1]; ++k) {
+        size_t l = b->order[j];
+        size_t r = b->order[k];
+        if (b->hashes[l] == b->hashes[r]) {
+          return m->dinfo->eq(pairs[l].first, pairs[r].first) ? CDC_STATUS_ALREADY_EXISTS
+                                                              : CDC_STATUS_UNKN;
+        }
+      }
+    }
+  }
+
+  return CDC_STATUS_OK;
+}
+
+static bool place_bucket(frozen_map_t *m, struct builder *b, size_t bucket)
+{
+  size_t begin = b->offsets[bucket];
+  size_t end = b->offsets[bucket + 1];
+  for (uint32_t seed = 1; seed < FROZEN_MAP_MAX_SEED; ++seed) {
+    size_t i = begin;
+    for (; i < end; ++i) {
+      size_t slot = get_slot(b->hashes[b->order[i]], seed, m->size);
+      if (b->taken[slot]) {
+        break;
+      }
+
+      // Marked at once, so that keys of the bucket do not share a slot.
+      b->taken[slot] = true;
+      b->slots[i] = slot;
+    }
+
+    if (i == end) {
+      m->displacements[bucket] = seed;
+      return true;
+    }
+
+    while (i-- > begin) {
+      b->taken[b->slots[i]] = false;
+    }
+  }
+
+  return false;
+}
+
+// Places the keys for the current salt. Returns false if some bucket can not
+// be placed, then the keys are tried to be placed with another salt.
+static bool place(frozen_map_t *m, struct builder *b, size_t count)
+{
+  memset(b->taken, 0, m->size * sizeof(bool));
+  memset(m->displacements, 0, m->bcount * sizeof(uint32_t));
+  size_t i = 0;
+  for (; i < count; ++i) {
+    size_t bucket = b->buckets[i];
+    if (b->offsets[bucket + 1] - b->offsets[bucket] == 1) {
+      break;
+    }
+
+    if (!place_bucket(m, b, bucket)) {
+      return false;
+    }
+  }
+
+  // The buckets with one key get free slots directly.
+  size_t slot = 0;
+  for (; i < count; ++i) {
+    size_t bucket = b->buckets[i];
+    while (b->taken[slot]) {
+      ++slot;
+    }
+
+    b->taken[slot] = true;
+    b->slots[b->offsets[bucket]] = slot;
+    m->displacements[bucket] = FROZEN_MAP_DIRECT_SLOT | (uint32_t)slot;
+  }
+
+  return true;
+}
+
+static stat_t build(frozen_map_t *m, pair_t *pairs)
+{
+  struct builder b;
+  stat_t stat = init_builder(&b, m->dinfo, m->size, m->bcount);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  for (size_t i = 0; i < m->size; ++i) {
+    b.hashes[i] = m->dinfo->hash(pairs[i].first);
+  }
+
+  stat = CDC_STATUS_UNKN;
+  for (size_t attempt = 0; attempt < FROZEN_MAP_MAX_ATTEMPTS; ++attempt) {
+    m->salt = attempt * FROZEN_MAP_SEED_STEP;
+    size_t count = sort_buckets(m, &b);
+    if (attempt == 0 && (stat = check_duplicates(m, &b, pairs)) != CDC_STATUS_OK) {
+      break;
+    }
+
+    if (place(m, &b, count)) {
+      for (size_t i = 0; i < m->size; ++i) {
+        m->keys[b.slots[i]] = pairs[b.order[i]].first;
+        m->values[b.slots[i]] = pairs[b.order[i]].second;
+      }
+
+      stat = CDC_STATUS_OK;
+      break;
+    }
+
+    stat = CDC_STATUS_UNKN;
+  }
+
+  free_builder(&b);
+  return stat;
+}
+
+stat_t frozen_map_ctor(frozen_map_t **m, data_info_t *info, pair_t *pairs, size_t n)
+{
+  assert(m != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(n == 0 || pairs != NULL);
+  assert(n < FROZEN_MAP_DIRECT_SLOT);
+
+  frozen_map_t *tmp = (frozen_map_t *)di_calloc(info, sizeof(frozen_map_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  stat_t stat = CDC_STATUS_OK;
+  if (!(tmp->dinfo = di_shared_ctorc(info))) {
+    stat = CDC_STATUS_BAD_ALLOC;
+    goto free_frozen_map;
+  }
+
+  tmp->size = n;
+  tmp->bcount = n / FROZEN_MAP_BUCKET_SIZE + 1;
+  tmp->keys = (void **)di_malloc(info, n * sizeof(void *));
+  tmp->values = (void **)di_malloc(info, n * sizeof(void *));
+  tmp->displacements = (uint32_t *)di_malloc(info, tmp->bcount * sizeof(uint32_t));
+  if ((n && (!tmp->keys || !tmp->values)) || !tmp->displacements) {
+    stat = CDC_STATUS_BAD_ALLOC;
+    goto free_arrays;
+  }
+
+  if (n && (stat = build(tmp, pairs)) != CDC_STATUS_OK) {
+    goto free_arrays;
+  }
+
+  *m = tmp;
+  return CDC_STATUS_OK;
+free_arrays:
+  di_free(info, tmp->keys);
+  di_free(info, tmp->values);
+  di_free(info, tmp->displacements);
+  di_shared_dtor(tmp->dinfo);
+free_frozen_map:
+  di_free(info, tmp);
+  return stat;
+}
+
+stat_t frozen_map_ctor_hash_table(frozen_map_t **m, data_info_t *info, hash_table_t *t)
+{
+  assert(m != NULL);
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+
+  size_t size = hash_table_size(t);
+  pair_t *pairs = (pair_t *)di_malloc(info, CDC_MAX(size, 1) * sizeof(pair_t));
+  if (!pairs) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  hash_table_iter_t it = CDC_INIT_STRUCT;
+  hash_table_iter_t end = CDC_INIT_STRUCT;
+  hash_table_begin(t, &it);
+  hash_table_end(t, &end);
+  for (size_t i = 0; !hash_table_iter_is_eq(&it, &end); hash_table_iter_next(&it), ++i) {
+    pairs[i] = hash_table_iter_key_value(&it);
+  }
+
+  stat_t stat = frozen_map_ctor(m, info, pairs, size);
+  di_free(info, pairs);
+  return stat;
+}
+
+void frozen_map_dtor(frozen_map_t *m)
+{
+  assert(m != NULL);
+
+  if (CDC_HAS_DFREE(m->dinfo)) {
+    for (size_t i = 0; i < m->size; ++i) {
+      pair_t pair = {m->keys[i], m->values[i]};
+      m->dinfo->dfree(&pair);
+    }
+  }
+
+  di_free(m->dinfo, m->keys);
+  di_free(m->dinfo, m->values);
+  di_free(m->dinfo, m->displacements);
+  data_info_t *dinfo = m->dinfo;
+  di_free(dinfo, m);
+  di_shared_dtor(dinfo);
+}
+
+stat_t frozen_map_get(frozen_map_t *m, void *key, void **value)
+{
+  assert(m != NULL);
+
+  if (m->size == 0) {
+    return CDC_STATUS_NOT_FOUND;
+  }
+
+  size_t slot = find_slot(m, m->dinfo->hash(key));
+  if (!m->dinfo->eq(key, m->keys[slot])) {
+    return CDC_STATUS_NOT_FOUND;
+  }
+
+  *value = m->values[slot];
+  return CDC_STATUS_OK;
+}
+
+size_t frozen_map_count(frozen_map_t *m, void *key)
+{
+  assert(m != NULL);
+
+  if (m->size == 0) {
+    return 0;
+  }
+
+  return (size_t)m->dinfo->eq(key, m->keys[find_slot(m, m->dinfo->hash(key))]);
+}
@@ -22,6 +22,8 @@
 #include "cdcontainers/hash-table.h"
 
 #include "cdcontainers/data-info.h"
+#include "cdcontainers/global.h"
+#include "cdcontainers/node-pool.h"
 
 #include <assert.h>
 #include <stdint.h>
@@ -29,13 +31,82 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #define HASH_TABLE_MIN_CAPACITY 8  // must be pow 2
 #define HASH_TABLE_COPACITY_SHIFT 1
 #define HASH_TABLE_LOAD_FACTOR 0.7f
+// Number of old buckets that are moved by one modification during an
+// incremental rehash.
+#define HASH_TABLE_MIGRATION_STEP 4
+// Number of entries in one chunk of the node pool.
+#define HASH_TABLE_POOL_CHUNK_SIZE 256
+// Number of keys that are hashed and prefetched together in get_many.
+#define HASH_TABLE_BATCH_SIZE 16
+
+// All entries form one singly linked list that starts after the nil entry
+// t->head. Entries of a bucket are adjacent in the list and the bucket points
+// to the entry that precedes its first entry, or is NULL if the bucket is empty.
+//
+// During an incremental rehash the old buckets with indexes less than
+// t->migrated have already been moved to t->buckets, the rest are still in
+// t->old_buckets.
+//
+// With CDC_HASH_TABLE_SMALL the table object is followed by struct
+// cdc_hash_table_small in the same block, and the table starts without
+// buckets: the list starts after small->nil and links the entries of
+// small->entries, bit i of small->used is set if small->entries[i] is used and
+// small->hashes[i] is a copy of its hash. The storage is unused after the table
+// gets buckets and is released with the table.
+struct cdc_hash_table_small {
+  size_t hashes[CDC_HASH_TABLE_SMALL_SIZE];
+  unsigned used;
+  hash_table_entry_t nil;
+  hash_table_entry_t entries[CDC_HASH_TABLE_SMALL_SIZE];
+};
+
+CDC_STATIC_ASSERT(CDC_HASH_TABLE_SMALL_SIZE <= sizeof(unsigned) * 8, small_size_fits_mask);
+CDC_STATIC_ASSERT(CDC_HASH_TABLE_SMALL_SIZE % 2 == 0, small_size_is_even);
+
+// The flags of the layout of a table object, they stay with the object in
+// hash_table_swap.
+#define HASH_TABLE_LAYOUT_FLAGS (CDC_HASH_TABLE_CACHE_ALIGNED | CDC_HASH_TABLE_SMALL)
+
+static bool is_small(hash_table_t *t)
+{
+  return (t->flags & CDC_HASH_TABLE_SMALL) && !t->buckets;
+}
+
+static struct cdc_hash_table_small *get_small(hash_table_t *t)
+{
+  assert(t->flags & CDC_HASH_TABLE_SMALL);
+  return (struct cdc_hash_table_small *)(t + 1);
+}
+
+static unsigned lowest_bit(unsigned mask)
+{
+  assert(mask != 0);
+
+#if defined(__GNUC__)
+  return (unsigned)__builtin_ctz(mask);
+#else
+  unsigned i = 0;
+  while (!(mask & 1)) {
+    mask >>= 1;
+    ++i;
+  }
+
+  return i;
+#endif
+}
 
-static hash_table_entry_t *new_node(void *key, void *value, size_t hash)
+static hash_table_entry_t *new_node(hash_table_t *t, void *key, void *value, size_t hash)
 {
-  hash_table_entry_t *new_entry = (hash_table_entry_t *)malloc(sizeof(hash_table_entry_t));
+  hash_table_entry_t *new_entry =
+      t->pool ? (hash_table_entry_t *)node_pool_alloc(t->pool)
+              : (hash_table_entry_t *)di_malloc(t->dinfo, sizeof(hash_table_entry_t));
   if (!new_entry) {
     return NULL;
   }
@@ -54,12 +125,36 @@ static void free_entry(hash_table_t *t, hash_table_entry_t *entry)
     t->dinfo->dfree(&pair);
   }
 
-  free(entry);
+  if (t->pool) {
+    node_pool_free(t->pool, entry);
+  } else {
+    di_free(t->dinfo, entry);
+  }
 }
 
 static void free_entries(hash_table_t *t)
 {
-  hash_table_entry_t *curr = t->buckets[0]->next;
+  if (t->pool || is_small(t)) {
+    // Entries are released with their chunks or are stored in the table.
+    if (CDC_HAS_DFREE(t->dinfo)) {
+      for (hash_table_entry_t *curr = t->head->next; curr; curr = curr->next) {
+        pair_t pair = {curr->key, curr->value};
+        t->dinfo->dfree(&pair);
+      }
+    }
+
+    if (t->pool) {
+      node_pool_clear(t->pool);
+    }
+
+    return;
+  }
+
+  if (CDC_CAN_DROP_NODES(t->dinfo)) {
+    return;
+  }
+
+  hash_table_entry_t *curr = t->head->next;
   while (curr) {
     hash_table_entry_t *next = curr->next;
     free_entry(t, curr);
@@ -70,8 +165,10 @@ static void free_entries(hash_table_t *t)
 static void free_all_entries(hash_table_t *t)
 {
   free_entries(t);
-  // free nil entry
-  free(t->buckets[0]);
+  if (!is_small(t)) {
+    // free nil entry
+    di_free(t->dinfo, t->head);
+  }
 }
 
 static bool should_rehash(hash_table_t *t)
@@ -79,9 +176,16 @@ static bool should_rehash(hash_table_t *t)
   return ((double)t->size / (double)t->bcount) >= t->load_factor;
 }
 
-static stat_t rehash(hash_table_t *t)
+// With CDC_HASH_TABLE_MIX_HASH entries store mixed hashes. Mixing is a
+// bijection, so comparing mixed hashes is the same as comparing user hashes.
+static size_t table_hash(hash_table_t *t, size_t hash)
 {
-  return hash_table_rehash(t, t->bcount << HASH_TABLE_COPACITY_SHIFT);
+  return t->flags & CDC_HASH_TABLE_MIX_HASH ? cdc_hash_mix(hash) : hash;
+}
+
+static bool is_rehashing(hash_table_t *t)
+{
+  return t->old_buckets != NULL;
 }
 
 static size_t get_bucket(size_t hash, size_t count)
@@ -89,19 +193,35 @@ static size_t get_bucket(size_t hash, size_t count)
   return hash & (count - 1);
 }
 
-static hash_table_entry_t *find_entry_by_bucket(hash_table_t *t, void *key, size_t bucket)
+static hash_table_entry_t **get_slot(hash_table_t *t, size_t hash)
+{
+  if (is_rehashing(t)) {
+    size_t bucket = get_bucket(hash, t->old_bcount);
+    if (bucket >= t->migrated) {
+      return &t->old_buckets[bucket];
+    }
+  }
+
+  return &t->buckets[get_bucket(hash, t->bcount)];
+}
+
+// |eq| is called as eq(key, stored key), so |key| may be a probe.
+static hash_table_entry_t *find_entry_by_slot(hash_table_t *t, const void *key,
+                                              cdc_binary_pred_fn_t eq, size_t hash,
+                                              hash_table_entry_t **slot)
 {
-  hash_table_entry_t *entry = t->buckets[bucket];
+  hash_table_entry_t *entry = *slot;
   if (entry == NULL) {
     return NULL;
   }
 
   while (entry->next) {
-    if (t->dinfo->eq(key, entry->next->key)) {
+    // The stored hash is compared first, so eq is called only on a full match.
+    if (entry->next->hash == hash && eq(key, entry->next->key)) {
       return entry;
     }
 
-    if (bucket != get_bucket(entry->next->hash, t->bcount)) {
+    if (slot != get_slot(t, entry->next->hash)) {
       return NULL;
     }
 
@@ -111,124 +231,274 @@ static hash_table_entry_t *find_entry_by_bucket(hash_table_t *t, void *key, size
   return NULL;
 }
 
-static hash_table_entry_t *find_entry(hash_table_t *t, void *key)
+// Bit i of the mask is set if hashes[i] is equal to hash.
+#if defined(__SSE2__) && SIZE_MAX == UINT64_MAX
+static unsigned match_small_hashes(const size_t *hashes, size_t hash)
 {
-  size_t bucket = key ? get_bucket(t->dinfo->hash(key), t->bcount) : 0;
-  return find_entry_by_bucket(t, key, bucket);
+  // SSE2 has no 64-bit compare, so both 32-bit halves of a hash must match.
+  __m128i needle = _mm_set1_epi64x((long long)hash);
+  unsigned mask = 0;
+  for (unsigned i = 0; i < CDC_HASH_TABLE_SMALL_SIZE; i += 2) {
+    __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)&hashes[i]), needle);
+    eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    mask |= (unsigned)_mm_movemask_pd(_mm_castsi128_pd(eq)) << i;
+  }
+
+  return mask;
 }
+#else
+static unsigned match_small_hashes(const size_t *hashes, size_t hash)
+{
+  // The hashes are compared without branches, so the loop can be vectorized.
+  unsigned mask = 0;
+  for (unsigned i = 0; i < CDC_HASH_TABLE_SMALL_SIZE; ++i) {
+    mask |= (unsigned)(hashes[i] == hash) << i;
+  }
 
-static hash_table_entry_t *add_entry(hash_table_t *t, hash_table_entry_t *new_entry)
+  return mask;
+}
+#endif
+
+static hash_table_entry_t *find_small_entry(hash_table_t *t, const void *key,
+                                            cdc_binary_pred_fn_t eq, size_t hash)
 {
-  size_t bucket = new_entry->key ? get_bucket(new_entry->hash, t->bcount) : 0;
-  hash_table_entry_t *entry = t->buckets[bucket];
-  hash_table_entry_t *prev_entry = NULL;
-  if (entry == NULL) {
-    t->buckets[bucket] = t->tail;
-    prev_entry = t->tail;
-    t->tail->next = new_entry;
-    t->tail = new_entry;
-  } else {
-    if (entry->next) {
-      size_t next_bucket = get_bucket(entry->next->hash, t->bcount);
-      if (next_bucket != bucket) {
-        t->buckets[next_bucket] = new_entry;
+  struct cdc_hash_table_small *small = get_small(t);
+  unsigned mask = match_small_hashes(small->hashes, hash);
+  for (mask &= small->used; mask; mask &= mask - 1) {
+    hash_table_entry_t *finded = &small->entries[lowest_bit(mask)];
+    if (eq(key, finded->key)) {
+      hash_table_entry_t *entry = t->head;
+      while (entry->next != finded) {
+        entry = entry->next;
       }
 
-      prev_entry = entry;
-      hash_table_entry_t *next = entry->next;
-      entry->next = new_entry;
-      new_entry->next = next;
-    } else {
-      prev_entry = t->tail;
-      t->tail->next = new_entry;
-      t->tail = new_entry;
+      return entry;
     }
   }
 
+  return NULL;
+}
+
+static hash_table_entry_t *find_entry_by_eq(hash_table_t *t, const void *key,
+                                            cdc_binary_pred_fn_t eq, size_t hash)
+{
+  if (is_small(t)) {
+    return find_small_entry(t, key, eq, hash);
+  }
+
+  return find_entry_by_slot(t, key, eq, hash, get_slot(t, hash));
+}
+
+static hash_table_entry_t *find_entry(hash_table_t *t, void *key, size_t hash)
+{
+  return find_entry_by_eq(t, key, t->dinfo->eq, hash);
+}
+
+static hash_table_entry_t *find_entry_by_probe(hash_table_t *t, const void *probe,
+                                               const probe_info_t *info)
+{
+  return find_entry_by_eq(t, probe, info->eq, table_hash(t, info->hash(probe)));
+}
+
+static hash_table_entry_t *add_entry(hash_table_t *t, hash_table_entry_t *new_entry)
+{
+  hash_table_entry_t **slot = get_slot(t, new_entry->hash);
+  hash_table_entry_t *prev_entry = *slot;
+  if (prev_entry == NULL) {
+    prev_entry = t->tail;
+    *slot = prev_entry;
+    t->tail = new_entry;
+  }
+
+  new_entry->next = prev_entry->next;
+  prev_entry->next = new_entry;
   return prev_entry;
 }
 
-static stat_t make_and_insert_unique(hash_table_t *t, void *key, void *value,
-                                     hash_table_entry_t **ret)
+static hash_table_entry_t *add_small_entry(hash_table_t *t, void *key, void *value, size_t hash)
 {
-  if (should_rehash(t)) {
-    stat_t stat = rehash(t);
-    if (stat != CDC_STATUS_OK) {
-      return stat;
+  assert(t->size < CDC_HASH_TABLE_SMALL_SIZE);
+
+  struct cdc_hash_table_small *small = get_small(t);
+  unsigned i = lowest_bit(~small->used);
+  hash_table_entry_t *new_entry = &small->entries[i];
+  new_entry->next = NULL;
+  new_entry->key = key;
+  new_entry->value = value;
+  new_entry->hash = hash;
+  small->hashes[i] = hash;
+  small->used |= 1u << i;
+
+  hash_table_entry_t *prev_entry = t->tail;
+  prev_entry->next = new_entry;
+  t->tail = new_entry;
+  return prev_entry;
+}
+
+static void erase_small_entry(hash_table_t *t, hash_table_entry_t *entry)
+{
+  hash_table_entry_t *erased = entry->next;
+  entry->next = erased->next;
+  if (t->tail == erased) {
+    t->tail = entry;
+  }
+
+  if (CDC_HAS_DFREE(t->dinfo)) {
+    pair_t pair = {erased->key, erased->value};
+    t->dinfo->dfree(&pair);
+  }
+
+  struct cdc_hash_table_small *small = get_small(t);
+  small->used &= ~(1u << (unsigned)(erased - small->entries));
+  --t->size;
+}
+
+// Moves the entries stored in the table to allocated entries and the buckets.
+static stat_t promote(hash_table_t *t, size_t count)
+{
+  hash_table_entry_t *entries[CDC_HASH_TABLE_SMALL_SIZE];
+  hash_table_entry_t **new_buckets =
+      (hash_table_entry_t **)di_calloc(t->dinfo, count * sizeof(void *));
+  hash_table_entry_t *nil = (hash_table_entry_t *)di_calloc(t->dinfo, sizeof(hash_table_entry_t));
+  size_t n = 0;
+  if (!new_buckets || !nil) {
+    goto free_entries;
+  }
+
+  for (hash_table_entry_t *curr = t->head->next; curr; curr = curr->next) {
+    if (!(entries[n] = new_node(t, curr->key, curr->value, curr->hash))) {
+      goto free_entries;
     }
+
+    ++n;
   }
 
-  hash_table_entry_t *entry = new_node(key, value, t->dinfo->hash(key));
-  if (!entry) {
-    return CDC_STATUS_BAD_ALLOC;
+  t->buckets = new_buckets;
+  t->bcount = count;
+  t->head = nil;
+  t->tail = nil;
+  for (size_t i = 0; i < n; ++i) {
+    add_entry(t, entries[i]);
   }
 
-  *ret = add_entry(t, entry);
-  ++t->size;
   return CDC_STATUS_OK;
+free_entries:
+  for (size_t i = 0; i < n; ++i) {
+    if (t->pool) {
+      node_pool_free(t->pool, entries[i]);
+    } else {
+      di_free(t->dinfo, entries[i]);
+    }
+  }
+
+  di_free(t->dinfo, nil);
+  di_free(t->dinfo, new_buckets);
+  return CDC_STATUS_BAD_ALLOC;
 }
 
-static hash_table_entry_t *erase_entry(hash_table_t *t, hash_table_entry_t *entry, size_t bucket)
+// Unlinks the entries from entry->next to last inclusive, which belong to the
+// same slot and make the whole of it.
+static void unlink_entries(hash_table_t *t, hash_table_entry_t *entry, hash_table_entry_t *last,
+                           hash_table_entry_t **slot)
+{
+  hash_table_entry_t *next = last->next;
+  entry->next = next;
+  if (next != NULL) {
+    *get_slot(t, next->hash) = entry;
+  } else {
+    t->tail = entry;
+  }
+
+  *slot = NULL;
+}
+
+static hash_table_entry_t *erase_entry(hash_table_t *t, hash_table_entry_t *entry,
+                                       hash_table_entry_t **slot)
 {
   assert(entry != NULL);
   assert(entry->next != NULL);
 
-  hash_table_entry_t *next = entry->next->next;
-  size_t e_hash = get_bucket(entry->hash, t->bcount);
-  size_t en_hash = get_bucket(entry->next->hash, t->bcount);
-  free_entry(t, entry->next);
-  if (next != NULL) {
-    size_t n_hash = get_bucket(next->hash, t->bcount);
-    if (e_hash != en_hash && en_hash != n_hash) {
-      entry->next = next;
-      if (entry == t->buckets[0]) {
-        t->buckets[bucket] = t->buckets[0];
-      } else {
-        t->buckets[bucket] = NULL;
-      }
-
-      bucket = get_bucket(next->hash, t->bcount);
-      t->buckets[bucket] = entry;
-    } else if (en_hash == n_hash) {
-      entry->next = next;
-    } else {
-      entry->next = next;
-      bucket = get_bucket(next->hash, t->bcount);
-      t->buckets[bucket] = entry;
-    }
+  hash_table_entry_t *erased = entry->next;
+  hash_table_entry_t *next = erased->next;
+  if (*slot == entry && (next == NULL || get_slot(t, next->hash) != slot)) {
+    unlink_entries(t, entry, erased, slot);
   } else {
-    if (e_hash != en_hash) {
-      t->buckets[bucket] = NULL;
+    entry->next = next;
+    if (next == NULL) {
+      t->tail = entry;
+    } else if (get_slot(t, next->hash) != slot) {
+      *get_slot(t, next->hash) = entry;
     }
-
-    entry->next = NULL;
-    t->tail = entry;
   }
 
+  free_entry(t, erased);
   --t->size;
   return next;
 }
 
-static hash_table_entry_t **transfer(hash_table_t *t, hash_table_entry_t **buckets, size_t count)
+// Moves the entries of the next old bucket to the new buckets.
+static void migrate_bucket(hash_table_t *t)
+{
+  assert(is_rehashing(t));
+
+  hash_table_entry_t **slot = &t->old_buckets[t->migrated];
+  hash_table_entry_t *entry = *slot;
+  if (entry != NULL) {
+    hash_table_entry_t *first = entry->next;
+    hash_table_entry_t *last = first;
+    while (last->next && get_slot(t, last->next->hash) == slot) {
+      last = last->next;
+    }
+
+    unlink_entries(t, entry, last, slot);
+    last->next = NULL;
+    ++t->migrated;
+    while (first) {
+      hash_table_entry_t *next = first->next;
+      add_entry(t, first);
+      first = next;
+    }
+  } else {
+    ++t->migrated;
+  }
+
+  if (t->migrated == t->old_bcount) {
+    di_free(t->dinfo, t->old_buckets);
+    t->old_buckets = NULL;
+    t->old_bcount = 0;
+    t->migrated = 0;
+  }
+}
+
+static void migrate(hash_table_t *t, size_t count)
+{
+  for (size_t i = 0; i < count && is_rehashing(t); ++i) {
+    migrate_bucket(t);
+  }
+}
+
+static void finish_migration(hash_table_t *t)
+{
+  while (is_rehashing(t)) {
+    migrate_bucket(t);
+  }
+}
+
+static void transfer(hash_table_t *t, hash_table_entry_t **buckets, size_t count)
 {
-  hash_table_entry_t *entry = t->buckets[0]->next;
-  hash_table_entry_t **old_buffer = t->buckets;
+  hash_table_entry_t *entry = t->head->next;
   // Set a new buffer and a new tail.
-  t->buckets[0]->next = NULL;
-  buckets[0] = t->buckets[0];
+  t->head->next = NULL;
   t->buckets = buckets;
-  t->tail = buckets[0];
+  t->tail = t->head;
   t->bcount = count;
 
   hash_table_entry_t *next_entry = NULL;
   while (entry) {
     next_entry = entry->next;
-    entry->next = NULL;
     add_entry(t, entry);
     entry = next_entry;
   }
-
-  return old_buffer;
 }
 
 static stat_t reallocate(hash_table_t *t, size_t count)
@@ -241,23 +511,30 @@ static stat_t reallocate(hash_table_t *t, size_t count)
     }
   }
 
-  hash_table_entry_t **new_buckets = (hash_table_entry_t **)calloc(count * sizeof(void *), 1);
+  if (is_small(t)) {
+    return promote(t, count);
+  }
+
+  hash_table_entry_t **new_buckets =
+      (hash_table_entry_t **)di_calloc(t->dinfo, count * sizeof(void *));
   if (!new_buckets) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   if (t->buckets) {
-    hash_table_entry_t **old_buffer = transfer(t, new_buckets, count);
-    free(old_buffer);
+    finish_migration(t);
+    hash_table_entry_t **old_buffer = t->buckets;
+    transfer(t, new_buckets, count);
+    di_free(t->dinfo, old_buffer);
   } else {
-    hash_table_entry_t *nil = (hash_table_entry_t *)calloc(sizeof(hash_table_entry_t), 1);
+    hash_table_entry_t *nil = (hash_table_entry_t *)di_calloc(t->dinfo, sizeof(hash_table_entry_t));
     if (!nil) {
-      free(new_buckets);
+      di_free(t->dinfo, new_buckets);
       return CDC_STATUS_BAD_ALLOC;
     }
 
     t->buckets = new_buckets;
-    t->buckets[0] = nil;
+    t->head = nil;
     t->tail = nil;
     t->bcount = count;
   }
@@ -265,6 +542,69 @@ static stat_t reallocate(hash_table_t *t, size_t count)
   return CDC_STATUS_OK;
 }
 
+// Starts an incremental rehash: the current buckets become old buckets and are
+// moved to the new ones by the following modifications.
+static stat_t start_migration(hash_table_t *t, size_t count)
+{
+  finish_migration(t);
+  hash_table_entry_t **new_buckets =
+      (hash_table_entry_t **)di_calloc(t->dinfo, count * sizeof(void *));
+  if (!new_buckets) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  t->old_buckets = t->buckets;
+  t->old_bcount = t->bcount;
+  t->migrated = 0;
+  t->buckets = new_buckets;
+  t->bcount = count;
+  migrate(t, HASH_TABLE_MIGRATION_STEP);
+  return CDC_STATUS_OK;
+}
+
+static stat_t rehash(hash_table_t *t)
+{
+  if (t->flags & CDC_HASH_TABLE_INCREMENTAL_REHASH) {
+    return start_migration(t, t->bcount << HASH_TABLE_COPACITY_SHIFT);
+  }
+
+  return hash_table_rehash(t, t->bcount << HASH_TABLE_COPACITY_SHIFT);
+}
+
+static stat_t make_and_insert_unique(hash_table_t *t, void *key, void *value, size_t hash,
+                                     hash_table_entry_t **ret)
+{
+  if (is_small(t)) {
+    if (t->size < CDC_HASH_TABLE_SMALL_SIZE) {
+      *ret = add_small_entry(t, key, value, hash);
+      ++t->size;
+      return CDC_STATUS_OK;
+    }
+
+    size_t count = cdc_up_to_pow2((size_t)((double)(t->size + 1) / t->load_factor) + 1);
+    stat_t stat = reallocate(t, CDC_MAX(count, (size_t)HASH_TABLE_MIN_CAPACITY));
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  }
+
+  if (should_rehash(t)) {
+    stat_t stat = rehash(t);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  }
+
+  hash_table_entry_t *entry = new_node(t, key, value, hash);
+  if (!entry) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  *ret = add_entry(t, entry);
+  ++t->size;
+  return CDC_STATUS_OK;
+}
+
 static stat_t init_varg(hash_table_t *t, va_list args)
 {
   pair_t *pair = NULL;
@@ -278,40 +618,98 @@ static stat_t init_varg(hash_table_t *t, va_list args)
   return CDC_STATUS_OK;
 }
 
-stat_t hash_table_ctor1(hash_table_t **t, data_info_t *info, double load_factor)
+// Size of the block of a table object with |flags|.
+static size_t table_size(int flags)
+{
+  size_t size = sizeof(hash_table_t);
+  if (flags & CDC_HASH_TABLE_SMALL) {
+    size += sizeof(struct cdc_hash_table_small);
+  }
+
+  if (flags & CDC_HASH_TABLE_CACHE_ALIGNED) {
+    size = (size + CDC_CACHE_LINE_SIZE - 1) / CDC_CACHE_LINE_SIZE * CDC_CACHE_LINE_SIZE;
+  }
+
+  return size;
+}
+
+static hash_table_t *alloc_table(data_info_t *info, int flags)
+{
+  size_t size = table_size(flags);
+  if (!(flags & CDC_HASH_TABLE_CACHE_ALIGNED)) {
+    return (hash_table_t *)di_calloc(info, size);
+  }
+
+  void *table = cdc_aligned_malloc(CDC_ALLOCATOR(info), CDC_CACHE_LINE_SIZE, size);
+  if (table) {
+    memset(table, 0, size);
+  }
+
+  return (hash_table_t *)table;
+}
+
+static void free_table(data_info_t *info, hash_table_t *t)
+{
+  if (t->flags & CDC_HASH_TABLE_CACHE_ALIGNED) {
+    cdc_aligned_free(CDC_ALLOCATOR(info), t);
+  } else {
+    di_free(info, t);
+  }
+}
+
+stat_t hash_table_ctor2(hash_table_t **t, data_info_t *info, double load_factor, int flags)
 {
   assert(t != NULL);
   assert(CDC_HAS_HASH(info));
   assert(CDC_HAS_EQ(info));
   assert(load_factor > 0);
 
-  hash_table_t *tmp = (hash_table_t *)calloc(sizeof(hash_table_t), 1);
+  hash_table_t *tmp = alloc_table(info, flags);
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   tmp->load_factor = load_factor;
+  tmp->flags = flags;
   stat_t stat = CDC_STATUS_OK;
   if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
     stat = CDC_STATUS_BAD_ALLOC;
     goto free_hash_table;
   }
 
-  stat = reallocate(tmp, HASH_TABLE_MIN_CAPACITY);
-  if (stat != CDC_STATUS_OK) {
-    goto free_di;
+  if (flags & CDC_HASH_TABLE_NODE_POOL) {
+    stat = node_pool_ctor(&tmp->pool, tmp->dinfo, sizeof(hash_table_entry_t),
+                          HASH_TABLE_POOL_CHUNK_SIZE);
+    if (stat != CDC_STATUS_OK) {
+      goto free_di;
+    }
+  }
+
+  if (flags & CDC_HASH_TABLE_SMALL) {
+    tmp->head = &get_small(tmp)->nil;
+    tmp->tail = tmp->head;
+    tmp->bcount = 1;
+  } else {
+    stat = reallocate(tmp, HASH_TABLE_MIN_CAPACITY);
+    if (stat != CDC_STATUS_OK) {
+      goto free_pool;
+    }
   }
 
   *t = tmp;
   return stat;
+free_pool:
+  if (tmp->pool) {
+    node_pool_dtor(tmp->pool);
+  }
 free_di:
   di_shared_dtor(tmp->dinfo);
 free_hash_table:
-  free(tmp);
+  free_table(info, tmp);
   return stat;
 }
 
-stat_t hash_table_ctorl1(hash_table_t **t, data_info_t *info, double load_factor, ...)
+stat_t hash_table_ctorl2(hash_table_t **t, data_info_t *info, double load_factor, int flags, ...)
 {
   assert(t != NULL);
   assert(CDC_HAS_HASH(info));
@@ -319,20 +717,21 @@ stat_t hash_table_ctorl1(hash_table_t **t, data_info_t *info, double load_factor
   assert(load_factor > 0);
 
   va_list args;
-  va_start(args, load_factor);
-  stat_t stat = cdc_hash_table_ctorv1(t, info, load_factor, args);
+  va_start(args, flags);
+  stat_t stat = hash_table_ctorv2(t, info, load_factor, flags, args);
   va_end(args);
   return stat;
 }
 
-stat_t hash_table_ctorv1(hash_table_t **t, data_info_t *info, double load_factor, va_list args)
+stat_t hash_table_ctorv2(hash_table_t **t, data_info_t *info, double load_factor, int flags,
+                         va_list args)
 {
   assert(t != NULL);
   assert(CDC_HAS_HASH(info));
   assert(CDC_HAS_EQ(info));
   assert(load_factor > 0);
 
-  stat_t stat = hash_table_ctor1(t, info, load_factor);
+  stat_t stat = hash_table_ctor2(t, info, load_factor, flags);
   if (stat != CDC_STATUS_OK) {
     return stat;
   }
@@ -340,6 +739,40 @@ stat_t hash_table_ctorv1(hash_table_t **t, data_info_t *info, double load_factor
   return init_varg(*t, args);
 }
 
+stat_t hash_table_ctor1(hash_table_t **t, data_info_t *info, double load_factor)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(load_factor > 0);
+
+  return hash_table_ctor2(t, info, load_factor, 0);
+}
+
+stat_t hash_table_ctorl1(hash_table_t **t, data_info_t *info, double load_factor, ...)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(load_factor > 0);
+
+  va_list args;
+  va_start(args, load_factor);
+  stat_t stat = cdc_hash_table_ctorv1(t, info, load_factor, args);
+  va_end(args);
+  return stat;
+}
+
+stat_t hash_table_ctorv1(hash_table_t **t, data_info_t *info, double load_factor, va_list args)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(load_factor > 0);
+
+  return hash_table_ctorv2(t, info, load_factor, 0, args);
+}
+
 stat_t hash_table_ctor(hash_table_t **t, data_info_t *info)
 {
   assert(t != NULL);
@@ -376,16 +809,54 @@ void hash_table_dtor(hash_table_t *t)
   assert(t != NULL);
 
   free_all_entries(t);
-  free(t->buckets);
-  di_shared_dtor(t->dinfo);
-  free(t);
+  if (t->pool) {
+    node_pool_dtor(t->pool);
+  }
+
+  di_free(t->dinfo, t->old_buckets);
+  di_free(t->dinfo, t->buckets);
+  data_info_t *dinfo = t->dinfo;
+  free_table(dinfo, t);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t hash_table_memory_usage(hash_table_t *t)
+{
+  assert(t != NULL);
+
+  size_t bytes = table_size(t->flags);
+  if (t->buckets) {
+    // The sentinel is allocated together with the first buckets.
+    bytes += t->bcount * sizeof(void *) + sizeof(hash_table_entry_t);
+  }
+
+  if (t->old_buckets) {
+    bytes += t->old_bcount * sizeof(void *);
+  }
+
+  // Entries of a small table are stored in it.
+  if (t->pool) {
+    bytes += node_pool_memory_usage(t->pool);
+  } else if (!is_small(t)) {
+    bytes += t->size * sizeof(hash_table_entry_t);
+  }
+
+  return memory_usage_make(bytes, t->size);
 }
 
 stat_t hash_table_get(hash_table_t *t, void *key, void **value)
 {
   assert(t != NULL);
 
-  hash_table_entry_t *entry = find_entry(t, key);
+  return hash_table_get_hashed(t, key, t->dinfo->hash(key), value);
+}
+
+stat_t hash_table_get_hashed(hash_table_t *t, void *key, size_t hash, void **value)
+{
+  assert(t != NULL);
+
+  hash = table_hash(t, hash);
+  hash_table_entry_t *entry = find_entry(t, key, hash);
   if (!entry) {
     return CDC_STATUS_NOT_FOUND;
   }
@@ -394,11 +865,72 @@ stat_t hash_table_get(hash_table_t *t, void *key, void **value)
   return CDC_STATUS_OK;
 }
 
+size_t hash_table_get_many(hash_table_t *t, void **keys, size_t n, void **values, bool *found)
+{
+  assert(t != NULL);
+  assert(n == 0 || (keys != NULL && values != NULL && found != NULL));
+
+  size_t hashes[HASH_TABLE_BATCH_SIZE];
+  hash_table_entry_t **slots[HASH_TABLE_BATCH_SIZE];
+  size_t count = 0;
+  if (is_small(t)) {
+    for (size_t i = 0; i < n; ++i) {
+      found[i] = hash_table_get(t, keys[i], &values[i]) == CDC_STATUS_OK;
+      count += found[i];
+    }
+
+    return count;
+  }
+
+  for (size_t i = 0; i < n; i += HASH_TABLE_BATCH_SIZE) {
+    size_t batch = CDC_MIN(n - i, (size_t)HASH_TABLE_BATCH_SIZE);
+    for (size_t j = 0; j < batch; ++j) {
+      hashes[j] = table_hash(t, t->dinfo->hash(keys[i + j]));
+      slots[j] = get_slot(t, hashes[j]);
+      CDC_PREFETCH(slots[j]);
+    }
+
+    // A bucket points to the entry before the first entry of the bucket, so
+    // both of them are prefetched, one pass per level of indirection.
+    for (size_t j = 0; j < batch; ++j) {
+      if (*slots[j]) {
+        CDC_PREFETCH(*slots[j]);
+      }
+    }
+
+    for (size_t j = 0; j < batch; ++j) {
+      if (*slots[j]) {
+        CDC_PREFETCH((*slots[j])->next);
+      }
+    }
+
+    for (size_t j = 0; j < batch; ++j) {
+      hash_table_entry_t *entry =
+          find_entry_by_slot(t, keys[i + j], t->dinfo->eq, hashes[j], slots[j]);
+      found[i + j] = entry != NULL;
+      if (entry) {
+        values[i + j] = entry->next->value;
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
 size_t hash_table_count(hash_table_t *t, void *key)
 {
   assert(t != NULL);
 
-  return (size_t)(find_entry(t, key) != NULL);
+  return hash_table_count_hashed(t, key, t->dinfo->hash(key));
+}
+
+size_t hash_table_count_hashed(hash_table_t *t, void *key, size_t hash)
+{
+  assert(t != NULL);
+
+  hash = table_hash(t, hash);
+  return (size_t)(find_entry(t, key, hash) != NULL);
 }
 
 void hash_table_find(hash_table_t *t, void *key, hash_table_iter_t *it)
@@ -406,7 +938,51 @@ void hash_table_find(hash_table_t *t, void *key, hash_table_iter_t *it)
   assert(t != NULL);
   assert(it != NULL);
 
-  hash_table_entry_t *entry = find_entry(t, key);
+  hash_table_find_hashed(t, key, t->dinfo->hash(key), it);
+}
+
+void hash_table_find_hashed(hash_table_t *t, void *key, size_t hash, hash_table_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  hash = table_hash(t, hash);
+  hash_table_entry_t *entry = find_entry(t, key, hash);
+  it->container = t;
+  it->current = entry ? entry->next : NULL;
+}
+
+stat_t hash_table_get_probe(hash_table_t *t, const void *probe, const probe_info_t *info,
+                            void **value)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  hash_table_entry_t *entry = find_entry_by_probe(t, probe, info);
+  if (!entry) {
+    return CDC_STATUS_NOT_FOUND;
+  }
+
+  *value = entry->next->value;
+  return CDC_STATUS_OK;
+}
+
+size_t hash_table_count_probe(hash_table_t *t, const void *probe, const probe_info_t *info)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  return (size_t)(find_entry_by_probe(t, probe, info) != NULL);
+}
+
+void hash_table_find_probe(hash_table_t *t, const void *probe, const probe_info_t *info,
+                           hash_table_iter_t *it)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+  assert(it != NULL);
+
+  hash_table_entry_t *entry = find_entry_by_probe(t, probe, info);
   it->container = t;
   it->current = entry ? entry->next : NULL;
 }
@@ -416,8 +992,18 @@ void hash_table_clear(hash_table_t *t)
   assert(t != NULL);
 
   free_entries(t);
-  t->buckets[0]->next = NULL;
-  t->tail = t->buckets[0];
+  if (is_small(t)) {
+    get_small(t)->used = 0;
+  } else {
+    di_free(t->dinfo, t->old_buckets);
+    t->old_buckets = NULL;
+    t->old_bcount = 0;
+    t->migrated = 0;
+    memset(t->buckets, 0, t->bcount * sizeof(void *));
+  }
+
+  t->head->next = NULL;
+  t->tail = t->head;
   t->size = 0;
 }
 
@@ -426,10 +1012,20 @@ stat_t hash_table_insert(hash_table_t *t, void *key, void *value, hash_table_ite
 {
   assert(t != NULL);
 
-  hash_table_entry_t *entry = find_entry(t, key);
+  return hash_table_insert_hashed(t, key, t->dinfo->hash(key), value, it, inserted);
+}
+
+stat_t hash_table_insert_hashed(hash_table_t *t, void *key, size_t hash, void *value,
+                                hash_table_iter_t *it, bool *inserted)
+{
+  assert(t != NULL);
+
+  hash = table_hash(t, hash);
+  migrate(t, HASH_TABLE_MIGRATION_STEP);
+  hash_table_entry_t *entry = find_entry(t, key, hash);
   bool finded = entry;
   if (!finded) {
-    stat_t stat = make_and_insert_unique(t, key, value, &entry);
+    stat_t stat = make_and_insert_unique(t, key, value, hash, &entry);
     if (stat != CDC_STATUS_OK) {
       return stat;
     }
@@ -452,10 +1048,20 @@ stat_t hash_table_insert_or_assign(hash_table_t *t, void *key, void *value, hash
 {
   assert(t != NULL);
 
-  hash_table_entry_t *entry = find_entry(t, key);
+  return hash_table_insert_or_assign_hashed(t, key, t->dinfo->hash(key), value, it, inserted);
+}
+
+stat_t hash_table_insert_or_assign_hashed(hash_table_t *t, void *key, size_t hash, void *value,
+                                          hash_table_iter_t *it, bool *inserted)
+{
+  assert(t != NULL);
+
+  hash = table_hash(t, hash);
+  migrate(t, HASH_TABLE_MIGRATION_STEP);
+  hash_table_entry_t *entry = find_entry(t, key, hash);
   bool finded = entry;
   if (!finded) {
-    stat_t stat = make_and_insert_unique(t, key, value, &entry);
+    stat_t stat = make_and_insert_unique(t, key, value, hash, &entry);
     if (stat != CDC_STATUS_OK) {
       return stat;
     }
@@ -479,27 +1085,74 @@ size_t hash_table_erase(hash_table_t *t, void *key)
 {
   assert(t != NULL);
 
-  size_t bucket = key ? get_bucket(t->dinfo->hash(key), t->bcount) : 0;
-  hash_table_entry_t *entry = find_entry_by_bucket(t, key, bucket);
+  return hash_table_erase_hashed(t, key, t->dinfo->hash(key));
+}
+
+size_t hash_table_erase_hashed(hash_table_t *t, void *key, size_t hash)
+{
+  assert(t != NULL);
+
+  hash = table_hash(t, hash);
+  if (is_small(t)) {
+    hash_table_entry_t *entry = find_small_entry(t, key, t->dinfo->eq, hash);
+    if (!entry) {
+      return 0;
+    }
+
+    erase_small_entry(t, entry);
+    return 1;
+  }
+
+  migrate(t, HASH_TABLE_MIGRATION_STEP);
+  hash_table_entry_t **slot = get_slot(t, hash);
+  hash_table_entry_t *entry = find_entry_by_slot(t, key, t->dinfo->eq, hash, slot);
   if (!entry) {
     return 0;
   }
 
-  erase_entry(t, entry, bucket);
+  erase_entry(t, entry, slot);
   return 1;
 }
 
+// After the tables are swapped, the list of |t| still links the entries stored
+// in |other|, while the same entries are now stored in |t|.
+static void relink_small(hash_table_t *t, hash_table_t *other)
+{
+  struct cdc_hash_table_small *small = get_small(t);
+  t->head = &small->nil;
+  t->tail = t->head;
+  while (t->tail->next) {
+    t->tail->next = &small->entries[t->tail->next - get_small(other)->entries];
+    t->tail = t->tail->next;
+  }
+}
+
 void hash_table_swap(hash_table_t *a, hash_table_t *b)
 {
   assert(a != NULL);
   assert(b != NULL);
 
-  CDC_SWAP(hash_table_entry_t *, a->tail, b->tail);
-  CDC_SWAP(hash_table_entry_t **, a->buckets, b->buckets);
-  CDC_SWAP(size_t, a->bcount, b->bcount);
-  CDC_SWAP(double, a->load_factor, b->load_factor);
-  CDC_SWAP(size_t, a->size, b->size);
-  CDC_SWAP(data_info_t *, a->dinfo, b->dinfo);
+  bool a_small = is_small(a);
+  bool b_small = is_small(b);
+  // Entries of a table in small mode can be moved only to a storage.
+  assert(!a_small || (b->flags & CDC_HASH_TABLE_SMALL));
+  assert(!b_small || (a->flags & CDC_HASH_TABLE_SMALL));
+  int a_layout = a->flags & HASH_TABLE_LAYOUT_FLAGS;
+  int b_layout = b->flags & HASH_TABLE_LAYOUT_FLAGS;
+  CDC_SWAP(hash_table_t, *a, *b);
+  a->flags = (a->flags & ~HASH_TABLE_LAYOUT_FLAGS) | a_layout;
+  b->flags = (b->flags & ~HASH_TABLE_LAYOUT_FLAGS) | b_layout;
+  if (a_small || b_small) {
+    CDC_SWAP(struct cdc_hash_table_small, *get_small(a), *get_small(b));
+  }
+
+  if (b_small) {
+    relink_small(a, b);
+  }
+
+  if (a_small) {
+    relink_small(b, a);
+  }
 }
 
 stat_t hash_table_rehash(hash_table_t *t, size_t count)
@@ -519,5 +1172,37 @@ stat_t hash_table_reserve(hash_table_t *t, size_t count)
 {
   assert(t != NULL);
 
+  if (is_small(t) && count <= CDC_HASH_TABLE_SMALL_SIZE) {
+    return CDC_STATUS_OK;
+  }
+
   return hash_table_rehash(t, (size_t)((double)count / t->load_factor) + 1);
 }
+
+size_t hash_table_bucket_size(hash_table_t *t, size_t n)
+{
+  assert(t != NULL);
+  assert(n < t->bcount);
+
+  if (is_small(t)) {
+    return t->size;
+  }
+
+  size_t size = 0;
+  hash_table_entry_t **slot = &t->buckets[n];
+  for (hash_table_entry_t *entry = *slot;
+       entry && entry->next && get_slot(t, entry->next->hash) == slot; entry = entry->next) {
+    ++size;
+  }
+
+  // Entries of the bucket that have not been moved yet are in the old bucket.
+  if (is_rehashing(t) && get_bucket(n, t->old_bcount) >= t->migrated) {
+    slot = &t->old_buckets[get_bucket(n, t->old_bcount)];
+    for (hash_table_entry_t *entry = *slot;
+         entry && entry->next && get_slot(t, entry->next->hash) == slot; entry = entry->next) {
+      size += get_bucket(entry->next->hash, t->bcount) == n;
+    }
+  }
+
+  return size;
+}
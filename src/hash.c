@@ -0,0 +1,123 @@
+// The MIT License (MIT)
+// Copyright (c) 2017 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#include "cdcontainers/hash.h"
+
+#include <stdint.h>
+#include <string.h>
+
+static const uint64_t secret[4] = {UINT64_C(0xa0761d6478bd642f), UINT64_C(0xe7037ed1a0b428db),
+                                   UINT64_C(0x8ebc6af09c88c6e3), UINT64_C(0x589965cc75374cc3)};
+
+// Computes the 128-bit product of a and b, a gets the low half and b gets the
+// high half.
+static void mum(uint64_t *a, uint64_t *b)
+{
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = (__uint128_t)*a * *b;
+  *a = (uint64_t)r;
+  *b = (uint64_t)(r >> 64);
+#else
+  uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static uint64_t mix(uint64_t a, uint64_t b)
+{
+  mum(&a, &b);
+  return a ^ b;
+}
+
+static uint64_t read8(const uint8_t *p)
+{
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static uint64_t read4(const uint8_t *p)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static uint64_t read3(const uint8_t *p, size_t k)
+{
+  return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+size_t cdc_hash_bytes(const void *data, size_t length, size_t seed)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  uint64_t s = (uint64_t)seed;
+  uint64_t a = 0;
+  uint64_t b = 0;
+  s ^= mix(s ^ secret[0], secret[1]);
+  if (length <= 16) {
+    if (length >= 4) {
+      size_t shift = (length >> 3) << 2;
+      a = (read4(p) << 32) | read4(p + shift);
+      b = (read4(p + length - 4) << 32) | read4(p + length - 4 - shift);
+    } else if (length > 0) {
+      a = read3(p, length);
+    }
+  } else {
+    size_t i = length;
+    if (i > 48) {
+      uint64_t s1 = s;
+      uint64_t s2 = s;
+      do {
+        s = mix(read8(p) ^ secret[1], read8(p + 8) ^ s);
+        s1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ s1);
+        s2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ s2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      s ^= s1 ^ s2;
+    }
+
+    while (i > 16) {
+      s = mix(read8(p) ^ secret[1], read8(p + 8) ^ s);
+      p += 16;
+      i -= 16;
+    }
+
+    a = read8(p + i - 16);
+    b = read8(p + i - 8);
+  }
+
+  a ^= secret[1];
+  b ^= s;
+  mum(&a, &b);
+  return (size_t)mix(a ^ secret[0] ^ (uint64_t)length, b ^ secret[1]);
+}
+
+size_t cdc_hash_str(const char *str, size_t seed)
+{
+  return cdc_hash_bytes(str, strlen(str), seed);
+}
@@ -113,14 +113,14 @@ stat_t heap_ctor(heap_t **h, data_info_t *info)
   assert(h != NULL);
   assert(CDC_HAS_CMP(info));
 
-  heap_t *tmp = (heap_t *)calloc(sizeof(heap_t), 1);
+  heap_t *tmp = (heap_t *)di_calloc(info, sizeof(heap_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   stat_t ret = array_ctor(&tmp->array, info);
   if (ret != CDC_STATUS_OK) {
-    free(tmp);
+    di_free(info, tmp);
     return ret;
   }
 
@@ -157,8 +157,18 @@ void heap_dtor(heap_t *h)
 {
   assert(h != NULL);
 
+  const allocator_t *allocator = CDC_ALLOCATOR(h->array->dinfo);
   array_dtor(h->array);
-  free(h);
+  cdc_free(allocator, h);
+}
+
+memory_usage_t heap_memory_usage(heap_t *h)
+{
+  assert(h != NULL);
+
+  memory_usage_t usage = array_memory_usage(h->array);
+  usage.bytes += sizeof(heap_t);
+  return usage;
 }
 
 void heap_extract_top(heap_t *h)
@@ -26,9 +26,9 @@
 #include <stdint.h>
 #include <string.h>
 
-static list_node_t *make_new_node(void *val)
+static list_node_t *make_new_node(list_t *l, void *val)
 {
-  list_node_t *node = (list_node_t *)malloc(sizeof(list_node_t));
+  list_node_t *node = (list_node_t *)di_malloc(l->dinfo, sizeof(list_node_t));
   if (node) {
     node->data = val;
   }
@@ -44,11 +44,15 @@ static void free_node(list_t *l, list_node_t *node)
     l->dinfo->dfree(node->data);
   }
 
-  free(node);
+  di_free(l->dinfo, node);
 }
 
 static void free_nodes(list_t *l)
 {
+  if (CDC_CAN_DROP_NODES(l->dinfo)) {
+    return;
+  }
+
   list_node_t *current = l->head;
   list_node_t *next = NULL;
   while (current) {
@@ -60,7 +64,7 @@ static void free_nodes(list_t *l)
 
 static stat_t insert_mid(list_t *l, list_node_t *n, void *value)
 {
-  list_node_t *node = make_new_node(value);
+  list_node_t *node = make_new_node(l, value);
   if (node == NULL) {
     return CDC_STATUS_BAD_ALLOC;
   }
@@ -240,13 +244,13 @@ stat_t list_ctor(list_t **l, data_info_t *info)
 {
   assert(l != NULL);
 
-  list_t *tmp = (list_t *)calloc(sizeof(list_t), 1);
+  list_t *tmp = (list_t *)di_calloc(info, sizeof(list_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
-    free(tmp);
+    di_free(info, tmp);
     return CDC_STATUS_BAD_ALLOC;
   }
 
@@ -282,8 +286,16 @@ void list_dtor(list_t *l)
   assert(l != NULL);
 
   free_nodes(l);
-  di_shared_dtor(l->dinfo);
-  free(l);
+  data_info_t *dinfo = l->dinfo;
+  di_free(dinfo, l);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t list_memory_usage(list_t *l)
+{
+  assert(l != NULL);
+
+  return memory_usage_make(sizeof(list_t) + l->size * sizeof(list_node_t), l->size);
 }
 
 void list_set(list_t *l, size_t index, void *value)
@@ -297,7 +309,7 @@ stat_t list_push_back(list_t *l, void *value)
 {
   assert(l != NULL);
 
-  list_node_t *node = make_new_node(value);
+  list_node_t *node = make_new_node(l, value);
   if (!node) {
     return CDC_STATUS_BAD_ALLOC;
   }
@@ -338,7 +350,7 @@ stat_t list_push_front(list_t *l, void *value)
 {
   assert(l != NULL);
 
-  list_node_t *node = make_new_node(value);
+  list_node_t *node = make_new_node(l, value);
   if (!node) {
     return CDC_STATUS_BAD_ALLOC;
   }
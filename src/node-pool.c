@@ -0,0 +1,173 @@
+// The MIT License (MIT)
+// Copyright (c) 2017 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "cdcontainers/node-pool.h"
+
+#include "cdcontainers/data-info.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#if defined(CDC_NODE_POOL_HUGEPAGES) && defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Nodes are aligned as pointers, a free node stores the pointer to the next one.
+#define NODE_POOL_ALIGNMENT sizeof(void *)
+
+// A chunk starts with the pointer to the previous chunk followed by nodes.
+struct chunk {
+  struct chunk *next;
+};
+
+static size_t align_up(size_t size)
+{
+  return (size + NODE_POOL_ALIGNMENT - 1) & ~(NODE_POOL_ALIGNMENT - 1);
+}
+
+static size_t header_size()
+{
+  return align_up(sizeof(struct chunk));
+}
+
+static void *alloc_chunk(node_pool_t *pool, size_t size)
+{
+// Chunks from posix_memalign have no header of the memory counter.
+#if defined(CDC_NODE_POOL_HUGEPAGES) && defined(__linux__) && defined(MADV_HUGEPAGE) && \
+    !defined(CDC_MEMORY_COUNTER)
+  if (size == CDC_NODE_POOL_HUGEPAGE_SIZE && !CDC_HAS_ALLOCATOR(pool->dinfo)) {
+    void *chunk = NULL;
+    if (posix_memalign(&chunk, CDC_NODE_POOL_HUGEPAGE_SIZE, size) != 0) {
+      return NULL;
+    }
+
+    madvise(chunk, size, MADV_HUGEPAGE);
+    return chunk;
+  }
+#endif
+  return di_malloc(pool->dinfo, size);
+}
+
+static bool add_chunk(node_pool_t *pool)
+{
+  size_t size = pool->chunk_size ? header_size() + pool->node_size * pool->chunk_size
+                                  : pool->chunk_bytes;
+  struct chunk *chunk = (struct chunk *)alloc_chunk(pool, size);
+  if (!chunk) {
+    return false;
+  }
+
+  chunk->next = (struct chunk *)pool->chunks;
+  pool->chunks = chunk;
+  pool->bytes += size;
+  pool->cursor = (char *)chunk + header_size();
+  pool->end = pool->cursor + (size - header_size()) / pool->node_size * pool->node_size;
+  if (!pool->chunk_size && pool->chunk_bytes < CDC_NODE_POOL_HUGEPAGE_SIZE) {
+    pool->chunk_bytes *= 2;
+  }
+
+  return true;
+}
+
+stat_t node_pool_ctor(node_pool_t **pool, data_info_t *info, size_t node_size, size_t chunk_size)
+{
+  assert(pool != NULL);
+  assert(node_size > 0);
+
+  node_pool_t *tmp = (node_pool_t *)di_calloc(info, sizeof(node_pool_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  tmp->node_size = align_up(node_size < sizeof(void *) ? sizeof(void *) : node_size);
+  tmp->chunk_size = chunk_size;
+  tmp->chunk_bytes = CDC_NODE_POOL_PAGE_SIZE;
+  assert(chunk_size > 0 || header_size() + tmp->node_size <= CDC_NODE_POOL_PAGE_SIZE);
+  tmp->dinfo = info;
+  *pool = tmp;
+  return CDC_STATUS_OK;
+}
+
+void node_pool_dtor(node_pool_t *pool)
+{
+  assert(pool != NULL);
+
+  node_pool_clear(pool);
+  di_free(pool->dinfo, pool);
+}
+
+void *node_pool_alloc(node_pool_t *pool)
+{
+  assert(pool != NULL);
+
+  if (pool->free_nodes) {
+    void *node = pool->free_nodes;
+    pool->free_nodes = *(void **)node;
+    return node;
+  }
+
+  // New nodes are cut from the current chunk one after another, so nodes that
+  // are allocated together are adjacent in memory.
+  if (pool->cursor == pool->end && !add_chunk(pool)) {
+    return NULL;
+  }
+
+  void *node = pool->cursor;
+  pool->cursor += pool->node_size;
+  return node;
+}
+
+void node_pool_free(node_pool_t *pool, void *node)
+{
+  assert(pool != NULL);
+
+  if (node) {
+    *(void **)node = pool->free_nodes;
+    pool->free_nodes = node;
+  }
+}
+
+void node_pool_clear(node_pool_t *pool)
+{
+  assert(pool != NULL);
+
+  struct chunk *chunk = CDC_HAS_BULK_FREE(pool->dinfo) ? NULL : (struct chunk *)pool->chunks;
+  while (chunk) {
+    struct chunk *next = chunk->next;
+    di_free(pool->dinfo, chunk);
+    chunk = next;
+  }
+
+  pool->free_nodes = NULL;
+  pool->chunks = NULL;
+  pool->cursor = NULL;
+  pool->end = NULL;
+  pool->chunk_bytes = CDC_NODE_POOL_PAGE_SIZE;
+  pool->bytes = 0;
+}
+
+size_t node_pool_memory_usage(node_pool_t *pool)
+{
+  assert(pool != NULL);
+
+  return sizeof(node_pool_t) + pool->bytes;
+}
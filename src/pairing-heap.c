@@ -34,7 +34,7 @@ static void free_node(pairing_heap_t *h, pairing_heap_node_t *node)
     h->dinfo->dfree(node->key);
   }
 
-  free(node);
+  di_free(h->dinfo, node);
 }
 
 static void free_heap(pairing_heap_t *h, pairing_heap_node_t *root)
@@ -167,13 +167,13 @@ stat_t pairing_heap_ctor(pairing_heap_t **h, data_info_t *info)
   assert(h != NULL);
   assert(CDC_HAS_CMP(info));
 
-  pairing_heap_t *tmp = (pairing_heap_t *)calloc(sizeof(pairing_heap_t), 1);
+  pairing_heap_t *tmp = (pairing_heap_t *)di_calloc(info, sizeof(pairing_heap_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
-    free(tmp);
+    di_free(info, tmp);
     return CDC_STATUS_BAD_ALLOC;
   }
 
@@ -211,8 +211,17 @@ void pairing_heap_dtor(pairing_heap_t *h)
   assert(h != NULL);
 
   free_heap(h, h->root);
-  di_shared_dtor(h->dinfo);
-  free(h);
+  data_info_t *dinfo = h->dinfo;
+  di_free(dinfo, h);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t pairing_heap_memory_usage(pairing_heap_t *h)
+{
+  assert(h != NULL);
+
+  return memory_usage_make(sizeof(pairing_heap_t) + h->size * sizeof(pairing_heap_node_t),
+                           h->size);
 }
 
 stat_t pairing_heap_extract_top(pairing_heap_t *h)
@@ -230,7 +239,8 @@ stat_t pairing_heap_riinsert(pairing_heap_t *h, void *key, pairing_heap_iter_t *
 {
   assert(h != NULL);
 
-  pairing_heap_node_t *root = (pairing_heap_node_t *)calloc(sizeof(pairing_heap_node_t), 1);
+  pairing_heap_node_t *root =
+      (pairing_heap_node_t *)di_calloc(h->dinfo, sizeof(pairing_heap_node_t));
   if (!root) {
     return CDC_STATUS_BAD_ALLOC;
   }
@@ -0,0 +1,818 @@
+﻿// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "cdcontainers/rb-tree.h"
+
+#include "cdcontainers/data-info.h"
+#include "cdcontainers/node-pool.h"
+#include "cdcontainers/tree-utils.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Colors of nodes, the lowest bit of parent_color.
+#define RB_RED 0
+#define RB_BLACK 1
+
+CDC_MAKE_FIND_NODE_FN(rb_tree_node_t *)
+CDC_MAKE_FIND_NODE_BY_PROBE_FN(rb_tree_node_t *)
+CDC_MAKE_LOWER_BOUND_FN(rb_tree_node_t *)
+CDC_MAKE_UPPER_BOUND_FN(rb_tree_node_t *)
+CDC_MAKE_MIN_NODE_FN(rb_tree_node_t *)
+CDC_MAKE_MAX_NODE_FN(rb_tree_node_t *)
+
+static rb_tree_node_t *make_new_node(rb_tree_t *t, void *key, void *val)
+{
+  rb_tree_node_t *node = (rb_tree_node_t *)node_pool_alloc(t->pool);
+  if (!node) {
+    return NULL;
+  }
+
+  node->key = key;
+  node->value = val;
+  node->parent_color = RB_RED;
+  node->left = NULL;
+  node->right = NULL;
+  return node;
+}
+
+static void free_node(rb_tree_t *t, rb_tree_node_t *node)
+{
+  assert(t != NULL);
+
+  if (CDC_HAS_DFREE(t->dinfo)) {
+    pair_t pair = {node->key, node->value};
+    t->dinfo->dfree(&pair);
+  }
+
+  node_pool_free(t->pool, node);
+}
+
+static void free_rb_tree(rb_tree_t *t, rb_tree_node_t *root)
+{
+  assert(t != NULL);
+
+  // The nodes are released with the chunks of the pool, so they are visited
+  // only to free the data.
+  if (root == NULL || !CDC_HAS_DFREE(t->dinfo)) {
+    return;
+  }
+
+  free_rb_tree(t, root->left);
+  free_rb_tree(t, root->right);
+  free_node(t, root);
+}
+
+static rb_tree_node_t *parent_of(rb_tree_node_t *node)
+{
+  return (rb_tree_node_t *)(node->parent_color & ~(uintptr_t)RB_BLACK);
+}
+
+static bool is_red(rb_tree_node_t *node)
+{
+  return node && (node->parent_color & RB_BLACK) == RB_RED;
+}
+
+static uintptr_t color_of(rb_tree_node_t *node)
+{
+  return is_red(node) ? RB_RED : RB_BLACK;
+}
+
+static void set_parent(rb_tree_node_t *node, rb_tree_node_t *parent)
+{
+  node->parent_color = (uintptr_t)parent | (node->parent_color & RB_BLACK);
+}
+
+static void set_color(rb_tree_node_t *node, uintptr_t color)
+{
+  node->parent_color = (node->parent_color & ~(uintptr_t)RB_BLACK) | color;
+}
+
+static rb_tree_node_t *successor(rb_tree_node_t *node)
+{
+  if (node->right) {
+    return cdc_min_tree_node(node->right);
+  }
+
+  rb_tree_node_t *p = parent_of(node);
+  while (p && node == p->right) {
+    node = p;
+    p = parent_of(p);
+  }
+
+  return p;
+}
+
+static rb_tree_node_t *predecessor(rb_tree_node_t *node)
+{
+  if (node->left) {
+    return cdc_max_tree_node(node->left);
+  }
+
+  rb_tree_node_t *p = parent_of(node);
+  while (p && node == p->left) {
+    node = p;
+    p = parent_of(p);
+  }
+
+  return p;
+}
+
+static void replace_child(rb_tree_t *t, rb_tree_node_t *parent, rb_tree_node_t *old_child,
+                          rb_tree_node_t *new_child)
+{
+  if (!parent) {
+    t->root = new_child;
+  } else if (parent->left == old_child) {
+    parent->left = new_child;
+  } else {
+    parent->right = new_child;
+  }
+}
+
+static void rotate_left(rb_tree_t *t, rb_tree_node_t *node)
+{
+  rb_tree_node_t *q = node->right;
+  rb_tree_node_t *parent = parent_of(node);
+  node->right = q->left;
+  if (node->right) {
+    set_parent(node->right, node);
+  }
+
+  q->left = node;
+  set_parent(q, parent);
+  replace_child(t, parent, node, q);
+  set_parent(node, q);
+}
+
+static void rotate_right(rb_tree_t *t, rb_tree_node_t *node)
+{
+  rb_tree_node_t *q = node->left;
+  rb_tree_node_t *parent = parent_of(node);
+  node->left = q->right;
+  if (node->left) {
+    set_parent(node->left, node);
+  }
+
+  q->right = node;
+  set_parent(q, parent);
+  replace_child(t, parent, node, q);
+  set_parent(node, q);
+}
+
+// Restores the properties after the red node is linked. Recoloring moves the
+// violation up the tree, rotations end the loop.
+static void insert_fixup(rb_tree_t *t, rb_tree_node_t *node)
+{
+  rb_tree_node_t *parent = NULL;
+  while ((parent = parent_of(node)) && is_red(parent)) {
+    // The parent is red, so it is not the root.
+    rb_tree_node_t *gparent = parent_of(parent);
+    if (parent == gparent->left) {
+      rb_tree_node_t *uncle = gparent->right;
+      if (is_red(uncle)) {
+        set_color(uncle, RB_BLACK);
+        set_color(parent, RB_BLACK);
+        set_color(gparent, RB_RED);
+        node = gparent;
+        continue;
+      }
+
+      if (node == parent->right) {
+        rotate_left(t, parent);
+        parent = node;
+      }
+
+      set_color(parent, RB_BLACK);
+      set_color(gparent, RB_RED);
+      rotate_right(t, gparent);
+      break;
+    } else {
+      rb_tree_node_t *uncle = gparent->left;
+      if (is_red(uncle)) {
+        set_color(uncle, RB_BLACK);
+        set_color(parent, RB_BLACK);
+        set_color(gparent, RB_RED);
+        node = gparent;
+        continue;
+      }
+
+      if (node == parent->left) {
+        rotate_right(t, parent);
+        parent = node;
+      }
+
+      set_color(parent, RB_BLACK);
+      set_color(gparent, RB_RED);
+      rotate_left(t, gparent);
+      break;
+    }
+  }
+
+  set_color(t->root, RB_BLACK);
+}
+
+// Restores the black height of the subtree of the node, which can be NULL,
+// after a black node above it is removed.
+static void erase_fixup(rb_tree_t *t, rb_tree_node_t *node, rb_tree_node_t *parent)
+{
+  while (node != t->root && !is_red(node)) {
+    if (node == parent->left) {
+      rb_tree_node_t *sibling = parent->right;
+      if (is_red(sibling)) {
+        set_color(sibling, RB_BLACK);
+        set_color(parent, RB_RED);
+        rotate_left(t, parent);
+        sibling = parent->right;
+      }
+
+      if (!is_red(sibling->left) && !is_red(sibling->right)) {
+        set_color(sibling, RB_RED);
+        node = parent;
+        parent = parent_of(node);
+        continue;
+      }
+
+      if (!is_red(sibling->right)) {
+        set_color(sibling->left, RB_BLACK);
+        set_color(sibling, RB_RED);
+        rotate_right(t, sibling);
+        sibling = parent->right;
+      }
+
+      set_color(sibling, color_of(parent));
+      set_color(parent, RB_BLACK);
+      set_color(sibling->right, RB_BLACK);
+      rotate_left(t, parent);
+    } else {
+      rb_tree_node_t *sibling = parent->left;
+      if (is_red(sibling)) {
+        set_color(sibling, RB_BLACK);
+        set_color(parent, RB_RED);
+        rotate_right(t, parent);
+        sibling = parent->left;
+      }
+
+      if (!is_red(sibling->left) && !is_red(sibling->right)) {
+        set_color(sibling, RB_RED);
+        node = parent;
+        parent = parent_of(node);
+        continue;
+      }
+
+      if (!is_red(sibling->left)) {
+        set_color(sibling->right, RB_BLACK);
+        set_color(sibling, RB_RED);
+        rotate_left(t, sibling);
+        sibling = parent->left;
+      }
+
+      set_color(sibling, color_of(parent));
+      set_color(parent, RB_BLACK);
+      set_color(sibling->left, RB_BLACK);
+      rotate_right(t, parent);
+    }
+
+    node = t->root;
+  }
+
+  if (node) {
+    set_color(node, RB_BLACK);
+  }
+}
+
+static rb_tree_node_t *insert_unique(rb_tree_t *t, rb_tree_node_t *node, rb_tree_node_t *nearest)
+{
+  if (t->root != NULL) {
+    if (t->dinfo->cmp(node->key, nearest->key)) {
+      nearest->left = node;
+    } else {
+      nearest->right = node;
+    }
+
+    set_parent(node, nearest);
+    insert_fixup(t, node);
+  } else {
+    set_color(node, RB_BLACK);
+    t->root = node;
+  }
+
+  ++t->size;
+  return node;
+}
+
+static rb_tree_node_t *find_hint(rb_tree_node_t *node, void *key, cdc_binary_pred_fn_t compar)
+{
+  while (node) {
+    if (compar(key, node->key)) {
+      if (node->left) {
+        node = node->left;
+      } else {
+        break;
+      }
+    } else if (compar(node->key, key)) {
+      if (node->right) {
+        node = node->right;
+      } else {
+        break;
+      }
+    } else {
+      break;
+    }
+  }
+
+  return node;
+}
+
+static void erase_node(rb_tree_t *t, rb_tree_node_t *node)
+{
+  if (node->left && node->right) {
+    rb_tree_node_t *mnode = cdc_min_tree_node(node->right);
+    CDC_SWAP(void *, node->value, mnode->value);
+    CDC_SWAP(void *, node->key, mnode->key);
+    node = mnode;
+  }
+
+  rb_tree_node_t *child = node->left ? node->left : node->right;
+  rb_tree_node_t *parent = parent_of(node);
+  replace_child(t, parent, node, child);
+  if (child) {
+    set_parent(child, parent);
+  }
+
+  if (!is_red(node)) {
+    erase_fixup(t, child, parent);
+  }
+
+  free_node(t, node);
+}
+
+// Builds a balanced subtree of the sorted pairs. Nodes are allocated in the
+// order of the keys, so neighbouring keys are close in memory.
+// All levels except the deepest one are full, so the nodes of the deepest level
+// are red and the others are black.
+static stat_t build_sorted(rb_tree_t *t, const pair_t *pairs, size_t n, size_t depth,
+                           size_t red_depth, rb_tree_node_t **root)
+{
+  *root = NULL;
+  if (n == 0) {
+    return CDC_STATUS_OK;
+  }
+
+  size_t mid = n / 2;
+  rb_tree_node_t *left = NULL;
+  rb_tree_node_t *right = NULL;
+  stat_t stat = build_sorted(t, pairs, mid, depth + 1, red_depth, &left);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  rb_tree_node_t *node = make_new_node(t, pairs[mid].first, pairs[mid].second);
+  if (!node) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  stat = build_sorted(t, pairs + mid + 1, n - mid - 1, depth + 1, red_depth, &right);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  node->left = left;
+  node->right = right;
+  if (left) {
+    set_parent(left, node);
+  }
+
+  if (right) {
+    set_parent(right, node);
+  }
+
+  set_color(node, depth == red_depth ? RB_RED : RB_BLACK);
+  *root = node;
+  return CDC_STATUS_OK;
+}
+
+static stat_t init_varg(rb_tree_t *t, va_list args)
+{
+  pair_t *pair = NULL;
+  while ((pair = va_arg(args, pair_t *)) != CDC_END) {
+    stat_t stat = rb_tree_insert(t, pair->first, pair->second, NULL);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  }
+
+  return CDC_STATUS_OK;
+}
+
+stat_t rb_tree_ctor(rb_tree_t **t, data_info_t *info)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+
+  rb_tree_t *tmp = (rb_tree_t *)di_calloc(info, sizeof(rb_tree_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
+    di_free(info, tmp);
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  stat_t stat = node_pool_ctor(&tmp->pool, tmp->dinfo, sizeof(rb_tree_node_t), 0);
+  if (stat != CDC_STATUS_OK) {
+    di_shared_dtor(tmp->dinfo);
+    di_free(info, tmp);
+    return stat;
+  }
+
+  *t = tmp;
+  return CDC_STATUS_OK;
+}
+
+stat_t rb_tree_ctorl(rb_tree_t **t, data_info_t *info, ...)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+
+  va_list args;
+  va_start(args, info);
+  stat_t stat = rb_tree_ctorv(t, info, args);
+  va_end(args);
+  return stat;
+}
+
+stat_t rb_tree_ctorv(rb_tree_t **t, data_info_t *info, va_list args)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+
+  stat_t stat = rb_tree_ctor(t, info);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  return init_varg(*t, args);
+}
+
+stat_t rb_tree_ctor_sorted(rb_tree_t **t, data_info_t *info, const pair_t *pairs, size_t n)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+  assert(pairs != NULL || n == 0);
+  assert(cdc_is_sorted_unique(pairs, n, info->cmp));
+
+  rb_tree_t *tmp = NULL;
+  stat_t stat = rb_tree_ctor(&tmp, info);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  size_t red_depth = 0;
+  while (((size_t)2 << red_depth) <= n) {
+    ++red_depth;
+  }
+
+  // Nodes of a failed build are not linked to the root, so they are released
+  // with the pool and the data is not freed.
+  if ((stat = build_sorted(tmp, pairs, n, 0, red_depth, &tmp->root)) != CDC_STATUS_OK) {
+    tmp->root = NULL;
+    rb_tree_dtor(tmp);
+    return stat;
+  }
+
+  if (tmp->root) {
+    set_color(tmp->root, RB_BLACK);
+  }
+
+  tmp->size = n;
+  *t = tmp;
+  return CDC_STATUS_OK;
+}
+
+void rb_tree_dtor(rb_tree_t *t)
+{
+  assert(t != NULL);
+
+  free_rb_tree(t, t->root);
+  node_pool_dtor(t->pool);
+  data_info_t *dinfo = t->dinfo;
+  di_free(dinfo, t);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t rb_tree_memory_usage(rb_tree_t *t)
+{
+  assert(t != NULL);
+
+  return memory_usage_make(sizeof(rb_tree_t) + node_pool_memory_usage(t->pool), t->size);
+}
+
+stat_t rb_tree_get(rb_tree_t *t, void *key, void **value)
+{
+  assert(t != NULL);
+
+  rb_tree_node_t *node = cdc_find_tree_node(t->root, key, t->dinfo->cmp);
+  if (node) {
+    *value = node->value;
+    return CDC_STATUS_OK;
+  }
+
+  return CDC_STATUS_NOT_FOUND;
+}
+
+size_t rb_tree_count(rb_tree_t *t, void *key)
+{
+  assert(t != NULL);
+
+  return (size_t)(cdc_find_tree_node(t->root, key, t->dinfo->cmp) != NULL);
+}
+
+void rb_tree_find(rb_tree_t *t, void *key, rb_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  rb_tree_node_t *node = cdc_find_tree_node(t->root, key, t->dinfo->cmp);
+  if (!node) {
+    rb_tree_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = predecessor(node);
+}
+
+void rb_tree_lower_bound(rb_tree_t *t, void *key, rb_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  rb_tree_node_t *node = cdc_lower_bound_tree_node(t->root, key, t->dinfo->cmp);
+  if (!node) {
+    rb_tree_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = predecessor(node);
+}
+
+void rb_tree_upper_bound(rb_tree_t *t, void *key, rb_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  rb_tree_node_t *node = cdc_upper_bound_tree_node(t->root, key, t->dinfo->cmp);
+  if (!node) {
+    rb_tree_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = predecessor(node);
+}
+
+void rb_tree_equal_range(rb_tree_t *t, void *key, pair_rb_tree_iter_t *range)
+{
+  assert(t != NULL);
+  assert(range != NULL);
+
+  rb_tree_lower_bound(t, key, &range->first);
+  range->second = range->first;
+  if (range->first.current && !t->dinfo->cmp(key, range->first.current->key)) {
+    rb_tree_iter_next(&range->second);
+  }
+}
+
+void rb_tree_range(rb_tree_t *t, void *from, void *to, pair_rb_tree_iter_t *range)
+{
+  assert(t != NULL);
+  assert(range != NULL);
+  assert(!t->dinfo->cmp(to, from));
+
+  rb_tree_lower_bound(t, from, &range->first);
+  rb_tree_lower_bound(t, to, &range->second);
+}
+
+stat_t rb_tree_get_probe(rb_tree_t *t, const void *probe, const probe_info_t *info, void **value)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  rb_tree_node_t *node = cdc_find_tree_node_by_probe(t->root, probe, info);
+  if (node) {
+    *value = node->value;
+    return CDC_STATUS_OK;
+  }
+
+  return CDC_STATUS_NOT_FOUND;
+}
+
+size_t rb_tree_count_probe(rb_tree_t *t, const void *probe, const probe_info_t *info)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  return (size_t)(cdc_find_tree_node_by_probe(t->root, probe, info) != NULL);
+}
+
+void rb_tree_find_probe(rb_tree_t *t, const void *probe, const probe_info_t *info,
+                         rb_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+  assert(it != NULL);
+
+  rb_tree_node_t *node = cdc_find_tree_node_by_probe(t->root, probe, info);
+  if (!node) {
+    rb_tree_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = predecessor(node);
+}
+
+stat_t rb_tree_insert(rb_tree_t *t, void *key, void *value, pair_rb_tree_iter_bool_t *ret)
+{
+  assert(t != NULL);
+
+  rb_tree_iter_t *it = NULL;
+  bool *inserted = NULL;
+  if (ret) {
+    it = &ret->first;
+    inserted = &ret->second;
+  }
+
+  return rb_tree_insert1(t, key, value, it, inserted);
+}
+
+stat_t rb_tree_insert1(rb_tree_t *t, void *key, void *value, rb_tree_iter_t *it, bool *inserted)
+{
+  assert(t != NULL);
+
+  rb_tree_node_t *node = find_hint(t->root, key, t->dinfo->cmp);
+  bool finded = node && cdc_eq(t->dinfo->cmp, node->key, key);
+  if (!finded) {
+    rb_tree_node_t *new_node = make_new_node(t, key, value);
+    if (!new_node) {
+      return CDC_STATUS_BAD_ALLOC;
+    }
+
+    node = insert_unique(t, new_node, node);
+  }
+
+  if (it) {
+    it->container = t;
+    it->current = node;
+    it->prev = predecessor(node);
+  }
+
+  if (inserted) {
+    *inserted = !finded;
+  }
+
+  return CDC_STATUS_OK;
+}
+
+stat_t rb_tree_insert_or_assign(rb_tree_t *t, void *key, void *value,
+                                 pair_rb_tree_iter_bool_t *ret)
+{
+  assert(t != NULL);
+
+  rb_tree_iter_t *it = NULL;
+  bool *inserted = NULL;
+  if (ret) {
+    it = &ret->first;
+    inserted = &ret->second;
+  }
+
+  return rb_tree_insert_or_assign1(t, key, value, it, inserted);
+}
+
+stat_t rb_tree_insert_or_assign1(rb_tree_t *t, void *key, void *value, rb_tree_iter_t *it,
+                                  bool *inserted)
+{
+  assert(t != NULL);
+
+  rb_tree_node_t *node = find_hint(t->root, key, t->dinfo->cmp);
+  bool finded = node && cdc_eq(t->dinfo->cmp, node->key, key);
+  if (!finded) {
+    rb_tree_node_t *new_node = make_new_node(t, key, value);
+    if (!new_node) {
+      return CDC_STATUS_BAD_ALLOC;
+    }
+
+    node = insert_unique(t, new_node, node);
+  } else {
+    node->value = value;
+  }
+
+  if (it) {
+    it->container = t;
+    it->current = node;
+    it->prev = predecessor(node);
+  }
+
+  if (inserted) {
+    *inserted = !finded;
+  }
+
+  return CDC_STATUS_OK;
+}
+
+size_t rb_tree_erase(rb_tree_t *t, void *key)
+{
+  assert(t != NULL);
+
+  rb_tree_node_t *node = cdc_find_tree_node(t->root, key, t->dinfo->cmp);
+  if (!node) {
+    return 0;
+  }
+
+  erase_node(t, node);
+  --t->size;
+  return 1;
+}
+
+void rb_tree_clear(rb_tree_t *t)
+{
+  assert(t != NULL);
+
+  free_rb_tree(t, t->root);
+  node_pool_clear(t->pool);
+  t->size = 0;
+  t->root = NULL;
+}
+
+void rb_tree_swap(rb_tree_t *a, rb_tree_t *b)
+{
+  assert(a != NULL);
+  assert(b != NULL);
+
+  CDC_SWAP(rb_tree_node_t *, a->root, b->root);
+  CDC_SWAP(size_t, a->size, b->size);
+  CDC_SWAP(data_info_t *, a->dinfo, b->dinfo);
+  CDC_SWAP(node_pool_t *, a->pool, b->pool);
+}
+
+void rb_tree_begin(rb_tree_t *t, rb_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  it->container = t;
+  it->current = cdc_min_tree_node(t->root);
+  it->prev = NULL;
+}
+
+void rb_tree_end(rb_tree_t *t, rb_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  it->container = t;
+  it->current = NULL;
+  it->prev = cdc_max_tree_node(t->root);
+}
+
+void rb_tree_iter_next(rb_tree_iter_t *it)
+{
+  assert(it != NULL);
+
+  it->prev = it->current;
+  it->current = successor(it->current);
+}
+
+void rb_tree_iter_prev(rb_tree_iter_t *it)
+{
+  assert(it != NULL);
+
+  it->current = it->prev;
+  it->prev = predecessor(it->current);
+}
@@ -0,0 +1,490 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "cdcontainers/rcu-hash-table.h"
+
+#include "cdcontainers/data-info.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RCU_HASH_TABLE_MIN_CAPACITY 8  // must be pow 2
+#define RCU_HASH_TABLE_COPACITY_SHIFT 1
+#define RCU_HASH_TABLE_LOAD_FACTOR 0.7f
+
+// Entries are published with release stores and loaded with acquire loads, so
+// a reader that finds an entry also sees its key, value and hash. Writers are
+// serialized by the mutex and read the links directly.
+static rcu_hash_table_entry_t *load_link(rcu_hash_table_entry_t **link)
+{
+  return __atomic_load_n(link, __ATOMIC_ACQUIRE);
+}
+
+static void publish_link(rcu_hash_table_entry_t **link, rcu_hash_table_entry_t *entry)
+{
+  __atomic_store_n(link, entry, __ATOMIC_RELEASE);
+}
+
+static size_t get_bucket(size_t hash, size_t count)
+{
+  return hash & (count - 1);
+}
+
+static rcu_hash_table_buckets_t *new_buckets(rcu_hash_table_t *t, size_t count)
+{
+  return (rcu_hash_table_buckets_t *)di_calloc(
+      t->dinfo, sizeof(rcu_hash_table_buckets_t) + count * sizeof(rcu_hash_table_entry_t *));
+}
+
+static rcu_hash_table_entry_t *new_entry(rcu_hash_table_t *t, void *key, void *value,
+                                         size_t hash)
+{
+  rcu_hash_table_entry_t *entry =
+      (rcu_hash_table_entry_t *)di_calloc(t->dinfo, sizeof(rcu_hash_table_entry_t));
+  if (entry) {
+    entry->key = key;
+    entry->value = value;
+    entry->hash = hash;
+  }
+
+  return entry;
+}
+
+static void free_entry(rcu_hash_table_t *t, rcu_hash_table_entry_t *entry, bool free_data)
+{
+  if (free_data && CDC_HAS_DFREE(t->dinfo)) {
+    pair_t pair = {entry->key, entry->value};
+    t->dinfo->dfree(&pair);
+  }
+
+  di_free(t->dinfo, entry);
+}
+
+static bool should_grow(rcu_hash_table_t *t)
+{
+  return ((double)(t->size + 1) / (double)t->buckets->count) >= t->load_factor;
+}
+
+static void retire_entry(rcu_hash_table_t *t, rcu_hash_table_entry_t *entry, bool free_data)
+{
+  entry->retired_epoch = t->epoch;
+  entry->free_data = free_data;
+  entry->retired_next = t->retired_entries;
+  t->retired_entries = entry;
+  ++t->retired_count;
+}
+
+static void retire_chain(rcu_hash_table_t *t, rcu_hash_table_entry_t *entry, bool free_data)
+{
+  while (entry) {
+    rcu_hash_table_entry_t *next = entry->next;
+    retire_entry(t, entry, free_data);
+    entry = next;
+  }
+}
+
+static void retire_buckets(rcu_hash_table_t *t, rcu_hash_table_buckets_t *buckets)
+{
+  buckets->retired_epoch = t->epoch;
+  buckets->retired_next = t->retired_buckets;
+  t->retired_buckets = buckets;
+}
+
+static size_t min_reader_epoch(rcu_hash_table_t *t)
+{
+  size_t min = SIZE_MAX;
+  for (rcu_reader_t *r = t->readers; r; r = r->next) {
+    size_t epoch = __atomic_load_n(&r->epoch, __ATOMIC_ACQUIRE);
+    if (epoch != 0 && epoch < min) {
+      min = epoch;
+    }
+  }
+
+  return min;
+}
+
+static void reclaim(rcu_hash_table_t *t)
+{
+  // Pairs with the fence in cdc_rcu_reader_lock: either the reader sees the
+  // unlinked state, or the writer sees the epoch of the reader.
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  size_t min = min_reader_epoch(t);
+
+  // An entry retired in epoch e is unreachable for the readers that entered
+  // their sections in a later epoch.
+  rcu_hash_table_entry_t **entry = &t->retired_entries;
+  while (*entry) {
+    rcu_hash_table_entry_t *curr = *entry;
+    if (curr->retired_epoch < min) {
+      *entry = curr->retired_next;
+      free_entry(t, curr, curr->free_data);
+      --t->retired_count;
+    } else {
+      entry = &curr->retired_next;
+    }
+  }
+
+  rcu_hash_table_buckets_t **buckets = &t->retired_buckets;
+  while (*buckets) {
+    rcu_hash_table_buckets_t *curr = *buckets;
+    if (curr->retired_epoch < min) {
+      *buckets = curr->retired_next;
+      di_free(t->dinfo, curr);
+    } else {
+      buckets = &curr->retired_next;
+    }
+  }
+}
+
+// Finishes a modification: the entries retired by it get the current epoch
+// and the readers that enter their sections after this get the next one.
+static void finish_write(rcu_hash_table_t *t)
+{
+  __atomic_store_n(&t->epoch, t->epoch + 1, __ATOMIC_SEQ_CST);
+  reclaim(t);
+}
+
+static rcu_hash_table_entry_t **find_link(rcu_hash_table_t *t, void *key, size_t hash)
+{
+  rcu_hash_table_buckets_t *buckets = t->buckets;
+  rcu_hash_table_entry_t **link = &buckets->buckets[get_bucket(hash, buckets->count)];
+  while (*link) {
+    if ((*link)->hash == hash && t->dinfo->eq(key, (*link)->key)) {
+      return link;
+    }
+
+    link = &(*link)->next;
+  }
+
+  return NULL;
+}
+
+static rcu_hash_table_entry_t *find_entry(rcu_hash_table_t *t, void *key, size_t hash)
+{
+  rcu_hash_table_buckets_t *buckets = __atomic_load_n(&t->buckets, __ATOMIC_ACQUIRE);
+  rcu_hash_table_entry_t *entry = load_link(&buckets->buckets[get_bucket(hash, buckets->count)]);
+  while (entry) {
+    if (entry->hash == hash && t->dinfo->eq(key, entry->key)) {
+      return entry;
+    }
+
+    entry = load_link(&entry->next);
+  }
+
+  return NULL;
+}
+
+static void free_buckets(rcu_hash_table_t *t, rcu_hash_table_buckets_t *buckets, bool free_data)
+{
+  for (size_t i = 0; i < buckets->count; ++i) {
+    rcu_hash_table_entry_t *entry = buckets->buckets[i];
+    while (entry) {
+      rcu_hash_table_entry_t *next = entry->next;
+      free_entry(t, entry, free_data);
+      entry = next;
+    }
+  }
+
+  di_free(t->dinfo, buckets);
+}
+
+// Entries can not be moved to another chain while readers walk them, so the
+// table grows by copying all entries into a new bucket array.
+static stat_t grow(rcu_hash_table_t *t)
+{
+  rcu_hash_table_buckets_t *old = t->buckets;
+  size_t count = old->count << RCU_HASH_TABLE_COPACITY_SHIFT;
+  rcu_hash_table_buckets_t *buckets = new_buckets(t, count);
+  if (!buckets) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  buckets->count = count;
+  for (size_t i = 0; i < old->count; ++i) {
+    for (rcu_hash_table_entry_t *entry = old->buckets[i]; entry; entry = entry->next) {
+      rcu_hash_table_entry_t *copy = new_entry(t, entry->key, entry->value, entry->hash);
+      if (!copy) {
+        free_buckets(t, buckets, false);
+        return CDC_STATUS_BAD_ALLOC;
+      }
+
+      size_t bucket = get_bucket(copy->hash, count);
+      copy->next = buckets->buckets[bucket];
+      buckets->buckets[bucket] = copy;
+    }
+  }
+
+  __atomic_store_n(&t->buckets, buckets, __ATOMIC_RELEASE);
+  for (size_t i = 0; i < old->count; ++i) {
+    retire_chain(t, old->buckets[i], false);
+  }
+
+  retire_buckets(t, old);
+  return CDC_STATUS_OK;
+}
+
+static stat_t insert(rcu_hash_table_t *t, void *key, void *value, bool assign, bool *inserted)
+{
+  size_t hash = t->dinfo->hash(key);
+  stat_t stat = CDC_STATUS_OK;
+  bool is_inserted = false;
+  pthread_mutex_lock(&t->mutex);
+  rcu_hash_table_entry_t **link = find_link(t, key, hash);
+  if (link) {
+    if (assign) {
+      rcu_hash_table_entry_t *entry = *link;
+      rcu_hash_table_entry_t *copy = new_entry(t, entry->key, value, hash);
+      if (!copy) {
+        stat = CDC_STATUS_BAD_ALLOC;
+        goto unlock;
+      }
+
+      copy->next = entry->next;
+      publish_link(link, copy);
+      retire_entry(t, entry, false);
+      finish_write(t);
+    }
+  } else {
+    if (should_grow(t) && (stat = grow(t)) != CDC_STATUS_OK) {
+      goto unlock;
+    }
+
+    rcu_hash_table_entry_t *entry = new_entry(t, key, value, hash);
+    if (!entry) {
+      stat = CDC_STATUS_BAD_ALLOC;
+      goto unlock;
+    }
+
+    rcu_hash_table_buckets_t *buckets = t->buckets;
+    rcu_hash_table_entry_t **head = &buckets->buckets[get_bucket(hash, buckets->count)];
+    entry->next = *head;
+    publish_link(head, entry);
+    __atomic_store_n(&t->size, t->size + 1, __ATOMIC_RELAXED);
+    is_inserted = true;
+    finish_write(t);
+  }
+
+  if (inserted) {
+    *inserted = is_inserted;
+  }
+
+unlock:
+  pthread_mutex_unlock(&t->mutex);
+  return stat;
+}
+
+stat_t rcu_hash_table_ctor(rcu_hash_table_t **t, data_info_t *info)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+
+  return rcu_hash_table_ctor1(t, info, RCU_HASH_TABLE_LOAD_FACTOR);
+}
+
+stat_t rcu_hash_table_ctor1(rcu_hash_table_t **t, data_info_t *info, double load_factor)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(load_factor > 0);
+
+  rcu_hash_table_t *tmp = (rcu_hash_table_t *)di_calloc(info, sizeof(rcu_hash_table_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  stat_t stat = CDC_STATUS_OK;
+  if (!(tmp->dinfo = di_shared_ctorc(info))) {
+    stat = CDC_STATUS_BAD_ALLOC;
+    goto free_hash_table;
+  }
+
+  if (!(tmp->buckets = new_buckets(tmp, RCU_HASH_TABLE_MIN_CAPACITY))) {
+    stat = CDC_STATUS_BAD_ALLOC;
+    goto free_di;
+  }
+
+  if (pthread_mutex_init(&tmp->mutex, NULL) != 0) {
+    stat = CDC_STATUS_UNKN;
+    goto free_buckets;
+  }
+
+  tmp->buckets->count = RCU_HASH_TABLE_MIN_CAPACITY;
+  tmp->load_factor = load_factor;
+  // 0 is reserved for readers outside of critical sections.
+  tmp->epoch = 1;
+  *t = tmp;
+  return CDC_STATUS_OK;
+free_buckets:
+  di_free(info, tmp->buckets);
+free_di:
+  di_shared_dtor(tmp->dinfo);
+free_hash_table:
+  di_free(info, tmp);
+  return stat;
+}
+
+void rcu_hash_table_dtor(rcu_hash_table_t *t)
+{
+  assert(t != NULL);
+  assert(t->readers == NULL);
+
+  reclaim(t);
+  assert(t->retired_entries == NULL);
+  assert(t->retired_buckets == NULL);
+  free_buckets(t, t->buckets, true);
+  pthread_mutex_destroy(&t->mutex);
+  data_info_t *dinfo = t->dinfo;
+  di_free(dinfo, t);
+  di_shared_dtor(dinfo);
+}
+
+stat_t rcu_reader_ctor(rcu_hash_table_t *t, rcu_reader_t **r)
+{
+  assert(t != NULL);
+  assert(r != NULL);
+
+  void *tmp =
+      cdc_aligned_malloc(CDC_ALLOCATOR(t->dinfo), CDC_CACHE_LINE_SIZE, sizeof(rcu_reader_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  rcu_reader_t *reader = (rcu_reader_t *)tmp;
+  memset(reader, 0, sizeof(rcu_reader_t));
+  reader->table = t;
+  pthread_mutex_lock(&t->mutex);
+  reader->next = t->readers;
+  t->readers = reader;
+  pthread_mutex_unlock(&t->mutex);
+  *r = reader;
+  return CDC_STATUS_OK;
+}
+
+void rcu_reader_dtor(rcu_reader_t *r)
+{
+  assert(r != NULL);
+  assert(r->epoch == 0);
+
+  rcu_hash_table_t *t = r->table;
+  pthread_mutex_lock(&t->mutex);
+  rcu_reader_t **reader = &t->readers;
+  while (*reader != r) {
+    reader = &(*reader)->next;
+  }
+
+  *reader = r->next;
+  pthread_mutex_unlock(&t->mutex);
+  cdc_aligned_free(CDC_ALLOCATOR(t->dinfo), r);
+}
+
+stat_t rcu_hash_table_get(rcu_hash_table_t *t, void *key, void **value)
+{
+  assert(t != NULL);
+
+  rcu_hash_table_entry_t *entry = find_entry(t, key, t->dinfo->hash(key));
+  if (!entry) {
+    return CDC_STATUS_NOT_FOUND;
+  }
+
+  *value = entry->value;
+  return CDC_STATUS_OK;
+}
+
+size_t rcu_hash_table_count(rcu_hash_table_t *t, void *key)
+{
+  assert(t != NULL);
+
+  return (size_t)(find_entry(t, key, t->dinfo->hash(key)) != NULL);
+}
+
+size_t rcu_hash_table_retired_count(rcu_hash_table_t *t)
+{
+  assert(t != NULL);
+
+  pthread_mutex_lock(&t->mutex);
+  size_t count = t->retired_count;
+  pthread_mutex_unlock(&t->mutex);
+  return count;
+}
+
+void rcu_hash_table_clear(rcu_hash_table_t *t)
+{
+  assert(t != NULL);
+
+  pthread_mutex_lock(&t->mutex);
+  rcu_hash_table_buckets_t *buckets = t->buckets;
+  for (size_t i = 0; i < buckets->count; ++i) {
+    rcu_hash_table_entry_t *entry = buckets->buckets[i];
+    publish_link(&buckets->buckets[i], NULL);
+    retire_chain(t, entry, true);
+  }
+
+  __atomic_store_n(&t->size, 0, __ATOMIC_RELAXED);
+  finish_write(t);
+  pthread_mutex_unlock(&t->mutex);
+}
+
+stat_t rcu_hash_table_insert(rcu_hash_table_t *t, void *key, void *value, bool *inserted)
+{
+  assert(t != NULL);
+
+  return insert(t, key, value, false, inserted);
+}
+
+stat_t rcu_hash_table_insert_or_assign(rcu_hash_table_t *t, void *key, void *value,
+                                       bool *inserted)
+{
+  assert(t != NULL);
+
+  return insert(t, key, value, true, inserted);
+}
+
+size_t rcu_hash_table_erase(rcu_hash_table_t *t, void *key)
+{
+  assert(t != NULL);
+
+  size_t hash = t->dinfo->hash(key);
+  pthread_mutex_lock(&t->mutex);
+  rcu_hash_table_entry_t **link = find_link(t, key, hash);
+  if (link) {
+    rcu_hash_table_entry_t *entry = *link;
+    publish_link(link, entry->next);
+    retire_entry(t, entry, true);
+    __atomic_store_n(&t->size, t->size - 1, __ATOMIC_RELAXED);
+    finish_write(t);
+  }
+
+  pthread_mutex_unlock(&t->mutex);
+  return (size_t)(link != NULL);
+}
+
+void rcu_hash_table_reclaim(rcu_hash_table_t *t)
+{
+  assert(t != NULL);
+
+  pthread_mutex_lock(&t->mutex);
+  reclaim(t);
+  pthread_mutex_unlock(&t->mutex);
+}
@@ -0,0 +1,635 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "cdcontainers/robin-hood-table.h"
+
+#include "cdcontainers/data-info.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROBIN_HOOD_TABLE_MIN_CAPACITY 16  // must be pow 2
+#define ROBIN_HOOD_TABLE_COPACITY_SHIFT 1
+#define ROBIN_HOOD_TABLE_LOAD_FACTOR 0.9f
+// Distances are stored in one byte. The table grows when an element would be
+// moved farther than this from its home slot.
+#define ROBIN_HOOD_TABLE_MAX_DIST 128
+// The table does not grow because of a long probe if it would become emptier
+// than this: such a probe is caused by equal hashes rather than by the load.
+#define ROBIN_HOOD_TABLE_MIN_LOAD_FACTOR 0.125f
+
+// dists[i] == 0 marks an empty slot, otherwise dists[i] - 1 is the distance
+// between the slot i and the home slot of its element.
+
+// Slot selection uses the low bits of the hash, so user hashes with weak bits
+// (e.g. identity hashes of integers) are mixed first.
+static size_t get_hash(robin_hood_table_t *t, void *key)
+{
+  return cdc_hash_mix(t->dinfo->hash(key));
+}
+
+static size_t capacity_to_growth(size_t capacity, double load_factor)
+{
+  size_t growth = (size_t)((double)capacity * load_factor);
+  // At least one slot must stay empty, otherwise a probe of an absent key
+  // never stops.
+  return growth < capacity ? growth : capacity - 1;
+}
+
+static void free_entry(robin_hood_table_t *t, robin_hood_table_entry_t *entry)
+{
+  if (CDC_HAS_DFREE(t->dinfo)) {
+    pair_t pair = {entry->key, entry->value};
+    t->dinfo->dfree(&pair);
+  }
+}
+
+static void free_entries(robin_hood_table_t *t)
+{
+  if (!CDC_HAS_DFREE(t->dinfo)) {
+    return;
+  }
+
+  for (size_t i = 0; i < t->capacity; ++i) {
+    if (t->dists[i]) {
+      free_entry(t, &t->slots[i]);
+    }
+  }
+}
+
+// Returns the slot of the key or t->capacity. In the last case |pos| and |dist|
+// are set to the slot where the key has to be inserted. |eq| is called as
+// eq(key, stored key), so |key| may be a probe.
+static size_t find_slot(robin_hood_table_t *t, const void *key, cdc_binary_pred_fn_t eq,
+                        size_t hash, size_t *pos, size_t *dist)
+{
+  size_t mask = t->capacity - 1;
+  size_t i = hash & mask;
+  size_t d = 1;
+  // Elements of a cluster are ordered by their distances, so the search stops
+  // at the first element that is closer to its home than the key would be.
+  while (t->dists[i] >= d) {
+    if (t->dists[i] == d && t->slots[i].hash == hash && eq(key, t->slots[i].key)) {
+      return i;
+    }
+
+    i = (i + 1) & mask;
+    ++d;
+  }
+
+  if (pos) {
+    *pos = i;
+    *dist = d;
+  }
+
+  return t->capacity;
+}
+
+static size_t find_probe(robin_hood_table_t *t, const void *probe, const probe_info_t *info)
+{
+  return find_slot(t, probe, info->eq, cdc_hash_mix(info->hash(probe)), NULL, NULL);
+}
+
+static size_t find_pos(robin_hood_table_t *t, size_t hash, size_t *dist)
+{
+  size_t mask = t->capacity - 1;
+  size_t i = hash & mask;
+  size_t d = 1;
+  while (t->dists[i] >= d) {
+    i = (i + 1) & mask;
+    ++d;
+  }
+
+  *dist = d;
+  return i;
+}
+
+// Inserts the entry into the slot |pos| and shifts the elements that follow it
+// up to the nearest empty slot. Returns false and does not change the table if
+// any of the elements would be moved too far.
+static bool insert_at(robin_hood_table_t *t, size_t pos, size_t dist,
+                      robin_hood_table_entry_t *entry)
+{
+  if (dist > ROBIN_HOOD_TABLE_MAX_DIST) {
+    return false;
+  }
+
+  size_t mask = t->capacity - 1;
+  size_t last = pos;
+  while (t->dists[last]) {
+    if (t->dists[last] == ROBIN_HOOD_TABLE_MAX_DIST) {
+      return false;
+    }
+
+    last = (last + 1) & mask;
+  }
+
+  for (size_t i = last; i != pos; i = (i - 1) & mask) {
+    size_t prev = (i - 1) & mask;
+    t->slots[i] = t->slots[prev];
+    t->dists[i] = (uint8_t)(t->dists[prev] + 1);
+  }
+
+  t->slots[pos] = *entry;
+  t->dists[pos] = (uint8_t)dist;
+  return true;
+}
+
+static stat_t reallocate(robin_hood_table_t *t, size_t capacity)
+{
+  assert(capacity >= ROBIN_HOOD_TABLE_MIN_CAPACITY);
+  assert(capacity_to_growth(capacity, t->load_factor) >= t->size);
+
+  robin_hood_table_entry_t *slots = (robin_hood_table_entry_t *)di_malloc(
+      t->dinfo, capacity * sizeof(robin_hood_table_entry_t) + capacity * sizeof(uint8_t));
+  if (!slots) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  robin_hood_table_t tmp = *t;
+  tmp.slots = slots;
+  tmp.dists = (uint8_t *)(slots + capacity);
+  tmp.capacity = capacity;
+  memset(tmp.dists, 0, capacity * sizeof(uint8_t));
+  for (size_t i = 0; i < t->capacity; ++i) {
+    if (t->dists[i]) {
+      size_t dist = 0;
+      size_t pos = find_pos(&tmp, t->slots[i].hash, &dist);
+      if (!insert_at(&tmp, pos, dist, &t->slots[i])) {
+        di_free(t->dinfo, slots);
+        return CDC_STATUS_OVERFLOW;
+      }
+    }
+  }
+
+  di_free(t->dinfo, t->slots);
+  t->slots = tmp.slots;
+  t->dists = tmp.dists;
+  t->capacity = capacity;
+  return CDC_STATUS_OK;
+}
+
+static bool is_too_sparse(robin_hood_table_t *t, size_t capacity)
+{
+  return (double)t->size < (double)capacity * ROBIN_HOOD_TABLE_MIN_LOAD_FACTOR;
+}
+
+static stat_t grow(robin_hood_table_t *t)
+{
+  size_t capacity = t->capacity;
+  do {
+    capacity <<= ROBIN_HOOD_TABLE_COPACITY_SHIFT;
+  } while (capacity_to_growth(capacity, t->load_factor) <= t->size);
+
+  for (;;) {
+    stat_t stat = reallocate(t, capacity);
+    if (stat != CDC_STATUS_OVERFLOW) {
+      return stat;
+    }
+
+    capacity <<= ROBIN_HOOD_TABLE_COPACITY_SHIFT;
+    if (is_too_sparse(t, capacity)) {
+      return CDC_STATUS_OVERFLOW;
+    }
+  }
+}
+
+static stat_t insert_unique(robin_hood_table_t *t, void *key, void *value, size_t hash,
+                            size_t pos, size_t dist, size_t *ret)
+{
+  robin_hood_table_entry_t entry = {key, value, hash};
+  if (t->size >= capacity_to_growth(t->capacity, t->load_factor)) {
+    stat_t stat = grow(t);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+
+    pos = find_pos(t, hash, &dist);
+  }
+
+  while (!insert_at(t, pos, dist, &entry)) {
+    if (is_too_sparse(t, t->capacity << ROBIN_HOOD_TABLE_COPACITY_SHIFT)) {
+      return CDC_STATUS_OVERFLOW;
+    }
+
+    stat_t stat = grow(t);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+
+    pos = find_pos(t, hash, &dist);
+  }
+
+  ++t->size;
+  *ret = pos;
+  return CDC_STATUS_OK;
+}
+
+// Backward shift deletion: the following elements of the cluster are moved one
+// slot closer to their home slots, so no tombstones are needed.
+static void erase_slot(robin_hood_table_t *t, size_t i)
+{
+  free_entry(t, &t->slots[i]);
+  size_t mask = t->capacity - 1;
+  size_t next = (i + 1) & mask;
+  while (t->dists[next] > 1) {
+    t->slots[i] = t->slots[next];
+    t->dists[i] = (uint8_t)(t->dists[next] - 1);
+    i = next;
+    next = (next + 1) & mask;
+  }
+
+  t->dists[i] = 0;
+  --t->size;
+}
+
+static size_t next_full_slot(robin_hood_table_t *t, size_t i)
+{
+  while (i < t->capacity && !t->dists[i]) {
+    ++i;
+  }
+
+  return i;
+}
+
+static stat_t init_varg(robin_hood_table_t *t, va_list args)
+{
+  pair_t *pair = NULL;
+  while ((pair = va_arg(args, pair_t *)) != CDC_END) {
+    stat_t stat = robin_hood_table_insert(t, pair->first, pair->second, NULL, NULL);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  }
+
+  return CDC_STATUS_OK;
+}
+
+stat_t robin_hood_table_ctor1(robin_hood_table_t **t, data_info_t *info, double load_factor)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(load_factor > 0 && load_factor < 1);
+
+  robin_hood_table_t *tmp = (robin_hood_table_t *)di_calloc(info, sizeof(robin_hood_table_t));
+  if (!tmp) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  tmp->load_factor = load_factor;
+  stat_t stat = CDC_STATUS_OK;
+  if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
+    stat = CDC_STATUS_BAD_ALLOC;
+    goto free_hash_table;
+  }
+
+  stat = reallocate(tmp, ROBIN_HOOD_TABLE_MIN_CAPACITY);
+  if (stat != CDC_STATUS_OK) {
+    goto free_di;
+  }
+
+  *t = tmp;
+  return stat;
+free_di:
+  di_shared_dtor(tmp->dinfo);
+free_hash_table:
+  di_free(info, tmp);
+  return stat;
+}
+
+stat_t robin_hood_table_ctorl1(robin_hood_table_t **t, data_info_t *info, double load_factor,
+                               ...)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(load_factor > 0 && load_factor < 1);
+
+  va_list args;
+  va_start(args, load_factor);
+  stat_t stat = robin_hood_table_ctorv1(t, info, load_factor, args);
+  va_end(args);
+  return stat;
+}
+
+stat_t robin_hood_table_ctorv1(robin_hood_table_t **t, data_info_t *info, double load_factor,
+                               va_list args)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+  assert(load_factor > 0 && load_factor < 1);
+
+  stat_t stat = robin_hood_table_ctor1(t, info, load_factor);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  return init_varg(*t, args);
+}
+
+stat_t robin_hood_table_ctor(robin_hood_table_t **t, data_info_t *info)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+
+  return robin_hood_table_ctor1(t, info, ROBIN_HOOD_TABLE_LOAD_FACTOR);
+}
+
+stat_t robin_hood_table_ctorl(robin_hood_table_t **t, data_info_t *info, ...)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+
+  va_list args;
+  va_start(args, info);
+  stat_t stat = robin_hood_table_ctorv(t, info, args);
+  va_end(args);
+  return stat;
+}
+
+stat_t robin_hood_table_ctorv(robin_hood_table_t **t, data_info_t *info, va_list args)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_HASH(info));
+  assert(CDC_HAS_EQ(info));
+
+  return robin_hood_table_ctorv1(t, info, ROBIN_HOOD_TABLE_LOAD_FACTOR, args);
+}
+
+void robin_hood_table_dtor(robin_hood_table_t *t)
+{
+  assert(t != NULL);
+
+  free_entries(t);
+  di_free(t->dinfo, t->slots);
+  data_info_t *dinfo = t->dinfo;
+  di_free(dinfo, t);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t robin_hood_table_memory_usage(robin_hood_table_t *t)
+{
+  assert(t != NULL);
+
+  size_t slot_size = sizeof(robin_hood_table_entry_t) + sizeof(uint8_t);
+  return memory_usage_make(sizeof(robin_hood_table_t) + t->capacity * slot_size, t->size);
+}
+
+stat_t robin_hood_table_get(robin_hood_table_t *t, void *key, void **value)
+{
+  assert(t != NULL);
+
+  size_t i = find_slot(t, key, t->dinfo->eq, get_hash(t, key), NULL, NULL);
+  if (i == t->capacity) {
+    return CDC_STATUS_NOT_FOUND;
+  }
+
+  *value = t->slots[i].value;
+  return CDC_STATUS_OK;
+}
+
+size_t robin_hood_table_count(robin_hood_table_t *t, void *key)
+{
+  assert(t != NULL);
+
+  return (size_t)(find_slot(t, key, t->dinfo->eq, get_hash(t, key), NULL, NULL) != t->capacity);
+}
+
+void robin_hood_table_find(robin_hood_table_t *t, void *key, robin_hood_table_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  it->container = t;
+  it->current = find_slot(t, key, t->dinfo->eq, get_hash(t, key), NULL, NULL);
+}
+
+stat_t robin_hood_table_get_probe(robin_hood_table_t *t, const void *probe,
+                                  const probe_info_t *info, void **value)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  size_t i = find_probe(t, probe, info);
+  if (i == t->capacity) {
+    return CDC_STATUS_NOT_FOUND;
+  }
+
+  *value = t->slots[i].value;
+  return CDC_STATUS_OK;
+}
+
+size_t robin_hood_table_count_probe(robin_hood_table_t *t, const void *probe,
+                                    const probe_info_t *info)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  return (size_t)(find_probe(t, probe, info) != t->capacity);
+}
+
+void robin_hood_table_find_probe(robin_hood_table_t *t, const void *probe, const probe_info_t *info,
+                                 robin_hood_table_iter_t *it)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+  assert(it != NULL);
+
+  it->container = t;
+  it->current = find_probe(t, probe, info);
+}
+
+void robin_hood_table_clear(robin_hood_table_t *t)
+{
+  assert(t != NULL);
+
+  free_entries(t);
+  memset(t->dists, 0, t->capacity * sizeof(uint8_t));
+  t->size = 0;
+}
+
+stat_t robin_hood_table_insert(robin_hood_table_t *t, void *key, void *value,
+                               robin_hood_table_iter_t *it, bool *inserted)
+{
+  assert(t != NULL);
+
+  size_t hash = get_hash(t, key);
+  size_t pos = 0;
+  size_t dist = 0;
+  size_t i = find_slot(t, key, t->dinfo->eq, hash, &pos, &dist);
+  bool finded = i != t->capacity;
+  if (!finded) {
+    stat_t stat = insert_unique(t, key, value, hash, pos, dist, &i);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  }
+
+  if (it) {
+    it->container = t;
+    it->current = i;
+  }
+
+  if (inserted) {
+    *inserted = !finded;
+  }
+
+  return CDC_STATUS_OK;
+}
+
+stat_t robin_hood_table_insert_or_assign(robin_hood_table_t *t, void *key, void *value,
+                                         robin_hood_table_iter_t *it, bool *inserted)
+{
+  assert(t != NULL);
+
+  size_t hash = get_hash(t, key);
+  size_t pos = 0;
+  size_t dist = 0;
+  size_t i = find_slot(t, key, t->dinfo->eq, hash, &pos, &dist);
+  bool finded = i != t->capacity;
+  if (!finded) {
+    stat_t stat = insert_unique(t, key, value, hash, pos, dist, &i);
+    if (stat != CDC_STATUS_OK) {
+      return stat;
+    }
+  } else {
+    t->slots[i].value = value;
+  }
+
+  if (it) {
+    it->container = t;
+    it->current = i;
+  }
+
+  if (inserted) {
+    *inserted = !finded;
+  }
+
+  return CDC_STATUS_OK;
+}
+
+size_t robin_hood_table_erase(robin_hood_table_t *t, void *key)
+{
+  assert(t != NULL);
+
+  size_t i = find_slot(t, key, t->dinfo->eq, get_hash(t, key), NULL, NULL);
+  if (i == t->capacity) {
+    return 0;
+  }
+
+  erase_slot(t, i);
+  return 1;
+}
+
+void robin_hood_table_swap(robin_hood_table_t *a, robin_hood_table_t *b)
+{
+  assert(a != NULL);
+  assert(b != NULL);
+
+  CDC_SWAP(robin_hood_table_entry_t *, a->slots, b->slots);
+  CDC_SWAP(uint8_t *, a->dists, b->dists);
+  CDC_SWAP(size_t, a->capacity, b->capacity);
+  CDC_SWAP(size_t, a->size, b->size);
+  CDC_SWAP(double, a->load_factor, b->load_factor);
+  CDC_SWAP(data_info_t *, a->dinfo, b->dinfo);
+}
+
+void robin_hood_table_begin(robin_hood_table_t *t, robin_hood_table_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  it->container = t;
+  it->current = next_full_slot(t, 0);
+}
+
+void robin_hood_table_set_max_load_factor(robin_hood_table_t *t, double load_factor)
+{
+  assert(t != NULL);
+  assert(load_factor > 0 && load_factor < 1);
+
+  t->load_factor = load_factor;
+}
+
+stat_t robin_hood_table_rehash(robin_hood_table_t *t, size_t count)
+{
+  assert(t != NULL);
+
+  if (count <= t->capacity) {
+    return CDC_STATUS_OK;
+  }
+
+  count = cdc_up_to_pow2(count);
+  assert(count != 0);
+  return reallocate(t, count);
+}
+
+stat_t robin_hood_table_reserve(robin_hood_table_t *t, size_t count)
+{
+  assert(t != NULL);
+
+  return robin_hood_table_rehash(t, (size_t)((double)count / t->load_factor) + 1);
+}
+
+size_t robin_hood_table_max_probe_length(robin_hood_table_t *t)
+{
+  assert(t != NULL);
+
+  size_t max = 0;
+  for (size_t i = 0; i < t->capacity; ++i) {
+    if (t->dists[i] > max + 1) {
+      max = t->dists[i] - 1;
+    }
+  }
+
+  return max;
+}
+
+double robin_hood_table_mean_probe_length(robin_hood_table_t *t)
+{
+  assert(t != NULL);
+
+  if (t->size == 0) {
+    return 0;
+  }
+
+  size_t sum = 0;
+  for (size_t i = 0; i < t->capacity; ++i) {
+    if (t->dists[i]) {
+      sum += t->dists[i] - 1;
+    }
+  }
+
+  return (double)sum / (double)t->size;
+}
+
+void robin_hood_table_iter_next(robin_hood_table_iter_t *it)
+{
+  assert(it != NULL);
+
+  it->current = next_full_slot(it->container, it->current + 1);
+}
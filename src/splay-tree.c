@@ -22,6 +22,7 @@
 #include "cdcontainers/splay-tree.h"
 
 #include "cdcontainers/data-info.h"
+#include "cdcontainers/node-pool.h"
 #include "cdcontainers/tree-utils.h"
 
 #include <stdint.h>
@@ -34,14 +35,17 @@ struct node_pair {
 };
 
 CDC_MAKE_FIND_NODE_FN(splay_tree_node_t *)
+CDC_MAKE_FIND_NODE_BY_PROBE_FN(splay_tree_node_t *)
+CDC_MAKE_LOWER_BOUND_FN(splay_tree_node_t *)
+CDC_MAKE_UPPER_BOUND_FN(splay_tree_node_t *)
 CDC_MAKE_MIN_NODE_FN(splay_tree_node_t *)
 CDC_MAKE_MAX_NODE_FN(splay_tree_node_t *)
 CDC_MAKE_SUCCESSOR_FN(splay_tree_node_t *)
 CDC_MAKE_PREDECESSOR_FN(splay_tree_node_t *)
 
-static splay_tree_node_t *make_new_node(void *key, void *val)
+static splay_tree_node_t *make_new_node(splay_tree_t *t, void *key, void *val)
 {
-  splay_tree_node_t *node = (splay_tree_node_t *)malloc(sizeof(splay_tree_node_t));
+  splay_tree_node_t *node = (splay_tree_node_t *)node_pool_alloc(t->pool);
   if (node) {
     node->key = key;
     node->value = val;
@@ -60,14 +64,16 @@ static void free_node(splay_tree_t *t, splay_tree_node_t *node)
     t->dinfo->dfree(&pair);
   }
 
-  free(node);
+  node_pool_free(t->pool, node);
 }
 
 static void free_splay_tree(splay_tree_t *t, splay_tree_node_t *root)
 {
   assert(t != NULL);
 
-  if (root == NULL) {
+  // The nodes are released with the chunks of the pool, so they are visited
+  // only to free the data.
+  if (root == NULL || !CDC_HAS_DFREE(t->dinfo)) {
     return;
   }
 
@@ -253,6 +259,19 @@ static splay_tree_node_t *sfind(splay_tree_t *t, void *key)
   return node;
 }
 
+static splay_tree_node_t *sfind_probe(splay_tree_t *t, const void *probe,
+                                      const probe_info_t *info)
+{
+  splay_tree_node_t *node = cdc_find_tree_node_by_probe(t->root, probe, info);
+  if (!node) {
+    return node;
+  }
+
+  node = splay(node);
+  t->root = node;
+  return node;
+}
+
 static splay_tree_node_t *insert_unique(splay_tree_t *t, splay_tree_node_t *node,
                                         splay_tree_node_t *nearest)
 {
@@ -277,6 +296,47 @@ static splay_tree_node_t *insert_unique(splay_tree_t *t, splay_tree_node_t *node
   return node;
 }
 
+// Builds a balanced subtree of the sorted pairs. Nodes are allocated in the
+// order of the keys, so neighbouring keys are close in memory.
+static stat_t build_sorted(splay_tree_t *t, const pair_t *pairs, size_t n, splay_tree_node_t **root)
+{
+  *root = NULL;
+  if (n == 0) {
+    return CDC_STATUS_OK;
+  }
+
+  size_t mid = n / 2;
+  splay_tree_node_t *left = NULL;
+  splay_tree_node_t *right = NULL;
+  stat_t stat = build_sorted(t, pairs, mid, &left);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  splay_tree_node_t *node = make_new_node(t, pairs[mid].first, pairs[mid].second);
+  if (!node) {
+    return CDC_STATUS_BAD_ALLOC;
+  }
+
+  stat = build_sorted(t, pairs + mid + 1, n - mid - 1, &right);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  node->left = left;
+  node->right = right;
+  if (left) {
+    left->parent = node;
+  }
+
+  if (right) {
+    right->parent = node;
+  }
+
+  *root = node;
+  return CDC_STATUS_OK;
+}
+
 static stat_t init_varg(splay_tree_t *t, va_list args)
 {
   pair_t *pair = NULL;
@@ -295,16 +355,23 @@ stat_t splay_tree_ctor(splay_tree_t **t, data_info_t *info)
   assert(t != NULL);
   assert(CDC_HAS_CMP(info));
 
-  splay_tree_t *tmp = (splay_tree_t *)calloc(sizeof(splay_tree_t), 1);
+  splay_tree_t *tmp = (splay_tree_t *)di_calloc(info, sizeof(splay_tree_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
-    free(tmp);
+    di_free(info, tmp);
     return CDC_STATUS_BAD_ALLOC;
   }
 
+  stat_t stat = node_pool_ctor(&tmp->pool, tmp->dinfo, sizeof(splay_tree_node_t), 0);
+  if (stat != CDC_STATUS_OK) {
+    di_shared_dtor(tmp->dinfo);
+    di_free(info, tmp);
+    return stat;
+  }
+
   *t = tmp;
   return CDC_STATUS_OK;
 }
@@ -334,13 +401,48 @@ stat_t splay_tree_ctorv(splay_tree_t **t, data_info_t *info, va_list args)
   return init_varg(*t, args);
 }
 
+stat_t splay_tree_ctor_sorted(splay_tree_t **t, data_info_t *info, const pair_t *pairs, size_t n)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+  assert(pairs != NULL || n == 0);
+  assert(cdc_is_sorted_unique(pairs, n, info->cmp));
+
+  splay_tree_t *tmp = NULL;
+  stat_t stat = splay_tree_ctor(&tmp, info);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  // Nodes of a failed build are not linked to the root, so they are released
+  // with the pool and the data is not freed.
+  if ((stat = build_sorted(tmp, pairs, n, &tmp->root)) != CDC_STATUS_OK) {
+    tmp->root = NULL;
+    splay_tree_dtor(tmp);
+    return stat;
+  }
+
+  tmp->size = n;
+  *t = tmp;
+  return CDC_STATUS_OK;
+}
+
 void splay_tree_dtor(splay_tree_t *t)
 {
   assert(t != NULL);
 
   free_splay_tree(t, t->root);
-  di_shared_dtor(t->dinfo);
-  free(t);
+  node_pool_dtor(t->pool);
+  data_info_t *dinfo = t->dinfo;
+  di_free(dinfo, t);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t splay_tree_memory_usage(splay_tree_t *t)
+{
+  assert(t != NULL);
+
+  return memory_usage_make(sizeof(splay_tree_t) + node_pool_memory_usage(t->pool), t->size);
 }
 
 stat_t splay_tree_get(splay_tree_t *t, void *key, void **value)
@@ -378,6 +480,103 @@ void splay_tree_find(splay_tree_t *t, void *key, splay_tree_iter_t *it)
   it->prev = cdc_tree_predecessor(node);
 }
 
+void splay_tree_lower_bound(splay_tree_t *t, void *key, splay_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  splay_tree_node_t *node = cdc_lower_bound_tree_node(t->root, key, t->dinfo->cmp);
+  if (!node) {
+    splay_tree_end(t, it);
+    return;
+  }
+
+  t->root = splay(node);
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
+void splay_tree_upper_bound(splay_tree_t *t, void *key, splay_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  splay_tree_node_t *node = cdc_upper_bound_tree_node(t->root, key, t->dinfo->cmp);
+  if (!node) {
+    splay_tree_end(t, it);
+    return;
+  }
+
+  t->root = splay(node);
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
+void splay_tree_equal_range(splay_tree_t *t, void *key, pair_splay_tree_iter_t *range)
+{
+  assert(t != NULL);
+  assert(range != NULL);
+
+  splay_tree_lower_bound(t, key, &range->first);
+  range->second = range->first;
+  if (range->first.current && !t->dinfo->cmp(key, range->first.current->key)) {
+    splay_tree_iter_next(&range->second);
+  }
+}
+
+void splay_tree_range(splay_tree_t *t, void *from, void *to, pair_splay_tree_iter_t *range)
+{
+  assert(t != NULL);
+  assert(range != NULL);
+  assert(!t->dinfo->cmp(to, from));
+
+  splay_tree_lower_bound(t, from, &range->first);
+  splay_tree_lower_bound(t, to, &range->second);
+}
+
+stat_t splay_tree_get_probe(splay_tree_t *t, const void *probe, const probe_info_t *info,
+                            void **value)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  splay_tree_node_t *node = sfind_probe(t, probe, info);
+  if (node) {
+    *value = node->value;
+    return CDC_STATUS_OK;
+  }
+
+  return CDC_STATUS_NOT_FOUND;
+}
+
+size_t splay_tree_count_probe(splay_tree_t *t, const void *probe, const probe_info_t *info)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  return (size_t)(sfind_probe(t, probe, info) != NULL);
+}
+
+void splay_tree_find_probe(splay_tree_t *t, const void *probe, const probe_info_t *info,
+                           splay_tree_iter_t *it)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+  assert(it != NULL);
+
+  splay_tree_node_t *node = sfind_probe(t, probe, info);
+  if (!node) {
+    splay_tree_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
 stat_t splay_tree_insert(splay_tree_t *t, void *key, void *value, pair_splay_tree_iter_bool_t *ret)
 {
   assert(t != NULL);
@@ -400,7 +599,7 @@ stat_t splay_tree_insert1(splay_tree_t *t, void *key, void *value, splay_tree_it
   splay_tree_node_t *node = find_hint(t->root, key, t->dinfo->cmp);
   bool finded = node && cdc_eq(t->dinfo->cmp, node->key, key);
   if (!finded) {
-    splay_tree_node_t *new_node = make_new_node(key, value);
+    splay_tree_node_t *new_node = make_new_node(t, key, value);
     if (!new_node) {
       return CDC_STATUS_BAD_ALLOC;
     }
@@ -444,7 +643,7 @@ stat_t splay_tree_insert_or_assign1(splay_tree_t *t, void *key, void *value, spl
   splay_tree_node_t *node = find_hint(t->root, key, t->dinfo->cmp);
   bool finded = node && cdc_eq(t->dinfo->cmp, node->key, key);
   if (!finded) {
-    splay_tree_node_t *new_node = make_new_node(key, value);
+    splay_tree_node_t *new_node = make_new_node(t, key, value);
     if (!new_node) {
       return CDC_STATUS_BAD_ALLOC;
     }
@@ -496,6 +695,7 @@ void splay_tree_clear(splay_tree_t *t)
   assert(t != NULL);
 
   free_splay_tree(t, t->root);
+  node_pool_clear(t->pool);
   t->size = 0;
   t->root = NULL;
 }
@@ -508,6 +708,7 @@ void splay_tree_swap(splay_tree_t *a, splay_tree_t *b)
   CDC_SWAP(splay_tree_node_t *, a->root, b->root);
   CDC_SWAP(size_t, a->size, b->size);
   CDC_SWAP(data_info_t *, a->dinfo, b->dinfo);
+  CDC_SWAP(node_pool_t *, a->pool, b->pool);
 }
 
 void splay_tree_begin(splay_tree_t *t, splay_tree_iter_t *it)
@@ -27,7 +27,7 @@ void cdc_print_stat(enum cdc_stat s)
   static const char *descriptions[] = {
       "CDC_STATUS_OK",       "CDC_STATUS_BAD_ALLOC",      "CDC_STATUS_OUT_OF_RANGE",
       "CDC_STATUS_OVERFLOW", "CDC_STATUS_ALREADY_EXISTS", "CDC_STATUS_NOT_FOUND",
-      "CDC_STATUS_UNKN"};
+      "CDC_STATUS_NOT_SUPPORTED", "CDC_STATUS_UNKN"};
   if (s < CDC_STATUS_OK || s > CDC_STATUS_UNKN) {
     s = CDC_STATUS_UNKN;
   }
@@ -20,6 +20,7 @@
 // IN THE SOFTWARE.
 #define CDC_USE_SHORT_NAMES
 #include "cdcontainers/avl-tree.h"
+#include "cdcontainers/data-info.h"
 #include "cdcontainers/tables/imap.h"
 
 #include <assert.h>
@@ -41,6 +42,14 @@ static stat_t ctorv(void **cntr, data_info_t *info, va_list args)
   return avl_tree_ctorv(tree, info, args);
 }
 
+static stat_t ctor_sorted(void **cntr, data_info_t *info, const pair_t *pairs, size_t n)
+{
+  assert(cntr != NULL);
+
+  avl_tree_t **tree = (avl_tree_t **)cntr;
+  return avl_tree_ctor_sorted(tree, info, pairs, n);
+}
+
 static void dtor(void *cntr)
 {
   assert(cntr != NULL);
@@ -57,6 +66,20 @@ static stat_t get(void *cntr, void *key, void **value)
   return avl_tree_get(tree, key, value);
 }
 
+static size_t get_many(void *cntr, void **keys, size_t n, void **values, bool *found)
+{
+  assert(cntr != NULL);
+
+  avl_tree_t *tree = (avl_tree_t *)cntr;
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    found[i] = avl_tree_get(tree, keys[i], &values[i]) == CDC_STATUS_OK;
+    count += found[i];
+  }
+
+  return count;
+}
+
 static size_t count(void *cntr, void *key)
 {
   assert(cntr != NULL);
@@ -74,6 +97,69 @@ static void find(void *cntr, void *key, void *it)
   avl_tree_find(tree, key, iter);
 }
 
+static void lower_bound(void *cntr, void *key, void *it)
+{
+  assert(cntr != NULL);
+
+  avl_tree_t *tree = (avl_tree_t *)cntr;
+  avl_tree_iter_t *iter = (avl_tree_iter_t *)it;
+  avl_tree_lower_bound(tree, key, iter);
+}
+
+static void upper_bound(void *cntr, void *key, void *it)
+{
+  assert(cntr != NULL);
+
+  avl_tree_t *tree = (avl_tree_t *)cntr;
+  avl_tree_iter_t *iter = (avl_tree_iter_t *)it;
+  avl_tree_upper_bound(tree, key, iter);
+}
+
+#ifdef CDC_ORDER_STATISTICS
+// Not select, stdlib.h can include sys/select.h that declares it.
+static void select_kth(void *cntr, size_t k, void *it)
+{
+  assert(cntr != NULL);
+
+  avl_tree_t *tree = (avl_tree_t *)cntr;
+  avl_tree_iter_t *iter = (avl_tree_iter_t *)it;
+  avl_tree_select(tree, k, iter);
+}
+
+static size_t rank(void *cntr, void *key)
+{
+  assert(cntr != NULL);
+
+  avl_tree_t *tree = (avl_tree_t *)cntr;
+  return avl_tree_rank(tree, key);
+}
+#endif
+
+static stat_t get_probe(void *cntr, const void *probe, const probe_info_t *info, void **value)
+{
+  assert(cntr != NULL);
+
+  avl_tree_t *tree = (avl_tree_t *)cntr;
+  return avl_tree_get_probe(tree, probe, info, value);
+}
+
+static size_t count_probe(void *cntr, const void *probe, const probe_info_t *info)
+{
+  assert(cntr != NULL);
+
+  avl_tree_t *tree = (avl_tree_t *)cntr;
+  return avl_tree_count_probe(tree, probe, info);
+}
+
+static void find_probe(void *cntr, const void *probe, const probe_info_t *info, void *it)
+{
+  assert(cntr != NULL);
+
+  avl_tree_t *tree = (avl_tree_t *)cntr;
+  avl_tree_iter_t *iter = (avl_tree_iter_t *)it;
+  avl_tree_find_probe(tree, probe, info, iter);
+}
+
 static size_t size(void *cntr)
 {
   assert(cntr != NULL);
@@ -90,6 +176,14 @@ static bool empty(void *cntr)
   return avl_tree_empty(tree);
 }
 
+static memory_usage_t memory_usage(void *cntr)
+{
+  assert(cntr != NULL);
+
+  avl_tree_t *tree = (avl_tree_t *)cntr;
+  return avl_tree_memory_usage(tree);
+}
+
 static void clear(void *cntr)
 {
   assert(cntr != NULL);
@@ -152,14 +246,14 @@ static void end(void *cntr, void *it)
   avl_tree_end(tree, iter);
 }
 
-static void *iter_ctor()
+static void *iter_ctor(const struct cdc_allocator *allocator)
 {
-  return malloc(sizeof(avl_tree_iter_t));
+  return cdc_malloc(allocator, sizeof(avl_tree_iter_t));
 }
 
-static void iter_dtor(void *it)
+static void iter_dtor(void *it, const struct cdc_allocator *allocator)
 {
-  free(it);
+  cdc_free(allocator, it);
 }
 
 static enum cdc_iterator_type type()
@@ -247,12 +341,24 @@ static const map_iter_table_t _iter_table = {.ctor = iter_ctor,
 
 static const map_table_t _table = {.ctor = ctor,
                                    .ctorv = ctorv,
+                                   .ctor_sorted = ctor_sorted,
                                    .dtor = dtor,
                                    .get = get,
+                                   .get_many = get_many,
                                    .count = count,
                                    .find = find,
+                                   .lower_bound = lower_bound,
+                                   .upper_bound = upper_bound,
+#ifdef CDC_ORDER_STATISTICS
+                                   .select = select_kth,
+                                   .rank = rank,
+#endif
+                                   .get_probe = get_probe,
+                                   .count_probe = count_probe,
+                                   .find_probe = find_probe,
                                    .size = size,
                                    .empty = empty,
+                                   .memory_usage = memory_usage,
                                    .clear = clear,
                                    .insert = insert,
                                    .insert_or_assign = insert_or_assign,
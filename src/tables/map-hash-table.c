@@ -19,6 +19,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 #define CDC_USE_SHORT_NAMES
+#include "cdcontainers/data-info.h"
 #include "cdcontainers/global.h"
 #include "cdcontainers/hash-table.h"
 #include "cdcontainers/tables/imap.h"
@@ -58,6 +59,14 @@ static stat_t get(void *cntr, void *key, void **value)
   return hash_table_get(tree, key, value);
 }
 
+static size_t get_many(void *cntr, void **keys, size_t n, void **values, bool *found)
+{
+  assert(cntr != NULL);
+
+  hash_table_t *tree = (hash_table_t *)cntr;
+  return hash_table_get_many(tree, keys, n, values, found);
+}
+
 static size_t count(void *cntr, void *key)
 {
   assert(cntr != NULL);
@@ -75,6 +84,31 @@ static void find(void *cntr, void *key, void *it)
   hash_table_find(tree, key, iter);
 }
 
+static stat_t get_probe(void *cntr, const void *probe, const probe_info_t *info, void **value)
+{
+  assert(cntr != NULL);
+
+  hash_table_t *tree = (hash_table_t *)cntr;
+  return hash_table_get_probe(tree, probe, info, value);
+}
+
+static size_t count_probe(void *cntr, const void *probe, const probe_info_t *info)
+{
+  assert(cntr != NULL);
+
+  hash_table_t *tree = (hash_table_t *)cntr;
+  return hash_table_count_probe(tree, probe, info);
+}
+
+static void find_probe(void *cntr, const void *probe, const probe_info_t *info, void *it)
+{
+  assert(cntr != NULL);
+
+  hash_table_t *tree = (hash_table_t *)cntr;
+  hash_table_iter_t *iter = (hash_table_iter_t *)it;
+  hash_table_find_probe(tree, probe, info, iter);
+}
+
 static size_t size(void *cntr)
 {
   assert(cntr != NULL);
@@ -91,6 +125,14 @@ static bool empty(void *cntr)
   return hash_table_empty(tree);
 }
 
+static memory_usage_t memory_usage(void *cntr)
+{
+  assert(cntr != NULL);
+
+  hash_table_t *tree = (hash_table_t *)cntr;
+  return hash_table_memory_usage(tree);
+}
+
 static void clear(void *cntr)
 {
   assert(cntr != NULL);
@@ -153,14 +195,14 @@ static void end(void *cntr, void *it)
   hash_table_end(tree, iter);
 }
 
-static void *iter_ctor()
+static void *iter_ctor(const struct cdc_allocator *allocator)
 {
-  return malloc(sizeof(hash_table_iter_t));
+  return cdc_malloc(allocator, sizeof(hash_table_iter_t));
 }
 
-static void iter_dtor(void *it)
+static void iter_dtor(void *it, const struct cdc_allocator *allocator)
 {
-  free(it);
+  cdc_free(allocator, it);
 }
 
 static enum cdc_iterator_type type()
@@ -248,10 +290,15 @@ static const map_table_t _table = {.ctor = ctor,
                                    .ctorv = ctorv,
                                    .dtor = dtor,
                                    .get = get,
+                                   .get_many = get_many,
                                    .count = count,
                                    .find = find,
+                                   .get_probe = get_probe,
+                                   .count_probe = count_probe,
+                                   .find_probe = find_probe,
                                    .size = size,
                                    .empty = empty,
+                                   .memory_usage = memory_usage,
                                    .clear = clear,
                                    .insert = insert,
                                    .insert_or_assign = insert_or_assign,
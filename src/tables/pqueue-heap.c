@@ -64,6 +64,14 @@ static bool empty(void *cntr)
   return heap_empty(heap);
 }
 
+static memory_usage_t memory_usage(void *cntr)
+{
+  assert(cntr != NULL);
+
+  heap_t *heap = (heap_t *)cntr;
+  return heap_memory_usage(heap);
+}
+
 static size_t size(void *cntr)
 {
   assert(cntr != NULL);
@@ -93,6 +101,7 @@ static const priority_queue_table_t _table = {.ctor = ctor,
                                               .dtor = dtor,
                                               .top = top,
                                               .empty = empty,
+                                              .memory_usage = memory_usage,
                                               .size = size,
                                               .push = push,
                                               .pop = pop};
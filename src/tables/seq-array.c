@@ -72,6 +72,14 @@ static bool empty(void *cntr)
   return array_empty(array);
 }
 
+static memory_usage_t memory_usage(void *cntr)
+{
+  assert(cntr != NULL);
+
+  array_t *array = (array_t *)cntr;
+  return array_memory_usage(array);
+}
+
 static size_t size(void *cntr)
 {
   assert(cntr != NULL);
@@ -158,6 +166,7 @@ static const sequence_table_t _table = {.ctor = ctor,
                                         .front = front,
                                         .back = back,
                                         .empty = empty,
+                                        .memory_usage = memory_usage,
                                         .size = size,
                                         .push_back = push_back,
                                         .pop_back = pop_back,
@@ -72,6 +72,14 @@ static bool empty(void *cntr)
   return circular_array_empty(circular_array);
 }
 
+static memory_usage_t memory_usage(void *cntr)
+{
+  assert(cntr != NULL);
+
+  circular_array_t *circular_array = (circular_array_t *)cntr;
+  return circular_array_memory_usage(circular_array);
+}
+
 static size_t size(void *cntr)
 {
   assert(cntr != NULL);
@@ -158,6 +166,7 @@ static const sequence_table_t _table = {.ctor = ctor,
                                         .front = front,
                                         .back = back,
                                         .empty = empty,
+                                        .memory_usage = memory_usage,
                                         .size = size,
                                         .push_back = push_back,
                                         .pop_back = pop_back,
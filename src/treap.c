@@ -22,6 +22,7 @@
 #include "cdcontainers/treap.h"
 
 #include "cdcontainers/data-info.h"
+#include "cdcontainers/node-pool.h"
 #include "cdcontainers/global.h"
 #include "cdcontainers/tree-utils.h"
 
@@ -35,10 +36,17 @@ struct node_pair {
 };
 
 CDC_MAKE_FIND_NODE_FN(treap_node_t *)
+CDC_MAKE_FIND_NODE_BY_PROBE_FN(treap_node_t *)
+CDC_MAKE_LOWER_BOUND_FN(treap_node_t *)
+CDC_MAKE_UPPER_BOUND_FN(treap_node_t *)
 CDC_MAKE_MIN_NODE_FN(treap_node_t *)
 CDC_MAKE_MAX_NODE_FN(treap_node_t *)
 CDC_MAKE_SUCCESSOR_FN(treap_node_t *)
 CDC_MAKE_PREDECESSOR_FN(treap_node_t *)
+#ifdef CDC_ORDER_STATISTICS
+CDC_MAKE_SELECT_NODE_FN(treap_node_t *)
+CDC_MAKE_RANK_FN(treap_node_t *)
+#endif
 
 static int default_prior(void *value)
 {
@@ -47,12 +55,15 @@ static int default_prior(void *value)
   return rand();
 }
 
-static treap_node_t *make_new_node(void *key, int prior, void *val)
+static treap_node_t *make_new_node(treap_t *t, void *key, int prior, void *val)
 {
-  treap_node_t *node = (treap_node_t *)malloc(sizeof(treap_node_t));
+  treap_node_t *node = (treap_node_t *)node_pool_alloc(t->pool);
   if (!node) return NULL;
 
   node->priority = prior;
+#ifdef CDC_ORDER_STATISTICS
+  node->size = 1;
+#endif
   node->key = key;
   node->value = val;
   node->parent = NULL;
@@ -68,12 +79,14 @@ static void free_node(treap_t *t, treap_node_t *node)
     t->dinfo->dfree(&pair);
   }
 
-  free(node);
+  node_pool_free(t->pool, node);
 }
 
 static void free_treap(treap_t *t, treap_node_t *root)
 {
-  if (root == NULL) {
+  // The nodes are released with the chunks of the pool, so they are visited
+  // only to free the data.
+  if (root == NULL || !CDC_HAS_DFREE(t->dinfo)) {
     return;
   }
 
@@ -82,6 +95,29 @@ static void free_treap(treap_t *t, treap_node_t *root)
   free_node(t, root);
 }
 
+static void update_size(treap_node_t *node)
+{
+#ifdef CDC_ORDER_STATISTICS
+  size_t lsize = node->left ? node->left->size : 0;
+  size_t rsize = node->right ? node->right->size : 0;
+  node->size = lsize + rsize + 1;
+#else
+  CDC_UNUSED(node);
+#endif
+}
+
+// Updates the sizes of the node and its ancestors.
+static void update_path(treap_node_t *node)
+{
+#ifdef CDC_ORDER_STATISTICS
+  for (; node; node = node->parent) {
+    update_size(node);
+  }
+#else
+  CDC_UNUSED(node);
+#endif
+}
+
 static struct node_pair split(treap_node_t *root, void *key, cdc_binary_pred_fn_t compar)
 {
   struct node_pair pair;
@@ -102,6 +138,7 @@ static struct node_pair split(treap_node_t *root, void *key, cdc_binary_pred_fn_
       pair.right->parent = NULL;
     }
 
+    update_size(root);
     pair.left = root;
     pair.right = pair.right;
     return pair;
@@ -116,6 +153,7 @@ static struct node_pair split(treap_node_t *root, void *key, cdc_binary_pred_fn_
       pair.right->parent = root;
     }
 
+    update_size(root);
     pair.left = pair.left;
     pair.right = root;
     return pair;
@@ -138,6 +176,7 @@ static treap_node_t *merge(treap_node_t *l, treap_node_t *r)
       l->right->parent = l;
     }
 
+    update_size(l);
     return l;
   } else {
     r->left = merge(l, r->left);
@@ -145,6 +184,7 @@ static treap_node_t *merge(treap_node_t *l, treap_node_t *r)
       r->left->parent = r;
     }
 
+    update_size(r);
     return r;
   }
 }
@@ -193,6 +233,8 @@ static void erase_node(treap_t *t, treap_node_t *node)
     } else {
       node->parent->right = tmp;
     }
+
+    update_path(node->parent);
   }
 
   --t->size;
@@ -234,6 +276,8 @@ static treap_node_t *insert_unique(treap_t *t, treap_node_t *node, treap_node_t
         pnode->right = node;
       }
     }
+
+    update_path(node);
   } else {
     t->root = node;
   }
@@ -242,6 +286,50 @@ static treap_node_t *insert_unique(treap_t *t, treap_node_t *node, treap_node_t
   return node;
 }
 
+// Builds the treap of the sorted pairs as a Cartesian tree: each node is added
+// to the right spine and the nodes of the spine with lower priorities become its
+// left subtree. Every node is moved off the spine once, so it takes O(n).
+static stat_t build_sorted(treap_t *t, const pair_t *pairs, size_t n)
+{
+  treap_node_t *last = NULL;
+  for (size_t i = 0; i < n; ++i) {
+    treap_node_t *node =
+        make_new_node(t, pairs[i].first, t->prior(pairs[i].second), pairs[i].second);
+    if (!node) {
+      return CDC_STATUS_BAD_ALLOC;
+    }
+
+    treap_node_t *child = NULL;
+    while (last && last->priority < node->priority) {
+      // The subtree of a node is complete when it leaves the spine.
+      update_size(last);
+      child = last;
+      last = last->parent;
+    }
+
+    node->left = child;
+    if (child) {
+      child->parent = node;
+    }
+
+    node->parent = last;
+    if (last) {
+      last->right = node;
+    }
+
+    last = node;
+  }
+
+  treap_node_t *root = last;
+  for (; last; last = last->parent) {
+    update_size(last);
+    root = last;
+  }
+
+  t->root = root;
+  return CDC_STATUS_OK;
+}
+
 static stat_t init_varg(treap_t *t, va_list args)
 {
   pair_t *pair = NULL;
@@ -260,16 +348,23 @@ stat_t treap_ctor1(treap_t **t, data_info_t *info, cdc_priority_fn_t prior)
   assert(t != NULL);
   assert(CDC_HAS_CMP(info));
 
-  treap_t *tmp = (treap_t *)calloc(sizeof(treap_t), 1);
+  treap_t *tmp = (treap_t *)di_calloc(info, sizeof(treap_t));
   if (!tmp) {
     return CDC_STATUS_BAD_ALLOC;
   }
 
   if (info && !(tmp->dinfo = di_shared_ctorc(info))) {
-    free(tmp);
+    di_free(info, tmp);
     return CDC_STATUS_BAD_ALLOC;
   }
 
+  stat_t stat = node_pool_ctor(&tmp->pool, tmp->dinfo, sizeof(treap_node_t), 0);
+  if (stat != CDC_STATUS_OK) {
+    di_shared_dtor(tmp->dinfo);
+    di_free(info, tmp);
+    return stat;
+  }
+
   tmp->prior = prior ? prior : default_prior;
   *t = tmp;
   return CDC_STATUS_OK;
@@ -328,13 +423,57 @@ stat_t treap_ctorv(treap_t **t, data_info_t *info, va_list args)
   return treap_ctorv1(t, info, NULL, args);
 }
 
+stat_t treap_ctor_sorted1(treap_t **t, data_info_t *info, cdc_priority_fn_t prior,
+                          const pair_t *pairs, size_t n)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+  assert(pairs != NULL || n == 0);
+  assert(cdc_is_sorted_unique(pairs, n, info->cmp));
+
+  treap_t *tmp = NULL;
+  stat_t stat = treap_ctor1(&tmp, info, prior);
+  if (stat != CDC_STATUS_OK) {
+    return stat;
+  }
+
+  // Nodes of a failed build are released with the pool and the data is not
+  // freed.
+  if ((stat = build_sorted(tmp, pairs, n)) != CDC_STATUS_OK) {
+    tmp->root = NULL;
+    treap_dtor(tmp);
+    return stat;
+  }
+
+  tmp->size = n;
+  *t = tmp;
+  return CDC_STATUS_OK;
+}
+
+stat_t treap_ctor_sorted(treap_t **t, data_info_t *info, const pair_t *pairs, size_t n)
+{
+  assert(t != NULL);
+  assert(CDC_HAS_CMP(info));
+
+  return treap_ctor_sorted1(t, info, NULL, pairs, n);
+}
+
 void treap_dtor(treap_t *t)
 {
   assert(t != NULL);
 
   free_treap(t, t->root);
-  di_shared_dtor(t->dinfo);
-  free(t);
+  node_pool_dtor(t->pool);
+  data_info_t *dinfo = t->dinfo;
+  di_free(dinfo, t);
+  di_shared_dtor(dinfo);
+}
+
+memory_usage_t treap_memory_usage(treap_t *t)
+{
+  assert(t != NULL);
+
+  return memory_usage_make(sizeof(treap_t) + node_pool_memory_usage(t->pool), t->size);
 }
 
 stat_t treap_get(treap_t *t, void *key, void **value)
@@ -373,6 +512,124 @@ void treap_find(treap_t *t, void *key, treap_iter_t *it)
   it->prev = cdc_tree_predecessor(node);
 }
 
+void treap_lower_bound(treap_t *t, void *key, treap_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  treap_node_t *node = cdc_lower_bound_tree_node(t->root, key, t->dinfo->cmp);
+  if (!node) {
+    treap_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
+void treap_upper_bound(treap_t *t, void *key, treap_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  treap_node_t *node = cdc_upper_bound_tree_node(t->root, key, t->dinfo->cmp);
+  if (!node) {
+    treap_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
+void treap_equal_range(treap_t *t, void *key, pair_treap_iter_t *range)
+{
+  assert(t != NULL);
+  assert(range != NULL);
+
+  treap_lower_bound(t, key, &range->first);
+  range->second = range->first;
+  if (range->first.current && !t->dinfo->cmp(key, range->first.current->key)) {
+    treap_iter_next(&range->second);
+  }
+}
+
+void treap_range(treap_t *t, void *from, void *to, pair_treap_iter_t *range)
+{
+  assert(t != NULL);
+  assert(range != NULL);
+  assert(!t->dinfo->cmp(to, from));
+
+  treap_lower_bound(t, from, &range->first);
+  treap_lower_bound(t, to, &range->second);
+}
+
+#ifdef CDC_ORDER_STATISTICS
+void treap_select(treap_t *t, size_t k, treap_iter_t *it)
+{
+  assert(t != NULL);
+  assert(it != NULL);
+
+  treap_node_t *node = cdc_select_tree_node(t->root, k);
+  if (!node) {
+    treap_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
+size_t treap_rank(treap_t *t, void *key)
+{
+  assert(t != NULL);
+
+  return cdc_tree_rank(t->root, key, t->dinfo->cmp);
+}
+#endif
+
+stat_t treap_get_probe(treap_t *t, const void *probe, const probe_info_t *info, void **value)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  treap_node_t *node = cdc_find_tree_node_by_probe(t->root, probe, info);
+  if (node) {
+    *value = node->value;
+    return CDC_STATUS_OK;
+  }
+
+  return CDC_STATUS_NOT_FOUND;
+}
+
+size_t treap_count_probe(treap_t *t, const void *probe, const probe_info_t *info)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+
+  return (size_t)(cdc_find_tree_node_by_probe(t->root, probe, info) != NULL);
+}
+
+void treap_find_probe(treap_t *t, const void *probe, const probe_info_t *info, treap_iter_t *it)
+{
+  assert(t != NULL);
+  assert(info != NULL);
+  assert(it != NULL);
+
+  treap_node_t *node = cdc_find_tree_node_by_probe(t->root, probe, info);
+  if (!node) {
+    treap_end(t, it);
+    return;
+  }
+
+  it->container = t;
+  it->current = node;
+  it->prev = cdc_tree_predecessor(node);
+}
+
 stat_t treap_insert(treap_t *t, void *key, void *value, pair_treap_iter_bool_t *ret)
 {
   assert(t != NULL);
@@ -394,7 +651,7 @@ stat_t treap_insert1(treap_t *t, void *key, void *value, treap_iter_t *it, bool
   treap_node_t *node = cdc_find_tree_node(t->root, key, t->dinfo->cmp);
   bool finded = node;
   if (!node) {
-    node = make_new_node(key, t->prior(value), value);
+    node = make_new_node(t, key, t->prior(value), value);
     if (!node) {
       return CDC_STATUS_BAD_ALLOC;
     }
@@ -437,7 +694,7 @@ stat_t treap_insert_or_assign1(treap_t *t, void *key, void *value, treap_iter_t
   treap_node_t *node = cdc_find_tree_node(t->root, key, t->dinfo->cmp);
   bool finded = node;
   if (!node) {
-    node = make_new_node(key, t->prior(value), value);
+    node = make_new_node(t, key, t->prior(value), value);
     if (!node) {
       return CDC_STATUS_BAD_ALLOC;
     }
@@ -479,6 +736,7 @@ void treap_clear(treap_t *t)
   assert(t != NULL);
 
   free_treap(t, t->root);
+  node_pool_clear(t->pool);
   t->size = 0;
   t->root = NULL;
 }
@@ -492,6 +750,7 @@ void treap_swap(treap_t *a, treap_t *b)
   CDC_SWAP(size_t, a->size, b->size);
   CDC_SWAP(cdc_priority_fn_t, a->prior, b->prior);
   CDC_SWAP(data_info_t *, a->dinfo, b->dinfo);
+  CDC_SWAP(node_pool_t *, a->pool, b->pool);
 }
 
 void treap_begin(treap_t *t, treap_iter_t *it)
@@ -0,0 +1,164 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "test-common.h"
+
+#include "cdcontainers/arena.h"
+#include "cdcontainers/avl-tree.h"
+#include "cdcontainers/casts.h"
+#include "cdcontainers/hash-table.h"
+#include "cdcontainers/list.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <CUnit/Basic.h>
+
+static int lt(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) < CDC_TO_INT(r);
+}
+
+static int eq(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) == CDC_TO_INT(r);
+}
+
+static size_t hash(const void *val)
+{
+  return cdc_hash_int(CDC_TO_INT(val));
+}
+
+static size_t freed = 0;
+
+static void count_free(void *ptr)
+{
+  (void)ptr;
+  ++freed;
+}
+
+void test_arena_alloc()
+{
+  arena_t *a = NULL;
+
+  CU_ASSERT_EQUAL(arena_ctor(&a, 256), CDC_STATUS_OK);
+  char *prev = NULL;
+  for (int i = 1; i < 100; ++i) {
+    char *ptr = (char *)arena_alloc(a, (size_t)i);
+    CU_ASSERT(ptr != NULL);
+    CU_ASSERT_EQUAL((uintptr_t)ptr % 16, 0);
+    memset(ptr, i, (size_t)i);
+    CU_ASSERT(prev == NULL || ptr != prev);
+    prev = ptr;
+  }
+
+  char *large = (char *)arena_alloc(a, 1000);
+  CU_ASSERT(large != NULL);
+  memset(large, 0, 1000);
+
+  arena_reset(a);
+  char *first = (char *)arena_alloc(a, 8);
+  CU_ASSERT(first != NULL);
+  arena_reset(a);
+  CU_ASSERT_EQUAL(arena_alloc(a, 8), first);
+  arena_dtor(a);
+}
+
+void test_arena_realloc()
+{
+  arena_t *a = NULL;
+
+  CU_ASSERT_EQUAL(arena_ctor(&a, 256), CDC_STATUS_OK);
+  const allocator_t *allocator = arena_allocator(a);
+  CU_ASSERT(allocator->free == NULL);
+
+  int *ptr = (int *)allocator->realloc(allocator->ctx, NULL, 4 * sizeof(int));
+  for (int i = 0; i < 4; ++i) {
+    ptr[i] = i;
+  }
+
+  // The last allocation grows in place.
+  CU_ASSERT_EQUAL(allocator->realloc(allocator->ctx, ptr, 8 * sizeof(int)), ptr);
+  allocator->alloc(allocator->ctx, 1);
+  int *new_ptr = (int *)allocator->realloc(allocator->ctx, ptr, 16 * sizeof(int));
+  CU_ASSERT(new_ptr != ptr);
+  for (int i = 0; i < 4; ++i) {
+    CU_ASSERT_EQUAL(new_ptr[i], i);
+  }
+
+  new_ptr = (int *)allocator->realloc(allocator->ctx, new_ptr, 1000 * sizeof(int));
+  CU_ASSERT(new_ptr != NULL);
+  for (int i = 0; i < 4; ++i) {
+    CU_ASSERT_EQUAL(new_ptr[i], i);
+  }
+
+  arena_dtor(a);
+}
+
+void test_arena_containers()
+{
+  arena_t *a = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(arena_ctor(&a, 0), CDC_STATUS_OK);
+  info.allocator = arena_allocator(a);
+  for (int round = 0; round < 3; ++round) {
+    list_t *l = NULL;
+    avl_tree_t *t = NULL;
+    hash_table_t *h = NULL;
+    CU_ASSERT_EQUAL(list_ctor(&l, &info), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(avl_tree_ctor(&t, &info), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(hash_table_ctor(&h, &info), CDC_STATUS_OK);
+    for (int i = 0; i < 1000; ++i) {
+      CU_ASSERT_EQUAL(list_push_back(l, CDC_FROM_INT(i)), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(avl_tree_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(hash_table_insert(h, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                      CDC_STATUS_OK);
+    }
+
+    CU_ASSERT_EQUAL(list_size(l), 1000);
+    CU_ASSERT_EQUAL(avl_tree_size(t), 1000);
+    CU_ASSERT_EQUAL(hash_table_size(h), 1000);
+    CU_ASSERT_EQUAL(hash_table_count(h, CDC_FROM_INT(500)), 1);
+    list_dtor(l);
+    avl_tree_clear(t);
+    CU_ASSERT_EQUAL(avl_tree_size(t), 0);
+    avl_tree_dtor(t);
+    hash_table_dtor(h);
+    arena_reset(a);
+  }
+
+  // With dfree the nodes are still visited.
+  freed = 0;
+  info.dfree = count_free;
+  list_t *l = NULL;
+  CU_ASSERT_EQUAL(list_ctor(&l, &info), CDC_STATUS_OK);
+  for (int i = 0; i < 10; ++i) {
+    CU_ASSERT_EQUAL(list_push_back(l, CDC_FROM_INT(i)), CDC_STATUS_OK);
+  }
+
+  list_dtor(l);
+  CU_ASSERT_EQUAL(freed, 10);
+  arena_dtor(a);
+}
@@ -308,3 +308,47 @@ void test_array_shrink_to_fit()
   CU_ASSERT_EQUAL(array_capacity(v), count);
   array_dtor(v);
 }
+
+void test_array_growth_policy()
+{
+  array_t *v = NULL;
+  array_growth_policy_t policy = {1.5, 10, 20};
+
+  CU_ASSERT_EQUAL(array_ctor(&v, NULL), CDC_STATUS_OK);
+  array_set_growth_policy(v, &policy);
+  for (int i = 0; i < 5; ++i) {
+    CU_ASSERT_EQUAL(array_push_back(v, CDC_FROM_INT(i)), CDC_STATUS_OK);
+  }
+  CU_ASSERT_EQUAL(array_capacity(v), 10);
+  for (int i = 5; i < 11; ++i) {
+    CU_ASSERT_EQUAL(array_push_back(v, CDC_FROM_INT(i)), CDC_STATUS_OK);
+  }
+  CU_ASSERT_EQUAL(array_capacity(v), 15);
+  for (int i = 11; i < 100; ++i) {
+    CU_ASSERT_EQUAL(array_push_back(v, CDC_FROM_INT(i)), CDC_STATUS_OK);
+  }
+  for (int i = 0; i < 100; ++i) {
+    CU_ASSERT_EQUAL(CDC_TO_INT(array_get(v, i)), i);
+  }
+  size_t capacity = array_capacity(v);
+  for (int i = 100; i < (int)capacity + 1; ++i) {
+    CU_ASSERT_EQUAL(array_push_back(v, CDC_FROM_INT(i)), CDC_STATUS_OK);
+  }
+  CU_ASSERT_EQUAL(array_capacity(v), capacity + 20);
+  array_dtor(v);
+}
+
+void test_array_memory_usage()
+{
+  array_t *v = NULL;
+
+  CU_ASSERT_EQUAL(array_ctor(&v, NULL), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(array_reserve(v, 100), CDC_STATUS_OK);
+  for (int i = 0; i < 10; ++i) {
+    CU_ASSERT_EQUAL(array_push_back(v, CDC_FROM_INT(i)), CDC_STATUS_OK);
+  }
+  memory_usage_t usage = array_memory_usage(v);
+  CU_ASSERT_EQUAL(usage.count, 10);
+  CU_ASSERT_EQUAL(usage.bytes, sizeof(array_t) + 100 * sizeof(void *));
+  array_dtor(v);
+}
@@ -29,6 +29,8 @@
 #include <float.h>
 #include <math.h>
 #include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <CUnit/Basic.h>
 
@@ -300,6 +302,24 @@ void test_avl_tree_erase()
   avl_tree_dtor(t);
 }
 
+void test_avl_tree_erase_successor()
+{
+  avl_tree_t *t = NULL;
+  void *value = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  // The successor of the root is its right child and has a right subtree.
+  CU_ASSERT_EQUAL(avl_tree_ctorl(&t, &info, &c, &b, &d, &e, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(avl_tree_erase(t, c.first), 1);
+  CU_ASSERT_EQUAL(avl_tree_get(t, c.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(avl_tree_size(t), 3);
+  CU_ASSERT(avl_tree_key_int_eq(t, 3, &b, &d, &e));
+  CU_ASSERT_EQUAL(avl_tree_get(t, e.first, &value), CDC_STATUS_OK);
+  test_tree_links(t->root);
+  avl_tree_dtor(t);
+}
+
 void test_avl_tree_iterators()
 {
   avl_tree_t *t = NULL;
@@ -381,3 +401,246 @@ void test_avl_tree_height()
   CU_ASSERT(experimental_height <= theoretical_max_height);
   avl_tree_dtor(t);
 }
+
+// Checks the links and the heights of the subtree and returns its height.
+static unsigned char test_tree_heights(avl_tree_node_t *node)
+{
+  if (!node) return 0;
+
+  unsigned char lhs = test_tree_heights(node->left);
+  unsigned char rhs = test_tree_heights(node->right);
+  CU_ASSERT(lhs <= rhs + 1 && rhs <= lhs + 1);
+  CU_ASSERT_EQUAL(node->height, CDC_MAX(lhs, rhs) + 1);
+  return node->height;
+}
+
+void test_avl_tree_ctor_sorted()
+{
+  enum { kMaxSize = 1000 };
+  static pair_t pairs[kMaxSize];
+  const size_t sizes[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 15, 16, 17, 100, kMaxSize};
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  for (size_t i = 0; i < kMaxSize; ++i) {
+    pairs[i].first = CDC_FROM_INT(i);
+    pairs[i].second = CDC_FROM_INT(i * 2);
+  }
+
+  for (size_t s = 0; s < CDC_ARRAY_SIZE(sizes); ++s) {
+    size_t n = sizes[s];
+    avl_tree_t *t = NULL;
+    CU_ASSERT_EQUAL(avl_tree_ctor_sorted(&t, &info, pairs, n), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(avl_tree_size(t), n);
+    test_tree_links(t->root);
+    test_tree_heights(t->root);
+    if (t->root) {
+      CU_ASSERT_PTR_NULL(t->root->parent);
+    }
+
+    avl_tree_iter_t it = CDC_INIT_STRUCT;
+    avl_tree_begin(t, &it);
+    for (size_t i = 0; i < n; ++i) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_key(&it)), (int)i);
+      CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_value(&it)), (int)(i * 2));
+      avl_tree_iter_next(&it);
+    }
+
+    CU_ASSERT(!avl_tree_iter_has_next(&it));
+    for (size_t i = 0; i < n; i += 2) {
+      CU_ASSERT_EQUAL(avl_tree_erase(t, CDC_FROM_INT(i)), 1);
+    }
+
+    CU_ASSERT_EQUAL(avl_tree_insert(t, CDC_FROM_INT(n), NULL, NULL), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(avl_tree_size(t), n / 2 + 1);
+    test_tree_links(t->root);
+    test_tree_heights(t->root);
+    avl_tree_dtor(t);
+  }
+}
+
+void test_avl_tree_bounds()
+{
+  enum { kKeys = 500 };
+  avl_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(avl_tree_ctor(&t, &info), CDC_STATUS_OK);
+  for (int i = 0; i < kKeys; ++i) {
+    CU_ASSERT_EQUAL(avl_tree_insert(t, CDC_FROM_INT(i * 2), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+  }
+
+  avl_tree_iter_t it = CDC_INIT_STRUCT;
+  avl_tree_iter_t end = CDC_INIT_STRUCT;
+  avl_tree_end(t, &end);
+  for (int key = -1; key <= kKeys * 2; ++key) {
+    int lower = key < 0 ? 0 : key + key % 2;
+    avl_tree_lower_bound(t, CDC_FROM_INT(key), &it);
+    if (lower < kKeys * 2) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_key(&it)), lower);
+    } else {
+      CU_ASSERT(avl_tree_iter_is_eq(&it, &end));
+    }
+
+    int upper = key < 0 ? 0 : key + 2 - key % 2;
+    avl_tree_upper_bound(t, CDC_FROM_INT(key), &it);
+    if (upper < kKeys * 2) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_key(&it)), upper);
+    } else {
+      CU_ASSERT(avl_tree_iter_is_eq(&it, &end));
+    }
+
+    pair_avl_tree_iter_t range = CDC_INIT_STRUCT;
+    avl_tree_equal_range(t, CDC_FROM_INT(key), &range);
+    size_t count = 0;
+    while (!avl_tree_iter_is_eq(&range.first, &range.second)) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_key(&range.first)), key);
+      avl_tree_iter_next(&range.first);
+      ++count;
+    }
+
+    CU_ASSERT_EQUAL(count, avl_tree_count(t, CDC_FROM_INT(key)));
+  }
+
+  pair_avl_tree_iter_t range = CDC_INIT_STRUCT;
+  avl_tree_range(t, CDC_FROM_INT(101), CDC_FROM_INT(200), &range);
+  for (int key = 102; key < 200; key += 2) {
+    CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_key(&range.first)), key);
+    CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_value(&range.first)), key / 2);
+    avl_tree_iter_next(&range.first);
+  }
+
+  CU_ASSERT(avl_tree_iter_is_eq(&range.first, &range.second));
+  avl_tree_range(t, CDC_FROM_INT(7), CDC_FROM_INT(7), &range);
+  CU_ASSERT(avl_tree_iter_is_eq(&range.first, &range.second));
+  avl_tree_range(t, CDC_FROM_INT(900), CDC_FROM_INT(kKeys * 4), &range);
+  CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_key(&range.first)), 900);
+  CU_ASSERT(avl_tree_iter_is_eq(&range.second, &end));
+  avl_tree_clear(t);
+  avl_tree_lower_bound(t, CDC_FROM_INT(0), &it);
+  avl_tree_end(t, &end);
+  CU_ASSERT(avl_tree_iter_is_eq(&it, &end));
+  avl_tree_dtor(t);
+}
+
+#ifdef CDC_ORDER_STATISTICS
+// Checks the subtree sizes and returns the size of the subtree.
+static size_t test_tree_sizes(avl_tree_node_t *node)
+{
+  if (!node) return 0;
+
+  size_t size = test_tree_sizes(node->left) + test_tree_sizes(node->right) + 1;
+  CU_ASSERT_EQUAL(node->size, size);
+  return size;
+}
+#endif
+
+void test_avl_tree_random()
+{
+  enum { kKeys = 2000, kOps = 50000 };
+  static bool present[kKeys];
+  avl_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  memset(present, 0, sizeof(present));
+  CU_ASSERT_EQUAL(avl_tree_ctor(&t, &info), CDC_STATUS_OK);
+  srand(13);
+  for (int i = 0; i < kOps; ++i) {
+    int key = rand() % kKeys;
+    if (rand() % 3) {
+      CU_ASSERT_EQUAL(avl_tree_insert(t, CDC_FROM_INT(key), CDC_FROM_INT(key), NULL),
+                      CDC_STATUS_OK);
+      present[key] = true;
+    } else {
+      CU_ASSERT_EQUAL(avl_tree_erase(t, CDC_FROM_INT(key)), (size_t)present[key]);
+      present[key] = false;
+    }
+
+    if (i % 100 == 0) {
+      test_tree_links(t->root);
+      test_tree_heights(t->root);
+#ifdef CDC_ORDER_STATISTICS
+      CU_ASSERT_EQUAL(test_tree_sizes(t->root), avl_tree_size(t));
+#endif
+    }
+  }
+
+  size_t count = 0;
+  avl_tree_iter_t it = CDC_INIT_STRUCT;
+  avl_tree_begin(t, &it);
+  for (int key = 0; key < kKeys; ++key) {
+    if (present[key]) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_key(&it)), key);
+      avl_tree_iter_next(&it);
+      ++count;
+    }
+  }
+
+  CU_ASSERT(!avl_tree_iter_has_next(&it));
+  CU_ASSERT_EQUAL(avl_tree_size(t), count);
+  avl_tree_dtor(t);
+}
+
+#ifdef CDC_ORDER_STATISTICS
+void test_avl_tree_select_rank()
+{
+  enum { kKeys = 1000, kOps = 20000 };
+  static pair_t pairs[kKeys];
+  static bool present[kKeys];
+  avl_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  for (int i = 0; i < kKeys; ++i) {
+    pairs[i].first = CDC_FROM_INT(i);
+    pairs[i].second = CDC_FROM_INT(i);
+    present[i] = i % 2 == 0;
+  }
+
+  CU_ASSERT_EQUAL(avl_tree_ctor(&t, &info), CDC_STATUS_OK);
+  for (int i = 0; i < kKeys; i += 2) {
+    CU_ASSERT_EQUAL(avl_tree_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+  }
+
+  srand(17);
+  for (int i = 0; i < kOps; ++i) {
+    int key = rand() % kKeys;
+    if (rand() % 2) {
+      CU_ASSERT_EQUAL(avl_tree_insert(t, CDC_FROM_INT(key), CDC_FROM_INT(key), NULL),
+                      CDC_STATUS_OK);
+      present[key] = true;
+    } else {
+      CU_ASSERT_EQUAL(avl_tree_erase(t, CDC_FROM_INT(key)), (size_t)present[key]);
+      present[key] = false;
+    }
+  }
+
+  CU_ASSERT_EQUAL(test_tree_sizes(t->root), avl_tree_size(t));
+  avl_tree_iter_t it = CDC_INIT_STRUCT;
+  avl_tree_iter_t end = CDC_INIT_STRUCT;
+  size_t rank = 0;
+  for (int key = 0; key < kKeys; ++key) {
+    CU_ASSERT_EQUAL(avl_tree_rank(t, CDC_FROM_INT(key)), rank);
+    if (present[key]) {
+      avl_tree_select(t, rank, &it);
+      CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_key(&it)), key);
+      ++rank;
+    }
+  }
+
+  CU_ASSERT_EQUAL(avl_tree_size(t), rank);
+  avl_tree_select(t, rank, &it);
+  avl_tree_end(t, &end);
+  CU_ASSERT(avl_tree_iter_is_eq(&it, &end));
+  avl_tree_dtor(t);
+
+  CU_ASSERT_EQUAL(avl_tree_ctor_sorted(&t, &info, pairs, kKeys), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(test_tree_sizes(t->root), kKeys);
+  avl_tree_select(t, kKeys / 100 * 99, &it);
+  CU_ASSERT_EQUAL(CDC_TO_INT(avl_tree_iter_key(&it)), kKeys / 100 * 99);
+  CU_ASSERT_EQUAL(avl_tree_rank(t, CDC_FROM_INT(kKeys * 2)), kKeys);
+  avl_tree_dtor(t);
+}
+#endif
@@ -0,0 +1,101 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "test-common.h"
+
+#include "cdcontainers/bloom-filter.h"
+#include "cdcontainers/casts.h"
+
+#include <stdio.h>
+
+#include <CUnit/Basic.h>
+
+static size_t hash(const void *val)
+{
+  return cdc_hash_int(CDC_TO_INT(val));
+}
+
+void test_bloom_filter_ctor()
+{
+  bloom_filter_t *f = NULL;
+
+  CU_ASSERT_EQUAL(bloom_filter_ctor(&f, hash, 1000, 0.01, NULL), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(bloom_filter_capacity(f), 1000);
+  CU_ASSERT_EQUAL(bloom_filter_count(f), 0);
+  CU_ASSERT(!bloom_filter_contains(f, CDC_FROM_INT(1)));
+  bloom_filter_dtor(f);
+
+  CU_ASSERT_EQUAL(bloom_filter_ctor(&f, hash, 0, 0.5, NULL), CDC_STATUS_OK);
+  bloom_filter_add(f, CDC_FROM_INT(1));
+  CU_ASSERT(bloom_filter_contains(f, CDC_FROM_INT(1)));
+  bloom_filter_dtor(f);
+}
+
+void test_bloom_filter_add()
+{
+  bloom_filter_t *f = NULL;
+  const int count = 10000;
+
+  CU_ASSERT_EQUAL(bloom_filter_ctor(&f, hash, (size_t)count, 0.01, NULL), CDC_STATUS_OK);
+  for (int i = 0; i < count; ++i) {
+    bloom_filter_add(f, CDC_FROM_INT(i));
+  }
+
+  CU_ASSERT_EQUAL(bloom_filter_count(f), (size_t)count);
+  for (int i = 0; i < count; ++i) {
+    CU_ASSERT(bloom_filter_contains(f, CDC_FROM_INT(i)));
+    CU_ASSERT(bloom_filter_contains_hashed(f, hash(CDC_FROM_INT(i))));
+  }
+
+  bloom_filter_add_hashed(f, hash(CDC_FROM_INT(-1)));
+  CU_ASSERT(bloom_filter_contains(f, CDC_FROM_INT(-1)));
+
+  bloom_filter_clear(f);
+  CU_ASSERT_EQUAL(bloom_filter_count(f), 0);
+  for (int i = 0; i < count; ++i) {
+    CU_ASSERT(!bloom_filter_contains(f, CDC_FROM_INT(i)));
+  }
+
+  bloom_filter_dtor(f);
+}
+
+void test_bloom_filter_fp_rate()
+{
+  const double rates[] = {0.1, 0.01, 0.001};
+  const int count = 20000;
+  const int checks = 200000;
+
+  for (size_t k = 0; k < CDC_ARRAY_SIZE(rates); ++k) {
+    bloom_filter_t *f = NULL;
+    CU_ASSERT_EQUAL(bloom_filter_ctor(&f, hash, (size_t)count, rates[k], NULL), CDC_STATUS_OK);
+    for (int i = 0; i < count; ++i) {
+      bloom_filter_add(f, CDC_FROM_INT(i));
+    }
+
+    int positives = 0;
+    for (int i = count; i < count + checks; ++i) {
+      positives += bloom_filter_contains(f, CDC_FROM_INT(i));
+    }
+
+    CU_ASSERT((double)positives / checks < rates[k] * 1.5);
+    bloom_filter_dtor(f);
+  }
+}
@@ -0,0 +1,529 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "test-common.h"
+
+#include "cdcontainers/btree.h"
+#include "cdcontainers/casts.h"
+#include "cdcontainers/common.h"
+
+#include <limits.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <CUnit/Basic.h>
+
+static pair_t a = {CDC_FROM_INT(0), CDC_FROM_INT(0)};
+static pair_t b = {CDC_FROM_INT(1), CDC_FROM_INT(1)};
+static pair_t c = {CDC_FROM_INT(2), CDC_FROM_INT(2)};
+static pair_t d = {CDC_FROM_INT(3), CDC_FROM_INT(3)};
+static pair_t e = {CDC_FROM_INT(4), CDC_FROM_INT(4)};
+static pair_t f = {CDC_FROM_INT(5), CDC_FROM_INT(5)};
+static pair_t g = {CDC_FROM_INT(6), CDC_FROM_INT(6)};
+static pair_t h = {CDC_FROM_INT(7), CDC_FROM_INT(7)};
+
+static int lt(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) < CDC_TO_INT(r);
+}
+
+static void check_node(btree_node_t *node, btree_node_t *parent, size_t depth, long lo, long hi,
+                       size_t *leaf_depth, size_t *count)
+{
+  CU_ASSERT_EQUAL(node->parent, parent);
+  CU_ASSERT(node->size <= CDC_BTREE_ORDER);
+  if (parent) {
+    CU_ASSERT(node->size >= CDC_BTREE_ORDER / 2);
+  }
+
+  for (unsigned i = 0; i < node->size; ++i) {
+    long key = CDC_TO_INT(node->keys[i]);
+    CU_ASSERT(lo <= key && key < hi);
+    if (i > 0) {
+      CU_ASSERT(CDC_TO_INT(node->keys[i - 1]) < key);
+    }
+  }
+
+  if (node->is_leaf) {
+    if (*leaf_depth == 0) {
+      *leaf_depth = depth;
+    }
+
+    CU_ASSERT_EQUAL(*leaf_depth, depth);
+    *count += node->size;
+    return;
+  }
+
+  btree_inner_t *inner = (btree_inner_t *)node;
+  for (unsigned i = 0; i <= node->size; ++i) {
+    long child_lo = i > 0 ? CDC_TO_INT(node->keys[i - 1]) : lo;
+    long child_hi = i < node->size ? CDC_TO_INT(node->keys[i]) : hi;
+    check_node(inner->children[i], node, depth + 1, child_lo, child_hi, leaf_depth, count);
+  }
+}
+
+static void check_btree(btree_t *t)
+{
+  if (!t->root) {
+    CU_ASSERT_EQUAL(t->size, 0);
+    CU_ASSERT_PTR_NULL(t->first);
+    CU_ASSERT_PTR_NULL(t->last);
+    return;
+  }
+
+  size_t leaf_depth = 0;
+  size_t count = 0;
+  check_node(t->root, NULL, 1, LONG_MIN, LONG_MAX, &leaf_depth, &count);
+  CU_ASSERT_EQUAL(count, t->size);
+
+  size_t leaves = 0;
+  count = 0;
+  btree_leaf_t *prev = NULL;
+  for (btree_leaf_t *leaf = t->first; leaf; leaf = leaf->next) {
+    CU_ASSERT_EQUAL(leaf->prev, prev);
+    if (prev && prev->base.size && leaf->base.size) {
+      CU_ASSERT(CDC_TO_INT(prev->base.keys[prev->base.size - 1]) <
+                CDC_TO_INT(leaf->base.keys[0]));
+    }
+
+    count += leaf->base.size;
+    prev = leaf;
+    ++leaves;
+  }
+
+  CU_ASSERT_EQUAL(prev, t->last);
+  CU_ASSERT_EQUAL(count, t->size);
+  CU_ASSERT_EQUAL(leaves, t->leaf_count);
+}
+static bool btree_key_int_eq(btree_t *t, size_t count, ...)
+{
+  check_btree(t);
+  va_list args;
+  va_start(args, count);
+  for (size_t i = 0; i < count; ++i) {
+    pair_t *val = va_arg(args, pair_t *);
+    void *tmp = NULL;
+    if (btree_get(t, val->first, &tmp) != CDC_STATUS_OK || tmp != val->second) {
+      va_end(args);
+      return false;
+    }
+  }
+  va_end(args);
+  CU_ASSERT_EQUAL(btree_size(t), count);
+  return true;
+}
+
+void test_btree_ctor()
+{
+  btree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctor(&t, &info), CDC_STATUS_OK);
+  CU_ASSERT(btree_empty(t));
+  btree_dtor(t);
+}
+
+void test_btree_ctorl()
+{
+  btree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctorl(&t, &info, &a, &g, &h, &d, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_size(t), 4);
+  CU_ASSERT(btree_key_int_eq(t, 4, &a, &g, &h, &d));
+  btree_dtor(t);
+}
+
+void test_btree_get()
+{
+  btree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctorl(&t, &info, &a, &b, &c, &d, &g, &h, &e, &f, CDC_END),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_size(t), 8);
+  CU_ASSERT(btree_key_int_eq(t, 8, &a, &b, &c, &d, &g, &h, &e, &f));
+
+  void *value = NULL;
+  CU_ASSERT_EQUAL(btree_get(t, CDC_FROM_INT(10), &value), CDC_STATUS_NOT_FOUND);
+  btree_dtor(t);
+}
+
+void test_btree_count()
+{
+  btree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctorl(&t, &info, &a, &b, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_size(t), 2);
+  CU_ASSERT_EQUAL(btree_count(t, a.first), 1);
+  CU_ASSERT_EQUAL(btree_count(t, b.first), 1);
+  CU_ASSERT_EQUAL(btree_count(t, CDC_FROM_INT(10)), 0);
+  btree_dtor(t);
+}
+
+void test_btree_find()
+{
+  btree_t *t = NULL;
+  btree_iter_t it = CDC_INIT_STRUCT;
+  btree_iter_t it_end = CDC_INIT_STRUCT;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctorl(&t, &info, &a, &b, &c, &d, &g, CDC_END), CDC_STATUS_OK);
+  btree_find(t, a.first, &it);
+  CU_ASSERT_EQUAL(btree_iter_value(&it), a.second);
+  btree_find(t, b.first, &it);
+  CU_ASSERT_EQUAL(btree_iter_value(&it), b.second);
+  btree_find(t, g.first, &it);
+  CU_ASSERT_EQUAL(btree_iter_value(&it), g.second);
+  btree_find(t, h.first, &it);
+  btree_end(t, &it_end);
+  CU_ASSERT(btree_iter_is_eq(&it, &it_end));
+  btree_dtor(t);
+}
+
+void test_btree_clear()
+{
+  btree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctorl(&t, &info, &a, &b, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_size(t), 2);
+  btree_clear(t);
+  CU_ASSERT(btree_empty(t));
+  btree_clear(t);
+  CU_ASSERT(btree_empty(t));
+  btree_dtor(t);
+}
+
+void test_btree_insert()
+{
+  btree_t *t = NULL;
+  const int kCount = 100;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctor(&t, &info), CDC_STATUS_OK);
+
+  for (int i = 0; i < kCount; ++i) {
+    CU_ASSERT_EQUAL(btree_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+  }
+
+  CU_ASSERT_EQUAL(btree_size(t), (size_t)kCount);
+
+  for (int i = 0; i < kCount; ++i) {
+    void *val = NULL;
+    CU_ASSERT_EQUAL(btree_get(t, CDC_FROM_INT(i), &val), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(CDC_TO_INT(val), i);
+  }
+
+  btree_dtor(t);
+}
+
+void test_btree_insert_or_assign()
+{
+  btree_t *t = NULL;
+  pair_btree_iter_bool_t ret = CDC_INIT_STRUCT;
+  void *value = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctor(&t, &info), CDC_STATUS_OK);
+
+  CU_ASSERT_EQUAL(btree_insert_or_assign(t, a.first, a.second, &ret), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_size(t), 1);
+  CU_ASSERT_EQUAL(btree_iter_value(&ret.first), a.second);
+  CU_ASSERT(ret.second);
+
+  CU_ASSERT_EQUAL(btree_insert_or_assign(t, a.first, b.second, &ret), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_size(t), 1);
+  CU_ASSERT_EQUAL(btree_get(t, a.first, &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(value, b.second);
+  CU_ASSERT_EQUAL(btree_iter_value(&ret.first), b.second);
+  CU_ASSERT(!ret.second);
+
+  CU_ASSERT_EQUAL(btree_insert_or_assign(t, c.first, c.second, &ret), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_size(t), 2);
+  CU_ASSERT_EQUAL(btree_iter_value(&ret.first), c.second);
+  CU_ASSERT(ret.second);
+
+  CU_ASSERT_EQUAL(btree_insert_or_assign(t, c.first, d.second, &ret), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_size(t), 2);
+  CU_ASSERT_EQUAL(btree_get(t, c.first, &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(value, d.second);
+  CU_ASSERT_EQUAL(btree_iter_value(&ret.first), d.second);
+  CU_ASSERT(!ret.second);
+  btree_dtor(t);
+}
+
+void test_btree_erase()
+{
+  btree_t *t = NULL;
+  void *value = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctorl(&t, &info, &a, &b, &c, &d, &g, &h, &e, &f, CDC_END),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_size(t), 8);
+  CU_ASSERT(btree_key_int_eq(t, 8, &a, &b, &c, &d, &g, &h, &e, &f));
+  CU_ASSERT_EQUAL(btree_erase(t, a.first), 1);
+  CU_ASSERT_EQUAL(btree_get(t, a.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT(btree_key_int_eq(t, 7, &b, &c, &d, &g, &h, &e, &f));
+
+  CU_ASSERT_EQUAL(btree_erase(t, h.first), 1);
+  CU_ASSERT_EQUAL(btree_get(t, h.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(btree_size(t), 6);
+  CU_ASSERT(btree_key_int_eq(t, 6, &b, &c, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(btree_erase(t, h.first), 0);
+  CU_ASSERT_EQUAL(btree_size(t), 6);
+  CU_ASSERT(btree_key_int_eq(t, 6, &b, &c, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(btree_erase(t, b.first), 1);
+  CU_ASSERT_EQUAL(btree_get(t, b.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(btree_size(t), 5);
+  CU_ASSERT(btree_key_int_eq(t, 5, &c, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(btree_erase(t, c.first), 1);
+  CU_ASSERT_EQUAL(btree_get(t, c.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(btree_size(t), 4);
+  CU_ASSERT(btree_key_int_eq(t, 4, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(btree_erase(t, d.first), 1);
+  CU_ASSERT_EQUAL(btree_get(t, d.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(btree_size(t), 3);
+  CU_ASSERT(btree_key_int_eq(t, 3, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(btree_erase(t, g.first), 1);
+  CU_ASSERT_EQUAL(btree_get(t, g.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(btree_size(t), 2);
+  CU_ASSERT(btree_key_int_eq(t, 2, &e, &f));
+
+  CU_ASSERT_EQUAL(btree_erase(t, f.first), 1);
+  CU_ASSERT_EQUAL(btree_get(t, f.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(btree_size(t), 1);
+  CU_ASSERT(btree_key_int_eq(t, 1, &e));
+
+  CU_ASSERT_EQUAL(btree_erase(t, e.first), 1);
+  CU_ASSERT_EQUAL(btree_get(t, e.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT(btree_empty(t));
+  btree_dtor(t);
+}
+
+void test_btree_iterators()
+{
+  btree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctorl(&t, &info, &a, &b, &c, &d, &e, &f, &g, &h, CDC_END),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_size(t), 8);
+
+  btree_iter_t it1 = CDC_INIT_STRUCT;
+  btree_iter_t it2 = CDC_INIT_STRUCT;
+  pair_t *arr[] = {&a, &b, &c, &d, &e, &f, &g, &h};
+
+  size_t i = 0;
+  btree_begin(t, &it1);
+  btree_end(t, &it2);
+  for (; !btree_iter_is_eq(&it1, &it2); btree_iter_next(&it1)) {
+    CU_ASSERT_EQUAL(btree_iter_key(&it1), arr[i]->first)
+    ++i;
+  }
+  CU_ASSERT_EQUAL(btree_size(t), i);
+
+  i = btree_size(t) - 1;
+  btree_end(t, &it1);
+  btree_iter_prev(&it1);
+  btree_begin(t, &it2);
+  for (; !btree_iter_is_eq(&it1, &it2); btree_iter_prev(&it1)) {
+    CU_ASSERT_EQUAL(btree_iter_key(&it1), arr[i]->first)
+    --i;
+  }
+  CU_ASSERT_EQUAL(i, 0);
+
+  btree_begin(t, &it1);
+  while (btree_iter_has_next(&it1)) {
+    CU_ASSERT_EQUAL(btree_iter_key(&it1), arr[i]->first)
+    ++i;
+    btree_iter_next(&it1);
+  }
+  CU_ASSERT_EQUAL(btree_size(t), i);
+
+  i = btree_size(t) - 1;
+  btree_end(t, &it1);
+  btree_iter_prev(&it1);
+  while (btree_iter_has_prev(&it1)) {
+    CU_ASSERT_EQUAL(btree_iter_key(&it1), arr[i]->first);
+    --i;
+    btree_iter_prev(&it1);
+  }
+  CU_ASSERT_EQUAL(i, 0);
+  btree_dtor(t);
+}
+
+void test_btree_swap()
+{
+  btree_t *ta = NULL;
+  btree_t *tb = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctorl(&ta, &info, &b, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(btree_ctorl(&tb, &info, &a, &g, &h, &d, CDC_END), CDC_STATUS_OK);
+
+  btree_swap(ta, tb);
+
+  CU_ASSERT_EQUAL(btree_size(ta), 4);
+  CU_ASSERT(btree_key_int_eq(ta, 4, &a, &g, &h, &d));
+  CU_ASSERT_EQUAL(btree_size(tb), 1);
+  CU_ASSERT(btree_key_int_eq(tb, 1, &b));
+
+  btree_dtor(ta);
+  btree_dtor(tb);
+}
+
+void test_btree_random()
+{
+  enum { kKeys = 5000, kOps = 100000 };
+  static bool present[kKeys];
+  btree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  memset(present, 0, sizeof(present));
+  CU_ASSERT_EQUAL(btree_ctor(&t, &info), CDC_STATUS_OK);
+  srand(7);
+  for (int i = 0; i < kOps; ++i) {
+    int key = rand() % kKeys;
+    if (rand() % 3) {
+      bool inserted = false;
+      CU_ASSERT_EQUAL(btree_insert1(t, CDC_FROM_INT(key), CDC_FROM_INT(key), NULL, &inserted),
+                      CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(inserted, !present[key]);
+      present[key] = true;
+    } else {
+      CU_ASSERT_EQUAL(btree_erase(t, CDC_FROM_INT(key)), (size_t)present[key]);
+      present[key] = false;
+    }
+
+    if (i % 100 == 0) {
+      check_btree(t);
+    }
+  }
+
+  check_btree(t);
+  btree_iter_t it = CDC_INIT_STRUCT;
+  btree_begin(t, &it);
+  for (int key = 0; key < kKeys; ++key) {
+    if (present[key]) {
+      CU_ASSERT(btree_iter_has_next(&it));
+      CU_ASSERT_EQUAL(CDC_TO_INT(btree_iter_key(&it)), key);
+      btree_iter_next(&it);
+    }
+  }
+
+  CU_ASSERT(!btree_iter_has_next(&it));
+  for (int key = 0; key < kKeys; ++key) {
+    CU_ASSERT_EQUAL(btree_erase(t, CDC_FROM_INT(key)), (size_t)present[key]);
+  }
+
+  check_btree(t);
+  CU_ASSERT(btree_empty(t));
+  CU_ASSERT_EQUAL(t->leaf_count, 0);
+  CU_ASSERT_EQUAL(t->inner_count, 0);
+  btree_dtor(t);
+}
+
+
+void test_btree_bounds()
+{
+  enum { kKeys = 500 };
+  btree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(btree_ctor(&t, &info), CDC_STATUS_OK);
+  for (int i = 0; i < kKeys; ++i) {
+    CU_ASSERT_EQUAL(btree_insert(t, CDC_FROM_INT(i * 2), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+  }
+
+  btree_iter_t it = CDC_INIT_STRUCT;
+  btree_iter_t end = CDC_INIT_STRUCT;
+  btree_end(t, &end);
+  for (int key = -1; key <= kKeys * 2; ++key) {
+    int lower = key < 0 ? 0 : key + key % 2;
+    btree_lower_bound(t, CDC_FROM_INT(key), &it);
+    if (lower < kKeys * 2) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(btree_iter_key(&it)), lower);
+    } else {
+      CU_ASSERT(btree_iter_is_eq(&it, &end));
+    }
+
+    int upper = key < 0 ? 0 : key + 2 - key % 2;
+    btree_upper_bound(t, CDC_FROM_INT(key), &it);
+    if (upper < kKeys * 2) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(btree_iter_key(&it)), upper);
+    } else {
+      CU_ASSERT(btree_iter_is_eq(&it, &end));
+    }
+
+    pair_btree_iter_t range = CDC_INIT_STRUCT;
+    btree_equal_range(t, CDC_FROM_INT(key), &range);
+    size_t count = 0;
+    while (!btree_iter_is_eq(&range.first, &range.second)) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(btree_iter_key(&range.first)), key);
+      btree_iter_next(&range.first);
+      ++count;
+    }
+
+    CU_ASSERT_EQUAL(count, btree_count(t, CDC_FROM_INT(key)));
+  }
+
+  pair_btree_iter_t range = CDC_INIT_STRUCT;
+  btree_range(t, CDC_FROM_INT(101), CDC_FROM_INT(200), &range);
+  for (int key = 102; key < 200; key += 2) {
+    CU_ASSERT_EQUAL(CDC_TO_INT(btree_iter_key(&range.first)), key);
+    CU_ASSERT_EQUAL(CDC_TO_INT(btree_iter_value(&range.first)), key / 2);
+    btree_iter_next(&range.first);
+  }
+
+  CU_ASSERT(btree_iter_is_eq(&range.first, &range.second));
+  btree_range(t, CDC_FROM_INT(7), CDC_FROM_INT(7), &range);
+  CU_ASSERT(btree_iter_is_eq(&range.first, &range.second));
+  btree_range(t, CDC_FROM_INT(900), CDC_FROM_INT(kKeys * 4), &range);
+  CU_ASSERT_EQUAL(CDC_TO_INT(btree_iter_key(&range.first)), 900);
+  CU_ASSERT(btree_iter_is_eq(&range.second, &end));
+  btree_clear(t);
+  btree_lower_bound(t, CDC_FROM_INT(0), &it);
+  btree_end(t, &end);
+  CU_ASSERT(btree_iter_is_eq(&it, &end));
+  btree_dtor(t);
+}
@@ -21,7 +21,21 @@
 #define CDC_USE_SHORT_NAMES
 #include "test-common.h"
 
+#include "cdcontainers/adapters/map.h"
+#include "cdcontainers/array.h"
+#include "cdcontainers/avl-tree.h"
 #include "cdcontainers/casts.h"
+#include "cdcontainers/common.h"
+#include "cdcontainers/concurrent-map.h"
+#include "cdcontainers/hash-table.h"
+#include "cdcontainers/hash.h"
+#include "cdcontainers/list.h"
+#include "cdcontainers/rcu-hash-table.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <CUnit/Basic.h>
 
@@ -42,3 +56,280 @@ void test_ptr_double_cast()
   CU_ASSERT_EQUAL(CDC_TO_DOUBLE(CDC_FROM_DOUBLE(value)), value);
 #endif
 }
+
+static int bit_count(size_t x)
+{
+  int count = 0;
+  for (; x; x &= x - 1) {
+    ++count;
+  }
+
+  return count;
+}
+
+void test_hash_bytes()
+{
+  unsigned char data[256];
+  for (size_t i = 0; i < sizeof(data); ++i) {
+    data[i] = (unsigned char)(i * 31 + 7);
+  }
+
+  CU_ASSERT_EQUAL(cdc_hash_bytes(data, 0, 0), cdc_hash_bytes(data + 1, 0, 0));
+  CU_ASSERT_NOT_EQUAL(cdc_hash_bytes(data, 0, 0), cdc_hash_bytes(data, 0, 1));
+  for (size_t len = 1; len <= sizeof(data); ++len) {
+    size_t h = cdc_hash_bytes(data, len, 0);
+    CU_ASSERT_EQUAL(h, cdc_hash_bytes(data, len, 0));
+    CU_ASSERT_NOT_EQUAL(h, cdc_hash_bytes(data, len, 1));
+    CU_ASSERT_NOT_EQUAL(h, cdc_hash_bytes(data, len - 1, 0));
+
+    // Flipping any bit of the input changes about a half of the hash bits.
+    int changed = 0;
+    for (size_t bit = 0; bit < len * 8; ++bit) {
+      data[bit / 8] ^= (unsigned char)(1 << (bit % 8));
+      changed += bit_count(h ^ cdc_hash_bytes(data, len, 0));
+      data[bit / 8] ^= (unsigned char)(1 << (bit % 8));
+    }
+
+    double mean = (double)changed / (double)(len * 8);
+    CU_ASSERT(mean > CDC_DIGITS_SIZE * 0.4 && mean < CDC_DIGITS_SIZE * 0.6);
+  }
+}
+
+void test_hash_str()
+{
+  const char *strs[] = {"", "a", "ab", "abc", "abcd", "hello, world", "0123456789abcdef",
+                        "0123456789abcdef0", "The quick brown fox jumps over the lazy dog. "
+                        "The quick brown fox jumps over the lazy dog."};
+  for (size_t i = 0; i < CDC_ARRAY_SIZE(strs); ++i) {
+    CU_ASSERT_EQUAL(cdc_hash_str(strs[i], 0), cdc_hash_bytes(strs[i], strlen(strs[i]), 0));
+    CU_ASSERT_EQUAL(cdc_hash_str(strs[i], 42), cdc_hash_bytes(strs[i], strlen(strs[i]), 42));
+    CU_ASSERT_EQUAL(cdc_pdhash_str(strs[i]), cdc_hash_str(strs[i], 0));
+    for (size_t j = 0; j < i; ++j) {
+      CU_ASSERT_NOT_EQUAL(cdc_hash_str(strs[i], 0), cdc_hash_str(strs[j], 0));
+    }
+  }
+
+  cdc_hash_fn_t fn = cdc_pdhash_str;
+  char buffer[] = "hello, world";
+  CU_ASSERT_EQUAL(fn(buffer), fn("hello, world"));
+}
+
+void test_hash_mix()
+{
+  size_t used[16] = {0};
+  for (size_t i = 0; i < 1024; ++i) {
+    size_t h = cdc_hash_mix(i * 16);
+    CU_ASSERT_NOT_EQUAL(h, cdc_hash_mix(i * 16 + 1));
+    ++used[h & 15];
+  }
+
+  // Aligned values are spread over all the low bits.
+  for (size_t i = 0; i < CDC_ARRAY_SIZE(used); ++i) {
+    CU_ASSERT(used[i] > 32 && used[i] < 96);
+  }
+
+#ifndef CDC_PDHASH_NO_MIX
+  CU_ASSERT_EQUAL(cdc_pdhash_int(CDC_FROM_INT(42)), cdc_hash_mix(cdc_hash_int(42)));
+#endif
+}
+
+struct counting_allocator {
+  size_t allocs;
+  size_t frees;
+};
+
+static size_t int_hash(const void *val)
+{
+  return cdc_hash_int(CDC_TO_INT(val));
+}
+
+static void *counting_alloc(void *ctx, size_t size)
+{
+  ++((struct counting_allocator *)ctx)->allocs;
+  return malloc(size);
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t size)
+{
+  if (!ptr) {
+    ++((struct counting_allocator *)ctx)->allocs;
+  }
+
+  return realloc(ptr, size);
+}
+
+static void counting_free(void *ctx, void *ptr)
+{
+  ++((struct counting_allocator *)ctx)->frees;
+  free(ptr);
+}
+
+static int int_lt(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) < CDC_TO_INT(r);
+}
+
+static int int_eq(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) == CDC_TO_INT(r);
+}
+
+void test_allocator()
+{
+  struct counting_allocator counter = {0, 0};
+  allocator_t allocator = {counting_alloc, counting_realloc, counting_free, &counter};
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = int_lt;
+  info.eq = int_eq;
+  info.hash = int_hash;
+  info.allocator = &allocator;
+
+  array_t *v = NULL;
+  list_t *l = NULL;
+  hash_table_t *t = NULL;
+  CU_ASSERT_EQUAL(array_ctor(&v, &info), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(list_ctor(&l, &info), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(hash_table_ctor2(&t, &info, 0.7, CDC_HASH_TABLE_NODE_POOL), CDC_STATUS_OK);
+  for (int i = 0; i < 1000; ++i) {
+    CU_ASSERT_EQUAL(array_push_back(v, CDC_FROM_INT(i)), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(list_push_back(l, CDC_FROM_INT(i)), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                    CDC_STATUS_OK);
+  }
+
+  CU_ASSERT(counter.allocs > 1000);
+  array_dtor(v);
+  list_dtor(l);
+  hash_table_dtor(t);
+  CU_ASSERT_EQUAL(counter.allocs, counter.frees);
+
+  // Tree nodes are cut from chunks of the node pool, which are reused after
+  // erasing.
+  avl_tree_t *tree = NULL;
+  size_t allocs = counter.allocs;
+  CU_ASSERT_EQUAL(avl_tree_ctor(&tree, &info), CDC_STATUS_OK);
+  for (int i = 0; i < 10000; ++i) {
+    CU_ASSERT_EQUAL(avl_tree_insert(tree, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+  }
+
+  CU_ASSERT(counter.allocs - allocs < 20);
+  allocs = counter.allocs;
+  for (int i = 0; i < 10000; i += 2) {
+    CU_ASSERT_EQUAL(avl_tree_erase(tree, CDC_FROM_INT(i)), 1);
+  }
+
+  for (int i = 0; i < 10000; i += 2) {
+    CU_ASSERT_EQUAL(avl_tree_insert(tree, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+  }
+
+  CU_ASSERT_EQUAL(counter.allocs, allocs);
+  avl_tree_dtor(tree);
+  CU_ASSERT_EQUAL(counter.allocs, counter.frees);
+
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
+  for (size_t i = 0; i < CDC_ARRAY_SIZE(tables); ++i) {
+    allocs = counter.allocs;
+    map_t *m = NULL;
+    CU_ASSERT_EQUAL(map_ctor(tables[i], &m, &info), CDC_STATUS_OK);
+    for (int j = 0; j < 100; ++j) {
+      CU_ASSERT_EQUAL(map_insert(m, CDC_FROM_INT(j), CDC_FROM_INT(j), NULL, NULL),
+                      CDC_STATUS_OK);
+    }
+
+    CU_ASSERT_EQUAL(map_erase(m, CDC_FROM_INT(0)), 1);
+    CU_ASSERT(counter.allocs > allocs);
+
+    // The filter, its blocks and the iterators use the allocator too.
+    allocs = counter.allocs;
+    map_iter_t it = CDC_INIT_STRUCT;
+    CU_ASSERT_EQUAL(map_enable_filter(m, int_hash, 0.01), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_iter_ctor(m, &it), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(counter.allocs - allocs, 5);
+    map_iter_dtor(&it);
+    map_dtor(m);
+    CU_ASSERT_EQUAL(counter.allocs, counter.frees);
+  }
+
+  concurrent_map_t *cm = NULL;
+  allocs = counter.allocs;
+  CU_ASSERT_EQUAL(concurrent_map_ctor(&cm, &info), CDC_STATUS_OK);
+  for (int i = 0; i < 100; ++i) {
+    CU_ASSERT_EQUAL(concurrent_map_insert(cm, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL),
+                    CDC_STATUS_OK);
+  }
+
+  CU_ASSERT(counter.allocs > allocs);
+  concurrent_map_dtor(cm);
+  CU_ASSERT_EQUAL(counter.allocs, counter.frees);
+
+  rcu_hash_table_t *rt = NULL;
+  rcu_reader_t *reader = NULL;
+  CU_ASSERT_EQUAL(rcu_hash_table_ctor(&rt, &info), CDC_STATUS_OK);
+  allocs = counter.allocs;
+  CU_ASSERT_EQUAL(rcu_reader_ctor(rt, &reader), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(counter.allocs - allocs, 1);
+  rcu_reader_dtor(reader);
+  rcu_hash_table_dtor(rt);
+  CU_ASSERT_EQUAL(counter.allocs, counter.frees);
+}
+
+#define SHARED_INFO_THREADS 8
+#define SHARED_INFO_ROUNDS 1000
+
+static void *shared_info_worker(void *arg)
+{
+  data_info_t *info = (data_info_t *)arg;
+  for (int i = 0; i < SHARED_INFO_ROUNDS; ++i) {
+    hash_table_t *t = NULL;
+    avl_tree_t *tree = NULL;
+    if (hash_table_ctor(&t, info) != CDC_STATUS_OK) {
+      return NULL;
+    }
+
+    if (avl_tree_ctor(&tree, info) != CDC_STATUS_OK) {
+      hash_table_dtor(t);
+      return NULL;
+    }
+
+    hash_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL);
+    avl_tree_insert(tree, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL);
+    avl_tree_dtor(tree);
+    hash_table_dtor(t);
+  }
+
+  return arg;
+}
+
+void test_shared_data_info()
+{
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = int_lt;
+  info.eq = int_eq;
+  info.hash = int_hash;
+  pthread_t threads[SHARED_INFO_THREADS];
+
+  for (int i = 0; i < SHARED_INFO_THREADS; ++i) {
+    CU_ASSERT_EQUAL(pthread_create(&threads[i], NULL, shared_info_worker, &info), 0);
+  }
+
+  for (int i = 0; i < SHARED_INFO_THREADS; ++i) {
+    void *ret = NULL;
+    CU_ASSERT_EQUAL(pthread_join(threads[i], &ret), 0);
+    CU_ASSERT_EQUAL(ret, &info);
+  }
+
+  // The data info of the caller is not modified.
+  CU_ASSERT_EQUAL(info.__cnt, 0);
+
+  hash_table_t *a = NULL;
+  hash_table_t *b = NULL;
+  CU_ASSERT_EQUAL(hash_table_ctor(&a, &info), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(hash_table_ctor(&b, &info), CDC_STATUS_OK);
+  CU_ASSERT(a->dinfo != &info);
+  CU_ASSERT(b->dinfo != &info);
+  hash_table_dtor(a);
+  hash_table_dtor(b);
+  CU_ASSERT_EQUAL(info.__cnt, 0);
+}
@@ -28,6 +28,11 @@
 // Common tests
 void test_ptr_float_cast();
 void test_ptr_double_cast();
+void test_hash_bytes();
+void test_hash_str();
+void test_hash_mix();
+void test_allocator();
+void test_shared_data_info();
 
 // Array tests
 void test_array_ctor();
@@ -46,6 +51,8 @@ void test_array_push_back();
 void test_array_pop_back();
 void test_array_swap();
 void test_array_shrink_to_fit();
+void test_array_growth_policy();
+void test_array_memory_usage();
 
 // List tests
 void test_list_ctor();
@@ -179,6 +186,11 @@ void test_treap_clear();
 void test_treap_insert_or_assign();
 void test_treap_erase();
 void test_treap_height();
+void test_treap_ctor_sorted();
+void test_treap_bounds();
+#ifdef CDC_ORDER_STATISTICS
+void test_treap_select_rank();
+#endif
 
 // Hash table tests
 void test_hash_table_ctor();
@@ -193,6 +205,70 @@ void test_hash_table_erase();
 void test_hash_table_swap();
 void test_hash_table_rehash();
 void test_hash_table_reserve();
+void test_hash_table_hashed();
+void test_hash_table_incremental_rehash();
+void test_hash_table_node_pool();
+void test_hash_table_mix_hash();
+void test_hash_table_get_many();
+void test_hash_table_small();
+void test_hash_table_small_hashes();
+void test_hash_table_get_probe();
+
+// Flat hash table tests
+void test_flat_hash_table_ctor();
+void test_flat_hash_table_ctorl();
+void test_flat_hash_table_get();
+void test_flat_hash_table_count();
+void test_flat_hash_table_find();
+void test_flat_hash_table_clear();
+void test_flat_hash_table_insert();
+void test_flat_hash_table_insert_or_assign();
+void test_flat_hash_table_erase();
+void test_flat_hash_table_swap();
+void test_flat_hash_table_rehash();
+void test_flat_hash_table_reserve();
+void test_flat_hash_table_iterators();
+void test_flat_hash_table_many();
+
+// Bloom filter tests
+void test_bloom_filter_ctor();
+void test_bloom_filter_add();
+void test_bloom_filter_fp_rate();
+
+// Frozen map tests
+void test_frozen_map_ctor();
+void test_frozen_map_get();
+void test_frozen_map_ctor_hash_table();
+
+// Concurrent map tests
+void test_concurrent_map_ctor();
+void test_concurrent_map_insert();
+void test_concurrent_map_compute_if_absent();
+void test_concurrent_map_foreach();
+void test_concurrent_map_threads();
+
+// RCU hash table tests
+void test_rcu_hash_table_ctor();
+void test_rcu_hash_table_insert();
+void test_rcu_hash_table_reclaim();
+void test_rcu_hash_table_threads();
+
+// Robin Hood table tests
+void test_robin_hood_table_ctor();
+void test_robin_hood_table_ctorl();
+void test_robin_hood_table_get();
+void test_robin_hood_table_count();
+void test_robin_hood_table_find();
+void test_robin_hood_table_clear();
+void test_robin_hood_table_insert();
+void test_robin_hood_table_insert_or_assign();
+void test_robin_hood_table_erase();
+void test_robin_hood_table_swap();
+void test_robin_hood_table_rehash();
+void test_robin_hood_table_reserve();
+void test_robin_hood_table_iterators();
+void test_robin_hood_table_many();
+void test_robin_hood_table_probe_length();
 
 // Splay tree tests
 void test_splay_tree_ctor();
@@ -208,6 +284,8 @@ void test_splay_tree_clear();
 void test_splay_tree_insert_or_assign();
 void test_splay_tree_erase();
 void test_splay_tree_height();
+void test_splay_tree_ctor_sorted();
+void test_splay_tree_bounds();
 
 // Avl tree tests
 void test_avl_tree_ctor();
@@ -222,7 +300,46 @@ void test_avl_tree_find();
 void test_avl_tree_clear();
 void test_avl_tree_insert_or_assign();
 void test_avl_tree_erase();
+void test_avl_tree_erase_successor();
 void test_avl_tree_height();
+void test_avl_tree_ctor_sorted();
+void test_avl_tree_bounds();
+void test_avl_tree_random();
+#ifdef CDC_ORDER_STATISTICS
+void test_avl_tree_select_rank();
+#endif
+
+// B+ tree tests
+void test_btree_ctor();
+void test_btree_ctorl();
+void test_btree_insert();
+void test_btree_swap();
+void test_btree_iterators();
+void test_btree_get();
+void test_btree_count();
+void test_btree_find();
+void test_btree_clear();
+void test_btree_insert_or_assign();
+void test_btree_erase();
+void test_btree_random();
+void test_btree_bounds();
+
+// Red-black tree tests
+void test_rb_tree_ctor();
+void test_rb_tree_ctorl();
+void test_rb_tree_insert();
+void test_rb_tree_swap();
+void test_rb_tree_iterators();
+void test_rb_tree_get();
+void test_rb_tree_count();
+void test_rb_tree_find();
+void test_rb_tree_clear();
+void test_rb_tree_insert_or_assign();
+void test_rb_tree_erase();
+void test_rb_tree_height();
+void test_rb_tree_random();
+void test_rb_tree_ctor_sorted();
+void test_rb_tree_bounds();
 
 // Map tests
 void test_map_ctor();
@@ -232,11 +349,24 @@ void test_map_erase();
 void test_map_swap();
 void test_map_iterators();
 void test_map_get();
+void test_map_get_many();
 void test_map_count();
 void test_map_find();
+void test_map_probe();
 void test_map_clear();
 void test_map_insert_or_assign();
 void test_map_erase();
 void test_map_iter_type();
+void test_map_filter();
+void test_map_filter_churn();
+void test_map_memory_usage();
+void test_map_ctor_sorted();
+void test_map_bounds();
+void test_map_select_rank();
+
+// Arena tests
+void test_arena_alloc();
+void test_arena_realloc();
+void test_arena_containers();
 
 #endif  // CDSTRUCTURES_TESTS_TESTS_COMMON_H
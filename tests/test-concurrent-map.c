@@ -0,0 +1,269 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "test-common.h"
+
+#include "cdcontainers/casts.h"
+#include "cdcontainers/concurrent-map.h"
+#include "cdcontainers/global.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <CUnit/Basic.h>
+
+#define THREADS_COUNT 8
+#define KEYS_PER_THREAD 2000
+
+static int eq(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) == CDC_TO_INT(r);
+}
+
+static size_t hash(const void *val)
+{
+  return cdc_hash_int(CDC_TO_INT(val));
+}
+
+static void sum_values(void *key, void *value, void *arg)
+{
+  CDC_UNUSED(key);
+  *(int *)arg += CDC_TO_INT(value);
+}
+
+static void *square(void *key, void *arg)
+{
+  ++*(int *)arg;
+  return CDC_FROM_INT(CDC_TO_INT(key) * CDC_TO_INT(key));
+}
+
+struct worker_arg {
+  concurrent_map_t *m;
+  int id;
+  int errors;
+};
+
+static void *worker(void *p)
+{
+  struct worker_arg *arg = (struct worker_arg *)p;
+  int begin = arg->id * KEYS_PER_THREAD;
+  int end = begin + KEYS_PER_THREAD;
+  for (int i = begin; i < end; ++i) {
+    bool inserted = false;
+    if (concurrent_map_insert(arg->m, CDC_FROM_INT(i), CDC_FROM_INT(i), &inserted) !=
+            CDC_STATUS_OK ||
+        !inserted) {
+      ++arg->errors;
+    }
+  }
+
+  // Every thread also reads the keys of its neighbour, which are inserted
+  // concurrently, and computes shared keys.
+  int other = (begin + KEYS_PER_THREAD) % (THREADS_COUNT * KEYS_PER_THREAD);
+  for (int i = other; i < other + KEYS_PER_THREAD; ++i) {
+    void *value = NULL;
+    if (concurrent_map_get(arg->m, CDC_FROM_INT(i), &value) == CDC_STATUS_OK &&
+        CDC_TO_INT(value) != i) {
+      ++arg->errors;
+    }
+  }
+
+  for (int i = -1; i > -100; --i) {
+    void *value = NULL;
+    int calls = 0;
+    if (concurrent_map_compute_if_absent(arg->m, CDC_FROM_INT(i), square, &calls, &value, NULL) !=
+            CDC_STATUS_OK ||
+        CDC_TO_INT(value) != i * i) {
+      ++arg->errors;
+    }
+  }
+
+  for (int i = begin; i < end; i += 2) {
+    if (concurrent_map_erase(arg->m, CDC_FROM_INT(i)) != 1) {
+      ++arg->errors;
+    }
+  }
+
+  return NULL;
+}
+
+void test_concurrent_map_ctor()
+{
+  concurrent_map_t *m = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(concurrent_map_ctor(&m, &info), CDC_STATUS_OK);
+  CU_ASSERT(concurrent_map_empty(m));
+  concurrent_map_dtor(m);
+
+  CU_ASSERT_EQUAL(concurrent_map_ctor1(&m, &info, 5), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(concurrent_map_shard_count(m), 8);
+  CU_ASSERT_EQUAL(concurrent_map_size(m), 0);
+  for (size_t i = 0; i < concurrent_map_shard_count(m); ++i) {
+    CU_ASSERT_EQUAL((uintptr_t)&m->shards[i] % CDC_CACHE_LINE_SIZE, 0);
+    CU_ASSERT_EQUAL((uintptr_t)m->shards[i].shard.table % CDC_CACHE_LINE_SIZE, 0);
+  }
+  concurrent_map_dtor(m);
+
+  CU_ASSERT_EQUAL(concurrent_map_ctor1(&m, &info, 1), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(concurrent_map_shard_count(m), 1);
+  concurrent_map_dtor(m);
+}
+
+void test_concurrent_map_insert()
+{
+  concurrent_map_t *m = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  const int count = 1000;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(concurrent_map_ctor1(&m, &info, 16), CDC_STATUS_OK);
+  for (int i = 0; i < count; ++i) {
+    bool inserted = false;
+    CU_ASSERT_EQUAL(concurrent_map_insert(m, CDC_FROM_INT(i), CDC_FROM_INT(i), &inserted),
+                    CDC_STATUS_OK);
+    CU_ASSERT(inserted);
+  }
+
+  bool inserted = true;
+  CU_ASSERT_EQUAL(concurrent_map_insert(m, CDC_FROM_INT(1), CDC_FROM_INT(-1), &inserted),
+                  CDC_STATUS_OK);
+  CU_ASSERT(!inserted);
+  CU_ASSERT_EQUAL(concurrent_map_insert_or_assign(m, CDC_FROM_INT(1), CDC_FROM_INT(-1), &inserted),
+                  CDC_STATUS_OK);
+  CU_ASSERT(!inserted);
+  CU_ASSERT_EQUAL(concurrent_map_size(m), (size_t)count);
+
+  for (int i = 0; i < count; ++i) {
+    void *value = NULL;
+    CU_ASSERT_EQUAL(concurrent_map_get(m, CDC_FROM_INT(i), &value), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(CDC_TO_INT(value), i == 1 ? -1 : i);
+  }
+
+  void *value = NULL;
+  CU_ASSERT_EQUAL(concurrent_map_get(m, CDC_FROM_INT(count), &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(concurrent_map_count(m, CDC_FROM_INT(count)), 0);
+  CU_ASSERT_EQUAL(concurrent_map_count(m, CDC_FROM_INT(0)), 1);
+
+  for (int i = 0; i < count; i += 2) {
+    CU_ASSERT_EQUAL(concurrent_map_erase(m, CDC_FROM_INT(i)), 1);
+  }
+
+  CU_ASSERT_EQUAL(concurrent_map_erase(m, CDC_FROM_INT(0)), 0);
+  CU_ASSERT_EQUAL(concurrent_map_size(m), (size_t)count / 2);
+  concurrent_map_clear(m);
+  CU_ASSERT(concurrent_map_empty(m));
+  concurrent_map_dtor(m);
+}
+
+void test_concurrent_map_compute_if_absent()
+{
+  concurrent_map_t *m = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  int calls = 0;
+
+  CU_ASSERT_EQUAL(concurrent_map_ctor(&m, &info), CDC_STATUS_OK);
+  void *value = NULL;
+  bool inserted = false;
+  CU_ASSERT_EQUAL(
+      concurrent_map_compute_if_absent(m, CDC_FROM_INT(3), square, &calls, &value, &inserted),
+      CDC_STATUS_OK);
+  CU_ASSERT(inserted);
+  CU_ASSERT_EQUAL(CDC_TO_INT(value), 9);
+  CU_ASSERT_EQUAL(calls, 1);
+
+  CU_ASSERT_EQUAL(
+      concurrent_map_compute_if_absent(m, CDC_FROM_INT(3), square, &calls, &value, &inserted),
+      CDC_STATUS_OK);
+  CU_ASSERT(!inserted);
+  CU_ASSERT_EQUAL(CDC_TO_INT(value), 9);
+  CU_ASSERT_EQUAL(calls, 1);
+  CU_ASSERT_EQUAL(concurrent_map_compute_if_absent(m, CDC_FROM_INT(4), square, &calls, NULL, NULL),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(calls, 2);
+  CU_ASSERT_EQUAL(concurrent_map_size(m), 2);
+  concurrent_map_dtor(m);
+}
+
+void test_concurrent_map_foreach()
+{
+  concurrent_map_t *m = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  const int count = 100;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(concurrent_map_ctor1(&m, &info, 4), CDC_STATUS_OK);
+  for (int i = 1; i <= count; ++i) {
+    CU_ASSERT_EQUAL(concurrent_map_insert(m, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL),
+                    CDC_STATUS_OK);
+  }
+
+  int sum = 0;
+  concurrent_map_foreach(m, sum_values, &sum);
+  CU_ASSERT_EQUAL(sum, count * (count + 1) / 2);
+
+  int shards_sum = 0;
+  for (size_t i = 0; i < concurrent_map_shard_count(m); ++i) {
+    int shard_sum = 0;
+    concurrent_map_shard_foreach(m, i, sum_values, &shard_sum);
+    shards_sum += shard_sum;
+  }
+
+  CU_ASSERT_EQUAL(shards_sum, sum);
+  concurrent_map_dtor(m);
+}
+
+void test_concurrent_map_threads()
+{
+  concurrent_map_t *m = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  pthread_t threads[THREADS_COUNT];
+  struct worker_arg args[THREADS_COUNT];
+
+  CU_ASSERT_EQUAL(concurrent_map_ctor(&m, &info), CDC_STATUS_OK);
+  for (int i = 0; i < THREADS_COUNT; ++i) {
+    args[i].m = m;
+    args[i].id = i;
+    args[i].errors = 0;
+    CU_ASSERT_EQUAL(pthread_create(&threads[i], NULL, worker, &args[i]), 0);
+  }
+
+  for (int i = 0; i < THREADS_COUNT; ++i) {
+    CU_ASSERT_EQUAL(pthread_join(threads[i], NULL), 0);
+    CU_ASSERT_EQUAL(args[i].errors, 0);
+  }
+
+  CU_ASSERT_EQUAL(concurrent_map_size(m), THREADS_COUNT * KEYS_PER_THREAD / 2 + 99);
+  for (int i = 0; i < THREADS_COUNT * KEYS_PER_THREAD; ++i) {
+    CU_ASSERT_EQUAL(concurrent_map_count(m, CDC_FROM_INT(i)), (size_t)(i % 2));
+  }
+
+  concurrent_map_dtor(m);
+}
@@ -0,0 +1,155 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "test-common.h"
+
+#include "cdcontainers/casts.h"
+#include "cdcontainers/frozen-map.h"
+#include "cdcontainers/global.h"
+#include "cdcontainers/hash-table.h"
+
+#include <stdio.h>
+
+#include <CUnit/Basic.h>
+
+static size_t freed = 0;
+
+static int eq(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) == CDC_TO_INT(r);
+}
+
+static size_t hash(const void *val)
+{
+  return cdc_hash_int(CDC_TO_INT(val));
+}
+
+static void count_free(void *pair)
+{
+  CDC_UNUSED(pair);
+  ++freed;
+}
+
+static pair_t *make_pairs(int count, int step)
+{
+  pair_t *pairs = (pair_t *)malloc((size_t)count * sizeof(pair_t));
+  for (int i = 0; i < count; ++i) {
+    pairs[i].first = CDC_FROM_INT(i * step);
+    pairs[i].second = CDC_FROM_INT(-i);
+  }
+
+  return pairs;
+}
+
+void test_frozen_map_ctor()
+{
+  frozen_map_t *m = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  pair_t pair = {CDC_FROM_INT(5), CDC_FROM_INT(6)};
+
+  CU_ASSERT_EQUAL(frozen_map_ctor(&m, &info, NULL, 0), CDC_STATUS_OK);
+  CU_ASSERT(frozen_map_empty(m));
+  CU_ASSERT_EQUAL(frozen_map_count(m, CDC_FROM_INT(0)), 0);
+  frozen_map_dtor(m);
+
+  CU_ASSERT_EQUAL(frozen_map_ctor(&m, &info, &pair, 1), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(frozen_map_size(m), 1);
+  CU_ASSERT_EQUAL(frozen_map_count(m, CDC_FROM_INT(5)), 1);
+  CU_ASSERT_EQUAL(frozen_map_count(m, CDC_FROM_INT(6)), 0);
+  frozen_map_dtor(m);
+
+  pair_t pairs[] = {{CDC_FROM_INT(1), CDC_FROM_INT(1)},
+                    {CDC_FROM_INT(2), CDC_FROM_INT(2)},
+                    {CDC_FROM_INT(1), CDC_FROM_INT(3)}};
+  CU_ASSERT_EQUAL(frozen_map_ctor(&m, &info, pairs, CDC_ARRAY_SIZE(pairs)),
+                  CDC_STATUS_ALREADY_EXISTS);
+}
+
+void test_frozen_map_get()
+{
+  frozen_map_t *m = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  const int sizes[] = {2, 3, 17, 1000, 100000};
+
+  for (size_t k = 0; k < CDC_ARRAY_SIZE(sizes); ++k) {
+    int count = sizes[k];
+    pair_t *pairs = make_pairs(count, 3);
+    CU_ASSERT_EQUAL(frozen_map_ctor(&m, &info, pairs, (size_t)count), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(frozen_map_size(m), (size_t)count);
+    for (int i = 0; i < 3 * count; ++i) {
+      void *value = NULL;
+      if (i % 3 == 0) {
+        CU_ASSERT_EQUAL(frozen_map_get(m, CDC_FROM_INT(i), &value), CDC_STATUS_OK);
+        CU_ASSERT_EQUAL(CDC_TO_INT(value), -i / 3);
+      } else {
+        CU_ASSERT_EQUAL(frozen_map_get(m, CDC_FROM_INT(i), &value), CDC_STATUS_NOT_FOUND);
+      }
+    }
+
+    // Every element is stored exactly once.
+    long long sum = 0;
+    for (size_t i = 0; i < frozen_map_size(m); ++i) {
+      sum += CDC_TO_INT(frozen_map_key_at(m, i));
+      CU_ASSERT_EQUAL(-CDC_TO_INT(frozen_map_value_at(m, i)) * 3,
+                      CDC_TO_INT(frozen_map_key_at(m, i)));
+    }
+
+    CU_ASSERT_EQUAL(sum, 3LL * count * (count - 1) / 2);
+    frozen_map_dtor(m);
+    free(pairs);
+  }
+}
+
+void test_frozen_map_ctor_hash_table()
+{
+  hash_table_t *t = NULL;
+  frozen_map_t *m = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  const int count = 5000;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(hash_table_ctor(&t, &info), CDC_STATUS_OK);
+  for (int i = 0; i < count; ++i) {
+    CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i + 1), NULL, NULL),
+                    CDC_STATUS_OK);
+  }
+
+  // The frozen map owns the elements, so it frees them.
+  info.dfree = count_free;
+  CU_ASSERT_EQUAL(frozen_map_ctor_hash_table(&m, &info, t), CDC_STATUS_OK);
+  hash_table_dtor(t);
+  CU_ASSERT_EQUAL(frozen_map_size(m), (size_t)count);
+  for (int i = 0; i < count; ++i) {
+    void *value = NULL;
+    CU_ASSERT_EQUAL(frozen_map_get(m, CDC_FROM_INT(i), &value), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(CDC_TO_INT(value), i + 1);
+  }
+
+  CU_ASSERT_EQUAL(frozen_map_count(m, CDC_FROM_INT(count)), 0);
+  freed = 0;
+  frozen_map_dtor(m);
+  CU_ASSERT_EQUAL(freed, (size_t)count);
+}
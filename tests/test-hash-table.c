@@ -22,12 +22,15 @@
 #include "test-common.h"
 
 #include "cdcontainers/casts.h"
+#include "cdcontainers/global.h"
 #include "cdcontainers/hash-table.h"
 
 #include <assert.h>
 #include <float.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <CUnit/Basic.h>
 
@@ -60,6 +63,14 @@ static size_t hash1(const void *val)
   return cdc_hash_uint(CDC_TO_UINT(val));
 }
 
+static size_t eq_calls = 0;
+
+static int counting_eq(const void *l, const void *r)
+{
+  ++eq_calls;
+  return CDC_TO_INT(l) == CDC_TO_INT(r);
+}
+
 static bool hash_table_key_int_eq(hash_table_t *t, size_t count, ...)
 {
   va_list args;
@@ -372,3 +383,484 @@ void test_hash_table_reserve()
   CU_ASSERT((size_t)(hash_table_bucket_count(t) * cdc_hash_table_max_load_factor(t)) >= count);
   hash_table_dtor(t);
 }
+
+void test_hash_table_hashed()
+{
+  hash_table_t *t = NULL;
+  hash_table_iter_t it = CDC_INIT_STRUCT;
+  data_info_t info = CDC_INIT_STRUCT;
+  const int count = 64;
+  info.eq = counting_eq;
+  info.hash = hash;
+
+  // All keys are in one bucket, but eq must be called only for the matching key.
+  CU_ASSERT_EQUAL(hash_table_ctor1(&t, &info, 100.0), CDC_STATUS_OK);
+  size_t bcount = hash_table_bucket_count(t);
+  for (int i = 0; i < count; ++i) {
+    int key = i * (int)bcount;
+    CU_ASSERT_EQUAL(hash_table_insert_hashed(t, CDC_FROM_INT(key), hash(CDC_FROM_INT(key)),
+                                             CDC_FROM_INT(i), NULL, NULL),
+                    CDC_STATUS_OK);
+  }
+
+  CU_ASSERT_EQUAL(hash_table_bucket_count(t), bcount);
+  eq_calls = 0;
+  for (int i = 0; i < count; ++i) {
+    int key = i * (int)bcount;
+    void *value = NULL;
+    CU_ASSERT_EQUAL(hash_table_get_hashed(t, CDC_FROM_INT(key), hash(CDC_FROM_INT(key)), &value),
+                    CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(CDC_TO_INT(value), i);
+  }
+
+  CU_ASSERT_EQUAL(eq_calls, (size_t)count);
+  eq_calls = 0;
+  CU_ASSERT_EQUAL(hash_table_count_hashed(t, CDC_FROM_INT(1), hash(CDC_FROM_INT(1))), 0);
+  CU_ASSERT_EQUAL(hash_table_count(t, CDC_FROM_INT((count + 1) * (int)bcount)), 0);
+  CU_ASSERT_EQUAL(eq_calls, 0);
+
+  hash_table_find_hashed(t, CDC_FROM_INT(bcount), hash(CDC_FROM_INT(bcount)), &it);
+  CU_ASSERT_EQUAL(CDC_TO_INT(hash_table_iter_value(&it)), 1);
+
+  bool inserted = true;
+  CU_ASSERT_EQUAL(hash_table_insert_or_assign_hashed(t, CDC_FROM_INT(0), hash(CDC_FROM_INT(0)),
+                                                     CDC_FROM_INT(-1), &it, &inserted),
+                  CDC_STATUS_OK);
+  CU_ASSERT(!inserted);
+  CU_ASSERT_EQUAL(CDC_TO_INT(hash_table_iter_value(&it)), -1);
+
+  for (int i = 0; i < count; ++i) {
+    int key = i * (int)bcount;
+    CU_ASSERT_EQUAL(hash_table_erase_hashed(t, CDC_FROM_INT(key), hash(CDC_FROM_INT(key))), 1);
+  }
+
+  CU_ASSERT(hash_table_empty(t));
+  hash_table_dtor(t);
+}
+
+static bool hash_table_range_int_eq(hash_table_t *t, int from, int to, int step)
+{
+  size_t count = 0;
+  hash_table_iter_t it = CDC_INIT_STRUCT;
+  for (hash_table_begin(t, &it); hash_table_iter_has_next(&it); hash_table_iter_next(&it)) {
+    ++count;
+  }
+
+  if (count != hash_table_size(t)) {
+    return false;
+  }
+
+  for (int i = from; i < to; i += step) {
+    void *value = NULL;
+    if (hash_table_get(t, CDC_FROM_INT(i), &value) != CDC_STATUS_OK || CDC_TO_INT(value) != i) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void test_hash_table_incremental_rehash()
+{
+  hash_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  const int count = 10000;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(hash_table_ctor2(&t, &info, 1.0, CDC_HASH_TABLE_INCREMENTAL_REHASH),
+                  CDC_STATUS_OK);
+  bool was_migrating = false;
+  for (int i = 0; i < count; ++i) {
+    size_t bcount = hash_table_bucket_count(t);
+    CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                    CDC_STATUS_OK);
+    if (bcount != hash_table_bucket_count(t) && bcount >= 64) {
+      // Only a few buckets are moved by the insertion that grows the table.
+      CU_ASSERT(t->old_buckets != NULL);
+      CU_ASSERT(hash_table_range_int_eq(t, 0, i + 1, 1));
+      was_migrating = true;
+    }
+  }
+
+  CU_ASSERT(was_migrating);
+  CU_ASSERT_EQUAL(hash_table_size(t), (size_t)count);
+  CU_ASSERT(hash_table_range_int_eq(t, 0, count, 1));
+
+  for (int i = 0; i < count; i += 2) {
+    CU_ASSERT_EQUAL(hash_table_erase(t, CDC_FROM_INT(i)), 1);
+  }
+
+  CU_ASSERT_EQUAL(hash_table_size(t), (size_t)count / 2);
+  CU_ASSERT(hash_table_range_int_eq(t, 1, count, 2));
+  for (int i = 0; i < count; i += 2) {
+    CU_ASSERT_EQUAL(hash_table_count(t, CDC_FROM_INT(i)), 0);
+  }
+
+  // Growing by rehash finishes the pending migration.
+  CU_ASSERT_EQUAL(hash_table_reserve(t, (size_t)count * 4), CDC_STATUS_OK);
+  CU_ASSERT(t->old_buckets == NULL);
+  CU_ASSERT(hash_table_range_int_eq(t, 1, count, 2));
+
+  hash_table_clear(t);
+  CU_ASSERT(hash_table_empty(t));
+  CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(1), CDC_FROM_INT(1), NULL, NULL),
+                  CDC_STATUS_OK);
+  CU_ASSERT(hash_table_range_int_eq(t, 1, 2, 1));
+  hash_table_dtor(t);
+}
+
+static size_t freed = 0;
+
+static void count_free(void *pair)
+{
+  CDC_UNUSED(pair);
+  ++freed;
+}
+
+void test_hash_table_node_pool()
+{
+  const int flags[] = {CDC_HASH_TABLE_NODE_POOL,
+                       CDC_HASH_TABLE_NODE_POOL | CDC_HASH_TABLE_INCREMENTAL_REHASH};
+  const int count = 5000;
+  for (size_t f = 0; f < CDC_ARRAY_SIZE(flags); ++f) {
+    hash_table_t *t = NULL;
+    data_info_t info = CDC_INIT_STRUCT;
+    info.eq = eq;
+    info.hash = hash;
+    info.dfree = count_free;
+    freed = 0;
+
+    CU_ASSERT_EQUAL(hash_table_ctor2(&t, &info, 1.0, flags[f]), CDC_STATUS_OK);
+    for (int round = 0; round < 3; ++round) {
+      for (int i = 0; i < count; ++i) {
+        CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                        CDC_STATUS_OK);
+      }
+
+      // Erased entries are reused by the following insertions.
+      for (int i = 0; i < count; i += 2) {
+        CU_ASSERT_EQUAL(hash_table_erase(t, CDC_FROM_INT(i)), 1);
+      }
+
+      CU_ASSERT(hash_table_range_int_eq(t, 1, count, 2));
+    }
+
+    CU_ASSERT_EQUAL(freed, (size_t)(count / 2 * 3));
+    hash_table_clear(t);
+    CU_ASSERT_EQUAL(freed, (size_t)(count / 2 * 4));
+    CU_ASSERT(hash_table_empty(t));
+
+    hash_table_iter_t it1 = CDC_INIT_STRUCT;
+    hash_table_iter_t it2 = CDC_INIT_STRUCT;
+    CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(1), CDC_FROM_INT(1), &it1, NULL),
+                    CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(2), CDC_FROM_INT(2), &it2, NULL),
+                    CDC_STATUS_OK);
+    // Entries inserted one after another are adjacent in memory.
+    CU_ASSERT_EQUAL((char *)it2.current - (char *)it1.current,
+                    (ptrdiff_t)sizeof(hash_table_entry_t));
+    CU_ASSERT(hash_table_range_int_eq(t, 1, 3, 1));
+    hash_table_dtor(t);
+    CU_ASSERT_EQUAL(freed, (size_t)(count / 2 * 4 + 2));
+  }
+}
+
+void test_hash_table_small()
+{
+  const int flags[] = {CDC_HASH_TABLE_SMALL, CDC_HASH_TABLE_SMALL | CDC_HASH_TABLE_NODE_POOL,
+                       CDC_HASH_TABLE_SMALL | CDC_HASH_TABLE_INCREMENTAL_REHASH,
+                       CDC_HASH_TABLE_SMALL | CDC_HASH_TABLE_CACHE_ALIGNED};
+  const int count = CDC_HASH_TABLE_SMALL_SIZE;
+  for (size_t f = 0; f < CDC_ARRAY_SIZE(flags); ++f) {
+    hash_table_t *t = NULL;
+    hash_table_t *w = NULL;
+    data_info_t info = CDC_INIT_STRUCT;
+    info.eq = eq;
+    info.hash = hash;
+    info.dfree = count_free;
+    freed = 0;
+
+    CU_ASSERT_EQUAL(hash_table_ctor2(&t, &info, 0.7, flags[f]), CDC_STATUS_OK);
+    for (int i = 0; i < count; ++i) {
+      CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                      CDC_STATUS_OK);
+    }
+
+    CU_ASSERT_EQUAL(hash_table_bucket_count(t), 1);
+    CU_ASSERT_EQUAL(hash_table_bucket_size(t, 0), (size_t)count);
+    // The entries are stored in the block of the table.
+    CU_ASSERT(hash_table_memory_usage(t).bytes >=
+              sizeof(hash_table_t) + count * sizeof(hash_table_entry_t));
+    CU_ASSERT(hash_table_range_int_eq(t, 0, count, 1));
+    CU_ASSERT_EQUAL(hash_table_count(t, CDC_FROM_INT(count)), 0);
+
+    // Erased places are reused and the order of insertion is kept.
+    CU_ASSERT_EQUAL(hash_table_erase(t, CDC_FROM_INT(3)), 1);
+    CU_ASSERT_EQUAL(hash_table_erase(t, CDC_FROM_INT(3)), 0);
+    CU_ASSERT_EQUAL(hash_table_erase(t, CDC_FROM_INT(count - 1)), 1);
+    CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(count - 1), CDC_FROM_INT(count - 1), NULL,
+                                      NULL),
+                    CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(3), CDC_FROM_INT(3), NULL, NULL),
+                    CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(freed, 2);
+    CU_ASSERT_EQUAL(hash_table_bucket_count(t), 1);
+    CU_ASSERT(hash_table_range_int_eq(t, 0, count, 1));
+
+    hash_table_iter_t it = CDC_INIT_STRUCT;
+    hash_table_begin(t, &it);
+    for (int i = 0; i < count - 2; ++i) {
+      hash_table_iter_next(&it);
+    }
+
+    CU_ASSERT_EQUAL(CDC_TO_INT(hash_table_iter_key(&it)), count - 1);
+    hash_table_iter_next(&it);
+    CU_ASSERT_EQUAL(CDC_TO_INT(hash_table_iter_key(&it)), 3);
+
+    // A small table is swapped with a small and with a large one.
+    CU_ASSERT_EQUAL(hash_table_ctor2(&w, &info, 0.7, CDC_HASH_TABLE_SMALL), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(hash_table_insert(w, CDC_FROM_INT(-1), CDC_FROM_INT(-1), NULL, NULL),
+                    CDC_STATUS_OK);
+    hash_table_swap(t, w);
+    CU_ASSERT(hash_table_key_int_eq(t, 1, &(pair_t){CDC_FROM_INT(-1), CDC_FROM_INT(-1)}));
+    CU_ASSERT(hash_table_range_int_eq(w, 0, count, 1));
+    hash_table_swap(t, w);
+    CU_ASSERT(hash_table_range_int_eq(t, 0, count, 1));
+
+    // The table is moved to the buckets when it grows larger.
+    for (int i = count; i < 4 * count; ++i) {
+      CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                      CDC_STATUS_OK);
+    }
+
+    CU_ASSERT(hash_table_bucket_count(t) > 1);
+    CU_ASSERT(hash_table_range_int_eq(t, 0, 4 * count, 1));
+    hash_table_swap(t, w);
+    CU_ASSERT(hash_table_range_int_eq(w, 0, 4 * count, 1));
+    CU_ASSERT_EQUAL(hash_table_size(t), 1);
+    CU_ASSERT_EQUAL(hash_table_erase(t, CDC_FROM_INT(-1)), 1);
+    CU_ASSERT_EQUAL(freed, 3);
+    CU_ASSERT_EQUAL(hash_table_reserve(t, count), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(hash_table_bucket_count(t), 1);
+    CU_ASSERT_EQUAL(hash_table_reserve(t, 2 * count), CDC_STATUS_OK);
+    CU_ASSERT(hash_table_bucket_count(t) >= (size_t)(2 * count));
+
+    hash_table_clear(w);
+    CU_ASSERT_EQUAL(freed, (size_t)(4 * count + 3));
+    hash_table_dtor(w);
+    hash_table_dtor(t);
+  }
+
+  hash_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  info.dfree = count_free;
+  freed = 0;
+  CU_ASSERT_EQUAL(hash_table_ctor2(&t, &info, 0.7, CDC_HASH_TABLE_SMALL), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(1), CDC_FROM_INT(1), NULL, NULL),
+                  CDC_STATUS_OK);
+  hash_table_clear(t);
+  CU_ASSERT(hash_table_empty(t));
+  CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(2), CDC_FROM_INT(2), NULL, NULL),
+                  CDC_STATUS_OK);
+  hash_table_dtor(t);
+  CU_ASSERT_EQUAL(freed, 2);
+}
+
+// Hashes of different keys have equal low halves and differ in the high halves.
+static size_t high_half_hash(const void *val)
+{
+  return ((size_t)CDC_TO_INT(val) << (sizeof(size_t) * 4)) | 1;
+}
+
+// Hashes of different keys have equal high halves and differ in the low halves.
+static size_t low_half_hash(const void *val)
+{
+  return (size_t)CDC_TO_INT(val) | ((size_t)1 << (sizeof(size_t) * 4));
+}
+
+void test_hash_table_small_hashes()
+{
+  cdc_hash_fn_t hashes[] = {high_half_hash, low_half_hash};
+  const int count = CDC_HASH_TABLE_SMALL_SIZE;
+  for (size_t h = 0; h < CDC_ARRAY_SIZE(hashes); ++h) {
+    hash_table_t *t = NULL;
+    void *value = NULL;
+    data_info_t info = CDC_INIT_STRUCT;
+    info.eq = counting_eq;
+    info.hash = hashes[h];
+
+    CU_ASSERT_EQUAL(hash_table_ctor2(&t, &info, 0.7, CDC_HASH_TABLE_SMALL), CDC_STATUS_OK);
+    for (int i = 0; i < count; ++i) {
+      CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                      CDC_STATUS_OK);
+    }
+
+    // Only the entry with an equal hash is compared with the key.
+    CU_ASSERT_EQUAL(hash_table_bucket_count(t), 1);
+    for (int i = 0; i < count; ++i) {
+      eq_calls = 0;
+      CU_ASSERT_EQUAL(hash_table_get(t, CDC_FROM_INT(i), &value), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(CDC_TO_INT(value), i);
+      CU_ASSERT_EQUAL(eq_calls, 1);
+    }
+
+    eq_calls = 0;
+    CU_ASSERT_EQUAL(hash_table_get(t, CDC_FROM_INT(count), &value), CDC_STATUS_NOT_FOUND);
+    CU_ASSERT_EQUAL(eq_calls, 0);
+    hash_table_dtor(t);
+  }
+}
+
+static void bucket_stats(hash_table_t *t, size_t *used, size_t *max)
+{
+  size_t total = 0;
+  *used = 0;
+  *max = 0;
+  for (size_t i = 0; i < hash_table_bucket_count(t); ++i) {
+    size_t size = hash_table_bucket_size(t, i);
+    *used += size != 0;
+    *max = CDC_MAX(*max, size);
+    total += size;
+  }
+
+  CU_ASSERT_EQUAL(total, hash_table_size(t));
+}
+
+void test_hash_table_mix_hash()
+{
+  const int count = 4096;
+  const int flags[] = {0, CDC_HASH_TABLE_MIX_HASH,
+                       CDC_HASH_TABLE_MIX_HASH | CDC_HASH_TABLE_INCREMENTAL_REHASH};
+  for (size_t f = 0; f < CDC_ARRAY_SIZE(flags); ++f) {
+    hash_table_t *ints = NULL;
+    hash_table_t *ptrs = NULL;
+    data_info_t info = CDC_INIT_STRUCT;
+    info.eq = eq;
+    info.hash = hash;
+
+    CU_ASSERT_EQUAL(hash_table_ctor2(&ints, &info, 1.0, flags[f]), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(hash_table_ctor2(&ptrs, &info, 1.0, flags[f]), CDC_STATUS_OK);
+    for (int i = 0; i < count; ++i) {
+      // Sequential integers and 16-byte aligned pointer-like values.
+      CU_ASSERT_EQUAL(hash_table_insert(ints, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                      CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(hash_table_insert(ptrs, CDC_FROM_INT(i * 16), CDC_FROM_INT(i), NULL, NULL),
+                      CDC_STATUS_OK);
+    }
+
+    size_t used = 0;
+    size_t max = 0;
+    size_t bcount = hash_table_bucket_count(ptrs);
+    bucket_stats(ptrs, &used, &max);
+    if (flags[f] & CDC_HASH_TABLE_MIX_HASH) {
+      // About 1 - 1/e of the buckets are used when keys are spread uniformly.
+      CU_ASSERT(used > bcount / 2);
+      CU_ASSERT(max < 16);
+    } else {
+      CU_ASSERT(used <= bcount / 16);
+      CU_ASSERT(max >= 16);
+    }
+
+    bucket_stats(ints, &used, &max);
+    CU_ASSERT(used > hash_table_bucket_count(ints) / 2);
+    CU_ASSERT(max < 16);
+
+    void *value = NULL;
+    CU_ASSERT_EQUAL(hash_table_get(ptrs, CDC_FROM_INT(16 * 100), &value), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(CDC_TO_INT(value), 100);
+    void *key = CDC_FROM_INT(16 * 100);
+    CU_ASSERT_EQUAL(hash_table_get_hashed(ptrs, key, hash(key), &value), CDC_STATUS_OK);
+    hash_table_dtor(ints);
+    hash_table_dtor(ptrs);
+  }
+}
+
+void test_hash_table_get_many()
+{
+  hash_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  enum { count = 1001 };
+  info.eq = eq;
+  info.hash = hash;
+
+  // The incremental table is looked up both in the middle of a migration and
+  // after it, so keys are resolved from old and new buckets.
+  CU_ASSERT_EQUAL(hash_table_ctor2(&t, &info, 1.0, CDC_HASH_TABLE_INCREMENTAL_REHASH),
+                  CDC_STATUS_OK);
+  void *keys[2 * count];
+  void *values[2 * count];
+  bool found[2 * count];
+  for (int i = 0; i < 2 * count; ++i) {
+    keys[i] = CDC_FROM_INT(i);
+  }
+
+  CU_ASSERT_EQUAL(hash_table_get_many(t, keys, 2 * count, values, found), 0);
+  for (int i = 0; i < count; ++i) {
+    CU_ASSERT_EQUAL(hash_table_insert(t, CDC_FROM_INT(2 * i), CDC_FROM_INT(-i), NULL, NULL),
+                    CDC_STATUS_OK);
+  }
+
+  for (int k = 0; k < 2; ++k) {
+    for (int i = 0; i < 2 * count; ++i) {
+      values[i] = NULL;
+    }
+
+    CU_ASSERT_EQUAL(hash_table_get_many(t, keys, 2 * count, values, found), (size_t)count);
+    for (int i = 0; i < 2 * count; ++i) {
+      CU_ASSERT_EQUAL(found[i], i % 2 == 0);
+      CU_ASSERT_EQUAL(CDC_TO_INT(values[i]), i % 2 == 0 ? -i / 2 : 0);
+    }
+
+    CU_ASSERT_EQUAL(hash_table_rehash(t, (size_t)count * 4), CDC_STATUS_OK);
+  }
+
+  CU_ASSERT_EQUAL(hash_table_get_many(t, keys + 1, 1, values, found), 0);
+  CU_ASSERT_EQUAL(hash_table_get_many(t, NULL, 0, NULL, NULL), 0);
+  hash_table_dtor(t);
+}
+
+static int str_eq(const void *l, const void *r)
+{
+  return strcmp((const char *)l, (const char *)r) == 0;
+}
+
+void test_hash_table_get_probe()
+{
+  hash_table_t *t = NULL;
+  hash_table_iter_t it = CDC_INIT_STRUCT;
+  hash_table_iter_t it_end = CDC_INIT_STRUCT;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = str_eq;
+  info.hash = cdc_pdhash_str;
+  const char *buf = "alpha beta gamma betamax";
+  void *value = NULL;
+
+  CU_ASSERT_EQUAL(hash_table_ctor(&t, &info), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(hash_table_insert(t, "alpha", CDC_FROM_INT(1), NULL, NULL), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(hash_table_insert(t, "beta", CDC_FROM_INT(2), NULL, NULL), CDC_STATUS_OK);
+
+  str_view_t alpha = str_view_make(buf, 5);
+  str_view_t beta = str_view_make(buf + 6, 4);
+  str_view_t gamma = str_view_make(buf + 11, 5);
+  str_view_t betamax = str_view_make(buf + 17, 7);
+  str_view_t bet = str_view_make(buf + 6, 3);
+  CU_ASSERT_EQUAL(hash_table_get_probe(t, &alpha, cdc_str_view_probe, &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(CDC_TO_INT(value), 1);
+  CU_ASSERT_EQUAL(hash_table_get_probe(t, &beta, cdc_str_view_probe, &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(CDC_TO_INT(value), 2);
+  CU_ASSERT_EQUAL(hash_table_get_probe(t, &gamma, cdc_str_view_probe, &value),
+                  CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(hash_table_count_probe(t, &beta, cdc_str_view_probe), 1);
+  CU_ASSERT_EQUAL(hash_table_count_probe(t, &betamax, cdc_str_view_probe), 0);
+  CU_ASSERT_EQUAL(hash_table_count_probe(t, &bet, cdc_str_view_probe), 0);
+
+  hash_table_find_probe(t, &alpha, cdc_str_view_probe, &it);
+  CU_ASSERT_EQUAL(strcmp((const char *)hash_table_iter_key(&it), "alpha"), 0);
+  hash_table_find_probe(t, &gamma, cdc_str_view_probe, &it);
+  hash_table_end(t, &it_end);
+  CU_ASSERT(hash_table_iter_is_eq(&it, &it_end));
+  hash_table_dtor(t);
+}
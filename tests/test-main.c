@@ -41,7 +41,12 @@ int main(int argc, char** argv)
   }
 
   if (CU_add_test(p_suite, "ptr_float_cast", test_ptr_float_cast) == NULL ||
-      CU_add_test(p_suite, "ptr_double_cast", test_ptr_double_cast) == NULL) {
+      CU_add_test(p_suite, "ptr_double_cast", test_ptr_double_cast) == NULL ||
+      CU_add_test(p_suite, "hash_bytes", test_hash_bytes) == NULL ||
+      CU_add_test(p_suite, "hash_str", test_hash_str) == NULL ||
+      CU_add_test(p_suite, "hash_mix", test_hash_mix) == NULL ||
+      CU_add_test(p_suite, "allocator", test_allocator) == NULL ||
+      CU_add_test(p_suite, "shared_data_info", test_shared_data_info) == NULL) {
     CU_cleanup_registry();
     return CU_get_error();
   }
@@ -67,7 +72,9 @@ int main(int argc, char** argv)
       CU_add_test(p_suite, "test_push_back", test_array_push_back) == NULL ||
       CU_add_test(p_suite, "test_pop_back", test_array_pop_back) == NULL ||
       CU_add_test(p_suite, "test_swap", test_array_swap) == NULL ||
-      CU_add_test(p_suite, "test_shrink_to_fit", test_array_shrink_to_fit) == NULL) {
+      CU_add_test(p_suite, "test_shrink_to_fit", test_array_shrink_to_fit) == NULL ||
+      CU_add_test(p_suite, "test_growth_policy", test_array_growth_policy) == NULL ||
+      CU_add_test(p_suite, "test_memory_usage", test_array_memory_usage) == NULL) {
     CU_cleanup_registry();
     return CU_get_error();
   }
@@ -278,11 +285,20 @@ int main(int argc, char** argv)
       CU_add_test(p_suite, "test_insert_or_assign", test_treap_insert_or_assign) == NULL ||
       CU_add_test(p_suite, "test_erase", test_treap_erase) == NULL ||
       CU_add_test(p_suite, "test_iterators", test_treap_iterators) == NULL ||
-      CU_add_test(p_suite, "test_height", test_treap_height) == NULL) {
+      CU_add_test(p_suite, "test_height", test_treap_height) == NULL ||
+      CU_add_test(p_suite, "test_ctor_sorted", test_treap_ctor_sorted) == NULL ||
+      CU_add_test(p_suite, "test_bounds", test_treap_bounds) == NULL) {
     CU_cleanup_registry();
     return CU_get_error();
   }
 
+#ifdef CDC_ORDER_STATISTICS
+  if (CU_add_test(p_suite, "test_select_rank", test_treap_select_rank) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+#endif
+
   p_suite = CU_add_suite("HASH TABLE TESTS", NULL, NULL);
   if (p_suite == NULL) {
     CU_cleanup_registry();
@@ -300,7 +316,123 @@ int main(int argc, char** argv)
       CU_add_test(p_suite, "test_erase", test_hash_table_erase) == NULL ||
       CU_add_test(p_suite, "test_swap", test_hash_table_swap) == NULL ||
       CU_add_test(p_suite, "test_rehash", test_hash_table_rehash) == NULL ||
-      CU_add_test(p_suite, "test_reserve", test_hash_table_reserve) == NULL) {
+      CU_add_test(p_suite, "test_reserve", test_hash_table_reserve) == NULL ||
+      CU_add_test(p_suite, "test_hashed", test_hash_table_hashed) == NULL ||
+      CU_add_test(p_suite, "test_incremental_rehash", test_hash_table_incremental_rehash) ==
+          NULL ||
+      CU_add_test(p_suite, "test_node_pool", test_hash_table_node_pool) == NULL ||
+      CU_add_test(p_suite, "test_mix_hash", test_hash_table_mix_hash) == NULL ||
+      CU_add_test(p_suite, "test_get_many", test_hash_table_get_many) == NULL ||
+      CU_add_test(p_suite, "test_get_probe", test_hash_table_get_probe) == NULL ||
+      CU_add_test(p_suite, "test_small", test_hash_table_small) == NULL ||
+      CU_add_test(p_suite, "test_small_hashes", test_hash_table_small_hashes) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  p_suite = CU_add_suite("FLAT HASH TABLE TESTS", NULL, NULL);
+  if (p_suite == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (CU_add_test(p_suite, "test_ctor", test_flat_hash_table_ctor) == NULL ||
+      CU_add_test(p_suite, "test_ctorl", test_flat_hash_table_ctorl) == NULL ||
+      CU_add_test(p_suite, "test_get", test_flat_hash_table_get) == NULL ||
+      CU_add_test(p_suite, "test_count", test_flat_hash_table_count) == NULL ||
+      CU_add_test(p_suite, "test_find", test_flat_hash_table_find) == NULL ||
+      CU_add_test(p_suite, "test_clear", test_flat_hash_table_clear) == NULL ||
+      CU_add_test(p_suite, "test_insert", test_flat_hash_table_insert) == NULL ||
+      CU_add_test(p_suite, "test_insert_or_assign", test_flat_hash_table_insert_or_assign) ==
+          NULL ||
+      CU_add_test(p_suite, "test_erase", test_flat_hash_table_erase) == NULL ||
+      CU_add_test(p_suite, "test_swap", test_flat_hash_table_swap) == NULL ||
+      CU_add_test(p_suite, "test_rehash", test_flat_hash_table_rehash) == NULL ||
+      CU_add_test(p_suite, "test_reserve", test_flat_hash_table_reserve) == NULL ||
+      CU_add_test(p_suite, "test_iterators", test_flat_hash_table_iterators) == NULL ||
+      CU_add_test(p_suite, "test_many", test_flat_hash_table_many) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  p_suite = CU_add_suite("BLOOM FILTER TESTS", NULL, NULL);
+  if (p_suite == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (CU_add_test(p_suite, "test_ctor", test_bloom_filter_ctor) == NULL ||
+      CU_add_test(p_suite, "test_add", test_bloom_filter_add) == NULL ||
+      CU_add_test(p_suite, "test_fp_rate", test_bloom_filter_fp_rate) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  p_suite = CU_add_suite("FROZEN MAP TESTS", NULL, NULL);
+  if (p_suite == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (CU_add_test(p_suite, "test_ctor", test_frozen_map_ctor) == NULL ||
+      CU_add_test(p_suite, "test_get", test_frozen_map_get) == NULL ||
+      CU_add_test(p_suite, "test_ctor_hash_table", test_frozen_map_ctor_hash_table) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  p_suite = CU_add_suite("CONCURRENT MAP TESTS", NULL, NULL);
+  if (p_suite == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (CU_add_test(p_suite, "test_ctor", test_concurrent_map_ctor) == NULL ||
+      CU_add_test(p_suite, "test_insert", test_concurrent_map_insert) == NULL ||
+      CU_add_test(p_suite, "test_compute_if_absent", test_concurrent_map_compute_if_absent) ==
+          NULL ||
+      CU_add_test(p_suite, "test_foreach", test_concurrent_map_foreach) == NULL ||
+      CU_add_test(p_suite, "test_threads", test_concurrent_map_threads) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  p_suite = CU_add_suite("RCU HASH TABLE TESTS", NULL, NULL);
+  if (p_suite == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (CU_add_test(p_suite, "test_ctor", test_rcu_hash_table_ctor) == NULL ||
+      CU_add_test(p_suite, "test_insert", test_rcu_hash_table_insert) == NULL ||
+      CU_add_test(p_suite, "test_reclaim", test_rcu_hash_table_reclaim) == NULL ||
+      CU_add_test(p_suite, "test_threads", test_rcu_hash_table_threads) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  p_suite = CU_add_suite("ROBIN HOOD TABLE TESTS", NULL, NULL);
+  if (p_suite == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (CU_add_test(p_suite, "test_ctor", test_robin_hood_table_ctor) == NULL ||
+      CU_add_test(p_suite, "test_ctorl", test_robin_hood_table_ctorl) == NULL ||
+      CU_add_test(p_suite, "test_get", test_robin_hood_table_get) == NULL ||
+      CU_add_test(p_suite, "test_count", test_robin_hood_table_count) == NULL ||
+      CU_add_test(p_suite, "test_find", test_robin_hood_table_find) == NULL ||
+      CU_add_test(p_suite, "test_clear", test_robin_hood_table_clear) == NULL ||
+      CU_add_test(p_suite, "test_insert", test_robin_hood_table_insert) == NULL ||
+      CU_add_test(p_suite, "test_insert_or_assign", test_robin_hood_table_insert_or_assign) ==
+          NULL ||
+      CU_add_test(p_suite, "test_erase", test_robin_hood_table_erase) == NULL ||
+      CU_add_test(p_suite, "test_swap", test_robin_hood_table_swap) == NULL ||
+      CU_add_test(p_suite, "test_rehash", test_robin_hood_table_rehash) == NULL ||
+      CU_add_test(p_suite, "test_reserve", test_robin_hood_table_reserve) == NULL ||
+      CU_add_test(p_suite, "test_iterators", test_robin_hood_table_iterators) == NULL ||
+      CU_add_test(p_suite, "test_many", test_robin_hood_table_many) == NULL ||
+      CU_add_test(p_suite, "test_probe_length", test_robin_hood_table_probe_length) == NULL) {
     CU_cleanup_registry();
     return CU_get_error();
   }
@@ -322,7 +454,9 @@ int main(int argc, char** argv)
       CU_add_test(p_suite, "test_insert_or_assign", test_splay_tree_insert_or_assign) == NULL ||
       CU_add_test(p_suite, "test_erase", test_splay_tree_erase) == NULL ||
       CU_add_test(p_suite, "test_iterators", test_splay_tree_iterators) == NULL ||
-      CU_add_test(p_suite, "test_height", test_splay_tree_height) == NULL) {
+      CU_add_test(p_suite, "test_height", test_splay_tree_height) == NULL ||
+      CU_add_test(p_suite, "test_ctor_sorted", test_splay_tree_ctor_sorted) == NULL ||
+      CU_add_test(p_suite, "test_bounds", test_splay_tree_bounds) == NULL) {
     CU_cleanup_registry();
     return CU_get_error();
   }
@@ -343,8 +477,67 @@ int main(int argc, char** argv)
       CU_add_test(p_suite, "test_clear", test_avl_tree_clear) == NULL ||
       CU_add_test(p_suite, "test_insert_or_assign", test_avl_tree_insert_or_assign) == NULL ||
       CU_add_test(p_suite, "test_erase", test_avl_tree_erase) == NULL ||
+      CU_add_test(p_suite, "test_erase_successor", test_avl_tree_erase_successor) == NULL ||
       CU_add_test(p_suite, "test_iterators", test_avl_tree_iterators) == NULL ||
-      CU_add_test(p_suite, "test_height", test_avl_tree_height) == NULL) {
+      CU_add_test(p_suite, "test_height", test_avl_tree_height) == NULL ||
+      CU_add_test(p_suite, "test_ctor_sorted", test_avl_tree_ctor_sorted) == NULL ||
+      CU_add_test(p_suite, "test_bounds", test_avl_tree_bounds) == NULL ||
+      CU_add_test(p_suite, "test_random", test_avl_tree_random) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+#ifdef CDC_ORDER_STATISTICS
+  if (CU_add_test(p_suite, "test_select_rank", test_avl_tree_select_rank) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+#endif
+
+  p_suite = CU_add_suite("B+ TREE TESTS", NULL, NULL);
+  if (p_suite == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (CU_add_test(p_suite, "test_ctor", test_btree_ctor) == NULL ||
+      CU_add_test(p_suite, "test_ctorl", test_btree_ctorl) == NULL ||
+      CU_add_test(p_suite, "test_insert", test_btree_insert) == NULL ||
+      CU_add_test(p_suite, "test_swap", test_btree_swap) == NULL ||
+      CU_add_test(p_suite, "test_get", test_btree_get) == NULL ||
+      CU_add_test(p_suite, "test_count", test_btree_count) == NULL ||
+      CU_add_test(p_suite, "test_find", test_btree_find) == NULL ||
+      CU_add_test(p_suite, "test_clear", test_btree_clear) == NULL ||
+      CU_add_test(p_suite, "test_insert_or_assign", test_btree_insert_or_assign) == NULL ||
+      CU_add_test(p_suite, "test_erase", test_btree_erase) == NULL ||
+      CU_add_test(p_suite, "test_iterators", test_btree_iterators) == NULL ||
+      CU_add_test(p_suite, "test_random", test_btree_random) == NULL ||
+      CU_add_test(p_suite, "test_bounds", test_btree_bounds) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  p_suite = CU_add_suite("RED-BLACK TREE TESTS", NULL, NULL);
+  if (p_suite == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (CU_add_test(p_suite, "test_ctor", test_rb_tree_ctor) == NULL ||
+      CU_add_test(p_suite, "test_ctorl", test_rb_tree_ctorl) == NULL ||
+      CU_add_test(p_suite, "test_insert", test_rb_tree_insert) == NULL ||
+      CU_add_test(p_suite, "test_swap", test_rb_tree_swap) == NULL ||
+      CU_add_test(p_suite, "test_get", test_rb_tree_get) == NULL ||
+      CU_add_test(p_suite, "test_count", test_rb_tree_count) == NULL ||
+      CU_add_test(p_suite, "test_find", test_rb_tree_find) == NULL ||
+      CU_add_test(p_suite, "test_clear", test_rb_tree_clear) == NULL ||
+      CU_add_test(p_suite, "test_insert_or_assign", test_rb_tree_insert_or_assign) == NULL ||
+      CU_add_test(p_suite, "test_erase", test_rb_tree_erase) == NULL ||
+      CU_add_test(p_suite, "test_iterators", test_rb_tree_iterators) == NULL ||
+      CU_add_test(p_suite, "test_height", test_rb_tree_height) == NULL ||
+      CU_add_test(p_suite, "test_random", test_rb_tree_random) == NULL ||
+      CU_add_test(p_suite, "test_ctor_sorted", test_rb_tree_ctor_sorted) == NULL ||
+      CU_add_test(p_suite, "test_bounds", test_rb_tree_bounds) == NULL) {
     CU_cleanup_registry();
     return CU_get_error();
   }
@@ -360,13 +553,34 @@ int main(int argc, char** argv)
       CU_add_test(p_suite, "test_insert", test_map_insert) == NULL ||
       CU_add_test(p_suite, "test_swap", test_map_swap) == NULL ||
       CU_add_test(p_suite, "test_get", test_map_get) == NULL ||
+      CU_add_test(p_suite, "test_get_many", test_map_get_many) == NULL ||
       CU_add_test(p_suite, "test_count", test_map_count) == NULL ||
       CU_add_test(p_suite, "test_find", test_map_find) == NULL ||
+      CU_add_test(p_suite, "test_probe", test_map_probe) == NULL ||
       CU_add_test(p_suite, "test_clear", test_map_clear) == NULL ||
       CU_add_test(p_suite, "test_insert_or_assign", test_map_insert_or_assign) == NULL ||
       CU_add_test(p_suite, "test_erase", test_map_erase) == NULL ||
       CU_add_test(p_suite, "test_iterators", test_map_iterators) == NULL ||
-      CU_add_test(p_suite, "test_iter_type", test_map_iter_type) == NULL) {
+      CU_add_test(p_suite, "test_iter_type", test_map_iter_type) == NULL ||
+      CU_add_test(p_suite, "test_filter", test_map_filter) == NULL ||
+      CU_add_test(p_suite, "test_filter_churn", test_map_filter_churn) == NULL ||
+      CU_add_test(p_suite, "test_memory_usage", test_map_memory_usage) == NULL ||
+      CU_add_test(p_suite, "test_ctor_sorted", test_map_ctor_sorted) == NULL ||
+      CU_add_test(p_suite, "test_bounds", test_map_bounds) == NULL ||
+      CU_add_test(p_suite, "test_select_rank", test_map_select_rank) == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  p_suite = CU_add_suite("ARENA TESTS", NULL, NULL);
+  if (p_suite == NULL) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (CU_add_test(p_suite, "test_alloc", test_arena_alloc) == NULL ||
+      CU_add_test(p_suite, "test_realloc", test_arena_realloc) == NULL ||
+      CU_add_test(p_suite, "test_containers", test_arena_containers) == NULL) {
     CU_cleanup_registry();
     return CU_get_error();
   }
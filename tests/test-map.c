@@ -26,6 +26,7 @@
 
 #include <float.h>
 #include <stdarg.h>
+#include <string.h>
 
 #include <CUnit/Basic.h>
 
@@ -72,7 +73,9 @@ static bool map_key_int_eq(map_t *t, size_t count, ...)
 
 void test_map_ctor()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
     data_info_t info = CDC_INIT_STRUCT;
@@ -88,7 +91,9 @@ void test_map_ctor()
 
 void test_map_ctorl()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
     data_info_t info = CDC_INIT_STRUCT;
@@ -105,7 +110,9 @@ void test_map_ctorl()
 
 void test_map_get()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
     void *value = NULL;
@@ -123,9 +130,39 @@ void test_map_get()
   }
 }
 
+void test_map_get_many()
+{
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
+  for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
+    map_t *m = NULL;
+    void *keys[] = {a.first, CDC_FROM_INT(10), h.first, c.first, CDC_FROM_INT(-1)};
+    void *values[CDC_ARRAY_SIZE(keys)] = {NULL};
+    bool found[CDC_ARRAY_SIZE(keys)] = {false};
+    data_info_t info = CDC_INIT_STRUCT;
+    info.cmp = lt;
+    info.eq = eq;
+    info.hash = hash;
+
+    CU_ASSERT_EQUAL(map_ctorl(tables[t], &m, &info, &a, &b, &c, &d, &g, &h, &e, &f, CDC_END),
+                    CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_get_many(m, keys, CDC_ARRAY_SIZE(keys), values, found), 3);
+    CU_ASSERT(found[0] && !found[1] && found[2] && found[3] && !found[4]);
+    CU_ASSERT_EQUAL(values[0], a.second);
+    CU_ASSERT_EQUAL(values[1], NULL);
+    CU_ASSERT_EQUAL(values[2], h.second);
+    CU_ASSERT_EQUAL(values[3], c.second);
+    CU_ASSERT_EQUAL(values[4], NULL);
+    map_dtor(m);
+  }
+}
+
 void test_map_count()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
     data_info_t info = CDC_INIT_STRUCT;
@@ -144,7 +181,9 @@ void test_map_count()
 
 void test_map_find()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
     map_iter_t it = CDC_INIT_STRUCT;
@@ -173,9 +212,76 @@ void test_map_find()
   }
 }
 
+static int str_lt(const void *l, const void *r)
+{
+  return strcmp((const char *)l, (const char *)r) < 0;
+}
+
+static int str_eq(const void *l, const void *r)
+{
+  return strcmp((const char *)l, (const char *)r) == 0;
+}
+
+void test_map_probe()
+{
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
+  const char *words[] = {"b", "ab", "abc", "abd", "c", "ba"};
+  const char *buf = "abcab ba";
+  for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
+    map_t *m = NULL;
+    map_iter_t it = CDC_INIT_STRUCT;
+    map_iter_t it_end = CDC_INIT_STRUCT;
+    data_info_t info = CDC_INIT_STRUCT;
+    info.cmp = str_lt;
+    info.eq = str_eq;
+    info.hash = cdc_pdhash_str;
+    void *value = NULL;
+
+    CU_ASSERT_EQUAL(map_ctor(tables[t], &m, &info), CDC_STATUS_OK);
+    for (size_t i = 0; i < CDC_ARRAY_SIZE(words); ++i) {
+      CU_ASSERT_EQUAL(map_insert(m, (void *)words[i], CDC_FROM_SIZE(i), NULL, NULL),
+                      CDC_STATUS_OK);
+    }
+
+    for (size_t i = 0; i < CDC_ARRAY_SIZE(words); ++i) {
+      str_view_t view = str_view_make(words[i], strlen(words[i]));
+      CU_ASSERT_EQUAL(map_get_probe(m, &view, cdc_str_view_probe, &value), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(CDC_TO_SIZE(value), i);
+    }
+
+    str_view_t abc = str_view_make(buf, 3);
+    str_view_t ab = str_view_make(buf + 3, 2);
+    str_view_t a = str_view_make(buf, 1);
+    str_view_t abca = str_view_make(buf, 4);
+    str_view_t empty = str_view_make(buf, 0);
+    CU_ASSERT_EQUAL(map_count_probe(m, &abc, cdc_str_view_probe), 1);
+    CU_ASSERT_EQUAL(map_count_probe(m, &ab, cdc_str_view_probe), 1);
+    CU_ASSERT_EQUAL(map_count_probe(m, &a, cdc_str_view_probe), 0);
+    CU_ASSERT_EQUAL(map_count_probe(m, &abca, cdc_str_view_probe), 0);
+    CU_ASSERT_EQUAL(map_count_probe(m, &empty, cdc_str_view_probe), 0);
+    CU_ASSERT_EQUAL(map_get_probe(m, &abca, cdc_str_view_probe, &value), CDC_STATUS_NOT_FOUND);
+
+    CU_ASSERT_EQUAL(map_iter_ctor(m, &it), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_iter_ctor(m, &it_end), CDC_STATUS_OK);
+    str_view_t ba = str_view_make(buf + 6, 2);
+    map_find_probe(m, &ba, cdc_str_view_probe, &it);
+    CU_ASSERT_EQUAL(CDC_TO_SIZE(map_iter_value(&it)), 5);
+    map_find_probe(m, &a, cdc_str_view_probe, &it);
+    map_end(m, &it_end);
+    CU_ASSERT(map_iter_is_eq(&it, &it_end));
+    map_iter_dtor(&it);
+    map_iter_dtor(&it_end);
+    map_dtor(m);
+  }
+}
+
 void test_map_clear()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
     data_info_t info = CDC_INIT_STRUCT;
@@ -195,7 +301,9 @@ void test_map_clear()
 
 void test_map_insert()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
     const int count = 100;
@@ -221,7 +329,9 @@ void test_map_insert()
 
 void test_map_insert_or_assign()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
     map_iter_t it = CDC_INIT_STRUCT;
@@ -265,7 +375,9 @@ void test_map_insert_or_assign()
 
 void test_map_erase()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
     void *value = NULL;
@@ -330,7 +442,9 @@ void test_map_swap()
 
 void test_map_iterators()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  // The order of elements is checked, so only tables that keep it for these keys are here.
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable};
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
     data_info_t info = CDC_INIT_STRUCT;
@@ -401,9 +515,12 @@ void test_map_iterators()
 
 void test_map_iter_type()
 {
-  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_htable};
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
   const iterator_type_t answers[] = {CDC_BIDIR_ITERATOR, CDC_BIDIR_ITERATOR, CDC_BIDIR_ITERATOR,
-                                     CDC_FWD_ITERATOR};
+                                     CDC_BIDIR_ITERATOR, CDC_BIDIR_ITERATOR, CDC_FWD_ITERATOR,
+                                     CDC_FWD_ITERATOR,   CDC_FWD_ITERATOR};
   CU_ASSERT_EQUAL(CDC_ARRAY_SIZE(tables), CDC_ARRAY_SIZE(answers));
   for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
     map_t *m = NULL;
@@ -420,3 +537,297 @@ void test_map_iter_type()
     map_dtor(m);
   }
 }
+
+void test_map_filter()
+{
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
+  for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
+    map_t *m = NULL;
+    map_t *w = NULL;
+    map_iter_t it = CDC_INIT_STRUCT;
+    void *value = NULL;
+    data_info_t info = CDC_INIT_STRUCT;
+    const int count = 1000;
+    info.cmp = lt;
+    info.eq = eq;
+    info.hash = hash;
+
+    CU_ASSERT_EQUAL(map_ctorl(tables[t], &m, &info, &a, &b, CDC_END), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_enable_filter(m, hash, 0.01), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_count(m, a.first), 1);
+    CU_ASSERT_EQUAL(map_count(m, b.first), 1);
+
+    // The filter grows several times.
+    for (int i = 2; i < count; ++i) {
+      bool inserted = false;
+      CU_ASSERT_EQUAL(map_insert(m, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, &inserted),
+                      CDC_STATUS_OK);
+      CU_ASSERT(inserted);
+    }
+
+    CU_ASSERT_EQUAL(map_insert_or_assign(m, CDC_FROM_INT(count), CDC_FROM_INT(count), NULL, NULL),
+                    CDC_STATUS_OK);
+    for (int i = 0; i <= count; ++i) {
+      CU_ASSERT_EQUAL(map_count(m, CDC_FROM_INT(i)), 1);
+    }
+
+    for (int i = count + 1; i < 2 * count; ++i) {
+      CU_ASSERT_EQUAL(map_count(m, CDC_FROM_INT(i)), 0);
+      CU_ASSERT_EQUAL(map_get(m, CDC_FROM_INT(i), &value), CDC_STATUS_NOT_FOUND);
+    }
+
+    void *keys[40];
+    void *values[CDC_ARRAY_SIZE(keys)];
+    bool found[CDC_ARRAY_SIZE(keys)];
+    for (size_t i = 0; i < CDC_ARRAY_SIZE(keys); ++i) {
+      keys[i] = CDC_FROM_INT(i % 2 ? count - (int)i : count + (int)i);
+      found[i] = i % 2 == 0;
+    }
+    CU_ASSERT_EQUAL(map_get_many(m, keys, CDC_ARRAY_SIZE(keys), values, found),
+                    CDC_ARRAY_SIZE(keys) / 2 + 1);
+    for (size_t i = 0; i < CDC_ARRAY_SIZE(keys); ++i) {
+      CU_ASSERT_EQUAL(found[i], i == 0 || i % 2 == 1);
+      if (found[i]) {
+        CU_ASSERT_EQUAL(values[i], keys[i]);
+      }
+    }
+
+    CU_ASSERT_EQUAL(map_iter_ctor(m, &it), CDC_STATUS_OK);
+    map_find(m, CDC_FROM_INT(-1), &it);
+    CU_ASSERT(!map_iter_has_next(&it));
+    map_find(m, CDC_FROM_INT(5), &it);
+    CU_ASSERT_EQUAL(map_iter_value(&it), CDC_FROM_INT(5));
+    map_iter_dtor(&it);
+
+    CU_ASSERT_EQUAL(map_erase(m, CDC_FROM_INT(5)), 1);
+    CU_ASSERT_EQUAL(map_count(m, CDC_FROM_INT(5)), 0);
+
+    // The filter moves together with the container.
+    CU_ASSERT_EQUAL(map_ctorl(tables[t], &w, &info, &c, CDC_END), CDC_STATUS_OK);
+    map_swap(m, w);
+    CU_ASSERT_EQUAL(map_count(w, CDC_FROM_INT(7)), 1);
+    CU_ASSERT_EQUAL(map_count(m, c.first), 1);
+    CU_ASSERT_EQUAL(map_count(m, CDC_FROM_INT(7)), 0);
+
+    map_clear(w);
+    CU_ASSERT_EQUAL(map_count(w, CDC_FROM_INT(7)), 0);
+    CU_ASSERT_EQUAL(map_insert(w, CDC_FROM_INT(7), CDC_FROM_INT(7), NULL, NULL), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_count(w, CDC_FROM_INT(7)), 1);
+    map_disable_filter(w);
+    CU_ASSERT_EQUAL(map_count(w, CDC_FROM_INT(7)), 1);
+    map_dtor(m);
+    map_dtor(w);
+  }
+}
+
+void test_map_filter_churn()
+{
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_htable, cdc_map_flat_htable};
+  for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
+    map_t *m = NULL;
+    data_info_t info = CDC_INIT_STRUCT;
+    const int size = 10;
+    info.cmp = lt;
+    info.eq = eq;
+    info.hash = hash;
+
+    CU_ASSERT_EQUAL(map_ctor(tables[t], &m, &info), CDC_STATUS_OK);
+    for (int i = 0; i < size; ++i) {
+      CU_ASSERT_EQUAL(map_insert(m, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL), CDC_STATUS_OK);
+    }
+
+    CU_ASSERT_EQUAL(map_enable_filter(m, hash, 0.01), CDC_STATUS_OK);
+    size_t capacity = bloom_filter_capacity(m->filter);
+    // Many insertions at a constant size do not grow the filter.
+    for (int i = size; i < 100 * size; ++i) {
+      CU_ASSERT_EQUAL(map_insert(m, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(map_erase(m, CDC_FROM_INT(i - size)), 1);
+    }
+
+    CU_ASSERT_EQUAL(map_size(m), (size_t)size);
+    CU_ASSERT_EQUAL(bloom_filter_capacity(m->filter), capacity);
+    for (int i = 99 * size; i < 100 * size; ++i) {
+      CU_ASSERT_EQUAL(map_count(m, CDC_FROM_INT(i)), 1);
+    }
+    map_dtor(m);
+  }
+}
+
+void test_map_memory_usage()
+{
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
+  for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
+    map_t *m = NULL;
+    data_info_t info = CDC_INIT_STRUCT;
+    info.cmp = lt;
+    info.eq = eq;
+    info.hash = hash;
+    size_t live = cdc_live_bytes();
+
+    CU_ASSERT_EQUAL(map_ctor(tables[t], &m, &info), CDC_STATUS_OK);
+    memory_usage_t empty = map_memory_usage(m);
+    CU_ASSERT_EQUAL(empty.count, 0);
+    CU_ASSERT(empty.bytes >= sizeof(map_t));
+    for (int i = 0; i < 100; ++i) {
+      CU_ASSERT_EQUAL(map_insert(m, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL), CDC_STATUS_OK);
+    }
+    memory_usage_t full = map_memory_usage(m);
+    CU_ASSERT_EQUAL(full.count, 100);
+    CU_ASSERT(full.bytes > empty.bytes);
+    CU_ASSERT_EQUAL(map_enable_filter(m, hash, 0.01), CDC_STATUS_OK);
+    CU_ASSERT(map_memory_usage(m).bytes > full.bytes);
+#ifdef CDC_MEMORY_COUNTER
+    CU_ASSERT(cdc_live_bytes() - live >= full.bytes);
+#endif
+    map_dtor(m);
+    CU_ASSERT_EQUAL(cdc_live_bytes(), live);
+  }
+}
+
+void test_map_ctor_sorted()
+{
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
+  enum { kSize = 500 };
+  static pair_t pairs[kSize];
+  for (size_t i = 0; i < kSize; ++i) {
+    pairs[i].first = CDC_FROM_INT(i);
+    pairs[i].second = CDC_FROM_INT(kSize - i);
+  }
+
+  for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
+    map_t *m = NULL;
+    void *value = NULL;
+    data_info_t info = CDC_INIT_STRUCT;
+    info.cmp = lt;
+    info.eq = eq;
+    info.hash = hash;
+
+    CU_ASSERT_EQUAL(map_ctor_sorted(tables[t], &m, &info, pairs, 0), CDC_STATUS_OK);
+    CU_ASSERT(map_empty(m));
+    map_dtor(m);
+
+    CU_ASSERT_EQUAL(map_ctor_sorted(tables[t], &m, &info, pairs, kSize), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_size(m), kSize);
+    for (size_t i = 0; i < kSize; ++i) {
+      CU_ASSERT_EQUAL(map_get(m, pairs[i].first, &value), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(value, pairs[i].second);
+    }
+
+    CU_ASSERT_EQUAL(map_get(m, CDC_FROM_INT(kSize), &value), CDC_STATUS_NOT_FOUND);
+    CU_ASSERT_EQUAL(map_insert(m, CDC_FROM_INT(kSize), NULL, NULL, NULL), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_erase(m, CDC_FROM_INT(0)), 1);
+    CU_ASSERT_EQUAL(map_size(m), kSize);
+    map_dtor(m);
+  }
+}
+
+void test_map_bounds()
+{
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
+  const bool ordered[] = {true, true, true, true, true, false, false, false};
+  for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
+    map_t *m = NULL;
+    map_iter_t first = CDC_INIT_STRUCT;
+    map_iter_t last = CDC_INIT_STRUCT;
+    map_iter_t it_end = CDC_INIT_STRUCT;
+    data_info_t info = CDC_INIT_STRUCT;
+    info.cmp = lt;
+    info.eq = eq;
+    info.hash = hash;
+
+    CU_ASSERT_EQUAL(map_ctorl(tables[t], &m, &info, &a, &c, &e, &g, CDC_END), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_iter_ctor(m, &first), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_iter_ctor(m, &last), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_iter_ctor(m, &it_end), CDC_STATUS_OK);
+    map_end(m, &it_end);
+    if (!ordered[t]) {
+      CU_ASSERT_EQUAL(map_lower_bound(m, b.first, &first), CDC_STATUS_NOT_SUPPORTED);
+      CU_ASSERT_EQUAL(map_upper_bound(m, b.first, &first), CDC_STATUS_NOT_SUPPORTED);
+      CU_ASSERT_EQUAL(map_equal_range(m, b.first, &first, &last), CDC_STATUS_NOT_SUPPORTED);
+      CU_ASSERT_EQUAL(map_range(m, b.first, f.first, &first, &last), CDC_STATUS_NOT_SUPPORTED);
+    } else {
+      CU_ASSERT_EQUAL(map_lower_bound(m, b.first, &first), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(map_iter_key(&first), c.first);
+      CU_ASSERT_EQUAL(map_lower_bound(m, c.first, &first), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(map_iter_key(&first), c.first);
+      CU_ASSERT_EQUAL(map_upper_bound(m, c.first, &first), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(map_iter_key(&first), e.first);
+      CU_ASSERT_EQUAL(map_upper_bound(m, g.first, &first), CDC_STATUS_OK);
+      CU_ASSERT(map_iter_is_eq(&first, &it_end));
+
+      CU_ASSERT_EQUAL(map_equal_range(m, e.first, &first, &last), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(map_iter_value(&first), e.second);
+      map_iter_next(&first);
+      CU_ASSERT(map_iter_is_eq(&first, &last));
+      CU_ASSERT_EQUAL(map_equal_range(m, f.first, &first, &last), CDC_STATUS_OK);
+      CU_ASSERT(map_iter_is_eq(&first, &last));
+
+      CU_ASSERT_EQUAL(map_range(m, b.first, g.first, &first, &last), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(map_iter_key(&first), c.first);
+      map_iter_next(&first);
+      CU_ASSERT_EQUAL(map_iter_key(&first), e.first);
+      map_iter_next(&first);
+      CU_ASSERT(map_iter_is_eq(&first, &last));
+    }
+
+    map_iter_dtor(&first);
+    map_iter_dtor(&last);
+    map_iter_dtor(&it_end);
+    map_dtor(m);
+  }
+}
+
+void test_map_select_rank()
+{
+  const map_table_t *tables[] = {cdc_map_avl, cdc_map_splay, cdc_map_treap, cdc_map_btree,
+                                 cdc_map_rbtree, cdc_map_htable, cdc_map_flat_htable,
+                                 cdc_map_robin_hood_htable};
+#ifdef CDC_ORDER_STATISTICS
+  const bool supported[] = {true, false, true, false, false, false, false, false};
+#else
+  const bool supported[] = {false, false, false, false, false, false, false, false};
+#endif
+  for (size_t t = 0; t < CDC_ARRAY_SIZE(tables); ++t) {
+    map_t *m = NULL;
+    map_iter_t it = CDC_INIT_STRUCT;
+    map_iter_t it_end = CDC_INIT_STRUCT;
+    size_t rank = 0;
+    data_info_t info = CDC_INIT_STRUCT;
+    info.cmp = lt;
+    info.eq = eq;
+    info.hash = hash;
+
+    CU_ASSERT_EQUAL(map_ctorl(tables[t], &m, &info, &a, &c, &e, &g, CDC_END), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_iter_ctor(m, &it), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(map_iter_ctor(m, &it_end), CDC_STATUS_OK);
+    map_end(m, &it_end);
+    if (!supported[t]) {
+      CU_ASSERT_EQUAL(map_select(m, 0, &it), CDC_STATUS_NOT_SUPPORTED);
+      CU_ASSERT_EQUAL(map_rank(m, a.first, &rank), CDC_STATUS_NOT_SUPPORTED);
+    } else {
+      CU_ASSERT_EQUAL(map_select(m, 2, &it), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(map_iter_key(&it), e.first);
+      CU_ASSERT_EQUAL(map_select(m, 4, &it), CDC_STATUS_OK);
+      CU_ASSERT(map_iter_is_eq(&it, &it_end));
+      CU_ASSERT_EQUAL(map_rank(m, e.first, &rank), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(rank, 2);
+      CU_ASSERT_EQUAL(map_rank(m, f.first, &rank), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(rank, 3);
+      CU_ASSERT_EQUAL(map_erase(m, a.first), 1);
+      CU_ASSERT_EQUAL(map_rank(m, f.first, &rank), CDC_STATUS_OK);
+      CU_ASSERT_EQUAL(rank, 2);
+    }
+
+    map_iter_dtor(&it);
+    map_iter_dtor(&it_end);
+    map_dtor(m);
+  }
+}
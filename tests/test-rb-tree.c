@@ -0,0 +1,577 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "test-common.h"
+
+#include "cdcontainers/rb-tree.h"
+#include "cdcontainers/casts.h"
+#include "cdcontainers/common.h"
+#include "cdcontainers/tree-utils.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <CUnit/Basic.h>
+
+CDC_MAKE_TREE_HEIGTH_FN(rb_tree_node_t *)
+
+static pair_t a = {CDC_FROM_INT(0), CDC_FROM_INT(0)};
+static pair_t b = {CDC_FROM_INT(1), CDC_FROM_INT(1)};
+static pair_t c = {CDC_FROM_INT(2), CDC_FROM_INT(2)};
+static pair_t d = {CDC_FROM_INT(3), CDC_FROM_INT(3)};
+static pair_t e = {CDC_FROM_INT(4), CDC_FROM_INT(4)};
+static pair_t f = {CDC_FROM_INT(5), CDC_FROM_INT(5)};
+static pair_t g = {CDC_FROM_INT(6), CDC_FROM_INT(6)};
+static pair_t h = {CDC_FROM_INT(7), CDC_FROM_INT(7)};
+
+static int lt(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) < CDC_TO_INT(r);
+}
+
+static rb_tree_node_t *parent_of(rb_tree_node_t *node)
+{
+  return (rb_tree_node_t *)(node->parent_color & ~(uintptr_t)1);
+}
+
+static bool is_red(rb_tree_node_t *node)
+{
+  return node && (node->parent_color & 1) == 0;
+}
+
+// Checks the links and the colors of the subtree and returns its black height.
+static size_t test_tree_links(rb_tree_node_t *node)
+{
+  if (!node) return 1;
+
+  if (node->left) {
+    CU_ASSERT_EQUAL(parent_of(node->left), node);
+    CU_ASSERT(!is_red(node) || !is_red(node->left));
+  }
+
+  if (node->right) {
+    CU_ASSERT_EQUAL(parent_of(node->right), node);
+    CU_ASSERT(!is_red(node) || !is_red(node->right));
+  }
+
+  size_t lhs = test_tree_links(node->left);
+  size_t rhs = test_tree_links(node->right);
+  CU_ASSERT_EQUAL(lhs, rhs);
+  return lhs + !is_red(node);
+}
+
+static void test_rb_tree_props(rb_tree_t *t)
+{
+  CU_ASSERT(!is_red(t->root));
+  if (t->root) {
+    CU_ASSERT_PTR_NULL(parent_of(t->root));
+  }
+
+  test_tree_links(t->root);
+}
+
+static bool rb_tree_key_int_eq(rb_tree_t *t, size_t count, ...)
+{
+  test_rb_tree_props(t);
+  va_list args;
+  va_start(args, count);
+  for (size_t i = 0; i < count; ++i) {
+    pair_t *val = va_arg(args, pair_t *);
+    void *tmp = NULL;
+    if (rb_tree_get(t, val->first, &tmp) != CDC_STATUS_OK || tmp != val->second) {
+      va_end(args);
+      return false;
+    }
+  }
+  va_end(args);
+  CU_ASSERT_EQUAL(rb_tree_size(t), count);
+  return true;
+}
+
+static inline void rb_tree_inorder_print_int(rb_tree_node_t *node)
+{
+  if (node->left) {
+    rb_tree_inorder_print_int(node->left);
+  }
+
+  printf("%d ", CDC_TO_INT(node->key));
+
+  if (node->right) {
+    rb_tree_inorder_print_int(node->right);
+  }
+}
+
+void test_rb_tree_ctor()
+{
+  rb_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctor(&t, &info), CDC_STATUS_OK);
+  CU_ASSERT(rb_tree_empty(t));
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_ctorl()
+{
+  rb_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctorl(&t, &info, &a, &g, &h, &d, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 4);
+  CU_ASSERT(rb_tree_key_int_eq(t, 4, &a, &g, &h, &d));
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_get()
+{
+  rb_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctorl(&t, &info, &a, &b, &c, &d, &g, &h, &e, &f, CDC_END),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 8);
+  CU_ASSERT(rb_tree_key_int_eq(t, 8, &a, &b, &c, &d, &g, &h, &e, &f));
+
+  void *value = NULL;
+  CU_ASSERT_EQUAL(rb_tree_get(t, CDC_FROM_INT(10), &value), CDC_STATUS_NOT_FOUND);
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_count()
+{
+  rb_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctorl(&t, &info, &a, &b, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 2);
+  CU_ASSERT_EQUAL(rb_tree_count(t, a.first), 1);
+  CU_ASSERT_EQUAL(rb_tree_count(t, b.first), 1);
+  CU_ASSERT_EQUAL(rb_tree_count(t, CDC_FROM_INT(10)), 0);
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_find()
+{
+  rb_tree_t *t = NULL;
+  rb_tree_iter_t it = CDC_INIT_STRUCT;
+  rb_tree_iter_t it_end = CDC_INIT_STRUCT;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctorl(&t, &info, &a, &b, &c, &d, &g, CDC_END), CDC_STATUS_OK);
+  rb_tree_find(t, a.first, &it);
+  CU_ASSERT_EQUAL(rb_tree_iter_value(&it), a.second);
+  rb_tree_find(t, b.first, &it);
+  CU_ASSERT_EQUAL(rb_tree_iter_value(&it), b.second);
+  rb_tree_find(t, g.first, &it);
+  CU_ASSERT_EQUAL(rb_tree_iter_value(&it), g.second);
+  rb_tree_find(t, h.first, &it);
+  rb_tree_end(t, &it_end);
+  CU_ASSERT(rb_tree_iter_is_eq(&it, &it_end));
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_clear()
+{
+  rb_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctorl(&t, &info, &a, &b, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 2);
+  rb_tree_clear(t);
+  CU_ASSERT(rb_tree_empty(t));
+  rb_tree_clear(t);
+  CU_ASSERT(rb_tree_empty(t));
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_insert()
+{
+  rb_tree_t *t = NULL;
+  const int kCount = 100;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctor(&t, &info), CDC_STATUS_OK);
+
+  for (int i = 0; i < kCount; ++i) {
+    CU_ASSERT_EQUAL(rb_tree_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+  }
+
+  CU_ASSERT_EQUAL(rb_tree_size(t), (size_t)kCount);
+
+  for (int i = 0; i < kCount; ++i) {
+    void *val = NULL;
+    CU_ASSERT_EQUAL(rb_tree_get(t, CDC_FROM_INT(i), &val), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(CDC_TO_INT(val), i);
+  }
+
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_insert_or_assign()
+{
+  rb_tree_t *t = NULL;
+  pair_rb_tree_iter_bool_t ret = CDC_INIT_STRUCT;
+  void *value = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctor(&t, &info), CDC_STATUS_OK);
+
+  CU_ASSERT_EQUAL(rb_tree_insert_or_assign(t, a.first, a.second, &ret), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 1);
+  CU_ASSERT_EQUAL(rb_tree_iter_value(&ret.first), a.second);
+  CU_ASSERT(ret.second);
+
+  CU_ASSERT_EQUAL(rb_tree_insert_or_assign(t, a.first, b.second, &ret), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 1);
+  CU_ASSERT_EQUAL(rb_tree_get(t, a.first, &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(value, b.second);
+  CU_ASSERT_EQUAL(rb_tree_iter_value(&ret.first), b.second);
+  CU_ASSERT(!ret.second);
+
+  CU_ASSERT_EQUAL(rb_tree_insert_or_assign(t, c.first, c.second, &ret), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 2);
+  CU_ASSERT_EQUAL(rb_tree_iter_value(&ret.first), c.second);
+  CU_ASSERT(ret.second);
+
+  CU_ASSERT_EQUAL(rb_tree_insert_or_assign(t, c.first, d.second, &ret), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 2);
+  CU_ASSERT_EQUAL(rb_tree_get(t, c.first, &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(value, d.second);
+  CU_ASSERT_EQUAL(rb_tree_iter_value(&ret.first), d.second);
+  CU_ASSERT(!ret.second);
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_erase()
+{
+  rb_tree_t *t = NULL;
+  void *value = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctorl(&t, &info, &a, &b, &c, &d, &g, &h, &e, &f, CDC_END),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 8);
+  rb_tree_inorder_print_int(t->root);
+  CU_ASSERT(rb_tree_key_int_eq(t, 8, &a, &b, &c, &d, &g, &h, &e, &f));
+  CU_ASSERT_EQUAL(rb_tree_erase(t, a.first), 1);
+  rb_tree_inorder_print_int(t->root);
+  CU_ASSERT_EQUAL(rb_tree_get(t, a.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT(rb_tree_key_int_eq(t, 7, &b, &c, &d, &g, &h, &e, &f));
+
+  CU_ASSERT_EQUAL(rb_tree_erase(t, h.first), 1);
+  CU_ASSERT_EQUAL(rb_tree_get(t, h.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 6);
+  CU_ASSERT(rb_tree_key_int_eq(t, 6, &b, &c, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(rb_tree_erase(t, h.first), 0);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 6);
+  CU_ASSERT(rb_tree_key_int_eq(t, 6, &b, &c, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(rb_tree_erase(t, b.first), 1);
+  CU_ASSERT_EQUAL(rb_tree_get(t, b.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 5);
+  CU_ASSERT(rb_tree_key_int_eq(t, 5, &c, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(rb_tree_erase(t, c.first), 1);
+  CU_ASSERT_EQUAL(rb_tree_get(t, c.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 4);
+  CU_ASSERT(rb_tree_key_int_eq(t, 4, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(rb_tree_erase(t, d.first), 1);
+  CU_ASSERT_EQUAL(rb_tree_get(t, d.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 3);
+  CU_ASSERT(rb_tree_key_int_eq(t, 3, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(rb_tree_erase(t, g.first), 1);
+  CU_ASSERT_EQUAL(rb_tree_get(t, g.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 2);
+  CU_ASSERT(rb_tree_key_int_eq(t, 2, &e, &f));
+
+  CU_ASSERT_EQUAL(rb_tree_erase(t, f.first), 1);
+  CU_ASSERT_EQUAL(rb_tree_get(t, f.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 1);
+  CU_ASSERT(rb_tree_key_int_eq(t, 1, &e));
+
+  CU_ASSERT_EQUAL(rb_tree_erase(t, e.first), 1);
+  CU_ASSERT_EQUAL(rb_tree_get(t, e.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT(rb_tree_empty(t));
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_iterators()
+{
+  rb_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctorl(&t, &info, &a, &b, &c, &d, &e, &f, &g, &h, CDC_END),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_size(t), 8);
+
+  rb_tree_iter_t it1 = CDC_INIT_STRUCT;
+  rb_tree_iter_t it2 = CDC_INIT_STRUCT;
+  pair_t *arr[] = {&a, &b, &c, &d, &e, &f, &g, &h};
+
+  size_t i = 0;
+  rb_tree_begin(t, &it1);
+  rb_tree_end(t, &it2);
+  for (; !rb_tree_iter_is_eq(&it1, &it2); rb_tree_iter_next(&it1)) {
+    CU_ASSERT_EQUAL(rb_tree_iter_key(&it1), arr[i]->first)
+    ++i;
+  }
+  CU_ASSERT_EQUAL(rb_tree_size(t), i);
+
+  i = rb_tree_size(t) - 1;
+  rb_tree_end(t, &it1);
+  rb_tree_iter_prev(&it1);
+  rb_tree_begin(t, &it2);
+  for (; !rb_tree_iter_is_eq(&it1, &it2); rb_tree_iter_prev(&it1)) {
+    CU_ASSERT_EQUAL(rb_tree_iter_key(&it1), arr[i]->first)
+    --i;
+  }
+  CU_ASSERT_EQUAL(i, 0);
+
+  rb_tree_begin(t, &it1);
+  while (rb_tree_iter_has_next(&it1)) {
+    CU_ASSERT_EQUAL(rb_tree_iter_key(&it1), arr[i]->first)
+    ++i;
+    rb_tree_iter_next(&it1);
+  }
+  CU_ASSERT_EQUAL(rb_tree_size(t), i);
+
+  i = rb_tree_size(t) - 1;
+  rb_tree_end(t, &it1);
+  rb_tree_iter_prev(&it1);
+  while (rb_tree_iter_has_prev(&it1)) {
+    CU_ASSERT_EQUAL(rb_tree_iter_key(&it1), arr[i]->first);
+    --i;
+    rb_tree_iter_prev(&it1);
+  }
+  CU_ASSERT_EQUAL(i, 0);
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_swap()
+{
+  rb_tree_t *ta = NULL;
+  rb_tree_t *tb = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctorl(&ta, &info, &b, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rb_tree_ctorl(&tb, &info, &a, &g, &h, &d, CDC_END), CDC_STATUS_OK);
+
+  rb_tree_swap(ta, tb);
+
+  CU_ASSERT_EQUAL(rb_tree_size(ta), 4);
+  CU_ASSERT(rb_tree_key_int_eq(ta, 4, &a, &g, &h, &d));
+  CU_ASSERT_EQUAL(rb_tree_size(tb), 1);
+  CU_ASSERT(rb_tree_key_int_eq(tb, 1, &b));
+
+  rb_tree_dtor(ta);
+  rb_tree_dtor(tb);
+}
+
+void test_rb_tree_height()
+{
+  size_t count = 100000;
+  rb_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  rb_tree_ctor(&t, &info);
+  for (size_t i = 0; i < count; ++i) {
+    int val = rand();
+    if (rb_tree_insert(t, CDC_FROM_INT(val), NULL, NULL) != CDC_STATUS_OK) {
+      CU_ASSERT(true);
+    }
+  }
+
+  double experimental_height = cdc_tree_height(t->root);
+  double theoretical_max_height = 2.0 * log2((double)count + 1);
+  printf(
+      "\nExperimental red-black tree heigth: %f, theoretical max red-black tree heigth: "
+      "%f, tree size: %zu\n",
+      experimental_height, theoretical_max_height, count);
+  CU_ASSERT(experimental_height <= theoretical_max_height);
+  test_rb_tree_props(t);
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_random()
+{
+  enum { kKeys = 5000, kOps = 100000 };
+  static bool present[kKeys];
+  rb_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  memset(present, 0, sizeof(present));
+  CU_ASSERT_EQUAL(rb_tree_ctor(&t, &info), CDC_STATUS_OK);
+  srand(11);
+  for (int i = 0; i < kOps; ++i) {
+    int key = rand() % kKeys;
+    if (rand() % 3) {
+      CU_ASSERT_EQUAL(rb_tree_insert(t, CDC_FROM_INT(key), CDC_FROM_INT(key), NULL),
+                      CDC_STATUS_OK);
+      present[key] = true;
+    } else {
+      CU_ASSERT_EQUAL(rb_tree_erase(t, CDC_FROM_INT(key)), (size_t)present[key]);
+      present[key] = false;
+    }
+
+    if (i % 100 == 0) {
+      test_rb_tree_props(t);
+    }
+  }
+
+  test_rb_tree_props(t);
+  size_t count = 0;
+  rb_tree_iter_t it = CDC_INIT_STRUCT;
+  rb_tree_begin(t, &it);
+  for (int key = 0; key < kKeys; ++key) {
+    if (present[key]) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(rb_tree_iter_key(&it)), key);
+      rb_tree_iter_next(&it);
+      ++count;
+    }
+  }
+
+  CU_ASSERT(!rb_tree_iter_has_next(&it));
+  CU_ASSERT_EQUAL(rb_tree_size(t), count);
+  rb_tree_dtor(t);
+}
+
+void test_rb_tree_ctor_sorted()
+{
+  enum { kMaxSize = 1000 };
+  static pair_t pairs[kMaxSize];
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  for (size_t i = 0; i < kMaxSize; ++i) {
+    pairs[i].first = CDC_FROM_INT(i);
+    pairs[i].second = CDC_FROM_INT(i * 2);
+  }
+
+  for (size_t n = 0; n <= kMaxSize; n = n < 100 ? n + 1 : n + 100) {
+    rb_tree_t *t = NULL;
+    CU_ASSERT_EQUAL(rb_tree_ctor_sorted(&t, &info, pairs, n), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(rb_tree_size(t), n);
+    test_rb_tree_props(t);
+
+    rb_tree_iter_t it = CDC_INIT_STRUCT;
+    rb_tree_begin(t, &it);
+    for (size_t i = 0; i < n; ++i) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(rb_tree_iter_key(&it)), (int)i);
+      CU_ASSERT_EQUAL(CDC_TO_INT(rb_tree_iter_value(&it)), (int)(i * 2));
+      rb_tree_iter_next(&it);
+    }
+
+    CU_ASSERT(!rb_tree_iter_has_next(&it));
+    for (size_t i = 0; i < n; i += 2) {
+      CU_ASSERT_EQUAL(rb_tree_erase(t, CDC_FROM_INT(i)), 1);
+    }
+
+    CU_ASSERT_EQUAL(rb_tree_insert(t, CDC_FROM_INT(n), NULL, NULL), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(rb_tree_size(t), n / 2 + 1);
+    test_rb_tree_props(t);
+    rb_tree_dtor(t);
+  }
+}
+
+void test_rb_tree_bounds()
+{
+  enum { kKeys = 500 };
+  rb_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(rb_tree_ctor(&t, &info), CDC_STATUS_OK);
+  for (int i = 0; i < kKeys; ++i) {
+    CU_ASSERT_EQUAL(rb_tree_insert(t, CDC_FROM_INT(i * 2), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+  }
+
+  rb_tree_iter_t it = CDC_INIT_STRUCT;
+  rb_tree_iter_t end = CDC_INIT_STRUCT;
+  rb_tree_end(t, &end);
+  for (int key = -1; key <= kKeys * 2; ++key) {
+    int lower = key < 0 ? 0 : key + key % 2;
+    rb_tree_lower_bound(t, CDC_FROM_INT(key), &it);
+    if (lower < kKeys * 2) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(rb_tree_iter_key(&it)), lower);
+    } else {
+      CU_ASSERT(rb_tree_iter_is_eq(&it, &end));
+    }
+
+    int upper = key < 0 ? 0 : key + 2 - key % 2;
+    rb_tree_upper_bound(t, CDC_FROM_INT(key), &it);
+    if (upper < kKeys * 2) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(rb_tree_iter_key(&it)), upper);
+    } else {
+      CU_ASSERT(rb_tree_iter_is_eq(&it, &end));
+    }
+
+    pair_rb_tree_iter_t range = CDC_INIT_STRUCT;
+    rb_tree_equal_range(t, CDC_FROM_INT(key), &range);
+    size_t count = 0;
+    while (!rb_tree_iter_is_eq(&range.first, &range.second)) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(rb_tree_iter_key(&range.first)), key);
+      rb_tree_iter_next(&range.first);
+      ++count;
+    }
+
+    CU_ASSERT_EQUAL(count, rb_tree_count(t, CDC_FROM_INT(key)));
+  }
+
+  pair_rb_tree_iter_t range = CDC_INIT_STRUCT;
+  rb_tree_range(t, CDC_FROM_INT(101), CDC_FROM_INT(200), &range);
+  for (int key = 102; key < 200; key += 2) {
+    CU_ASSERT_EQUAL(CDC_TO_INT(rb_tree_iter_key(&range.first)), key);
+    CU_ASSERT_EQUAL(CDC_TO_INT(rb_tree_iter_value(&range.first)), key / 2);
+    rb_tree_iter_next(&range.first);
+  }
+
+  CU_ASSERT(rb_tree_iter_is_eq(&range.first, &range.second));
+  rb_tree_range(t, CDC_FROM_INT(7), CDC_FROM_INT(7), &range);
+  CU_ASSERT(rb_tree_iter_is_eq(&range.first, &range.second));
+  rb_tree_range(t, CDC_FROM_INT(900), CDC_FROM_INT(kKeys * 4), &range);
+  CU_ASSERT_EQUAL(CDC_TO_INT(rb_tree_iter_key(&range.first)), 900);
+  CU_ASSERT(rb_tree_iter_is_eq(&range.second, &end));
+  rb_tree_clear(t);
+  rb_tree_lower_bound(t, CDC_FROM_INT(0), &it);
+  rb_tree_end(t, &end);
+  CU_ASSERT(rb_tree_iter_is_eq(&it, &end));
+  rb_tree_dtor(t);
+}
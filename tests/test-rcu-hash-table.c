@@ -0,0 +1,254 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "test-common.h"
+
+#include "cdcontainers/casts.h"
+#include "cdcontainers/global.h"
+#include "cdcontainers/rcu-hash-table.h"
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include <CUnit/Basic.h>
+
+#define READERS_COUNT 4
+#define KEYS_COUNT 512
+#define WRITER_ROUNDS 20
+
+static size_t freed = 0;
+
+static int eq(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) == CDC_TO_INT(r);
+}
+
+static size_t hash(const void *val)
+{
+  return cdc_hash_int(CDC_TO_INT(val));
+}
+
+static void count_free(void *pair)
+{
+  CDC_UNUSED(pair);
+  ++freed;
+}
+
+struct reader_arg {
+  rcu_hash_table_t *t;
+  bool *stop;
+  int errors;
+};
+
+static void *reader(void *p)
+{
+  struct reader_arg *arg = (struct reader_arg *)p;
+  rcu_reader_t *r = NULL;
+  if (rcu_reader_ctor(arg->t, &r) != CDC_STATUS_OK) {
+    ++arg->errors;
+    return NULL;
+  }
+
+  while (!__atomic_load_n(arg->stop, __ATOMIC_ACQUIRE)) {
+    rcu_reader_lock(r);
+    for (int i = 0; i < KEYS_COUNT; ++i) {
+      void *value = NULL;
+      // Values are always congruent to their keys.
+      if (rcu_hash_table_get(arg->t, CDC_FROM_INT(i), &value) == CDC_STATUS_OK &&
+          CDC_TO_INT(value) % KEYS_COUNT != i) {
+        ++arg->errors;
+      }
+    }
+
+    rcu_reader_unlock(r);
+  }
+
+  rcu_reader_dtor(r);
+  return NULL;
+}
+
+void test_rcu_hash_table_ctor()
+{
+  rcu_hash_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(rcu_hash_table_ctor(&t, &info), CDC_STATUS_OK);
+  CU_ASSERT(rcu_hash_table_empty(t));
+  rcu_hash_table_dtor(t);
+
+  CU_ASSERT_EQUAL(rcu_hash_table_ctor1(&t, &info, 2.0), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rcu_hash_table_size(t), 0);
+  rcu_hash_table_dtor(t);
+}
+
+void test_rcu_hash_table_insert()
+{
+  rcu_hash_table_t *t = NULL;
+  rcu_reader_t *r = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  const int count = 1000;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(rcu_hash_table_ctor(&t, &info), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rcu_reader_ctor(t, &r), CDC_STATUS_OK);
+  for (int i = 0; i < count; ++i) {
+    bool inserted = false;
+    CU_ASSERT_EQUAL(rcu_hash_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), &inserted),
+                    CDC_STATUS_OK);
+    CU_ASSERT(inserted);
+  }
+
+  bool inserted = true;
+  CU_ASSERT_EQUAL(rcu_hash_table_insert(t, CDC_FROM_INT(1), CDC_FROM_INT(-1), &inserted),
+                  CDC_STATUS_OK);
+  CU_ASSERT(!inserted);
+  CU_ASSERT_EQUAL(rcu_hash_table_insert_or_assign(t, CDC_FROM_INT(1), CDC_FROM_INT(-1), &inserted),
+                  CDC_STATUS_OK);
+  CU_ASSERT(!inserted);
+  CU_ASSERT_EQUAL(rcu_hash_table_size(t), (size_t)count);
+
+  rcu_reader_lock(r);
+  for (int i = 0; i < count; ++i) {
+    void *value = NULL;
+    CU_ASSERT_EQUAL(rcu_hash_table_get(t, CDC_FROM_INT(i), &value), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(CDC_TO_INT(value), i == 1 ? -1 : i);
+  }
+
+  CU_ASSERT_EQUAL(rcu_hash_table_count(t, CDC_FROM_INT(count)), 0);
+  rcu_reader_unlock(r);
+
+  for (int i = 0; i < count; i += 2) {
+    CU_ASSERT_EQUAL(rcu_hash_table_erase(t, CDC_FROM_INT(i)), 1);
+  }
+
+  CU_ASSERT_EQUAL(rcu_hash_table_erase(t, CDC_FROM_INT(0)), 0);
+  CU_ASSERT_EQUAL(rcu_hash_table_size(t), (size_t)count / 2);
+  rcu_reader_lock(r);
+  for (int i = 0; i < count; ++i) {
+    CU_ASSERT_EQUAL(rcu_hash_table_count(t, CDC_FROM_INT(i)), (size_t)(i % 2));
+  }
+
+  rcu_reader_unlock(r);
+  rcu_hash_table_clear(t);
+  CU_ASSERT(rcu_hash_table_empty(t));
+  CU_ASSERT_EQUAL(rcu_hash_table_retired_count(t), 0);
+  rcu_reader_dtor(r);
+  rcu_hash_table_dtor(t);
+}
+
+void test_rcu_hash_table_reclaim()
+{
+  rcu_hash_table_t *t = NULL;
+  rcu_reader_t *r1 = NULL;
+  rcu_reader_t *r2 = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  info.dfree = count_free;
+
+  CU_ASSERT_EQUAL(rcu_hash_table_ctor(&t, &info), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rcu_reader_ctor(t, &r1), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rcu_reader_ctor(t, &r2), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rcu_hash_table_insert(t, CDC_FROM_INT(1), CDC_FROM_INT(1), NULL),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rcu_hash_table_insert(t, CDC_FROM_INT(2), CDC_FROM_INT(2), NULL),
+                  CDC_STATUS_OK);
+
+  // An entry that is erased while a reader is in its section is freed only
+  // after the reader leaves it.
+  freed = 0;
+  void *value = NULL;
+  rcu_reader_lock(r1);
+  CU_ASSERT_EQUAL(rcu_hash_table_get(t, CDC_FROM_INT(1), &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rcu_hash_table_erase(t, CDC_FROM_INT(1)), 1);
+  CU_ASSERT_EQUAL(rcu_hash_table_retired_count(t), 1);
+  CU_ASSERT_EQUAL(freed, 0);
+
+  // A reader that enters later does not see the entry and does not hold it.
+  rcu_reader_lock(r2);
+  CU_ASSERT_EQUAL(rcu_hash_table_count(t, CDC_FROM_INT(1)), 0);
+  rcu_reader_unlock(r1);
+  rcu_hash_table_reclaim(t);
+  CU_ASSERT_EQUAL(rcu_hash_table_retired_count(t), 0);
+  CU_ASSERT_EQUAL(freed, 1);
+
+  // An assignment replaces the entry, the reader keeps the old value.
+  CU_ASSERT_EQUAL(rcu_hash_table_get(t, CDC_FROM_INT(2), &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(rcu_hash_table_insert_or_assign(t, CDC_FROM_INT(2), CDC_FROM_INT(3), NULL),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(CDC_TO_INT(value), 2);
+  CU_ASSERT_EQUAL(rcu_hash_table_retired_count(t), 1);
+  rcu_reader_unlock(r2);
+  rcu_hash_table_reclaim(t);
+  CU_ASSERT_EQUAL(rcu_hash_table_retired_count(t), 0);
+  // The replaced entry shares the data with the new one.
+  CU_ASSERT_EQUAL(freed, 1);
+
+  rcu_reader_dtor(r1);
+  rcu_reader_dtor(r2);
+  rcu_hash_table_dtor(t);
+  CU_ASSERT_EQUAL(freed, 2);
+}
+
+void test_rcu_hash_table_threads()
+{
+  rcu_hash_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  pthread_t threads[READERS_COUNT];
+  struct reader_arg args[READERS_COUNT];
+  bool stop = false;
+
+  CU_ASSERT_EQUAL(rcu_hash_table_ctor(&t, &info), CDC_STATUS_OK);
+  for (int i = 0; i < READERS_COUNT; ++i) {
+    args[i].t = t;
+    args[i].stop = &stop;
+    args[i].errors = 0;
+    CU_ASSERT_EQUAL(pthread_create(&threads[i], NULL, reader, &args[i]), 0);
+  }
+
+  for (int k = 0; k < WRITER_ROUNDS; ++k) {
+    for (int i = 0; i < KEYS_COUNT; ++i) {
+      CU_ASSERT_EQUAL(rcu_hash_table_insert_or_assign(t, CDC_FROM_INT(i),
+                                                      CDC_FROM_INT(i + k * KEYS_COUNT), NULL),
+                      CDC_STATUS_OK);
+    }
+
+    for (int i = k % 2; i < KEYS_COUNT; i += 2) {
+      CU_ASSERT_EQUAL(rcu_hash_table_erase(t, CDC_FROM_INT(i)), 1);
+    }
+  }
+
+  __atomic_store_n(&stop, true, __ATOMIC_RELEASE);
+  for (int i = 0; i < READERS_COUNT; ++i) {
+    CU_ASSERT_EQUAL(pthread_join(threads[i], NULL), 0);
+    CU_ASSERT_EQUAL(args[i].errors, 0);
+  }
+
+  rcu_hash_table_reclaim(t);
+  CU_ASSERT_EQUAL(rcu_hash_table_retired_count(t), 0);
+  CU_ASSERT_EQUAL(rcu_hash_table_size(t), KEYS_COUNT / 2);
+  rcu_hash_table_dtor(t);
+}
@@ -0,0 +1,514 @@
+// The MIT License (MIT)
+// Copyright (c) 2018 Maksim Andrianov
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+#define CDC_USE_SHORT_NAMES
+#include "test-common.h"
+
+#include "cdcontainers/casts.h"
+#include "cdcontainers/global.h"
+#include "cdcontainers/robin-hood-table.h"
+
+#include <assert.h>
+#include <float.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <CUnit/Basic.h>
+
+static pair_t a = {CDC_FROM_INT(0), CDC_FROM_INT(0)};
+static pair_t b = {CDC_FROM_INT(1), CDC_FROM_INT(1)};
+static pair_t c = {CDC_FROM_INT(2), CDC_FROM_INT(2)};
+static pair_t d = {CDC_FROM_INT(3), CDC_FROM_INT(3)};
+static pair_t e = {CDC_FROM_INT(4), CDC_FROM_INT(4)};
+static pair_t f = {CDC_FROM_INT(5), CDC_FROM_INT(5)};
+static pair_t g = {CDC_FROM_INT(6), CDC_FROM_INT(6)};
+static pair_t h = {CDC_FROM_INT(7), CDC_FROM_INT(7)};
+
+static int eq(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) == CDC_TO_INT(r);
+}
+
+static int eq_plus_1(const void *l, const void *r)
+{
+  return CDC_TO_INT(l) + 1 == CDC_TO_INT(r) + 1;
+}
+
+static size_t hash(const void *val)
+{
+  return cdc_hash_int(CDC_TO_INT(val));
+}
+
+static size_t hash1(const void *val)
+{
+  return cdc_hash_uint(CDC_TO_UINT(val));
+}
+
+static size_t same_hash(const void *val)
+{
+  CDC_UNUSED(val);
+  return 0;
+}
+
+static bool robin_hood_table_key_int_eq(robin_hood_table_t *t, size_t count, ...)
+{
+  va_list args;
+  va_start(args, count);
+  for (size_t i = 0; i < count; ++i) {
+    pair_t *val = va_arg(args, pair_t *);
+    void *tmp = NULL;
+    if (robin_hood_table_get(t, val->first, &tmp) != CDC_STATUS_OK || tmp != val->second) {
+      va_end(args);
+      return false;
+    }
+  }
+
+  va_end(args);
+  return true;
+}
+
+void test_robin_hood_table_ctor()
+{
+  robin_hood_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctor1(&t, &info, 0.5), CDC_STATUS_OK);
+  CU_ASSERT(robin_hood_table_empty(t));
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_ctorl()
+{
+  robin_hood_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctorl1(&t, &info, 0.5, &a, &b, &c, &d, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 4);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 4, &a, &b, &c, &d));
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_get()
+{
+  robin_hood_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctorl1(&t, &info, 0.5, &a, &b, &c, &d, &g, &h, &e, &f, CDC_END),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 8);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 8, &a, &b, &c, &d, &g, &h, &e, &f));
+  void *value = NULL;
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, CDC_FROM_INT(10), &value), CDC_STATUS_NOT_FOUND);
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_count()
+{
+  robin_hood_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctorl1(&t, &info, 0.5, &a, &b, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 2);
+  CU_ASSERT_EQUAL(robin_hood_table_count(t, a.first), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_count(t, b.first), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_count(t, CDC_FROM_INT(10)), 0);
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_find()
+{
+  robin_hood_table_t *t = NULL;
+  robin_hood_table_iter_t it = CDC_INIT_STRUCT;
+  robin_hood_table_iter_t it_end = CDC_INIT_STRUCT;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctorl1(&t, &info, 0.5, &a, &b, &c, &d, &g, CDC_END),
+                  CDC_STATUS_OK);
+  robin_hood_table_find(t, a.first, &it);
+  CU_ASSERT_EQUAL(robin_hood_table_iter_value(&it), a.second);
+  robin_hood_table_find(t, b.first, &it);
+  CU_ASSERT_EQUAL(robin_hood_table_iter_value(&it), b.second);
+  robin_hood_table_find(t, g.first, &it);
+  CU_ASSERT_EQUAL(robin_hood_table_iter_value(&it), g.second);
+  robin_hood_table_find(t, h.first, &it);
+  robin_hood_table_end(t, &it_end);
+  CU_ASSERT(robin_hood_table_iter_is_eq(&it, &it_end));
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_clear()
+{
+  robin_hood_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctorl1(&t, &info, 0.5, &a, &b, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 2);
+  robin_hood_table_clear(t);
+  CU_ASSERT(robin_hood_table_empty(t));
+  robin_hood_table_clear(t);
+  CU_ASSERT(robin_hood_table_empty(t));
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_insert()
+{
+  robin_hood_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctor1(&t, &info, 0.5), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_insert(t, a.first, a.second, NULL, NULL), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 1);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 1, &a));
+
+  CU_ASSERT_EQUAL(robin_hood_table_insert(t, a.first, b.second, NULL, NULL), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 1);
+
+  void *value = NULL;
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, a.first, &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(value, a.second);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 1, &a));
+
+  CU_ASSERT_EQUAL(robin_hood_table_insert(t, b.first, b.second, NULL, NULL), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 2);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 2, &a, &b));
+
+  CU_ASSERT_EQUAL(robin_hood_table_insert(t, c.first, c.second, NULL, NULL), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 3);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 3, &a, &b, &c));
+
+  CU_ASSERT_EQUAL(robin_hood_table_insert(t, d.first, d.second, NULL, NULL), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 4);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 4, &a, &b, &c, &d));
+
+  CU_ASSERT_EQUAL(robin_hood_table_insert(t, e.first, e.second, NULL, NULL), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 5);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 5, &a, &b, &c, &d, &e));
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_insert_or_assign()
+{
+  robin_hood_table_t *t = NULL;
+  robin_hood_table_iter_t it = CDC_INIT_STRUCT;
+  bool inserted = false;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctor1(&t, &info, 0.5), CDC_STATUS_OK);
+
+  CU_ASSERT_EQUAL(robin_hood_table_insert_or_assign(t, a.first, a.second, &it, &inserted),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_iter_value(&it), a.second);
+  CU_ASSERT(inserted);
+
+  CU_ASSERT_EQUAL(robin_hood_table_insert_or_assign(t, a.first, b.second, &it, &inserted),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 1);
+
+  void *value = NULL;
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, a.first, &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(value, b.second);
+  CU_ASSERT_EQUAL(robin_hood_table_iter_value(&it), b.second);
+  CU_ASSERT(!inserted);
+
+  CU_ASSERT_EQUAL(robin_hood_table_insert_or_assign(t, c.first, c.second, &it, &inserted),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 2);
+  CU_ASSERT_EQUAL(robin_hood_table_iter_value(&it), c.second);
+  CU_ASSERT(inserted);
+
+  CU_ASSERT_EQUAL(robin_hood_table_insert_or_assign(t, c.first, d.second, &it, &inserted),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 2);
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, c.first, &value), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(value, d.second);
+  CU_ASSERT_EQUAL(robin_hood_table_iter_value(&it), d.second);
+  CU_ASSERT(!inserted);
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_erase()
+{
+  robin_hood_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+  void *value = NULL;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctorl1(&t, &info, 0.5, &a, &b, &c, &d, &g, &h, &e, &f, CDC_END),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 8);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 8, &a, &b, &c, &d, &g, &h, &e, &f));
+
+  CU_ASSERT_EQUAL(robin_hood_table_erase(t, a.first), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, a.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 7, &b, &c, &d, &g, &h, &e, &f));
+
+  CU_ASSERT_EQUAL(robin_hood_table_erase(t, h.first), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, h.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 6);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 6, &b, &c, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(robin_hood_table_erase(t, h.first), 0);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 6);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 6, &b, &c, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(robin_hood_table_erase(t, b.first), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, b.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 5);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 5, &c, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(robin_hood_table_erase(t, c.first), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, c.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 4);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 4, &d, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(robin_hood_table_erase(t, d.first), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, d.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 3);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 3, &g, &e, &f));
+
+  CU_ASSERT_EQUAL(robin_hood_table_erase(t, f.first), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, f.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 2);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 2, &g, &e));
+
+  CU_ASSERT_EQUAL(robin_hood_table_erase(t, e.first), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, e.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 1);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 1, &g));
+
+  CU_ASSERT_EQUAL(robin_hood_table_erase(t, g.first), 1);
+  CU_ASSERT_EQUAL(robin_hood_table_get(t, g.first, &value), CDC_STATUS_NOT_FOUND);
+  CU_ASSERT(robin_hood_table_empty(t));
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_swap()
+{
+  robin_hood_table_t *ta = NULL;
+  robin_hood_table_t *tb = NULL;
+  double lf_ta = 0.5;
+  double lf_tb = 0.75;
+
+  data_info_t infoa = CDC_INIT_STRUCT;
+  infoa.eq = eq;
+  infoa.hash = hash;
+
+  data_info_t infob = CDC_INIT_STRUCT;
+  infob.eq = eq_plus_1;
+  infob.hash = hash1;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctorl1(&ta, &infoa, lf_ta, &a, &b, CDC_END), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_ctorl1(&tb, &infob, lf_tb, &c, &d, CDC_END), CDC_STATUS_OK);
+
+  robin_hood_table_swap(ta, tb);
+
+  CU_ASSERT_EQUAL(ta->dinfo->eq, eq_plus_1);
+  CU_ASSERT_EQUAL(ta->dinfo->hash, hash1);
+  CU_ASSERT_EQUAL(robin_hood_table_max_load_factor(ta), lf_tb);
+  CU_ASSERT(robin_hood_table_key_int_eq(ta, 2, &c, &d));
+
+  CU_ASSERT_EQUAL(tb->dinfo->eq, eq);
+  CU_ASSERT_EQUAL(tb->dinfo->hash, hash);
+  CU_ASSERT_EQUAL(robin_hood_table_max_load_factor(tb), lf_ta);
+  CU_ASSERT(robin_hood_table_key_int_eq(tb, 2, &a, &b));
+  robin_hood_table_dtor(ta);
+  robin_hood_table_dtor(tb);
+}
+
+void test_robin_hood_table_rehash()
+{
+  robin_hood_table_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctorl1(&t, &info, 0.5, &a, &b, &c, &d, &g, &h, &e, &f, CDC_END),
+                  CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 8);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 8, &a, &b, &c, &d, &g, &h, &e, &f));
+
+  size_t bcount = robin_hood_table_bucket_count(t) * 100;
+  CU_ASSERT_EQUAL(robin_hood_table_rehash(t, bcount), CDC_STATUS_OK);
+  CU_ASSERT(robin_hood_table_bucket_count(t) >= bcount);
+
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), 8);
+  CU_ASSERT(robin_hood_table_key_int_eq(t, 8, &a, &b, &c, &d, &g, &h, &e, &f));
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_reserve()
+{
+  robin_hood_table_t *t = NULL;
+  size_t count = 100;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctor1(&t, &info, 0.5), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_reserve(t, count), CDC_STATUS_OK);
+  CU_ASSERT((size_t)(robin_hood_table_bucket_count(t) * robin_hood_table_max_load_factor(t)) >=
+            count);
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_iterators()
+{
+  robin_hood_table_t *t = NULL;
+  robin_hood_table_iter_t it = CDC_INIT_STRUCT;
+  robin_hood_table_iter_t it_end = CDC_INIT_STRUCT;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctor(&t, &info), CDC_STATUS_OK);
+  robin_hood_table_begin(t, &it);
+  robin_hood_table_end(t, &it_end);
+  CU_ASSERT(robin_hood_table_iter_is_eq(&it, &it_end));
+  robin_hood_table_dtor(t);
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctorl(&t, &info, &a, &b, &c, &d, &e, &f, &g, &h, CDC_END),
+                  CDC_STATUS_OK);
+  int seen = 0;
+  size_t count = 0;
+  robin_hood_table_begin(t, &it);
+  robin_hood_table_end(t, &it_end);
+  for (; !robin_hood_table_iter_is_eq(&it, &it_end); robin_hood_table_iter_next(&it)) {
+    pair_t pair = robin_hood_table_iter_key_value(&it);
+    CU_ASSERT_EQUAL(pair.first, pair.second);
+    seen |= 1 << CDC_TO_INT(robin_hood_table_iter_key(&it));
+    ++count;
+  }
+
+  CU_ASSERT_EQUAL(count, 8);
+  CU_ASSERT_EQUAL(seen, 0xff);
+  CU_ASSERT(!robin_hood_table_iter_has_next(&it));
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_many()
+{
+  robin_hood_table_t *t = NULL;
+  const int count = 10000;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctor(&t, &info), CDC_STATUS_OK);
+  for (int i = 0; i < count; ++i) {
+    CU_ASSERT_EQUAL(robin_hood_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                    CDC_STATUS_OK);
+  }
+
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), (size_t)count);
+  CU_ASSERT(robin_hood_table_load_factor(t) <= robin_hood_table_max_load_factor(t));
+  // Churn creates tombstones, they must not break lookups or grow the table forever.
+  size_t bcount = robin_hood_table_bucket_count(t);
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < count; i += 2) {
+      CU_ASSERT_EQUAL(robin_hood_table_erase(t, CDC_FROM_INT(i)), 1);
+    }
+
+    for (int i = 0; i < count; i += 2) {
+      CU_ASSERT_EQUAL(robin_hood_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                      CDC_STATUS_OK);
+    }
+  }
+
+  CU_ASSERT_EQUAL(robin_hood_table_bucket_count(t), bcount);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), (size_t)count);
+  for (int i = 0; i < count; ++i) {
+    void *value = NULL;
+    CU_ASSERT_EQUAL(robin_hood_table_get(t, CDC_FROM_INT(i), &value), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(CDC_TO_INT(value), i);
+  }
+
+  for (int i = 0; i < count; ++i) {
+    CU_ASSERT_EQUAL(robin_hood_table_erase(t, CDC_FROM_INT(i)), 1);
+    CU_ASSERT_EQUAL(robin_hood_table_count(t, CDC_FROM_INT(i)), 0);
+  }
+
+  CU_ASSERT(robin_hood_table_empty(t));
+  robin_hood_table_dtor(t);
+}
+
+void test_robin_hood_table_probe_length()
+{
+  robin_hood_table_t *t = NULL;
+  const int count = 10000;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.eq = eq;
+  info.hash = hash;
+
+  CU_ASSERT_EQUAL(robin_hood_table_ctor1(&t, &info, 0.95), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(robin_hood_table_max_probe_length(t), 0);
+  CU_ASSERT_EQUAL(robin_hood_table_mean_probe_length(t), 0);
+  for (int i = 0; i < count; ++i) {
+    CU_ASSERT_EQUAL(robin_hood_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL),
+                    CDC_STATUS_OK);
+  }
+
+  size_t max = robin_hood_table_max_probe_length(t);
+  double mean = robin_hood_table_mean_probe_length(t);
+  CU_ASSERT(max > 0 && max <= 128);
+  CU_ASSERT(mean > 0 && mean <= (double)max);
+  for (int i = 0; i < count; i += 2) {
+    CU_ASSERT_EQUAL(robin_hood_table_erase(t, CDC_FROM_INT(i)), 1);
+  }
+
+  // Backward shift deletion does not make probes longer.
+  CU_ASSERT(robin_hood_table_max_probe_length(t) <= max);
+  CU_ASSERT(robin_hood_table_mean_probe_length(t) <= mean);
+  robin_hood_table_dtor(t);
+
+  info.hash = same_hash;
+  CU_ASSERT_EQUAL(robin_hood_table_ctor(&t, &info), CDC_STATUS_OK);
+  stat_t stat = CDC_STATUS_OK;
+  int i = 0;
+  for (; i < count && stat == CDC_STATUS_OK; ++i) {
+    stat = robin_hood_table_insert(t, CDC_FROM_INT(i), CDC_FROM_INT(i), NULL, NULL);
+  }
+
+  CU_ASSERT_EQUAL(stat, CDC_STATUS_OVERFLOW);
+  CU_ASSERT_EQUAL(robin_hood_table_size(t), (size_t)(i - 1));
+  CU_ASSERT_EQUAL(robin_hood_table_max_probe_length(t), robin_hood_table_size(t) - 1);
+  for (int j = 0; j < i - 1; ++j) {
+    CU_ASSERT_EQUAL(robin_hood_table_count(t, CDC_FROM_INT(j)), 1);
+  }
+
+  robin_hood_table_dtor(t);
+}
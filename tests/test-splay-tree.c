@@ -358,3 +358,107 @@ void test_splay_tree_height()
   printf("\nExperimental splay tree heigth: %f, tree size: %zu\n", experimental_height, count);
   splay_tree_dtor(t);
 }
+
+void test_splay_tree_ctor_sorted()
+{
+  enum { kMaxSize = 1000 };
+  static pair_t pairs[kMaxSize];
+  const size_t sizes[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 15, 16, 17, 100, kMaxSize};
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  for (size_t i = 0; i < kMaxSize; ++i) {
+    pairs[i].first = CDC_FROM_INT(i);
+    pairs[i].second = CDC_FROM_INT(i * 2);
+  }
+
+  for (size_t s = 0; s < CDC_ARRAY_SIZE(sizes); ++s) {
+    size_t n = sizes[s];
+    splay_tree_t *t = NULL;
+    CU_ASSERT_EQUAL(splay_tree_ctor_sorted(&t, &info, pairs, n), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(splay_tree_size(t), n);
+    CU_ASSERT(cdc_tree_height(t->root) <= log2((double)n + 1) + 1);
+
+    splay_tree_iter_t it = CDC_INIT_STRUCT;
+    splay_tree_begin(t, &it);
+    for (size_t i = 0; i < n; ++i) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(splay_tree_iter_key(&it)), (int)i);
+      CU_ASSERT_EQUAL(CDC_TO_INT(splay_tree_iter_value(&it)), (int)(i * 2));
+      splay_tree_iter_next(&it);
+    }
+
+    CU_ASSERT(!splay_tree_iter_has_next(&it));
+    for (size_t i = 0; i < n; i += 2) {
+      CU_ASSERT_EQUAL(splay_tree_erase(t, CDC_FROM_INT(i)), 1);
+    }
+
+    CU_ASSERT_EQUAL(splay_tree_insert(t, CDC_FROM_INT(n), NULL, NULL), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(splay_tree_size(t), n / 2 + 1);
+    splay_tree_dtor(t);
+  }
+}
+
+void test_splay_tree_bounds()
+{
+  enum { kKeys = 500 };
+  splay_tree_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(splay_tree_ctor(&t, &info), CDC_STATUS_OK);
+  for (int i = 0; i < kKeys; ++i) {
+    CU_ASSERT_EQUAL(splay_tree_insert(t, CDC_FROM_INT(i * 2), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+  }
+
+  splay_tree_iter_t it = CDC_INIT_STRUCT;
+  splay_tree_iter_t end = CDC_INIT_STRUCT;
+  splay_tree_end(t, &end);
+  for (int key = -1; key <= kKeys * 2; ++key) {
+    int lower = key < 0 ? 0 : key + key % 2;
+    splay_tree_lower_bound(t, CDC_FROM_INT(key), &it);
+    if (lower < kKeys * 2) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(splay_tree_iter_key(&it)), lower);
+    } else {
+      CU_ASSERT(splay_tree_iter_is_eq(&it, &end));
+    }
+
+    int upper = key < 0 ? 0 : key + 2 - key % 2;
+    splay_tree_upper_bound(t, CDC_FROM_INT(key), &it);
+    if (upper < kKeys * 2) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(splay_tree_iter_key(&it)), upper);
+    } else {
+      CU_ASSERT(splay_tree_iter_is_eq(&it, &end));
+    }
+
+    pair_splay_tree_iter_t range = CDC_INIT_STRUCT;
+    splay_tree_equal_range(t, CDC_FROM_INT(key), &range);
+    size_t count = 0;
+    while (!splay_tree_iter_is_eq(&range.first, &range.second)) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(splay_tree_iter_key(&range.first)), key);
+      splay_tree_iter_next(&range.first);
+      ++count;
+    }
+
+    CU_ASSERT_EQUAL(count, splay_tree_count(t, CDC_FROM_INT(key)));
+  }
+
+  pair_splay_tree_iter_t range = CDC_INIT_STRUCT;
+  splay_tree_range(t, CDC_FROM_INT(101), CDC_FROM_INT(200), &range);
+  for (int key = 102; key < 200; key += 2) {
+    CU_ASSERT_EQUAL(CDC_TO_INT(splay_tree_iter_key(&range.first)), key);
+    CU_ASSERT_EQUAL(CDC_TO_INT(splay_tree_iter_value(&range.first)), key / 2);
+    splay_tree_iter_next(&range.first);
+  }
+
+  CU_ASSERT(splay_tree_iter_is_eq(&range.first, &range.second));
+  splay_tree_range(t, CDC_FROM_INT(7), CDC_FROM_INT(7), &range);
+  CU_ASSERT(splay_tree_iter_is_eq(&range.first, &range.second));
+  splay_tree_range(t, CDC_FROM_INT(900), CDC_FROM_INT(kKeys * 4), &range);
+  CU_ASSERT_EQUAL(CDC_TO_INT(splay_tree_iter_key(&range.first)), 900);
+  CU_ASSERT(splay_tree_iter_is_eq(&range.second, &end));
+  splay_tree_clear(t);
+  splay_tree_lower_bound(t, CDC_FROM_INT(0), &it);
+  splay_tree_end(t, &end);
+  CU_ASSERT(splay_tree_iter_is_eq(&it, &end));
+  splay_tree_dtor(t);
+}
@@ -28,6 +28,8 @@
 #include <float.h>
 #include <math.h>
 #include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <CUnit/Basic.h>
 
@@ -354,3 +356,197 @@ void test_treap_height()
   printf("\nExperimental treap heigth: %f, tree size: %zu\n", experimental_height, count);
   treap_dtor(t);
 }
+
+// Checks the links and the heap property of the subtree.
+static void test_tree_heap(treap_node_t *node)
+{
+  if (!node) return;
+
+  if (node->left) {
+    CU_ASSERT_EQUAL(node->left->parent, node);
+    CU_ASSERT(node->left->priority <= node->priority);
+    test_tree_heap(node->left);
+  }
+
+  if (node->right) {
+    CU_ASSERT_EQUAL(node->right->parent, node);
+    CU_ASSERT(node->right->priority <= node->priority);
+    test_tree_heap(node->right);
+  }
+}
+
+void test_treap_ctor_sorted()
+{
+  enum { kMaxSize = 1000 };
+  static pair_t pairs[kMaxSize];
+  const size_t sizes[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 15, 16, 17, 100, kMaxSize};
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  for (size_t i = 0; i < kMaxSize; ++i) {
+    pairs[i].first = CDC_FROM_INT(i);
+    pairs[i].second = CDC_FROM_INT(i * 2);
+  }
+
+  for (size_t s = 0; s < CDC_ARRAY_SIZE(sizes); ++s) {
+    size_t n = sizes[s];
+    treap_t *t = NULL;
+    CU_ASSERT_EQUAL(treap_ctor_sorted(&t, &info, pairs, n), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(treap_size(t), n);
+    test_tree_heap(t->root);
+    if (t->root) {
+      CU_ASSERT_PTR_NULL(t->root->parent);
+    }
+
+    treap_iter_t it = CDC_INIT_STRUCT;
+    treap_begin(t, &it);
+    for (size_t i = 0; i < n; ++i) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(treap_iter_key(&it)), (int)i);
+      CU_ASSERT_EQUAL(CDC_TO_INT(treap_iter_value(&it)), (int)(i * 2));
+      treap_iter_next(&it);
+    }
+
+    CU_ASSERT(!treap_iter_has_next(&it));
+    for (size_t i = 0; i < n; i += 2) {
+      CU_ASSERT_EQUAL(treap_erase(t, CDC_FROM_INT(i)), 1);
+    }
+
+    CU_ASSERT_EQUAL(treap_insert(t, CDC_FROM_INT(n), NULL, NULL), CDC_STATUS_OK);
+    CU_ASSERT_EQUAL(treap_size(t), n / 2 + 1);
+    test_tree_heap(t->root);
+    treap_dtor(t);
+  }
+}
+
+void test_treap_bounds()
+{
+  enum { kKeys = 500 };
+  treap_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  CU_ASSERT_EQUAL(treap_ctor(&t, &info), CDC_STATUS_OK);
+  for (int i = 0; i < kKeys; ++i) {
+    CU_ASSERT_EQUAL(treap_insert(t, CDC_FROM_INT(i * 2), CDC_FROM_INT(i), NULL), CDC_STATUS_OK);
+  }
+
+  treap_iter_t it = CDC_INIT_STRUCT;
+  treap_iter_t end = CDC_INIT_STRUCT;
+  treap_end(t, &end);
+  for (int key = -1; key <= kKeys * 2; ++key) {
+    int lower = key < 0 ? 0 : key + key % 2;
+    treap_lower_bound(t, CDC_FROM_INT(key), &it);
+    if (lower < kKeys * 2) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(treap_iter_key(&it)), lower);
+    } else {
+      CU_ASSERT(treap_iter_is_eq(&it, &end));
+    }
+
+    int upper = key < 0 ? 0 : key + 2 - key % 2;
+    treap_upper_bound(t, CDC_FROM_INT(key), &it);
+    if (upper < kKeys * 2) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(treap_iter_key(&it)), upper);
+    } else {
+      CU_ASSERT(treap_iter_is_eq(&it, &end));
+    }
+
+    pair_treap_iter_t range = CDC_INIT_STRUCT;
+    treap_equal_range(t, CDC_FROM_INT(key), &range);
+    size_t count = 0;
+    while (!treap_iter_is_eq(&range.first, &range.second)) {
+      CU_ASSERT_EQUAL(CDC_TO_INT(treap_iter_key(&range.first)), key);
+      treap_iter_next(&range.first);
+      ++count;
+    }
+
+    CU_ASSERT_EQUAL(count, treap_count(t, CDC_FROM_INT(key)));
+  }
+
+  pair_treap_iter_t range = CDC_INIT_STRUCT;
+  treap_range(t, CDC_FROM_INT(101), CDC_FROM_INT(200), &range);
+  for (int key = 102; key < 200; key += 2) {
+    CU_ASSERT_EQUAL(CDC_TO_INT(treap_iter_key(&range.first)), key);
+    CU_ASSERT_EQUAL(CDC_TO_INT(treap_iter_value(&range.first)), key / 2);
+    treap_iter_next(&range.first);
+  }
+
+  CU_ASSERT(treap_iter_is_eq(&range.first, &range.second));
+  treap_range(t, CDC_FROM_INT(7), CDC_FROM_INT(7), &range);
+  CU_ASSERT(treap_iter_is_eq(&range.first, &range.second));
+  treap_range(t, CDC_FROM_INT(900), CDC_FROM_INT(kKeys * 4), &range);
+  CU_ASSERT_EQUAL(CDC_TO_INT(treap_iter_key(&range.first)), 900);
+  CU_ASSERT(treap_iter_is_eq(&range.second, &end));
+  treap_clear(t);
+  treap_lower_bound(t, CDC_FROM_INT(0), &it);
+  treap_end(t, &end);
+  CU_ASSERT(treap_iter_is_eq(&it, &end));
+  treap_dtor(t);
+}
+
+#ifdef CDC_ORDER_STATISTICS
+// Checks the subtree sizes and returns the size of the subtree.
+static size_t test_tree_sizes(treap_node_t *node)
+{
+  if (!node) return 0;
+
+  size_t size = test_tree_sizes(node->left) + test_tree_sizes(node->right) + 1;
+  CU_ASSERT_EQUAL(node->size, size);
+  return size;
+}
+
+void test_treap_select_rank()
+{
+  enum { kKeys = 1000, kOps = 20000 };
+  static pair_t pairs[kKeys];
+  static bool present[kKeys];
+  treap_t *t = NULL;
+  data_info_t info = CDC_INIT_STRUCT;
+  info.cmp = lt;
+
+  for (int i = 0; i < kKeys; ++i) {
+    pairs[i].first = CDC_FROM_INT(i);
+    pairs[i].second = CDC_FROM_INT(i);
+    present[i] = true;
+  }
+
+  CU_ASSERT_EQUAL(treap_ctor_sorted(&t, &info, pairs, kKeys), CDC_STATUS_OK);
+  CU_ASSERT_EQUAL(test_tree_sizes(t->root), kKeys);
+  srand(19);
+  for (int i = 0; i < kOps; ++i) {
+    int key = rand() % kKeys;
+    if (rand() % 2) {
+      CU_ASSERT_EQUAL(treap_insert(t, CDC_FROM_INT(key), CDC_FROM_INT(key), NULL),
+                      CDC_STATUS_OK);
+      present[key] = true;
+    } else {
+      CU_ASSERT_EQUAL(treap_erase(t, CDC_FROM_INT(key)), (size_t)present[key]);
+      present[key] = false;
+    }
+
+    if (i % 100 == 0) {
+      test_tree_heap(t->root);
+      CU_ASSERT_EQUAL(test_tree_sizes(t->root), treap_size(t));
+    }
+  }
+
+  treap_iter_t it = CDC_INIT_STRUCT;
+  treap_iter_t end = CDC_INIT_STRUCT;
+  size_t rank = 0;
+  for (int key = 0; key < kKeys; ++key) {
+    CU_ASSERT_EQUAL(treap_rank(t, CDC_FROM_INT(key)), rank);
+    if (present[key]) {
+      treap_select(t, rank, &it);
+      CU_ASSERT_EQUAL(CDC_TO_INT(treap_iter_key(&it)), key);
+      ++rank;
+    }
+  }
+
+  CU_ASSERT_EQUAL(treap_size(t), rank);
+  treap_select(t, rank, &it);
+  treap_end(t, &end);
+  CU_ASSERT(treap_iter_is_eq(&it, &end));
+  treap_clear(t);
+  CU_ASSERT_EQUAL(treap_rank(t, CDC_FROM_INT(0)), 0);
+  treap_dtor(t);
+}
+#endif